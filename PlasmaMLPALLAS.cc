@@ -16,6 +16,16 @@
 #include "G4UIExecutive.hh"
 #include "Geometry.hh"
 #include "G4MTRunManager.hh"
+#include "G4TaskRunManager.hh"
+#include "PlasmaMLPALLASOnnxInference.hh"
+#include "PlasmaMLPALLASPhaseSpaceFile.hh"
+#include "PlasmaMLPALLASFieldMap.hh"
+#include "PlasmaMLPALLASScanDriver.hh"
+#include "PlasmaMLPALLASCheckpoint.hh"
+#include "PlasmaMLPALLASMPIDriver.hh"
+#include "PlasmaMLPALLASStartupCache.hh"
+#include "PlasmaMLPALLASOutputManager.hh"
+#include "TROOT.h"
 #include <thread>
 #include <mutex>
 #include <fstream>
@@ -28,7 +38,33 @@
  *
  * This program can run in two modes:
  * 1. Visualization mode: `./PlasmaMLPALLAS outputFile`
- * 2. Batch mode: `./PlasmaMLPALLAS outputFile NParticles macro MT ON/OFF [threads]`
+ * 2. Batch mode: `./PlasmaMLPALLAS outputFile NParticles macro ON/TASKS/OFF [threads]`
+ *
+ * In batch mode ON selects G4MTRunManager, TASKS G4TaskRunManager (events
+ * taken by the idle threads in tasks of /run/eventModulo events, with TBB
+ * when G4USE_TBB=1) and OFF the sequential G4RunManager. Built with WITH_MPI
+ * and launched with mpirun on several ranks, the events of the final
+ * /run/beamOn are shared by the ranks (PlasmaMLPALLASMPIDriver) and rank 0
+ * writes the merged output file.
+ *
+ * A third mode only evaluates the ONNX model on a grid of laser/plasma inputs
+ * and writes the predicted moments to a CSV file, without running any event:
+ * `./PlasmaMLPALLAS --predict output.csv Xoff A0 CN2 Pressure`
+ * where each input is either a single value or `min:max:n`.
+ *
+ * A fourth mode converts a CSV bunch (x,y,z,ux,uy,uz,Ekin,weight) into the
+ * binary file read by the phase-space source (setStatusONNX 2):
+ * `./PlasmaMLPALLAS --phasespace input.csv output.bin`
+ *
+ * A fifth mode converts a text table of a measured dipole map (x,y,z,Bx,By,Bz
+ * on a regular grid) into the binary file read with setStatusMapBField 2:
+ * `./PlasmaMLPALLAS --fieldmap input.csv output.bin`
+ *
+ * In batch mode, a macro calling /PlasmaMLPALLAS/scan/run replaces the final
+ * /run/beamOn: all the working points end up in the same output file. The
+ * visualization is not set up, and a startup cache
+ * (/PlasmaMLPALLAS/cache/setDirectory) saves the GDML parsing and the
+ * physics table building of the next jobs.
  */
 int main(int argc, char **argv)
 {
@@ -40,8 +76,61 @@ int main(int argc, char **argv)
         return 1;
     }
 
+    /** Prediction mode: dump ONNX moments for a grid of inputs */
+    if (std::string(argv[1]) == "--predict")
+    {
+        std::array<OnnxGridAxis, 4> axes;
+        if (argc != 7 || !OnnxGridAxis::Parse(argv[3], axes[0]) || !OnnxGridAxis::Parse(argv[4], axes[1]) ||
+            !OnnxGridAxis::Parse(argv[5], axes[2]) || !OnnxGridAxis::Parse(argv[6], axes[3]))
+        {
+            G4Exception("Main", "main0005", FatalException,
+                        "Usage: ./PlasmaMLPALLAS --predict [CSV file] [Xoff] [A0] [CN2] [Pressure] with each input given as value or min:max:n");
+            return 1;
+        }
+
+        PlasmaMLPALLASOnnxInference inference;
+        size_t nPoints = inference.DumpMomentsGrid(axes, argv[2]);
+        G4cout << nPoints << " predictions saved to file " << argv[2] << G4endl;
+        return 0;
+    }
+
+    /** Conversion mode: build a binary phase-space file from a CSV table */
+    if (std::string(argv[1]) == "--phasespace")
+    {
+        if (argc != 4)
+        {
+            G4Exception("Main", "main0006", FatalException,
+                        "Usage: ./PlasmaMLPALLAS --phasespace [CSV file] [binary file]");
+            return 1;
+        }
+
+        size_t nRecords = PlasmaMLPALLASPhaseSpaceFile::ConvertCSV(argv[2], argv[3]);
+        G4cout << nRecords << " macro-particles saved to file " << argv[3] << G4endl;
+        return 0;
+    }
+
+    /** Conversion mode: build a binary 3D field map from a text table */
+    if (std::string(argv[1]) == "--fieldmap")
+    {
+        if (argc != 4)
+        {
+            G4Exception("Main", "main0007", FatalException,
+                        "Usage: ./PlasmaMLPALLAS --fieldmap [CSV file] [binary file]");
+            return 1;
+        }
+
+        size_t nNodes = PlasmaMLPALLASFieldMap::ConvertCSV(argv[2], argv[3]);
+        G4cout << nNodes << " field map nodes saved to file " << argv[3] << G4endl;
+        return 0;
+    }
+
+    /** MPI ranks of the job (a single rank without WITH_MPI or mpirun) */
+    PlasmaMLPALLASMPIDriver &mpi = PlasmaMLPALLASMPIDriver::Instance();
+    mpi.Initialize(&argc, &argv);
+
     /** Output file name */
     char *outputFile = argv[1];
+    mpi.SetOutputName(outputFile);
 
     /** Total number of particles to simulate (for batch mode) */
     size_t TotalNParticles = 0;
@@ -55,6 +144,9 @@ int main(int argc, char **argv)
     /** Pointer to the Geant4 run manager (single or multi-threaded) */
     G4RunManager *runManager;
 
+    /** Thread-local gDirectory and ROOT global lists protected: every worker fills the trees of its own file without lock */
+    ROOT::EnableThreadSafety();
+
     /** Determine execution mode */
     if (argc == 2) // VISUALIZATION MODE
     {
@@ -65,11 +157,14 @@ int main(int argc, char **argv)
         TotalNParticles = std::stoul(argv[2]);
         G4String pMT = argv[4];
 
-        /** Multi-threaded mode */
-        if (pMT == "ON")
+        /** Multi-threaded mode, with a thread per worker or a pool of threads taking tasks of events */
+        if (pMT == "ON" || pMT == "TASKS")
         {
             flag_MT = true;
-            runManager = new G4MTRunManager;
+            if (pMT == "TASKS")
+                runManager = new G4TaskRunManager;
+            else
+                runManager = new G4MTRunManager;
 
             if (argc == 6)
                 Ncores = std::stoul(argv[5]);
@@ -85,7 +180,7 @@ int main(int argc, char **argv)
         else
         {
             G4Exception("Main", "main0002", FatalException,
-                        "MT parameter (5th argument) must be ON or OFF.");
+                        "MT parameter (5th argument) must be ON, TASKS or OFF.");
         }
     }
     else
@@ -106,9 +201,13 @@ int main(int argc, char **argv)
     runManager->SetUserInitialization(new PlasmaMLPALLASActionInitialization(
         outputFile, TotalNParticles, Ncores, flag_MT, GeomCons));
 
-    /** Initialize visualization manager */
-    G4VisManager *visManager = new G4VisExecutive;
-    visManager->Initialize();
+    /** Initialize visualization manager (interactive mode only: batch jobs skip the drivers setup) */
+    G4VisManager *visManager = nullptr;
+    if (argc == 2)
+    {
+        visManager = new G4VisExecutive;
+        visManager->Initialize();
+    }
 
     /** Initialize Geant4 kernel */
     runManager->Initialize();
@@ -131,36 +230,31 @@ int main(int argc, char **argv)
         G4String macro = argv[3];
         UI->ApplyCommand(command + macro);
 
-        std::string runCommand = "/run/beamOn " + std::string(argv[2]);
-        UI->ApplyCommand(runCommand);
-
-        /** Multi-threaded: merge output ROOT files */
-        if (flag_MT)
+        /** A macro running /PlasmaMLPALLAS/scan/run, checkpoint/beamOn or mpi/beamOn already simulated its events */
+        if (!PlasmaMLPALLASScanDriver::Instance().HasRun() && !PlasmaMLPALLASCheckpoint::Instance().HasRun() && !mpi.HasRun())
         {
-            std::string mergeCommand = "/control/shell hadd -k -f " + std::string(outputFile) + ".root";
-            for (size_t i = 1; i <= Ncores; ++i)
+            if (mpi.IsDistributed())
+                mpi.Run(TotalNParticles);
+            else
             {
-                mergeCommand += " " + std::string(outputFile) + "_" + std::to_string(i) + ".root";
-            }
-            UI->ApplyCommand(mergeCommand);
-
-            /** Clean up temporary files */
-            for (size_t i = 1; i <= Ncores; ++i)
-            {
-                std::string removeCommand = "/control/shell rm -f " + std::string(outputFile) + "_" + std::to_string(i) + ".root";
-                UI->ApplyCommand(removeCommand);
+                std::string runCommand = "/run/beamOn " + std::string(argv[2]);
+                UI->ApplyCommand(runCommand);
             }
         }
+
+        /** Keep the physics tables of this configuration for the next jobs (/PlasmaMLPALLAS/cache/setDirectory), once per job */
+        if (mpi.GetRank() == 0)
+            PlasmaMLPALLASStartupCache::Instance().StorePhysicsTables();
     }
 
-    /** Move final ROOT file to results folder */
-    std::string movefile = "/control/shell mv " + std::string(outputFile) + ".root ../Resultats";
-    UI->ApplyCommand(movefile);
-    G4cout << "Output saved in Resultats folder to file " << outputFile << ".root" << G4endl;
+    /** The run action wrote the final file (merged in memory from the worker threads in MT, by rank 0 with MPI) */
+    if (mpi.GetRank() == 0)
+        G4cout << "Output saved to " << PlasmaMLPALLASOutputManager::Instance().GetOutputPath(outputFile) << G4endl;
 
     /** Final cleanup */
     delete visManager;
     delete runManager;
+    mpi.Finalize();
 
     return 0;
 }
@@ -0,0 +1,399 @@
+/**
+ * @file PlasmaMLPALLAS_bench.cc
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ * @brief Micro-benchmarks of the hot paths of the simulation.
+ *
+ * Each benchmark times one operation of the event loop outside of any run,
+ * on realistic inputs:
+ *  - field/...: PlasmaMLPALLASMagneticField::GetFieldValue at points of the
+ *    constant dipole, of the quadrupoles and of the drifts (PALLAS lattice
+ *    of vis.mac);
+ *  - onnx/...: the per-primary path of the generator, PredictMoments then
+ *    PlasmaMLPALLASBeamSampler::Next with the default source optics, on the
+ *    same working point (moments cached, sampling only) and on a new point at
+ *    every call (one session run each), skipped without the model file;
+ *  - stepping/...: PlasmaMLPALLASSteppingAction::UserSteppingAction on steps
+ *    located by a G4Navigator in a geometry holding the named volumes of the
+ *    role table and unnamed ones, in a shuffled order;
+ *  - output/...: filling of an Input-like table and of a YAG-like table with
+ *    hit vectors (PlasmaMLPALLASOutputTable, as the run action does) into an
+ *    in-memory file, synchronously and with one writer thread.
+ *
+ * Usage, from the directory of the executable (for the ONNX model):
+ * `./PlasmaMLPALLAS_bench [filter] [repetitions]`
+ * where only the benchmarks whose name contains the filter are run. Each
+ * benchmark is repeated (default 5) and the fastest repetition is kept. The
+ * results are a CSV table on stdout, the Geant4 output goes to stderr:
+ *
+ *   benchmark,iterations,ns_per_op,ops_per_s
+ *
+ * The end-to-end throughput, startup time and thread scaling of a macro are
+ * measured by bench/scaling.sh with the PlasmaMLPALLAS executable itself.
+ */
+
+#include "PlasmaMLPALLASMagneticField.hh"
+#include "PlasmaMLPALLASOnnxInference.hh"
+#include "PlasmaMLPALLASBeamSampler.hh"
+#include "PlasmaMLPALLASRunConfig.hh"
+#include "PlasmaMLPALLASOnnxSession.hh"
+#include "PlasmaMLPALLASSteppingAction.hh"
+#include "PlasmaMLPALLASVolumeRoles.hh"
+#include "PlasmaMLPALLASOutputManager.hh"
+#include "PlasmaMLPALLASOutputTable.hh"
+#include "G4Box.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PVPlacement.hh"
+#include "G4NistManager.hh"
+#include "G4Navigator.hh"
+#include "G4TouchableHistory.hh"
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4Track.hh"
+#include "G4DynamicParticle.hh"
+#include "G4Electron.hh"
+#include "G4UImanager.hh"
+#include "G4UIsession.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ios.hh"
+#include "TMemFile.h"
+#include "TROOT.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /// Sink of the results, so that the compiler keeps the timed work
+    volatile G4double gSink = 0.;
+
+    /// Options of the command line
+    struct Options
+    {
+        std::string filter;   ///< Substring of the benchmarks to run
+        int repetitions = 5;  ///< Repetitions of each benchmark
+    };
+
+    /**
+     * @brief Whether one of the benchmarks of a group is selected (its set-up is skipped otherwise).
+     * @param options Filter
+     * @param names Names of the benchmarks of the group
+     */
+    G4bool Selected(const Options& options, std::initializer_list<const char*> names)
+    {
+        return std::any_of(names.begin(), names.end(), [&options](const char* name)
+                           { return std::string(name).find(options.filter) != std::string::npos; });
+    }
+
+    /// Geant4 output sent to stderr, out of the CSV table
+    class StderrSession : public G4UIsession
+    {
+    public:
+        G4int ReceiveG4cout(const G4String& message) override
+        {
+            std::cerr << message << std::flush;
+            return 0;
+        }
+        G4int ReceiveG4cerr(const G4String& message) override
+        {
+            std::cerr << message << std::flush;
+            return 0;
+        }
+    };
+
+    /**
+     * @brief Time a benchmark and print its CSV line.
+     * @param options Filter and repetitions
+     * @param name Name of the benchmark
+     * @param iterations Operations per repetition
+     * @param body Runs the given number of operations
+     */
+    void Run(const Options& options, const std::string& name, size_t iterations, const std::function<void(size_t)>& body)
+    {
+        if (name.find(options.filter) == std::string::npos)
+            return;
+
+        body(std::max<size_t>(iterations / 10, 1)); // warm-up: caches, lazy initialisations
+        double best = 0.;
+        for (int r = 0; r < options.repetitions; ++r)
+        {
+            const auto begin = std::chrono::steady_clock::now();
+            body(iterations);
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            best = (r == 0) ? seconds : std::min(best, seconds);
+        }
+        std::printf("%s,%zu,%.2f,%.6g\n", name.c_str(), iterations, 1e9 * best / iterations, iterations / best);
+        std::fflush(stdout);
+    }
+
+    //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+    /**
+     * @brief GetFieldValue at points of the dipole, of the quadrupoles and of the drifts.
+     */
+    void BenchField(const Options& options)
+    {
+        if (!Selected(options, {"field/dipole", "field/quadrupole", "field/drift"}))
+            return;
+
+        // PALLAS lattice of vis.mac: drift before each quadrupole, length, gradient
+        PlasmaMLPALLASMagneticField field;
+        const G4double drifts[4] = {173.331 * mm, 165.062 * mm, 259.041 * mm, 865.36 * mm};
+        const G4double lengths[4] = {100. * mm, 100. * mm, 200. * mm, 100. * mm};
+        const G4double gradients[4] = {-40.777059 * tesla / m, 29.517133 * tesla / m, -7.928288 * tesla / m, 8.503759 * tesla / m};
+        for (size_t i = 0; i < 4; ++i)
+        {
+            field.SetQDrift(i, drifts[i]);
+            field.SetQLength(i, lengths[i]);
+            field.SetGradient(i, gradients[i]);
+        }
+        field.SetMapBFieldStatus(0);
+        field.SetDipoleField(0.65 * tesla);
+
+        // 4096 points per region, in the apertures and along the beam
+        std::mt19937_64 engine(12345);
+        auto uniform = [&engine](G4double a, G4double b) { return std::uniform_real_distribution<G4double>(a, b)(engine); };
+        constexpr size_t kPoints = 4096;
+        std::vector<std::array<G4double, 4>> dipole(kPoints), quad(kPoints), drift(kPoints);
+        for (size_t i = 0; i < kPoints; ++i)
+        {
+            dipole[i] = {uniform(-50., 50.), uniform(3300., 3580.), uniform(-100., 100.), 0.};
+            const LatticeElement& element = field.GetLattice()[i % field.GetLattice().size()];
+            quad[i] = {uniform(-15., 15.), uniform(element.begin, element.end), uniform(-15., 15.), 0.};
+            drift[i] = {uniform(-15., 15.), (i % 2) ? uniform(1000., 1800.) : uniform(2000., 3200.), uniform(-15., 15.), 0.};
+        }
+
+        const std::pair<const char*, const std::vector<std::array<G4double, 4>>*> regions[3] = {
+            {"field/dipole", &dipole}, {"field/quadrupole", &quad}, {"field/drift", &drift}};
+        for (const auto& region : regions)
+        {
+            const std::vector<std::array<G4double, 4>>& points = *region.second;
+            Run(options, region.first, 4000000, [&field, &points](size_t n)
+                {
+                    G4double b[3], sum = 0.;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        field.GetFieldValue(points[i % kPoints].data(), b);
+                        sum += b[0] + b[2];
+                    }
+                    gSink = gSink + sum; });
+        }
+    }
+
+    //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+    /**
+     * @brief PredictMoments and BeamSampler::Next on a cached working point and on a new point at every call.
+     */
+    void BenchOnnx(const Options& options)
+    {
+        if (!Selected(options, {"onnx/generate_cached", "onnx/generate_new_point"}))
+            return;
+
+        const G4String model = PlasmaMLPALLASOnnxSession::Instance().GetModelPath();
+        if (!std::ifstream(model.c_str()))
+        {
+            G4cerr << "onnx/...: model " << model << " not found, skipped (run from the directory of the executable)" << G4endl;
+            return;
+        }
+
+        // Same calls as PlasmaMLPALLASPrimaryGeneratorAction for each ONNX primary
+        PlasmaMLPALLASOnnxInference inference;
+        PlasmaMLPALLASBeamSampler sampler;
+        const PlasmaMLPALLASRunConfig config;
+        sampler.SetTwiss(config.twissX, config.twissZ);
+
+        Run(options, "onnx/generate_cached", 200000, [&inference, &sampler](size_t n)
+            {
+                G4double sum = 0.;
+                for (size_t i = 0; i < n; ++i)
+                    sum += sampler.Next(inference.PredictMoments(600., 1.5, 0.0188, 50.)).Ekin;
+                gSink = gSink + sum; });
+
+        G4double xoff = -400.;
+        Run(options, "onnx/generate_new_point", 2000, [&inference, &sampler, &xoff](size_t n)
+            {
+                G4double sum = 0.;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    xoff = (xoff < 1800.) ? xoff + 0.1 : -400.;
+                    sum += sampler.Next(inference.PredictMoments(xoff, 1.5, 0.0188, 50.)).Ekin;
+                }
+                gSink = gSink + sum; });
+    }
+
+    //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+    /**
+     * @brief UserSteppingAction on steps in the volumes of the role table and in unnamed ones.
+     */
+    void BenchStepping(const Options& options)
+    {
+        if (!Selected(options, {"stepping/classify"}))
+            return;
+
+        // A world holding one box per role name and as many volumes without role, along y
+        G4Material* vacuum = G4NistManager::Instance()->FindOrBuildMaterial("G4_Galactic");
+        auto* worldLogical = new G4LogicalVolume(new G4Box("World", 1. * m, 5. * m, 1. * m), vacuum, "World");
+        G4VPhysicalVolume* world = new G4PVPlacement(nullptr, G4ThreeVector(), worldLogical, "World", nullptr, false, 0);
+        const char* names[] = {"Holder", "Q1Volume", "Q2Volume", "Q3Volume", "Q4Volume", "HorizontalCollimator",
+                               "VerticalCollimator", "BS1_YAG", "BSPEC1_YAG"};
+        std::vector<G4String> volumes(names, names + 9);
+        for (int i = 0; i < 9; ++i)
+            volumes.push_back("Chamber" + std::to_string(i));
+        auto* boxLogical = new G4LogicalVolume(new G4Box("Element", 5. * cm, 5. * cm, 5. * cm), vacuum, "Element");
+        std::vector<G4ThreeVector> centres;
+        for (size_t i = 0; i < volumes.size(); ++i)
+        {
+            centres.emplace_back(0., -4.5 * m + i * 50. * cm, 0.);
+            new G4PVPlacement(nullptr, centres.back(), boxLogical, volumes[i], worldLogical, false, static_cast<G4int>(i));
+        }
+        centres.emplace_back(50. * cm, 0., 0.); // in the world itself
+
+        PlasmaMLPALLASVolumeRoles roles;
+        roles.Build();
+        PlasmaMLPALLASSteppingAction stepping(roles);
+        G4UImanager::GetUIpointer()->ApplyCommand("/PlasmaMLPALLAS/step/SetTrackingStatusCollimators false");
+
+        // Steps of a primary electron, pre and post point located in the geometry, shuffled
+        G4Navigator navigator;
+        navigator.SetWorldVolume(world);
+        auto touchable = [&navigator](const G4ThreeVector& position)
+        {
+            navigator.LocateGlobalPointAndSetup(position, nullptr, false);
+            return G4TouchableHandle(navigator.CreateTouchableHistory());
+        };
+
+        G4Track track(new G4DynamicParticle(G4Electron::Definition(), G4ThreeVector(0., 1., 0.), 100. * MeV), 0., G4ThreeVector());
+        track.SetParentID(0);
+        constexpr size_t kSteps = 1024;
+        std::mt19937_64 engine(12345);
+        std::vector<std::unique_ptr<G4Step>> steps;
+        for (size_t i = 0; i < kSteps; ++i)
+        {
+            auto step = std::make_unique<G4Step>();
+            step->SetTrack(&track);
+            step->GetPreStepPoint()->SetTouchableHandle(touchable(centres[engine() % centres.size()]));
+            step->GetPostStepPoint()->SetTouchableHandle(touchable(centres[engine() % centres.size()]));
+            steps.push_back(std::move(step));
+        }
+
+        Run(options, "stepping/classify", 10000000, [&stepping, &steps, &track](size_t n)
+            {
+                G4int killed = 0;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    stepping.UserSteppingAction(steps[i % kSteps].get());
+                    killed += track.GetTrackStatus() != fAlive;
+                    track.SetTrackStatus(fAlive);
+                }
+                gSink = gSink + killed; });
+    }
+
+    //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+    /// Values of the columns of the benchmark tables
+    struct Row
+    {
+        int eventID = 0;
+        int trackID = 1;
+        float values[10] = {};
+        std::vector<float> hitX, hitZ, energy;
+        std::vector<int> particleID;
+    };
+
+    /**
+     * @brief Fill an Input-like table (scalars) and a YAG-like table (hit vectors) into a memory file.
+     */
+    void BenchOutput(const Options& options)
+    {
+        if (!Selected(options, {"output/fill_scalars_sync", "output/fill_hits_sync", "output/fill_scalars_async", "output/fill_hits_async"}))
+            return;
+
+        PlasmaMLPALLASOutputManager& output = PlasmaMLPALLASOutputManager::Instance();
+        Row row;
+        for (int i = 0; i < 20; ++i)
+        {
+            row.hitX.push_back(0.1f * i);
+            row.hitZ.push_back(-0.1f * i);
+            row.energy.push_back(1.f + i);
+            row.particleID.push_back(11);
+        }
+
+        auto fill = [&row](G4bool hits, size_t n)
+        {
+            TMemFile file("PlasmaMLPALLAS_bench.root", "RECREATE");
+            PlasmaMLPALLASOutputTable table(hits ? "BSYAG" : "Input", "Benchmark table");
+            table.AddColumn("EventID", &row.eventID);
+            table.AddColumn("TrackID", &row.trackID);
+            for (int c = 0; c < 10; ++c)
+                table.AddColumn("Value" + std::to_string(c), &row.values[c]);
+            if (hits)
+            {
+                table.AddColumn("x", &row.hitX);
+                table.AddColumn("z", &row.hitZ);
+                table.AddColumn("energy", &row.energy);
+                table.AddColumn("particleID", &row.particleID);
+            }
+            table.Open(&file);
+            for (size_t i = 0; i < n; ++i)
+            {
+                row.eventID = static_cast<int>(i);
+                for (int c = 0; c < 10; ++c)
+                    row.values[c] = 0.001f * (i + c);
+                table.Fill();
+            }
+            table.Close();
+            file.Write();
+        };
+
+        for (G4int writers : {0, 1})
+        {
+            output.SetWriterThreads(writers);
+            const std::string mode = writers ? "_async" : "_sync";
+            Run(options, "output/fill_scalars" + mode, 500000, [&fill](size_t n) { fill(false, n); });
+            Run(options, "output/fill_hits" + mode, 200000, [&fill](size_t n) { fill(true, n); });
+        }
+        output.SetWriterThreads(0);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Main function of the benchmarks.
+ * @param argc Number of command-line arguments
+ * @param argv [filter] [repetitions]
+ * @return Exit code (0 = success)
+ */
+int main(int argc, char** argv)
+{
+    Options options;
+    if (argc > 1)
+        options.filter = argv[1];
+    if (argc > 2)
+        options.repetitions = std::max(1, std::atoi(argv[2]));
+
+    /** The writer threads of the output fill the trees concurrently with the benchmark thread */
+    ROOT::EnableThreadSafety();
+
+    /** Geant4 messages of the set-up out of the CSV table */
+    StderrSession session;
+    G4UImanager::GetUIpointer()->SetCoutDestination(&session);
+
+    std::printf("benchmark,iterations,ns_per_op,ops_per_s\n");
+    BenchField(options);
+    BenchOnnx(options);
+    BenchStepping(options);
+    BenchOutput(options);
+    return 0;
+}
@@ -0,0 +1,72 @@
+#! /bin/bash
+
+# Thread scaling of the batch mode: events/s from 1 to MAX_THREADS threads.
+#
+# Run it from the directory holding the PlasmaMLPALLAS executable (bin/ of
+# the build), like a batch job:
+#
+#   ../bench/scaling.sh macro.mac [events_per_thread] [max_threads] [mode]
+#
+# Each point runs events_per_thread x threads events (weak scaling, default
+# 200 per thread) with 1, 2, 4... up to max_threads threads (default 64), in
+# the run mode ON (G4MTRunManager, default) or TASKS (G4TaskRunManager).
+# The event loop time is the "Real=" time of the Geant4 run summary printed
+# with /run/verbose 1, so the geometry and physics initialisation is left
+# out; the full wall time of the job is given as well, and the startup time
+# is the rest of it (initialisation, output merge and exit). The output is a
+# CSV table on stdout (the logs of the jobs stay in scaling_<threads>.log):
+#
+#   mode,threads,events,loop_s,wall_s,startup_s,events_per_s,speedup,efficiency
+#
+# The micro-benchmarks of the hot paths are in the PlasmaMLPALLAS_bench
+# target (cmake -DWITH_BENCHMARKS=ON).
+
+MACRO=$1
+EVENTS_PER_THREAD=${2:-200}
+MAX_THREADS=${3:-64}
+MODE=${4:-ON}
+EXE=./PlasmaMLPALLAS
+
+if [ -z "$MACRO" ] || [ ! -f "$MACRO" ] || [ ! -x "$EXE" ]; then
+    echo "usage: $0 macro.mac [events_per_thread] [max_threads] [ON/TASKS] (from the directory of $EXE)" >&2
+    exit 1
+fi
+
+# Run summary of the event loop, then the macro of the user
+WRAPPER=scaling_wrapper.mac
+printf "/run/verbose 1\n/control/execute %s\n" "$MACRO" > $WRAPPER
+
+echo "mode,threads,events,loop_s,wall_s,startup_s,events_per_s,speedup,efficiency"
+REFERENCE=""
+THREADS=1
+while [ $THREADS -le $MAX_THREADS ]; do
+    EVENTS=$((EVENTS_PER_THREAD * THREADS))
+    OUTPUT=scaling_$THREADS
+    LOG=$OUTPUT.log
+
+    BEGIN=$(date +%s.%N)
+    $EXE $OUTPUT $EVENTS $WRAPPER $MODE $THREADS > $LOG 2>&1
+    STATUS=$?
+    END=$(date +%s.%N)
+    rm -f ../Resultats/$OUTPUT.root $OUTPUT.root
+
+    if [ $STATUS -ne 0 ]; then
+        echo "$THREADS threads: job failed (see $LOG)" >&2
+        break
+    fi
+
+    WALL=$(echo "$END - $BEGIN" | bc -l)
+    LOOP=$(grep -o "Real=[0-9.e+-]*" $LOG | tail -1 | cut -d= -f2)
+    [ -z "$LOOP" ] && LOOP=$WALL
+
+    STARTUP=$(echo "$WALL - $LOOP" | bc -l)
+    RATE=$(echo "$EVENTS / $LOOP" | bc -l)
+    [ -z "$REFERENCE" ] && REFERENCE=$RATE
+    SPEEDUP=$(echo "$RATE / $REFERENCE" | bc -l)
+    EFFICIENCY=$(echo "$SPEEDUP / $THREADS" | bc -l)
+
+    printf "%s,%d,%d,%.3f,%.3f,%.3f,%.1f,%.2f,%.3f\n" $MODE $THREADS $EVENTS $LOOP $WALL $STARTUP $RATE $SPEEDUP $EFFICIENCY
+    THREADS=$((THREADS * 2))
+done
+
+rm -f $WRAPPER
@@ -20,6 +20,8 @@
 #include "G4UnitsTable.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4GDMLParser.hh"
+#include "PlasmaMLPALLASGDMLLoader.hh"
+#include "PlasmaMLPALLASCADModels.hh"
 
 class PlasmaMLPALLASGeometryConstruction;
 
@@ -50,7 +52,7 @@ public:
   ~Geometry();
 
   /**
-   * @brief Load and retrieve a GDML-defined volume.
+   * @brief Load and retrieve a GDML-defined volume (preloaded, from the startup cache or parsed).
    * @param fileName Path to the GDML file.
    * @param volumeName Name of the volume to retrieve.
    * @param material Material to assign to the volume.
@@ -58,6 +60,20 @@ public:
    */
   G4LogicalVolume *GetGDMLVolume(const char* fileName, const char* volumeName, G4Material* material);
 
+  /**
+   * @brief Read GDML models concurrently, ahead of the GetGDMLVolume calls.
+   * @param requests GDML files and names of the volumes that will be asked for.
+   */
+  void PreloadGDMLVolumes(const std::vector<PlasmaMLPALLASGDMLLoader::Request>& requests);
+
+  /**
+   * @brief Release the preloaded models that were not asked for.
+   */
+  void ReleaseGDMLVolumes();
+
+  /** @brief Navigation settings (proxies, voxel limits) of the GDML models. */
+  PlasmaMLPALLASCADModels& GetCADModels() { return CADModels; }
+
   /**
    * @brief Create a quadrupole magnet volume.
    * @param name Name of the quadrupole volume.
@@ -74,6 +90,12 @@ public:
    */
   G4LogicalVolume *GetFakeDiagsChamber();
 
+  /**
+   * @brief Create the vacuum volume carrying the dipole field.
+   * @return Pointer to the created G4LogicalVolume.
+   */
+  G4LogicalVolume *GetDipoleFieldVolume();
+
   /**
    * @brief Cleanup allocated geometry components.
    *
@@ -88,7 +110,8 @@ private:
   G4LogicalVolume* LogicalVolume; ///< Keeps track of allocated logical volume.
   G4Box* Box; ///< Keeps track of allocated box solid.
   G4Tubs* Tubs; ///< Keeps track of allocated tube solid.
-  G4GDMLParser* parser; ///< Parser for GDML geometry files.
+  PlasmaMLPALLASGDMLLoader Loader; ///< Concurrent reader of the GDML models.
+  PlasmaMLPALLASCADModels CADModels; ///< Solids built for the GDML models.
   G4VisAttributes *clear; ///< Visualization attributes (transparency).
 };
 
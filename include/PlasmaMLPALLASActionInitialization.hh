@@ -21,6 +21,8 @@
 #include "PlasmaMLPALLASRunAction.hh"
 #include "PlasmaMLPALLASEventAction.hh"
 #include "PlasmaMLPALLASSteppingAction.hh"
+#include "PlasmaMLPALLASStackingAction.hh"
+#include "PlasmaMLPALLASTrackingAction.hh"
 
 
 class PlasmaMLPALLASGeometryConstruction;
@@ -0,0 +1,92 @@
+#ifndef PlasmaMLPALLASAsyncWriter_h
+#define PlasmaMLPALLASAsyncWriter_h 1
+
+/**
+ * @class PlasmaMLPALLASAsyncWriter
+ * @brief Dedicated threads serialising and compressing the output tables.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * With /PlasmaMLPALLAS/output/setWriterThreads N > 0, the tables of the
+ * Geant4 threads no longer call TTree::Fill (or fill their RNTuple) in
+ * EndOfEventAction: they push their rows into single-producer queues
+ * (PlasmaMLPALLASRingBuffer) and go back to tracking. Each table is then
+ * a channel drained by one of the N writer threads, assigned to the least
+ * loaded one, which does the filling, the basket compression and the
+ * flushes. A channel is only ever drained by its writer thread, so the
+ * trees and RNTuple contexts are never used by two threads at once; the
+ * channels writing to the same file are given to the same writer thread,
+ * a TFile not being thread-safe.
+ *
+ * The pool is owned by PlasmaMLPALLASOutputManager and its threads live
+ * until the pool is destroyed (end of the job or new thread count).
+ */
+
+#include "globals.hh"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class PlasmaMLPALLASAsyncWriter
+{
+public:
+    /// Source of work for the writer threads
+    class Channel
+    {
+    public:
+        virtual ~Channel() = default;
+
+        /** @brief Write the queued rows (writer thread). @return False if nothing was queued */
+        virtual G4bool Drain() = 0;
+    };
+
+    /**
+     * @brief Start the writer threads.
+     * @param nThreads Number of writer threads (at least 1)
+     */
+    explicit PlasmaMLPALLASAsyncWriter(G4int nThreads);
+
+    /** @brief Stop and join the writer threads (no channel may be left). */
+    ~PlasmaMLPALLASAsyncWriter();
+
+    PlasmaMLPALLASAsyncWriter(const PlasmaMLPALLASAsyncWriter&) = delete;            /**< Delete copy constructor */
+    PlasmaMLPALLASAsyncWriter& operator=(const PlasmaMLPALLASAsyncWriter&) = delete; /**< Delete assignment operator */
+
+    /**
+     * @brief Give a channel to a writer thread.
+     * @param channel Channel to drain until Unregister()
+     * @param group Shared resource of the channel (its file): the thread of the other channels
+     *        of the group, nullptr or a new group for the thread with the fewest channels
+     */
+    void Register(Channel* channel, const void* group = nullptr);
+
+    /** @brief Remove a channel; on return no writer thread uses it any more. */
+    void Unregister(Channel* channel);
+
+    G4int GetNumberOfThreads() const { return static_cast<G4int>(fThreads.size()); }
+
+    /** Whether no channel is registered */
+    G4bool IsIdle() const;
+
+private:
+    /// One writer thread and its channels
+    struct WriterThread
+    {
+        mutable std::mutex mutex;        ///< Held for a pass over the channels, and to change them
+        std::vector<Channel*> channels;  ///< Channels drained by the thread
+        std::vector<const void*> groups; ///< Group of each channel
+        std::thread thread;
+    };
+
+    /** @brief Body of a writer thread: drain its channels, sleep briefly when none had rows. */
+    void Loop(WriterThread& writer);
+
+    std::vector<std::unique_ptr<WriterThread>> fThreads;
+    std::mutex fRegistrationMutex;   ///< Keeps the channels of a group together when registered concurrently
+    std::atomic<bool> fStop{false};
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef PlasmaMLPALLASBeamMoments_h
+#define PlasmaMLPALLASBeamMoments_h 1
+
+/**
+ * @class PlasmaMLPALLASBeamMoments
+ * @brief Streaming weighted moments of the beam on one plane (RMS sizes, emittances, Twiss parameters).
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * Replaces the loading of the per-event trees by the routine analysis
+ * (Resultats/PlasmaMLPALLAS_Routine.py) for the input plane, the entrance
+ * and exit of each quadrupole and the YAG screens. The means and
+ * co-moments of (x, x', z, z', E) are updated particle by particle with
+ * the weighted Welford algorithm, which stays accurate for beams far from
+ * the axis, and the worker accumulables are merged into the master ones
+ * at the end of the run with the pairwise formulas of Chan et al.
+ *
+ * Units: mm for the positions, mrad for the angles, MeV for the energy;
+ * the emittances are in mm.mrad, beta in mm/mrad and gamma in mrad/mm.
+ * The screens record no direction: their angular moments stay empty.
+ */
+
+#include "G4VAccumulable.hh"
+#include <array>
+
+class PlasmaMLPALLASBeamMoments : public G4VAccumulable
+{
+public:
+    /// Values written in the summary table for one plane
+    struct Summary
+    {
+        int entries = 0;
+        float weight = 0.;
+        float mean_x = 0., rms_x = 0., mean_xp = 0., rms_xp = 0.;
+        float emit_x = 0., alpha_x = 0., beta_x = 0., gamma_x = 0.;
+        float mean_z = 0., rms_z = 0., mean_zp = 0., rms_zp = 0.;
+        float emit_z = 0., alpha_z = 0., beta_z = 0., gamma_z = 0.;
+        float mean_E = 0., rms_E = 0.;
+    };
+
+    /**
+     * @brief Constructor.
+     * @param name Name of the plane, prefix of its columns in the summary table
+     * @param angles Whether the plane records the angles (false for the screens)
+     */
+    PlasmaMLPALLASBeamMoments(const G4String& name, G4bool angles);
+
+    /**
+     * @brief Add one particle crossing the plane.
+     * @param x Position along x (mm)
+     * @param xp Angle in the x plane (mrad)
+     * @param z Position along z (mm)
+     * @param zp Angle in the z plane (mrad)
+     * @param energy Kinetic energy (MeV)
+     * @param weight Statistical weight (ignored if not positive)
+     */
+    void Fill(G4double x, G4double xp, G4double z, G4double zp, G4double energy, G4double weight);
+
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+
+    G4bool HasAngles() const { return fAngles; }
+    G4long GetEntries() const { return fEntries; }     /**< Number of particles */
+    G4double GetSumOfWeights() const { return fSumW; } /**< Sum of the weights */
+
+    /** Means, RMS, emittances and Twiss parameters of the accumulated particles */
+    Summary GetSummary() const;
+
+private:
+    /// Variables and pairs of the co-moments
+    enum Variable { kX, kXp, kZ, kZp, kE, kNVariables };
+    static constexpr int kNPairs = 7;
+    static const std::array<std::array<int, 2>, kNPairs> kPairs;
+
+    G4bool fAngles;
+    G4long fEntries = 0;
+    G4double fSumW = 0.;
+    std::array<G4double, kNVariables> fMean{};   ///< Weighted means
+    std::array<G4double, kNPairs> fComoment{};   ///< Sums of w (a - <a>)(b - <b>) over kPairs
+};
+
+#endif
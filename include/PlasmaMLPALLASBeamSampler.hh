@@ -0,0 +1,84 @@
+#ifndef PlasmaMLPALLASBeamSampler_h
+#define PlasmaMLPALLASBeamSampler_h 1
+
+/**
+ * @class PlasmaMLPALLASBeamSampler
+ * @brief Per-thread block sampler of the source phase space (x, xp, z, zp, E).
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * Standard normal variates are produced by blocks from a single bulk call to
+ * the thread random engine (`flatArray`) followed by a Box-Muller transform
+ * over contiguous arrays. Each primary then only pops five pre-sampled values
+ * and scales them with the current beam moments and Twiss parameters, so the
+ * moments or the optics may change at any time without discarding the block.
+ */
+
+#include "globals.hh"
+#include "PlasmaMLPALLASOnnxInference.hh"
+#include <vector>
+
+/**
+ * @struct TwissParameters
+ * @brief Twiss parameters of one transverse plane of the source.
+ */
+struct TwissParameters {
+    G4double alpha = 0.;          ///< Twiss alpha
+    G4double beta = 1.;           ///< Twiss beta (Geant4 length units)
+    G4double emittanceRatio = 1.; ///< Emittance of the plane relative to the predicted epsb
+};
+
+/**
+ * @struct PhaseSpaceSample
+ * @brief One sampled primary: transverse coordinates, angles and kinetic energy.
+ */
+struct PhaseSpaceSample {
+    G4double x;     ///< X position
+    G4double xp;    ///< X angle
+    G4double z;     ///< Z position
+    G4double zp;    ///< Z angle
+    G4double Ekin;  ///< Kinetic energy (Gaussian smearing of the mean energy)
+};
+
+class PlasmaMLPALLASBeamSampler
+{
+public:
+    /**
+     * @brief Constructor
+     * @param blockSize Number of primaries sampled per block (rounded up to an even value)
+     */
+    explicit PlasmaMLPALLASBeamSampler(size_t blockSize = 1024);
+
+    /**
+     * @brief Set the source optics
+     * @param x Twiss parameters of the x plane
+     * @param z Twiss parameters of the z plane
+     */
+    void SetTwiss(const TwissParameters& x, const TwissParameters& z) { fTwissX = x; fTwissZ = z; }
+
+    /**
+     * @brief Draw the next primary from the pre-sampled block
+     * @param moments Beam moments (mean energy, relative spread, emittance)
+     * @return Sampled phase-space coordinates and kinetic energy
+     */
+    PhaseSpaceSample Next(const BeamMoments& moments);
+
+private:
+    /**
+     * @brief Fill a new block of standard normal variates
+     */
+    void Refill();
+
+    /// Components stored per primary, each in its own contiguous array
+    enum Component { kX = 0, kXp, kZ, kZp, kE, kNComponents };
+
+    size_t fBlockSize;               ///< Primaries per block
+    size_t fCursor;                  ///< Next unused primary in the block
+    std::vector<G4double> fNormals;  ///< [kNComponents x fBlockSize] standard normal variates
+
+    TwissParameters fTwissX;         ///< Optics of the x plane
+    TwissParameters fTwissZ;         ///< Optics of the z plane
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef PlasmaMLPALLASCADModels_h
+#define PlasmaMLPALLASCADModels_h 1
+
+/**
+ * @class PlasmaMLPALLASCADModels
+ * @brief Navigation settings of the tessellated CAD parts: fitted proxies and voxel limits.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * Each GDML model is built by Geometry::GetGDMLVolume in one of two modes:
+ *  - tessellated: the G4TessellatedSolid of the export (default), with an
+ *    optional limit on the number of voxels of its G4Voxelizer;
+ *  - proxy: the closest of a few fitted shapes (bounding box and, along x, y
+ *    or z, full or hollow tube, convex extrusion and stepped polycone of the
+ *    cross-section), filled with the material of the part diluted so that
+ *    the part keeps its mass.
+ *
+ * The fit samples points in the bounding box of the part, classifies them
+ * against the triangles, and keeps the shape with the largest overlap
+ * (Jaccard index: common volume over union volume). A part whose best shape
+ * is below the tolerance stays tessellated. The overlap and the volume
+ * mismatch of every part are reported at the end of the construction.
+ * The few models left to G4GDMLParser (see PlasmaMLPALLASGDMLLoader) stay
+ * as read.
+ *
+ * The smartless value (voxels per daughter in the navigation voxels of a
+ * mother volume) can be set per logical volume, the CAD parts as well as
+ * the holder or world.
+ */
+
+#include "globals.hh"
+#include <map>
+#include <vector>
+
+class G4LogicalVolume;
+class G4Material;
+struct PlasmaMLPALLASTessellatedMesh;
+
+class PlasmaMLPALLASCADModels
+{
+public:
+    /** Solid built for a CAD part */
+    enum class Mode
+    {
+        Tessellated, ///< Triangles of the export
+        Proxy        ///< Fitted CSG or extruded shape
+    };
+
+    /** Names accepted for the modes ("tessellated", "proxy") */
+    static const std::vector<G4String>& GetModeNames();
+
+    /**
+     * @brief Select the solid built for a part.
+     * @param mode Mode name
+     * @param volume Name of the logical volume, "all" for the parts without their own mode
+     * @return False if the mode is unknown (settings unchanged)
+     */
+    G4bool SetMode(const G4String& mode, const G4String& volume = "all");
+
+    /**
+     * @brief Set the navigation voxel limits of a logical volume.
+     * @param volume Name of the logical volume, "all" for the volumes without their own limits
+     * @param smartless Smartless value of the volume (-1 for the Geant4 default)
+     * @param maxVoxels Maximum number of voxels of a tessellated part (-1 for the Geant4 default)
+     */
+    void SetVoxelLimits(const G4String& volume, G4int smartless, G4int maxVoxels);
+
+    /** Minimum overlap (0-1) of a proxy with its part for the proxy to be used */
+    void SetProxyTolerance(G4double tolerance) { fProxyTolerance = tolerance; }
+    G4double GetProxyTolerance() const { return fProxyTolerance; }
+
+    /**
+     * @brief Build the logical volume of a CAD part.
+     * @param mesh Triangles of the part
+     * @param material Material of the part
+     * @param volume Name of the logical volume
+     * @return New logical volume, with a tessellated or a proxy solid
+     */
+    G4LogicalVolume* Build(const PlasmaMLPALLASTessellatedMesh& mesh, G4Material* material, const G4String& volume);
+
+    /** Apply the smartless values to the volumes of the stores and print the report of the proxies */
+    void EndConstruction();
+
+    /** Print the settings */
+    void Print() const;
+
+private:
+    /** Fit of a part, as reported at the end of the construction */
+    struct Fit
+    {
+        G4String volume;            ///< Name of the logical volume
+        G4String shape;             ///< Best shape ("box", "tube_z", "hollow_tube_x", "extrusion_y"...)
+        G4double meshVolume = 0.;   ///< Volume of the triangles
+        G4double proxyVolume = 0.;  ///< Volume of the best shape
+        G4double overlap = 0.;      ///< Jaccard index of the best shape
+        G4double missed = 0.;       ///< Fraction of the part outside the best shape
+        G4bool used = false;        ///< The proxy replaced the triangles
+    };
+
+    /** Value of a volume, or of "all" */
+    template <typename T>
+    static T Find(const std::map<G4String, T>& values, const G4String& volume, T fallback);
+
+    std::map<G4String, Mode> fModes;       ///< Mode per volume ("all": default)
+    std::map<G4String, G4int> fSmartless;  ///< Smartless per volume ("all": default)
+    std::map<G4String, G4int> fMaxVoxels;  ///< Voxel limit per tessellated part ("all": default)
+    G4double fProxyTolerance = 0.7;        ///< Minimum overlap of a proxy
+    std::vector<Fit> fFits;                ///< Fits of the current construction
+};
+
+#endif
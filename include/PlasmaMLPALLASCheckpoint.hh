@@ -0,0 +1,115 @@
+#ifndef PlasmaMLPALLASCheckpoint_h
+#define PlasmaMLPALLASCheckpoint_h 1
+
+/**
+ * @class PlasmaMLPALLASCheckpoint
+ * @brief Resumable job split into chunks of events, with a checkpoint file.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * /PlasmaMLPALLAS/checkpoint/beamOn N simulates N events as successive runs
+ * of setChunkEvents events. Each chunk writes and closes its own file (the
+ * output file suffixed by _chunk<k>, see PlasmaMLPALLASOutputManager); once
+ * it is done, the checkpoint file records the chunk files, the events done
+ * and the state of the random engine of the master, which seeds the workers.
+ *
+ * When a job cut short (wall time of a batch queue) is submitted again with
+ * the same macro, the chunks already in the checkpoint are skipped and the
+ * engine state is restored: the remaining chunks are the ones the first job
+ * would have produced, and the job ends as if it had never stopped. After the
+ * last chunk the chunk files are merged into the output file, then removed
+ * together with the checkpoint.
+ *
+ * The first event of each chunk in the job is published in the run
+ * configuration, so that the phase-space file is read on from where the
+ * previous chunk stopped.
+ *
+ * The singleton is created by the master (PlasmaMLPALLASActionInitialization),
+ * which owns the /PlasmaMLPALLAS/checkpoint/ commands.
+ */
+
+#include "globals.hh"
+#include <atomic>
+#include <vector>
+
+class PlasmaMLPALLASCheckpointMessenger;
+
+class PlasmaMLPALLASCheckpoint
+{
+public:
+    /**
+     * @brief Access the singleton instance.
+     * @return Reference to the process-wide checkpoint driver.
+     */
+    static PlasmaMLPALLASCheckpoint& Instance();
+
+    /**
+     * @brief Run a job of N events in chunks, resuming it from its checkpoint (master thread, Idle state).
+     * @param nEvents Number of events of the whole job
+     */
+    void Run(G4long nEvents);
+
+    /** Default output name of the job (suffix of the run actions) */
+    void SetOutputName(const G4String& name) { fOutputName = name; }
+
+    /** Checkpoint file, empty for the output path with the .checkpoint extension */
+    void SetFile(const G4String& file) { fFile = file; }
+    G4String GetFile() const;
+
+    /** Events per chunk */
+    void SetChunkEvents(G4int events) { fChunkEvents = events > 0 ? events : 1; }
+    G4int GetChunkEvents() const { return fChunkEvents; }
+
+    /// @name Accessors for the run actions
+    ///@{
+    G4bool IsRunning() const { return fRunning.load(); }         /**< Whether a checkpointed job is in progress */
+    G4int GetChunkIndex() const { return fChunkIndex.load(); }   /**< Index of the running chunk */
+    G4long GetEventOffset() const { return fEventOffset.load(); } /**< Events of the job before the running chunk (0 outside a job) */
+    G4bool HasRun() const { return fHasRun; }                    /**< Whether a job has been run in this process */
+    ///@}
+
+private:
+    PlasmaMLPALLASCheckpoint();
+    ~PlasmaMLPALLASCheckpoint();
+
+    PlasmaMLPALLASCheckpoint(const PlasmaMLPALLASCheckpoint&) = delete;            /**< Delete copy constructor */
+    PlasmaMLPALLASCheckpoint& operator=(const PlasmaMLPALLASCheckpoint&) = delete; /**< Delete assignment operator */
+
+    /// Content of a checkpoint file
+    struct State
+    {
+        G4long eventsTotal = 0;          ///< Events of the whole job
+        G4int chunkEvents = 0;           ///< Events per chunk
+        G4int chunksDone = 0;            ///< Chunks written and closed
+        G4long eventsDone = 0;           ///< Events of those chunks
+        std::vector<G4String> files;     ///< Files of those chunks
+        G4String rng;                    ///< Engine state after the last chunk
+    };
+
+    /**
+     * @brief Read a checkpoint file.
+     * @return false if there is none or if it cannot be parsed
+     */
+    static G4bool Load(const G4String& path, State& state);
+
+    /**
+     * @brief Write a checkpoint file through a temporary one, so that it is never left half written.
+     * @return false if it cannot be written
+     */
+    static G4bool Save(const G4String& path, const State& state);
+
+    G4String fOutputName;             /**< Default output name of the job */
+    G4String fFile;                   /**< Checkpoint file, empty for the default */
+    G4int fChunkEvents = 10000;       /**< Events per chunk */
+    G4bool fHasRun = false;           /**< A job has been run */
+
+    // Read by the run actions and the generators of every thread
+    std::atomic<G4bool> fRunning{false};      /**< A checkpointed job is in progress */
+    std::atomic<G4int> fChunkIndex{0};        /**< Index of the running chunk */
+    std::atomic<G4long> fEventOffset{0};      /**< First event of the running chunk in the job */
+
+    PlasmaMLPALLASCheckpointMessenger* fMessenger = nullptr; /**< UI commands /PlasmaMLPALLAS/checkpoint/ */
+};
+
+#endif
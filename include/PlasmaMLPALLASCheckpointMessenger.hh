@@ -0,0 +1,67 @@
+#ifndef PlasmaMLPALLASCheckpointMessenger_H
+#define PlasmaMLPALLASCheckpointMessenger_H
+
+/**
+ * @class PlasmaMLPALLASCheckpointMessenger
+ * @brief Provides UI commands to run a job in resumable chunks of events
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * This class sets the checkpoint file and the size of the chunks, and runs
+ * the job. The commands are created by the master and act on the
+ * process-wide PlasmaMLPALLASCheckpoint, so they are not broadcast to the
+ * worker threads.
+ */
+
+#include "G4UIcommand.hh"
+#include "G4UIcmdWithAnInteger.hh"                 // for G4UIcmdWithAnInteger
+#include "G4UIcmdWithAString.hh"                   // for G4UIcmdWithAString
+#include "G4UIdirectory.hh"                        // for G4UIdirectory
+#include "G4UImessenger.hh"
+
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithAString;
+class G4UIcommand;
+class G4UIdirectory;
+
+class PlasmaMLPALLASCheckpoint;
+
+class PlasmaMLPALLASCheckpointMessenger : public G4UImessenger
+{
+public:
+    /**
+     * @brief Constructor
+     * @param checkpoint Pointer to the checkpoint driver
+     */
+    PlasmaMLPALLASCheckpointMessenger(PlasmaMLPALLASCheckpoint *checkpoint);
+
+    /// Destructor
+    ~PlasmaMLPALLASCheckpointMessenger();
+
+    /**
+     * @brief Executes a command with a new value
+     * @param command Pointer to the issued command
+     * @param newValue String representation of the new value
+     */
+    virtual void SetNewValue(G4UIcommand *command, G4String newValue) final;
+
+    /**
+     * @brief Retrieves the current value of a command
+     * @param command Pointer to the command
+     * @return String representing the current value
+     */
+    virtual G4String GetCurrentValue(G4UIcommand *command) final;
+
+private:
+    /// Associated checkpoint driver
+    PlasmaMLPALLASCheckpoint *fCheckpoint = nullptr;
+
+    G4UIdirectory *fCheckpointDir = nullptr;          ///< Directory /PlasmaMLPALLAS/checkpoint
+
+    G4UIcmdWithAString *fSetFileCmd = nullptr;        ///< Set the checkpoint file
+    G4UIcmdWithAnInteger *fSetChunkEventsCmd = nullptr; ///< Set the events per chunk
+    G4UIcmdWithAnInteger *fBeamOnCmd = nullptr;       ///< Run or resume the job
+};
+
+#endif
@@ -11,6 +11,8 @@
 
 #include "G4UserEventAction.hh"
 #include "PlasmaMLPALLASQuadrupoleUtils.hh"
+#include "PlasmaMLPALLASProgressMonitor.hh"
+#include <vector>
 
 class G4Event;
 
@@ -28,6 +30,7 @@ struct RunTallyInput
     float z = 0.0;
     float zp = 0.0;
     float energy = 0.0;
+    float weight = 0.0;
 };
 
 
@@ -42,6 +45,7 @@ struct RunTallyCollimators
     float y = 0.0;
     float z = 0.0;
     float energy = 0.0;
+    float weight = 0.0;
     bool flag =false;
     
     // Methods to set data
@@ -49,6 +53,7 @@ struct RunTallyCollimators
     void SetYInteraction(float d) { y =d; }
     void SetZInteraction(float d) { z =d; }
     void SetEnergy(float d) { energy =d; }
+    void SetWeight(float d) { weight =d; }
     void ActiveFlag(){flag=true;}
     void ResetFlag(){flag=false;}
 
@@ -75,8 +80,10 @@ struct RunTallyYAG
     std::vector<int> parentID;
     std::vector<int> particleID;
     std::vector<float> energy;
+    std::vector<float> weight;
     float deposited_energy = 0.0;
     std::vector<float> total_deposited_energy;
+    std::vector<float> deposit;      ///< Energy deposited by each passage [keV], for the screen images (not written)
     G4bool flag = false;
 
     // Methods to add data
@@ -86,8 +93,10 @@ struct RunTallyYAG
     void AddParentID(int d) { parentID.push_back(d); }
     void AddParticleID(int d) { particleID.push_back(d); }
     void AddEnergy(float d) { energy.push_back(d); }
+    void AddWeight(float d) { weight.push_back(d); }
     void AddDepositedEnergy(float d) { deposited_energy += d; }
     void AddTotalDepositedEnergy(float d) { total_deposited_energy.push_back(d); }
+    void AddDeposit(float d) { deposit.push_back(d); }
 
     // Size accessors
     size_t XExitSize() const { return x_exit.size(); }
@@ -96,6 +105,7 @@ struct RunTallyYAG
     size_t ParentIDSize() const { return parentID.size(); }
     size_t ParticleIDSize() const { return particleID.size(); }
     size_t EnergySize() const { return energy.size(); }
+    size_t WeightSize() const { return weight.size(); }
     size_t TotalDepositedEnergySize() const { return total_deposited_energy.size(); }
 
     // Index accessors
@@ -105,6 +115,7 @@ struct RunTallyYAG
     int GetParentID(size_t i) const { return parentID.at(i); }
     int GetParticleID(size_t i) const { return particleID.at(i); }
     float GetEnergy(size_t i) const { return energy.at(i); }
+    float GetWeight(size_t i) const { return weight.at(i); }
     float GetTotalDepositedEnergy(size_t i) const { return total_deposited_energy.at(i); }
 
     // Flags
@@ -114,6 +125,26 @@ struct RunTallyYAG
 
     void ResetDepositedEnergy() { deposited_energy = 0; }
     float GetDepositedEnergy() const { return deposited_energy; }
+
+    /** Reserve the entries of an event (no allocation once the capacity is reached) */
+    void Reserve(size_t n)
+    {
+        for (auto *v : {&x_exit, &y_exit, &z_exit, &energy, &weight, &total_deposited_energy, &deposit})
+            v->reserve(n);
+        parentID.reserve(n);
+        particleID.reserve(n);
+    }
+
+    /** Empty the tally, keeping the capacity of the vectors */
+    void Clear()
+    {
+        for (auto *v : {&x_exit, &y_exit, &z_exit, &energy, &weight, &total_deposited_energy, &deposit})
+            v->clear();
+        parentID.clear();
+        particleID.clear();
+        deposited_energy = 0;
+        flag = false;
+    }
 };
 
 /**
@@ -121,6 +152,14 @@ struct RunTallyYAG
  *
  * Implements G4UserEventAction interface to handle per-event statistics,
  * including input particle, collimator, quadrupole, and detector data.
+ *
+ * An event may hold several primaries (bunch mode): input, quadrupole and
+ * collimator tallies are kept per primary and indexed by its track ID
+ * (1..K), while YAG tallies keep one entry per detected particle.
+ *
+ * The input tallies are read from the primary vertices at the beginning of
+ * the event; the quadrupole, collimator and YAG tallies are built from the
+ * hits collections of the sensitive detectors at the end of the event.
  */
 class PlasmaMLPALLASEventAction : public G4UserEventAction
 {
@@ -137,44 +176,51 @@ public:
     /** Called at the end of each event */
     void EndOfEventAction(const G4Event *);
 
-    /** Setters for input particle data */
-    void SetXStart(G4float d) { StatsInput.x = d; }
-    void SetXpStart(G4float d) { StatsInput.xp = d; }
-    void SetYStart(G4float d) { StatsInput.y = d; }
-    void SetYpStart(G4float d) { StatsInput.yp = d; }
-    void SetZStart(G4float d) { StatsInput.z = d; }
-    void SetZpStart(G4float d) { StatsInput.zp = d; }
-    void SetEnergyStart(G4float d) { StatsInput.energy = d; }
-
-    /** Setter for quadrupole energy */
-    void SetEnergy(G4float d) { StatsQuadrupoles.energy = d; }
-
-    /** Horizontal collimator flag and energy accessors */
-    
-    /** Vertical collimator flag and energy accessors */
-    
-
-    /** Accessors for quadrupole statistics */
-    RunTallyQuadrupoles& GetStatsQuadrupoles() { return StatsQuadrupoles; }
-
-        /** Accessors for generic detector statistics */
-    RunTallyCollimators& GetVerticalCollimators() { return StatsVerticalColl; }
-    RunTallyCollimators& GetHorizontalCollimators() { return StatsHorizontalColl; }
+    /** Accessors for the per-primary statistics, indexed by primary track ID */
+    RunTallyInput& GetStatsInput(G4int trackID) { return PrimarySlot(StatsInput, trackID); }
+    RunTallyQuadrupoles& GetStatsQuadrupoles(G4int trackID) { return PrimarySlot(StatsQuadrupoles, trackID); }
+    RunTallyCollimators& GetHorizontalCollimators(G4int trackID) { return PrimarySlot(StatsHorizontalColl, trackID); }
+    RunTallyCollimators& GetVerticalCollimators(G4int trackID) { return PrimarySlot(StatsVerticalColl, trackID); }
 
     /** Accessors for generic detector statistics */
     RunTallyYAG& GetBSYAG() { return StatsBSYAG; }
     RunTallyYAG& GetBSPECYAG() { return StatsBSPECYAG; }
 
 private:
-    TTree *EventTree;                        ///< ROOT tree for per-event data
-    TBranch *EventBranch;                    ///< ROOT branch for event tree
-    RunTallyInput StatsInput;                ///< Input particle statistics
-    RunTallyQuadrupoles StatsQuadrupoles;    ///< Quadrupole statistics
-    RunTallyCollimators StatsHorizontalColl; ///< Horizontal collimator statistics
-    RunTallyCollimators StatsVerticalColl;   ///< Vertical collimator statistics
+    /** Fill the input tallies from the primary vertices (track IDs in generation order) */
+    void FillInput(const G4Event *evt);
+
+    /** Turn the hits collections of the event into the tallies */
+    void FillFromHits(const G4Event *evt);
+
+    /** Resolve the hits collection IDs, again only when a detector was added */
+    void UpdateCollectionIDs();
+
+    /** Return the slot of a primary, growing the array if the event holds more primaries than vertices */
+    template <typename T>
+    static T& PrimarySlot(std::vector<T>& v, G4int trackID)
+    {
+        const size_t i = static_cast<size_t>(trackID - 1);
+        if (i >= v.size()) v.resize(i + 1);
+        return v[i];
+    }
+
+    TTree *EventTree;                                     ///< ROOT tree for per-event data
+    TBranch *EventBranch;                                 ///< ROOT branch for event tree
+    std::vector<RunTallyInput> StatsInput;                ///< Input particle statistics, per primary
+    std::vector<RunTallyQuadrupoles> StatsQuadrupoles;    ///< Quadrupole statistics, per primary
+    std::vector<RunTallyCollimators> StatsHorizontalColl; ///< Horizontal collimator statistics, per primary
+    std::vector<RunTallyCollimators> StatsVerticalColl;   ///< Vertical collimator statistics, per primary
     RunTallyYAG StatsBSYAG;                  ///< Beam Stop YAG detector statistics
     RunTallyYAG StatsBSPECYAG;               ///< Beam Stop SPEC YAG detector statistics
+    G4int fQuadrupoleHCID = -1;              ///< Hits collection of the quadrupole boundaries
+    G4int fHorizontalCollHCID = -1;          ///< Hits collection of the horizontal collimator
+    G4int fVerticalCollHCID = -1;            ///< Hits collection of the vertical collimator
+    G4int fBSYAGHCID = -1;                   ///< Hits collection of the BS1 YAG screen
+    G4int fBSPECYAGHCID = -1;                ///< Hits collection of the BSPEC1 YAG screen
+    size_t fNumCollections = 0;              ///< Size of the collection table when the IDs were resolved
     G4String suffixe;                        ///< Suffix for output naming
+    PlasmaMLPALLASProgressMonitor::Counter& fProgressCounter; ///< Completed-event counter of this thread
 };
 
 #endif
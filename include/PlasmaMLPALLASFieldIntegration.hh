@@ -0,0 +1,73 @@
+#ifndef PlasmaMLPALLASFieldIntegration_h
+#define PlasmaMLPALLASFieldIntegration_h 1
+
+/**
+ * @struct PlasmaMLPALLASFieldIntegration
+ * @brief Integrator and accuracy settings of one field region.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The geometry holds one set of settings for the quadrupole volumes and one
+ * for the dipole field volume, and builds the field manager of each region
+ * from them in ConstructSDandField. The steppers are:
+ *  - ClassicalRK4: classical 4th order Runge-Kutta (historical stepper)
+ *  - DormandPrince745: embedded RK 4(5) with G4IntegrationDriver
+ *  - FSALDormandPrince745, FSALBogackiShampine45: first-same-as-last
+ *    variants with G4FSALIntegrationDriver
+ *
+ * "ExactHelix" is still accepted by /PlasmaMLPALLAS/field/setStepper as an
+ * alias of DormandPrince745: the helix is only exact in a field uniform over
+ * the whole region, and no field volume holds one.
+ *
+ * The "reference" preset reproduces the historical settings (RK4, 1 µm minimum
+ * step, Geant4 default accuracies); "optics-fast" trades accuracy for
+ * throughput for optics campaigns.
+ */
+
+#include "globals.hh"
+#include "G4SystemOfUnits.hh"
+#include <vector>
+
+class G4FieldManager;
+class G4MagneticField;
+
+struct PlasmaMLPALLASFieldIntegration
+{
+    /** Names accepted for the stepper (ExactHelix is an alias of DormandPrince745) */
+    static const std::vector<G4String>& GetStepperNames();
+
+    /** Names accepted for the presets */
+    static const std::vector<G4String>& GetPresetNames();
+
+    /**
+     * @brief Settings of a named preset.
+     * @param preset Preset name ("reference" or "optics-fast")
+     * @param quadrupoles Settings of the quadrupole volumes
+     * @param dipole Settings of the dipole field volume
+     * @return False if the preset is unknown (settings unchanged)
+     */
+    static G4bool ApplyPreset(const G4String& preset,
+                              PlasmaMLPALLASFieldIntegration& quadrupoles,
+                              PlasmaMLPALLASFieldIntegration& dipole);
+
+    /**
+     * @brief Build a field manager with these settings.
+     * @param field Magnetic field of the region
+     * @return New field manager owning its chord finder
+     */
+    G4FieldManager* CreateFieldManager(G4MagneticField* field) const;
+
+    /** Print the settings of a region */
+    void Print(const G4String& region) const;
+
+    G4String stepper = "ClassicalRK4";        ///< Stepper name
+    G4double minStep = 1e-3 * mm;             ///< Minimum step of the integration driver
+    G4double deltaChord = 0.25 * mm;          ///< Maximum miss distance of a chord
+    G4double deltaOneStep = 0.01 * mm;        ///< Position accuracy of one step
+    G4double deltaIntersection = 0.001 * mm;  ///< Accuracy of the boundary intersections
+    G4double minEpsilon = 5e-5;               ///< Minimum relative accuracy of a step
+    G4double maxEpsilon = 1e-3;               ///< Maximum relative accuracy of a step
+};
+
+#endif
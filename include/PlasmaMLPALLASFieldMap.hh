@@ -0,0 +1,81 @@
+#ifndef PlasmaMLPALLASFieldMap_h
+#define PlasmaMLPALLASFieldMap_h 1
+
+/**
+ * @class PlasmaMLPALLASFieldMap
+ * @brief Memory-mapped 3D magnetic field map on a regular grid.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The file holds a measured field map in global coordinates:
+ *  - an 80-byte header: the magic "PMLBMAP1", the number of nodes along x, y
+ *    and z (uint64) and the first node and grid spacing along each axis
+ *    (double, mm)
+ *  - the nodes, x varying fastest, as three native floats (Bx, By, Bz in tesla)
+ *
+ * One mapping is shared read-only by the fields of all threads, so a dense
+ * map costs its size once per process whatever the number of threads. The
+ * field is evaluated with a trilinear interpolation of the three components
+ * at once. Files are produced from a text table with ConvertCSV (`--fieldmap`
+ * mode of the executable).
+ */
+
+#include "globals.hh"
+#include "PlasmaMLPALLASMappedFile.hh"
+#include <array>
+#include <cstdint>
+#include <memory>
+
+class PlasmaMLPALLASFieldMap
+{
+public:
+    /**
+     * @brief Get the mapping of a field map file, shared by all threads.
+     * @param path Binary field map file
+     * @return File mapping, created on first request and released with its last user
+     */
+    static std::shared_ptr<const PlasmaMLPALLASFieldMap> Open(const G4String& path);
+
+    /**
+     * @brief Convert a text table into a binary field map file.
+     * @param csvFile Input with the columns x,y,z,Bx,By,Bz (mm, tesla), one line per node of a regular grid, in any order
+     * @param binaryFile Output binary file
+     * @return Number of nodes written (0 if the table is not a complete regular grid)
+     */
+    static size_t ConvertCSV(const G4String& csvFile, const G4String& binaryFile);
+
+    /**
+     * @brief Interpolated field at a point.
+     * @param point Position [x, y, z] in global coordinates
+     * @param bField Output field [Bx, By, Bz], 0 outside the grid
+     */
+    void GetValue(const G4double point[3], G4double bField[3]) const;
+
+    /** Number of nodes along each axis */
+    const std::array<size_t, 3>& GetNumberOfNodes() const { return fNodes; }
+
+    /** First node along x, y, z (mm) */
+    const std::array<G4double, 3>& GetLowerCorner() const { return fMin; }
+
+    /** Last node along x, y, z (mm) */
+    std::array<G4double, 3> GetUpperCorner() const
+    {
+        return {fMin[0] + (fNodes[0] - 1) / fInvStep[0], fMin[1] + (fNodes[1] - 1) / fInvStep[1],
+                fMin[2] + (fNodes[2] - 1) / fInvStep[2]};
+    }
+
+    /** Path of the mapped file */
+    const G4String& GetPath() const { return fMapping.GetPath(); }
+
+private:
+    explicit PlasmaMLPALLASFieldMap(const G4String& path);
+
+    PlasmaMLPALLASMappedFile fMapping;         /**< Read-only mapping of the whole file */
+    const float* fValues = nullptr;            /**< (Bx, By, Bz) of the first node, inside the mapping */
+    std::array<size_t, 3> fNodes = {};         /**< Number of nodes along x, y, z */
+    std::array<G4double, 3> fMin = {};         /**< First node along x, y, z (mm) */
+    std::array<G4double, 3> fInvStep = {};     /**< Inverse of the grid spacing (1/mm) */
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef PlasmaMLPALLASFieldParameters_h
+#define PlasmaMLPALLASFieldParameters_h 1
+
+/**
+ * @struct PlasmaMLPALLASFieldParameters
+ * @brief Versioned snapshot of the magnet settings that can change between runs.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The geometry publishes a new snapshot each time a gradient, a drift or the
+ * constant dipole field is set. At BeginOfRunAction, every thread compares the
+ * version with the one its PlasmaMLPALLASMagneticField was last given and
+ * pushes the new values into it, keeping the field managers, the geometry and
+ * the physics tables (drifts also move the quadrupole volumes in place, see
+ * PlasmaMLPALLASGeometryConstruction::UpdatePlacements). Lengths, the dipole
+ * model and the field map change the volumes or the steppers and still need
+ * /run/reinitializeGeometry.
+ */
+
+#include "globals.hh"
+#include <array>
+#include <cstdint>
+
+struct PlasmaMLPALLASFieldParameters
+{
+    std::uint64_t version = 0;               ///< Publication number (starts at 1)
+    std::array<G4double, 4> gradients{};     ///< Gradients of Q1..Q4
+    std::array<G4double, 4> drifts{};        ///< Drifts before Q1..Q4 (source-Q1, Q1-Q2, Q2-Q3, Q3-Q4)
+    G4double constantDipoleBField = 0.;      ///< Constant dipole field
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef PlasmaMLPALLASFieldStatistics_h
+#define PlasmaMLPALLASFieldStatistics_h 1
+
+/**
+ * @struct PlasmaMLPALLASFieldStatistics
+ * @brief Per-thread cost counters of the field evaluation and propagation.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * Enabled with /PlasmaMLPALLAS/field/setStatusFieldStatistics 1 before the
+ * fields are built. Each thread then counts:
+ *  - the GetFieldValue calls per beamline region: the quadrupole aperture
+ *    hit (Q1..Q4, and QExtra for all the field-only quadrupoles of an
+ *    upgraded lattice), the dipole model when it gives a non-zero field, and
+ *    the drifts (calls that returned no field);
+ *  - for the integration driver of each field manager (quadrupoles, dipole):
+ *    the chord steps, the tracks that used it and the wall time spent in it.
+ *
+ * The counters are reset at BeginOfRunAction; the run action of each thread
+ * prints them at EndOfRunAction and stores them in its GlobalInput tree. The
+ * physics and navigation time is the run time minus the propagation time.
+ * Nothing is counted when disabled (one pointer test per field call).
+ */
+
+#include "globals.hh"
+#include <array>
+#include <chrono>
+
+struct PlasmaMLPALLASFieldStatistics
+{
+    /// Beamline regions of the field calls
+    enum Region { kDipole, kQ1, kQ2, kQ3, kQ4, kQExtra, kDrift, kNumRegions };
+
+    /// Field managers whose integration driver is timed
+    enum Driver { kQuadrupoleDriver, kDipoleDriver, kNumDrivers };
+
+    /** Names of the regions, as used in the branch names */
+    static const std::array<const char*, kNumRegions>& GetRegionNames();
+
+    /** Names of the field managers, as used in the branch names */
+    static const std::array<const char*, kNumDrivers>& GetDriverNames();
+
+    /** Statistics of the calling thread */
+    static PlasmaMLPALLASFieldStatistics& Local();
+
+    /** Zero the counters and start the run clock */
+    void Reset();
+
+    /** Stop the run clock */
+    void Stop();
+
+    /** Print the counters of the thread */
+    void Print() const;
+
+    std::array<G4long, kNumRegions> fieldCalls{};      ///< GetFieldValue calls per region
+    std::array<G4long, kNumDrivers> chordSteps{};      ///< AdvanceChordLimited calls per driver
+    std::array<G4long, kNumDrivers> tracks{};          ///< Tracks propagated by each driver
+    std::array<G4double, kNumDrivers> driverTime{};    ///< Wall time in each driver (s)
+    G4double runTime = 0.;                             ///< Wall time of the run (s)
+
+    std::chrono::steady_clock::time_point start;       ///< Start of the run
+};
+
+#endif
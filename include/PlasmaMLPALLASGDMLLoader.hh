@@ -0,0 +1,96 @@
+#ifndef PlasmaMLPALLASGDMLLoader_h
+#define PlasmaMLPALLASGDMLLoader_h 1
+
+/**
+ * @class PlasmaMLPALLASGDMLLoader
+ * @brief Concurrent reader of the tessellated CAD exports of gdml_models/.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * G4GDMLParser registers materials, solids and volumes in the global stores
+ * while it reads, so two parsers cannot run at the same time. The CAD exports
+ * are all one tessellated solid of triangles and one volume, so the loader
+ * reads them with its own reader, one file per thread, into plain triangle
+ * lists (no Geant4 object). The solids and volumes are then built on the
+ * master, one at a time, when PlasmaMLPALLASGeometryConstruction asks for
+ * them through Geometry::GetGDMLVolume, and each list is released as soon as
+ * its solid is built.
+ *
+ * A file the reader does not understand (quadrangular facets, expressions,
+ * other solids) is left to G4GDMLParser at the time it is requested.
+ */
+
+#include "globals.hh"
+#include <map>
+#include <vector>
+
+class G4TessellatedSolid;
+class G4VSolid;
+
+/**
+ * @struct PlasmaMLPALLASTessellatedMesh
+ * @brief Triangles of a tessellated solid.
+ */
+struct PlasmaMLPALLASTessellatedMesh
+{
+    G4String solidName;           ///< Name of the solid
+    std::vector<double> vertices; ///< Three vertices per facet [mm]
+    G4bool fromCache = false;     ///< Read from the startup cache rather than from the GDML file
+};
+
+class PlasmaMLPALLASGDMLLoader
+{
+public:
+    /** GDML file and name of the volume wanted from it */
+    struct Request
+    {
+        G4String file;   ///< Path to the GDML file
+        G4String volume; ///< Name of the volume
+    };
+
+    /**
+     * @brief Read the files concurrently, from the startup cache when possible.
+     * @param requests Volumes that the geometry will ask for
+     */
+    void Preload(const std::vector<Request>& requests);
+
+    /**
+     * @brief Hand over the preloaded triangles of a volume.
+     * @param file Path to the GDML file
+     * @param volume Name of the volume
+     * @param mesh Triangles of the solid of the volume
+     * @return False if the volume was not preloaded (or could not be read)
+     */
+    G4bool Take(const G4String& file, const G4String& volume, PlasmaMLPALLASTessellatedMesh& mesh);
+
+    /** Release the triangles that were not asked for */
+    void Clear() { fMeshes.clear(); }
+
+    /**
+     * @brief Read the solid of a volume from a tessellated GDML export.
+     * @param file Path to the GDML file
+     * @param volume Name of the volume
+     * @param mesh Triangles of the solid of the volume
+     * @return False if the file holds anything else than triangles with numerical coordinates
+     */
+    static G4bool ReadGDML(const G4String& file, const G4String& volume, PlasmaMLPALLASTessellatedMesh& mesh);
+
+    /**
+     * @brief Closed tessellated solid of the triangles.
+     * @param mesh Triangles of the solid
+     * @param maxVoxels Maximum number of voxels of the solid (-1 for the Geant4 default)
+     */
+    static G4TessellatedSolid* BuildSolid(const PlasmaMLPALLASTessellatedMesh& mesh, G4int maxVoxels = -1);
+
+    /**
+     * @brief Triangles of a solid read by G4GDMLParser.
+     * @return False if the solid is not a tessellated solid of triangles
+     */
+    static G4bool ToMesh(const G4VSolid* solid, PlasmaMLPALLASTessellatedMesh& mesh);
+
+private:
+    std::map<std::pair<G4String, G4String>, PlasmaMLPALLASTessellatedMesh> fMeshes; ///< Preloaded volumes
+};
+
+#endif
@@ -29,6 +29,11 @@
 #include "G4ChordFinder.hh"
 #include "G4ClassicalRK4.hh"
 #include "PlasmaMLPALLASMagneticField.hh"
+#include "PlasmaMLPALLASFieldIntegration.hh"
+#include "PlasmaMLPALLASFieldParameters.hh"
+#include <memory>
+#include "PlasmaMLPALLASLinearOpticsModel.hh"
+#include "PlasmaMLPALLASVolumeRoles.hh"
 
 class Geometry;
 class G4FieldManager;
@@ -92,6 +97,15 @@ public:
   /** @brief Construct sensitive detectors and magnetic fields. */
   void ConstructSDandField() override;
 
+  /**
+   * @brief Push the field parameters published since the last call into the field of the calling thread.
+   * @return True if the field was updated
+   *
+   * Called at BeginOfRunAction, so that gradient and dipole changes apply to the
+   * next run without rebuilding the geometry or the field managers.
+   */
+  G4bool UpdateMagneticField();
+
   /** @brief Construct method required by Geant4 kernel. */
   G4VPhysicalVolume *Construct() override;
 
@@ -116,11 +130,12 @@ public:
   void SetQ2Length(G4double QLength) {fQ2Length = QLength;};
   void SetQ3Length(G4double QLength) {fQ3Length = QLength;};
   void SetQ4Length(G4double QLength) {fQ4Length = QLength;};
-  void SetSourceQ1Distance(G4double distance) {fSourceQ1Distance = distance;};
-  void SetQ1Q2Distance(G4double distance) {fQ1Q2Distance = distance;};
-  void SetQ2Q3Distance(G4double distance) {fQ2Q3Distance = distance;};
-  void SetQ3Q4Distance(G4double distance) {fQ3Q4Distance = distance;};
-  void SetSourceCollimatorsDistance(G4double distance) {fSourceCollimatorsDistance = distance;};
+  /// Distances move the built placements in place (see UpdatePlacements)
+  void SetSourceQ1Distance(G4double distance) {fSourceQ1Distance = distance; UpdatePlacements();};
+  void SetQ1Q2Distance(G4double distance) {fQ1Q2Distance = distance; UpdatePlacements();};
+  void SetQ2Q3Distance(G4double distance) {fQ2Q3Distance = distance; UpdatePlacements();};
+  void SetQ3Q4Distance(G4double distance) {fQ3Q4Distance = distance; UpdatePlacements();};
+  void SetSourceCollimatorsDistance(G4double distance) {fSourceCollimatorsDistance = distance; UpdatePlacements();};
 
   const float GetQ1Length() const {return fQ1Length;}
   const float GetQ2Length() const {return fQ2Length;}
@@ -135,12 +150,18 @@ public:
 
   /** @name Magnetic Field Parameters */
   ///@{
-  void SetQ1Gradient(G4double QGrad) {fQ1Gradient = QGrad;};
-  void SetQ2Gradient(G4double QGrad) {fQ2Gradient = QGrad;};
-  void SetQ3Gradient(G4double QGrad) {fQ3Gradient = QGrad;};
-  void SetQ4Gradient(G4double QGrad) {fQ4Gradient = QGrad;};
+  void SetQ1Gradient(G4double QGrad) {fQ1Gradient = QGrad; PublishFieldParameters();};
+  void SetQ2Gradient(G4double QGrad) {fQ2Gradient = QGrad; PublishFieldParameters();};
+  void SetQ3Gradient(G4double QGrad) {fQ3Gradient = QGrad; PublishFieldParameters();};
+  void SetQ4Gradient(G4double QGrad) {fQ4Gradient = QGrad; PublishFieldParameters();};
   void SetStatusMapBField(G4int status) {fStatusMapBField = status;};
-  void SetConstantDipoleBField(G4double BField) {fConstantDipoleBField = BField;};
+  void SetConstantDipoleBField(G4double BField) {fConstantDipoleBField = BField; PublishFieldParameters();};
+  void SetFieldMapFile(const G4String &path) {fFieldMapFile = path;};
+  void SetStatusFieldVolumes(G4int status) {fStatusFieldVolumes = status;};
+  void SetStatusLinearOptics(G4int status) {fStatusLinearOptics = status;};
+  void SetStatusFieldStatistics(G4int status) {fStatusFieldStatistics = status;};
+  void AddQuadrupole(G4double drift, G4double length, G4double QGrad) {fExtraQuadrupoles.push_back({drift, length, QGrad});};
+  void ClearExtraQuadrupoles() {fExtraQuadrupoles.clear();};
 
   const float GetQ1Gradient() const {return fQ1Gradient;}
   const float GetQ2Gradient() const {return fQ2Gradient;}
@@ -148,9 +169,52 @@ public:
   const float GetQ4Gradient() const {return fQ4Gradient;}
   const int GetStatusMapBField() const {return fStatusMapBField;}
   const float GetConstantDipoleBField() const {return fConstantDipoleBField;}
+  const G4String &GetFieldMapFile() const {return fFieldMapFile;}
+  const int GetStatusFieldVolumes() const {return fStatusFieldVolumes;}
+  const int GetStatusLinearOptics() const {return fStatusLinearOptics;}
+  const int GetStatusFieldStatistics() const {return fStatusFieldStatistics;}
+  const std::vector<std::array<G4double, 3>> &GetExtraQuadrupoles() const {return fExtraQuadrupoles;}
+
+  /** Role of the physical volumes for the stepping action, rebuilt by Construct() */
+  const PlasmaMLPALLASVolumeRoles &GetVolumeRoles() const {return fVolumeRoles;}
+
+  /** Proxies and voxel limits of the CAD parts, applied by the next Construct() */
+  PlasmaMLPALLASCADModels &GetCADModels() {return Geom->GetCADModels();}
+
+  /** Integrator and accuracy settings of the quadrupole volumes (and of the whole holder) */
+  PlasmaMLPALLASFieldIntegration &GetQuadrupoleIntegration() {return fQuadrupoleIntegration;}
+  /** Integrator and accuracy settings of the dipole field volume */
+  PlasmaMLPALLASFieldIntegration &GetDipoleIntegration() {return fDipoleIntegration;}
   ///@}
 
 private:
+  /** @brief GDML models (file, volume) placed for the current display flags. */
+  std::vector<PlasmaMLPALLASGDMLLoader::Request> CollectGDMLModels() const;
+
+  /** @brief Centres along y of the Q1..Q4 field volumes. */
+  std::array<G4double, 4> GetQuadrupoleVolumePositions() const;
+
+  /** @brief Origins along y of the Q1..Q4 CAD models. */
+  std::array<G4double, 4> GetQuadrupoleModelPositions() const;
+
+  /** @brief Origin along y of the collimator CAD models. */
+  G4double GetCollimatorsPosition() const;
+
+  /**
+   * @brief Move the quadrupoles and the collimators of the built geometry to the current distances.
+   *
+   * The solids and logical volumes are kept: only the translations of the
+   * placements change, and only the voxels of the holder are rebuilt. Does
+   * nothing before the first construction (the values are read by Construct()).
+   */
+  void UpdatePlacements();
+
+  /** @brief Collimators upstream of the hand-off plane of the lattice (linear optics off). */
+  G4bool CollimatorsInsideLattice() const;
+
+  /** @brief CollimatorsInsideLattice() at the last construction. */
+  G4bool fCollimatorsInsideLattice = false;
+
   /** @brief Geometry handler. */
   Geometry *Geom;
 
@@ -166,9 +230,28 @@ private:
   G4int fStatusDisplayCollimators=0;
   G4int fStatusDisplayQuadrupoles=0;
   G4int fStatusMapBField=0;
+  G4int fStatusFieldVolumes=1;
+  G4int fStatusLinearOptics=0;
+  G4int fStatusFieldStatistics=0;
+
+  /** @brief Role of the physical volumes, read by the stepping actions. */
+  PlasmaMLPALLASVolumeRoles fVolumeRoles;
+
+  /** @brief Field integration settings per field region. */
+  PlasmaMLPALLASFieldIntegration fQuadrupoleIntegration;
+  PlasmaMLPALLASFieldIntegration fDipoleIntegration;
+
+  /** @brief Publish the current gradients, drifts and dipole field as a new snapshot. */
+  void PublishFieldParameters();
+
+  /** @brief Latest field parameters (guarded by a mutex, replaced and never modified). */
+  std::shared_ptr<const PlasmaMLPALLASFieldParameters> fFieldParameters;
 
   /** @brief Default magnetic and geometry values. */
   G4double fConstantDipoleBField =0.4*CLHEP::tesla;
+  G4String fFieldMapFile;
+  /** @brief Field-only quadrupoles after Q4: drift from the previous exit, length, gradient. */
+  std::vector<std::array<G4double, 3>> fExtraQuadrupoles;
   G4double fQ1Length = 0.1*CLHEP::m;
   G4double fQ2Length = 0.1*CLHEP::m;
   G4double fQ3Length = 0.2*CLHEP::m;
@@ -199,6 +282,15 @@ private:
   /** @brief Logical volumes (geometry definitions). */
   G4LogicalVolume *LogicalWorld=nullptr;
   G4LogicalVolume *LogicalHolder=nullptr;
+  G4LogicalVolume *LogicalQ1Volume=nullptr;
+  G4LogicalVolume *LogicalQ2Volume=nullptr;
+  G4LogicalVolume *LogicalQ3Volume=nullptr;
+  G4LogicalVolume *LogicalQ4Volume=nullptr;
+  G4LogicalVolume *LogicalQ1FieldVolume=nullptr;
+  G4LogicalVolume *LogicalQ2FieldVolume=nullptr;
+  G4LogicalVolume *LogicalQ3FieldVolume=nullptr;
+  G4LogicalVolume *LogicalQ4FieldVolume=nullptr;
+  G4LogicalVolume *LogicalDipoleFieldVolume=nullptr;
   G4LogicalVolume *LogicalFakeDiagsChamber=nullptr;
   G4LogicalVolume *LogicalPALLAS_QuadrupoleQ3=nullptr;
   G4LogicalVolume *LogicalPALLAS_QuadrupoleQ4=nullptr;
@@ -254,6 +346,15 @@ private:
   /** @brief Physical volumes (placements in space). */
   G4VPhysicalVolume *PhysicalWorld=nullptr;
   G4VPhysicalVolume *PhysicalHolder=nullptr;
+  G4VPhysicalVolume *PhysicalDipoleFieldVolume=nullptr;
+  G4VPhysicalVolume *PhysicalQ1Volume=nullptr;
+  G4VPhysicalVolume *PhysicalQ2Volume=nullptr;
+  G4VPhysicalVolume *PhysicalQ3Volume=nullptr;
+  G4VPhysicalVolume *PhysicalQ4Volume=nullptr;
+  G4VPhysicalVolume *PhysicalQ1FieldVolume=nullptr;
+  G4VPhysicalVolume *PhysicalQ2FieldVolume=nullptr;
+  G4VPhysicalVolume *PhysicalQ3FieldVolume=nullptr;
+  G4VPhysicalVolume *PhysicalQ4FieldVolume=nullptr;
   G4VPhysicalVolume *PhysicalFakeDiagsChamber=nullptr; 
   G4VPhysicalVolume *PhysicalPALLAS_QuadrupoleQ3=nullptr;
   G4VPhysicalVolume *PhysicalPALLAS_QuadrupoleQ4=nullptr;
@@ -311,9 +412,16 @@ private:
   G4RotationMatrix Flip;
   G4RotationMatrix* RotationMatrix;
 
-  /** @brief Thread-local magnetic field and field manager. */
+  /** @brief Thread-local magnetic field and field managers (quadrupoles or holder, dipole). */
   static G4ThreadLocal PlasmaMLPALLASMagneticField* fMagneticField;
   static G4ThreadLocal G4FieldManager* fFieldMgr;
+  static G4ThreadLocal G4FieldManager* fDipoleFieldMgr;
+
+  /** @brief Version of the field parameters last pushed into the field of the thread. */
+  static G4ThreadLocal std::uint64_t fAppliedFieldVersion;
+
+  /** @brief Thread-local linear-optics model of the "LinearOptics" region (Q1 volume). */
+  static G4ThreadLocal PlasmaMLPALLASLinearOpticsModel* fLinearOpticsModel;
 
 };
 #endif
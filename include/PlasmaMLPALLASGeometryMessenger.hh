@@ -12,13 +12,17 @@
  * initialization). Length, distance, gradients and display can be changed.
  */
 
+#include "G4UIcmdWithADouble.hh"                 // for G4UIcmdWithADouble
 #include "G4UIcmdWithADoubleAndUnit.hh"          // for G4UIcmdWithADoubleAndUnit
+#include "G4UIcmdWithAString.hh"                 // for G4UIcmdWithAString
 #include "G4UIcmdWithAnInteger.hh"               // for G4UIcmdWithAnInteger
 #include "G4UIcmdWithoutParameter.hh"            // for G4UIcmdWithoutParameter
 #include "G4UIdirectory.hh"                      // for G4UIdirectory
 #include "PlasmaMLPALLASGeometryConstruction.hh" // for PlasmaMLPALLASGeometryConstruction
 
+class G4UIcmdWithADouble;
 class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAString;
 class G4UIcmdWithAnInteger;
 class G4UIcmdWithoutParameter;
 class G4UIdirectory;
@@ -77,6 +81,12 @@ private:
     G4UIcmdWithADoubleAndUnit *fGeometryQ3Q4DistanceCmd = nullptr;
     /// Command to set the Source -- Collimators Distance
     G4UIcmdWithADoubleAndUnit *fGeometrySourceCollimatorsDistanceCmd = nullptr;
+    /// Command to select the solid of the CAD parts
+    G4UIcommand *fGeometryCADModeCmd = nullptr;
+    /// Command to set the minimum overlap of a CAD proxy
+    G4UIcmdWithADouble *fGeometryProxyToleranceCmd = nullptr;
+    /// Command to set the navigation voxel limits of a logical volume
+    G4UIcommand *fGeometryVoxelLimitsCmd = nullptr;
 
     ///FIELD
     /// Command to set the Q1 Gradient
@@ -91,6 +101,29 @@ private:
     G4UIcmdWithAnInteger *fFieldStatusMapBFieldCmd = nullptr;
     /// Command to set the Constant Dipole B Field
     G4UIcmdWithADoubleAndUnit *fFieldConstantDipoleBFieldCmd = nullptr;
+    /// Command to append a field-only quadrupole after the last one
+    G4UIcommand *fFieldAddQuadrupoleCmd = nullptr;
+    /// Command to remove the field-only quadrupoles
+    G4UIcmdWithoutParameter *fFieldClearQuadrupolesCmd = nullptr;
+    /// Command to set the binary 3D field map used with Status Map B Field 2
+    G4UIcmdWithAString *fFieldMapFileCmd = nullptr;
+    /// Command to compare the tabulated dipole profiles with the analytic fits
+    G4UIcmdWithAnInteger *fFieldValidateDipoleMapCmd = nullptr;
+    /// Command to set the status of the field volumes (whole holder/magnets only)
+    G4UIcmdWithAnInteger *fFieldStatusFieldVolumesCmd = nullptr;
+    G4UIcmdWithAnInteger *fFieldStatusLinearOpticsCmd = nullptr;
+    /// Command to enable the field cost counters
+    G4UIcmdWithAnInteger *fFieldStatusFieldStatisticsCmd = nullptr;
+    /// Command to select the stepper of a field region
+    G4UIcommand *fFieldStepperCmd = nullptr;
+    /// Command to set the step accuracies of a field region
+    G4UIcommand *fFieldAccuracyCmd = nullptr;
+    /// Command to set the relative accuracy bounds of a field region
+    G4UIcommand *fFieldEpsilonCmd = nullptr;
+    /// Command to apply a named set of integration settings
+    G4UIcmdWithAString *fFieldPresetCmd = nullptr;
+    /// Command to print the integration settings
+    G4UIcmdWithoutParameter *fFieldPrintIntegrationCmd = nullptr;
 
 };
 
@@ -0,0 +1,127 @@
+#ifndef PlasmaMLPALLASHits_h
+#define PlasmaMLPALLASHits_h 1
+
+/**
+ * @file PlasmaMLPALLASHits.hh
+ * @brief Hits of the sensitive detectors (quadrupole boundaries, collimators, YAG screens).
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The sensitive detectors only store what they see during the event; the
+ * hits collections are turned into the RunTally* structures of the event
+ * action at EndOfEventAction. The hits are allocated from thread-local
+ * G4Allocator pools, so a long run does not go back to the heap for them.
+ */
+
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
+#include "G4ThreeVector.hh"
+#include "PlasmaMLPALLASQuadrupoleUtils.hh"
+
+/**
+ * @class PlasmaMLPALLASQuadrupoleHit
+ * @brief Entry in or exit from a quadrupole field volume by a primary.
+ */
+class PlasmaMLPALLASQuadrupoleHit : public G4VHit
+{
+public:
+    inline void *operator new(size_t);
+    inline void operator delete(void *hit);
+
+    G4int trackID = 0;                          ///< Track ID of the primary
+    QuadID quad = QuadID::Q1;                   ///< Crossed quadrupole
+    PositionType posType = PositionType::Begin; ///< Entry (Begin) or exit (End)
+    G4double energy = 0.;                       ///< Kinetic energy [MeV]
+    G4ThreeVector position;                     ///< Position on the boundary [mm]
+    G4ThreeVector direction;                    ///< Momentum direction
+};
+
+/**
+ * @class PlasmaMLPALLASCollimatorHit
+ * @brief First interaction of a primary with a collimator.
+ */
+class PlasmaMLPALLASCollimatorHit : public G4VHit
+{
+public:
+    inline void *operator new(size_t);
+    inline void operator delete(void *hit);
+
+    G4int trackID = 0;      ///< Track ID of the primary
+    G4ThreeVector position; ///< Interaction position [mm]
+    G4double energy = 0.;   ///< Kinetic energy [MeV]
+    G4double weight = 0.;   ///< Statistical weight
+};
+
+/**
+ * @class PlasmaMLPALLASYAGHit
+ * @brief Passage of a particle through a YAG screen.
+ *
+ * The values are kept in single precision, as in the RunTallyYAG they end
+ * up in, so that the deposited energy is summed in the same way.
+ */
+class PlasmaMLPALLASYAGHit : public G4VHit
+{
+public:
+    inline void *operator new(size_t);
+    inline void operator delete(void *hit);
+
+    G4float x = 0.f;               ///< X position at the first step [mm]
+    G4float y = 0.f;               ///< Y position at the first step [mm]
+    G4float z = 0.f;               ///< Z position at the first step [mm]
+    G4int parentID = 0;            ///< Parent track ID
+    G4int particleID = 0;          ///< PDG encoding
+    G4float energy = 0.f;          ///< Kinetic energy at the first step [MeV]
+    G4float weight = 0.f;          ///< Statistical weight
+    G4float depositedEnergy = 0.f; ///< Energy deposited in the screen [keV]
+    G4bool closed = false;         ///< The particle left into the holder or stopped
+};
+
+using PlasmaMLPALLASQuadrupoleHitsCollection = G4THitsCollection<PlasmaMLPALLASQuadrupoleHit>;
+using PlasmaMLPALLASCollimatorHitsCollection = G4THitsCollection<PlasmaMLPALLASCollimatorHit>;
+using PlasmaMLPALLASYAGHitsCollection = G4THitsCollection<PlasmaMLPALLASYAGHit>;
+
+extern G4ThreadLocal G4Allocator<PlasmaMLPALLASQuadrupoleHit> *PlasmaMLPALLASQuadrupoleHitAllocator;
+extern G4ThreadLocal G4Allocator<PlasmaMLPALLASCollimatorHit> *PlasmaMLPALLASCollimatorHitAllocator;
+extern G4ThreadLocal G4Allocator<PlasmaMLPALLASYAGHit> *PlasmaMLPALLASYAGHitAllocator;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void *PlasmaMLPALLASQuadrupoleHit::operator new(size_t)
+{
+    if (!PlasmaMLPALLASQuadrupoleHitAllocator)
+        PlasmaMLPALLASQuadrupoleHitAllocator = new G4Allocator<PlasmaMLPALLASQuadrupoleHit>;
+    return (void *)PlasmaMLPALLASQuadrupoleHitAllocator->MallocSingle();
+}
+
+inline void PlasmaMLPALLASQuadrupoleHit::operator delete(void *hit)
+{
+    PlasmaMLPALLASQuadrupoleHitAllocator->FreeSingle((PlasmaMLPALLASQuadrupoleHit *)hit);
+}
+
+inline void *PlasmaMLPALLASCollimatorHit::operator new(size_t)
+{
+    if (!PlasmaMLPALLASCollimatorHitAllocator)
+        PlasmaMLPALLASCollimatorHitAllocator = new G4Allocator<PlasmaMLPALLASCollimatorHit>;
+    return (void *)PlasmaMLPALLASCollimatorHitAllocator->MallocSingle();
+}
+
+inline void PlasmaMLPALLASCollimatorHit::operator delete(void *hit)
+{
+    PlasmaMLPALLASCollimatorHitAllocator->FreeSingle((PlasmaMLPALLASCollimatorHit *)hit);
+}
+
+inline void *PlasmaMLPALLASYAGHit::operator new(size_t)
+{
+    if (!PlasmaMLPALLASYAGHitAllocator)
+        PlasmaMLPALLASYAGHitAllocator = new G4Allocator<PlasmaMLPALLASYAGHit>;
+    return (void *)PlasmaMLPALLASYAGHitAllocator->MallocSingle();
+}
+
+inline void PlasmaMLPALLASYAGHit::operator delete(void *hit)
+{
+    PlasmaMLPALLASYAGHitAllocator->FreeSingle((PlasmaMLPALLASYAGHit *)hit);
+}
+
+#endif
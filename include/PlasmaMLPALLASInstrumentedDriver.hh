@@ -0,0 +1,84 @@
+#ifndef PlasmaMLPALLASInstrumentedDriver_h
+#define PlasmaMLPALLASInstrumentedDriver_h 1
+
+/**
+ * @class PlasmaMLPALLASInstrumentedDriver
+ * @brief Integration driver that counts and times the driver it wraps.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * Installed into the chord finder of a field manager when the field statistics
+ * are enabled: every call is forwarded to the original driver (owned by the
+ * wrapper), so the integration is unchanged. The chord steps of each track
+ * and the time spent in AdvanceChordLimited and AccurateAdvance (boundary
+ * intersections) are added to PlasmaMLPALLASFieldStatistics of the thread.
+ */
+
+#include "G4VIntegrationDriver.hh"
+#include "PlasmaMLPALLASFieldStatistics.hh"
+
+class G4ChordFinder;
+
+class PlasmaMLPALLASInstrumentedDriver : public G4VIntegrationDriver
+{
+public:
+    /**
+     * @brief Wrap the driver of a chord finder.
+     * @param chordFinder Chord finder of the field manager (owns the new wrapper)
+     * @param driver Field manager counted, in the statistics of the calling thread
+     */
+    static void Install(G4ChordFinder* chordFinder, PlasmaMLPALLASFieldStatistics::Driver driver);
+
+    ~PlasmaMLPALLASInstrumentedDriver() override;
+
+    G4double AdvanceChordLimited(G4FieldTrack& track, G4double hstep, G4double eps,
+                                 G4double chordDistance) override;
+    G4bool AccurateAdvance(G4FieldTrack& track, G4double hstep, G4double eps,
+                           G4double hinitial = 0) override;
+
+    void SetEquationOfMotion(G4EquationOfMotion* equation) override { fDriver->SetEquationOfMotion(equation); }
+    G4EquationOfMotion* GetEquationOfMotion() override { return fDriver->GetEquationOfMotion(); }
+    void RenewStepperAndAdjust(G4MagIntegratorStepper* stepper) override { fDriver->RenewStepperAndAdjust(stepper); }
+    void SetVerboseLevel(G4int level) override { fDriver->SetVerboseLevel(level); }
+    G4int GetVerboseLevel() const override { return fDriver->GetVerboseLevel(); }
+    void OnComputeStep(const G4FieldTrack* track = nullptr) override { fDriver->OnComputeStep(track); }
+    void OnStartTracking() override { fDriver->OnStartTracking(); }
+
+    G4bool QuickAdvance(G4FieldTrack& track, const G4double dydx[], G4double hstep,
+                        G4double& dchord_step, G4double& dyerr) override
+    {
+        return fDriver->QuickAdvance(track, dydx, hstep, dchord_step, dyerr);
+    }
+    void GetDerivatives(const G4FieldTrack& track, G4double dydx[]) const override
+    {
+        fDriver->GetDerivatives(track, dydx);
+    }
+    void GetDerivatives(const G4FieldTrack& track, G4double dydx[], G4double field[]) const override
+    {
+        fDriver->GetDerivatives(track, dydx, field);
+    }
+
+    const G4MagIntegratorStepper* GetStepper() const override { return fDriver->GetStepper(); }
+    G4MagIntegratorStepper* GetStepper() override { return fDriver->GetStepper(); }
+    G4double ComputeNewStepSize(G4double errMaxNorm, G4double hstepCurrent) override
+    {
+        return fDriver->ComputeNewStepSize(errMaxNorm, hstepCurrent);
+    }
+    G4bool DoesReIntegrate() const override { return fDriver->DoesReIntegrate(); }
+    void StreamInfo(std::ostream& os) const override { fDriver->StreamInfo(os); }
+
+private:
+    PlasmaMLPALLASInstrumentedDriver(G4VIntegrationDriver* driver, PlasmaMLPALLASFieldStatistics::Driver index);
+
+    /** Count a new track the first time this driver sees it */
+    void CountTrack();
+
+    G4VIntegrationDriver* fDriver = nullptr;             ///< Wrapped driver (owned)
+    PlasmaMLPALLASFieldStatistics& fStatistics;          ///< Statistics of the thread
+    PlasmaMLPALLASFieldStatistics::Driver fIndex;        ///< Field manager counted
+    G4int fLastEventID = -1;                             ///< Event of the last track seen
+    G4int fLastTrackID = -1;                             ///< Last track seen
+};
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef PlasmaMLPALLASKillZones_h
+#define PlasmaMLPALLASKillZones_h 1
+
+/**
+ * @class PlasmaMLPALLASKillZones
+ * @brief Geometric and kinematic cuts stopping the particles lost by the beamline.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * Badly focused configurations send the beam into the chambers and the
+ * holder, where it is tracked for nothing. The stepping action kills a track
+ * at the end of a step:
+ *  - outside an aperture: a cylinder (radius around the beam axis y) or a
+ *    box (half widths in x and z), over a range of y;
+ *  - moving backwards: direction along y below a cosine;
+ *  - below a kinetic energy.
+ *
+ * The apertures are turned into a table of y intervals, each with the
+ * tightest radius and half widths of the apertures covering it, so that a
+ * step costs one binary search and three comparisons. By default only the
+ * primaries are cut, leaving the showers seen by the YAG screens untouched.
+ *
+ * One table per thread (Local()), configured by the messenger of the
+ * stepping action (commands broadcast to the workers). The kills are counted
+ * per cut, reset at BeginOfRunAction and stored in the GlobalInput tree.
+ */
+
+#include "globals.hh"
+#include <vector>
+
+class G4Track;
+class G4StepPoint;
+
+class PlasmaMLPALLASKillZones
+{
+public:
+    /// Shape of an aperture
+    enum class Shape { Cylinder, Box };
+
+    /// Aperture applied between two y positions
+    struct Aperture
+    {
+        G4String name;                ///< Name of the counter
+        Shape shape = Shape::Cylinder;
+        G4double yMin = 0.;           ///< Start along the beam axis
+        G4double yMax = 0.;           ///< End along the beam axis
+        G4double halfX = 0.;          ///< Radius (cylinder) or half width in x (box)
+        G4double halfZ = 0.;          ///< Radius (cylinder) or half width in z (box)
+    };
+
+    /** Table of the calling thread */
+    static PlasmaMLPALLASKillZones& Local();
+
+    /** Shape names as accepted by the messenger ("cylinder", "box") */
+    static const std::vector<G4String>& GetShapeNames();
+
+    /** @brief Add an aperture (a previous one with the same name is replaced). */
+    void AddAperture(const Aperture& aperture);
+
+    /** @brief Remove the apertures and disable the backward and energy cuts. */
+    void Clear();
+
+    /**
+     * @brief Kill the tracks moving backwards.
+     * @param minDirectionY Lowest direction cosine along y kept (-1 disables the cut)
+     */
+    void SetBackwardCut(G4double minDirectionY);
+    G4double GetBackwardCut() const { return fMinDirectionY; }
+
+    /** @brief Kill the tracks below a kinetic energy (0 disables the cut). */
+    void SetMinEnergy(G4double energy);
+    G4double GetMinEnergy() const { return fMinEnergy; }
+
+    /** @brief Apply the cuts to the primaries only (default) or to every track. */
+    void SetPrimariesOnly(G4bool primariesOnly) { fPrimariesOnly = primariesOnly; }
+    G4bool GetPrimariesOnly() const { return fPrimariesOnly; }
+
+    const std::vector<Aperture>& GetApertures() const { return fApertures; }
+
+    /** True if at least one cut is set (one test per step otherwise) */
+    G4bool IsActive() const { return fActive; }
+
+    /**
+     * @brief Check the end of a step against the cuts and count the kill.
+     * @param track Track of the step
+     * @param point Post-step point
+     * @return True if the track must be killed
+     */
+    G4bool Check(const G4Track* track, const G4StepPoint* point);
+
+    /** Names of the counters: one per aperture, "Backward" and "MinEnergy" */
+    std::vector<G4String> GetCounterNames() const;
+
+    /** Kills since the last Reset(), in the order of GetCounterNames() */
+    const std::vector<G4long>& GetCounts() const { return fCounts; }
+
+    /** Zero the counters */
+    void Reset();
+
+    /** Print the cuts and the counters of the thread */
+    void Print() const;
+
+private:
+    /// Interval of y with the tightest limits of the apertures covering it
+    struct Interval
+    {
+        G4double radius2 = -1.;     ///< Squared radius, < 0 without cylinder
+        G4double halfX = -1.;       ///< Half width in x, < 0 without box
+        G4double halfZ = -1.;       ///< Half width in z, < 0 without box
+        size_t radiusCounter = 0;   ///< Counter of the cylinder giving the radius
+        size_t boxXCounter = 0;     ///< Counter of the box giving halfX
+        size_t boxZCounter = 0;     ///< Counter of the box giving halfZ
+    };
+
+    /** @brief Rebuild the interval table and resize the counters. */
+    void Build();
+
+    std::vector<Aperture> fApertures;   ///< Apertures in definition order
+    std::vector<G4double> fEdges;       ///< Sorted y edges of the intervals
+    std::vector<Interval> fIntervals;   ///< fEdges.size() - 1 intervals
+    std::vector<G4long> fCounts;        ///< Kills per counter
+    G4double fMinDirectionY = -1.;      ///< Backward cut (disabled at -1)
+    G4double fMinEnergy = 0.;           ///< Energy cut (disabled at 0)
+    G4bool fPrimariesOnly = true;       ///< Cut the primaries only
+    G4bool fActive = false;             ///< At least one cut is set
+};
+
+#endif
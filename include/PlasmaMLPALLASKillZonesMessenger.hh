@@ -0,0 +1,72 @@
+#ifndef PlasmaMLPALLASKillZonesMessenger_H
+#define PlasmaMLPALLASKillZonesMessenger_H
+
+/**
+ * @class PlasmaMLPALLASKillZonesMessenger
+ * @brief Provides UI commands to configure the kill zones of the stepping action
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * Each thread owns its kill-zone table and a messenger (created with the
+ * stepping action); the commands are broadcast to the worker threads.
+ */
+
+#include "G4UIcommand.hh"
+#include "G4UIcmdWithABool.hh"                     // for G4UIcmdWithABool
+#include "G4UIcmdWithADouble.hh"                   // for G4UIcmdWithADouble
+#include "G4UIcmdWithADoubleAndUnit.hh"            // for G4UIcmdWithADoubleAndUnit
+#include "G4UIcmdWithoutParameter.hh"              // for G4UIcmdWithoutParameter
+#include "G4UIdirectory.hh"                        // for G4UIdirectory
+#include "G4UImessenger.hh"
+
+class G4UIcmdWithABool;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithoutParameter;
+class G4UIcommand;
+class G4UIdirectory;
+
+class PlasmaMLPALLASKillZones;
+
+class PlasmaMLPALLASKillZonesMessenger : public G4UImessenger
+{
+public:
+    /**
+     * @brief Constructor
+     * @param zones Kill-zone table of the thread
+     */
+    PlasmaMLPALLASKillZonesMessenger(PlasmaMLPALLASKillZones *zones);
+
+    /// Destructor
+    ~PlasmaMLPALLASKillZonesMessenger();
+
+    /**
+     * @brief Executes a command with a new value
+     * @param command Pointer to the issued command
+     * @param newValue String representation of the new value
+     */
+    virtual void SetNewValue(G4UIcommand *command, G4String newValue) final;
+
+    /**
+     * @brief Retrieves the current value of a command
+     * @param command Pointer to the command
+     * @return String representing the current value
+     */
+    virtual G4String GetCurrentValue(G4UIcommand *command) final;
+
+private:
+    /// Associated kill-zone table
+    PlasmaMLPALLASKillZones *fZones = nullptr;
+
+    G4UIdirectory *fKillZoneDir = nullptr;                ///< Directory /PlasmaMLPALLAS/killzone
+
+    G4UIcommand *fAddApertureCmd = nullptr;               ///< Cylinder or box aperture over a range of y
+    G4UIcmdWithADouble *fBackwardCutCmd = nullptr;        ///< Lowest direction cosine along y
+    G4UIcmdWithADoubleAndUnit *fMinEnergyCmd = nullptr;   ///< Lowest kinetic energy
+    G4UIcmdWithABool *fPrimariesOnlyCmd = nullptr;        ///< Cut the primaries only
+    G4UIcmdWithoutParameter *fClearCmd = nullptr;         ///< Remove all the cuts
+    G4UIcmdWithoutParameter *fListCmd = nullptr;          ///< Print the cuts and counters
+};
+
+#endif
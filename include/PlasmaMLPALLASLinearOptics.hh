@@ -0,0 +1,80 @@
+#ifndef PlasmaMLPALLASLinearOptics_h
+#define PlasmaMLPALLASLinearOptics_h 1
+
+/**
+ * @class PlasmaMLPALLASLinearOptics
+ * @brief Thick-lens transport of a charged particle through the quadrupole lattice.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The particle is carried along y from its position to just after the last
+ * quadrupole of the lattice of a PlasmaMLPALLASMagneticField, through exact
+ * straight drifts and the hard-edge quadrupole field of GetFieldValue
+ * (Bx = G z, Bz = -G x), which gives x'' = -k x and z'' = -k z with
+ * k = q c G / p. The strength is computed with the momentum of each
+ * particle, so the chromatic terms are included at all orders; the map is
+ * linear in the transverse coordinates (paraxial approximation).
+ *
+ * The transport is refused (and the particle left to Geant4) when it does
+ * not move forward, starts past the entrance of the first quadrupole, or crosses a quadrupole
+ * outside its field aperture or outside its volume.
+ */
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "CLHEP/Units/SystemOfUnits.h"
+#include <vector>
+
+class PlasmaMLPALLASMagneticField;
+
+class PlasmaMLPALLASLinearOptics
+{
+public:
+    /** Position and direction at an entrance or exit of a quadrupole */
+    struct Crossing {
+        size_t index = 0;          ///< Quadrupole index (0 for Q1)
+        G4bool begin = true;       ///< Entrance (true) or exit (false)
+        G4ThreeVector position;    ///< Global position
+        G4ThreeVector direction;   ///< Unit momentum direction
+    };
+
+    /** Outcome of a transport */
+    struct Result {
+        std::vector<Crossing> crossings;  ///< Quadrupole entrances and exits, along the beam
+        G4ThreeVector position;           ///< Position on the hand-off plane
+        G4ThreeVector direction;          ///< Unit momentum direction on the hand-off plane
+        G4double pathLength = 0.;         ///< Length of the trajectory
+    };
+
+    /**
+     * @brief Constructor.
+     * @param field Field providing the lattice (read at each transport)
+     * @param volumeHalfWidths Half width of the square quadrupole volumes, rotated by 45 degrees around y, by index
+     */
+    PlasmaMLPALLASLinearOptics(const PlasmaMLPALLASMagneticField* field, std::vector<G4double> volumeHalfWidths);
+
+    /**
+     * @brief Transport a particle to the hand-off plane.
+     * @param position Global start position
+     * @param direction Unit momentum direction
+     * @param charge Charge (eplus)
+     * @param momentum Momentum magnitude
+     * @param result Output crossings and final state
+     * @return False if the particle must be tracked by Geant4 instead (result not usable)
+     */
+    G4bool Transport(const G4ThreeVector& position, const G4ThreeVector& direction,
+                     G4double charge, G4double momentum, Result& result) const;
+
+    /** Distance after the exit of the last quadrupole where the particle is handed back to Geant4 */
+    static constexpr G4double HandOffDistance = 1. * CLHEP::mm;
+
+    /** Distance past the entrance of the first quadrupole still accepted as a start (particle on its boundary) */
+    static constexpr G4double StartTolerance = 1e-6 * CLHEP::mm;
+
+private:
+    const PlasmaMLPALLASMagneticField* fField = nullptr;
+    std::vector<G4double> fVolumeHalfWidths;
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef PlasmaMLPALLASLinearOpticsModel_h
+#define PlasmaMLPALLASLinearOpticsModel_h 1
+
+/**
+ * @class PlasmaMLPALLASLinearOpticsModel
+ * @brief Fast simulation model carrying primaries through the quadrupole lattice with transfer matrices.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The envelope is the Q1 volume. When a charged primary enters it, the model
+ * transports it with PlasmaMLPALLASLinearOptics to just after the last
+ * quadrupole, fills the same quadrupole tallies as the quadrupole detector and
+ * moves the track there, where Geant4 takes over (dipole, screens, any
+ * material). Particles the matrices cannot handle (outside an aperture or a
+ * volume) are left to Geant4 from the Q1 entrance.
+ *
+ * Modes (/PlasmaMLPALLAS/field/setStatusLinearOptics):
+ *  - 0: off, full Geant4 tracking
+ *  - 1: matrices through the lattice, Geant4 afterwards
+ *  - 2: matrices through the lattice, then the primary is killed (quadrupole
+ *       tallies only, for gradient tuning)
+ */
+
+#include "G4VFastSimulationModel.hh"
+#include "PlasmaMLPALLASLinearOptics.hh"
+
+class PlasmaMLPALLASGeometryConstruction;
+
+class PlasmaMLPALLASLinearOpticsModel : public G4VFastSimulationModel
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param name Model name
+     * @param envelope Region holding the Q1 volume
+     * @param field Field of the thread, providing the lattice
+     * @param volumeHalfWidths Half widths of the Q1..Q4 volumes
+     * @param geometry Geometry providing the mode
+     */
+    PlasmaMLPALLASLinearOpticsModel(const G4String& name, G4Region* envelope,
+                                    const PlasmaMLPALLASMagneticField* field,
+                                    std::vector<G4double> volumeHalfWidths,
+                                    const PlasmaMLPALLASGeometryConstruction* geometry);
+
+    /** Charged particles only */
+    G4bool IsApplicable(const G4ParticleDefinition& particle) override;
+
+    /** Primaries entering the lattice, when the transport succeeds */
+    G4bool ModelTrigger(const G4FastTrack& fastTrack) override;
+
+    /** Fill the quadrupole tallies and move (or kill) the primary */
+    void DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep) override;
+
+private:
+    PlasmaMLPALLASLinearOptics fOptics;
+    const PlasmaMLPALLASGeometryConstruction* fGeometry = nullptr;
+    PlasmaMLPALLASLinearOptics::Result fResult; ///< Transport computed by the last successful trigger
+};
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef PlasmaMLPALLASMPIDriver_h
+#define PlasmaMLPALLASMPIDriver_h 1
+
+/**
+ * @class PlasmaMLPALLASMPIDriver
+ * @brief Events of one job shared by the MPI ranks of an allocation, in chunks handed out on demand.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * Launched with mpirun, every rank is a full multi-threaded (or task-based)
+ * application running the same macro. /PlasmaMLPALLAS/mpi/beamOn N, which
+ * replaces the final /run/beamOn of the batch mode when there is more than
+ * one rank, splits the N events into chunks of setChunkEvents events:
+ *  - each rank takes the next chunk from a counter held by rank 0 (MPI
+ *    one-sided fetch-and-add), so fast ranks simulate more chunks than
+ *    ranks stuck in showering events, without any dispatcher;
+ *  - a chunk is one run writing and closing its own file (the output file
+ *    suffixed by _chunk<k>, see PlasmaMLPALLASOutputManager), seeded from
+ *    the seed of the job and the chunk index: the events do not depend on
+ *    the rank that simulated them;
+ *  - rank 0 merges the chunk files into the output file once all the
+ *    chunks are done, then removes them.
+ *
+ * The chunk files must be on a file system shared by the ranks. The first
+ * event of each chunk is published in the run configuration, so that the
+ * phase-space file is read on from there.
+ *
+ * Without PLASMAMLPALLAS_WITH_MPI (CMake option WITH_MPI) the process is the
+ * only rank and the job runs its chunks one after the other.
+ *
+ * The singleton is created by main, which owns the MPI environment, and owns
+ * the /PlasmaMLPALLAS/mpi/ commands.
+ */
+
+#include "globals.hh"
+#include <atomic>
+
+class PlasmaMLPALLASMPIMessenger;
+
+class PlasmaMLPALLASMPIDriver
+{
+public:
+    /**
+     * @brief Access the singleton instance.
+     * @return Reference to the process-wide MPI driver.
+     */
+    static PlasmaMLPALLASMPIDriver& Instance();
+
+    /**
+     * @brief Initialise MPI (once, before Geant4) and read the rank of the process.
+     * @param argc Pointer to the number of command-line arguments
+     * @param argv Pointer to the command-line arguments
+     */
+    void Initialize(int* argc, char*** argv);
+
+    /** @brief Finalise MPI (once, at the end of main). */
+    void Finalize();
+
+    /**
+     * @brief Run a job of N events shared by all the ranks (collective: every rank calls it).
+     * @param nEvents Number of events of the whole job
+     */
+    void Run(G4long nEvents);
+
+    /** Default output name of the job (name of the command line) */
+    void SetOutputName(const G4String& name) { fOutputName = name; }
+
+    /** Events per chunk */
+    void SetChunkEvents(G4int events) { fChunkEvents = events > 0 ? events : 1; }
+    G4int GetChunkEvents() const { return fChunkEvents; }
+
+    /** Seed of the job, 0 to draw it from the clock of rank 0 */
+    void SetSeed(G4long seed) { fSeed = seed; }
+    G4long GetSeed() const { return fSeed; }
+
+    /// @name Accessors for main and the run actions
+    ///@{
+    G4int GetRank() const { return fRank; }                      /**< Rank of the process (0 without MPI) */
+    G4int GetSize() const { return fSize; }                      /**< Number of ranks (1 without MPI) */
+    G4bool IsDistributed() const { return fSize > 1; }           /**< Whether the job spans several ranks */
+    G4bool IsRunning() const { return fRunning.load(); }         /**< Whether a distributed job is in progress */
+    G4long GetEventOffset() const { return fEventOffset.load(); } /**< Events of the job before the running chunk (0 outside a job) */
+    G4bool HasRun() const { return fHasRun; }                    /**< Whether a job has been run in this process */
+    ///@}
+
+private:
+    PlasmaMLPALLASMPIDriver();
+    ~PlasmaMLPALLASMPIDriver();
+
+    PlasmaMLPALLASMPIDriver(const PlasmaMLPALLASMPIDriver&) = delete;            /**< Delete copy constructor */
+    PlasmaMLPALLASMPIDriver& operator=(const PlasmaMLPALLASMPIDriver&) = delete; /**< Delete assignment operator */
+
+    G4String fOutputName;             /**< Default output name of the job */
+    G4int fChunkEvents = 10000;       /**< Events per chunk */
+    G4long fSeed = 0;                 /**< Seed of the job, 0 for the clock */
+    G4int fRank = 0;                  /**< Rank of the process */
+    G4int fSize = 1;                  /**< Number of ranks */
+    G4bool fInitialized = false;      /**< MPI initialised by Initialize() */
+    G4bool fHasRun = false;           /**< A job has been run */
+
+    // Read by the run actions and the generators of every thread
+    std::atomic<G4bool> fRunning{false};      /**< A distributed job is in progress */
+    std::atomic<G4long> fEventOffset{0};      /**< First event of the running chunk in the job */
+
+    PlasmaMLPALLASMPIMessenger* fMessenger = nullptr; /**< UI commands /PlasmaMLPALLAS/mpi/ */
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef PlasmaMLPALLASMPIMessenger_H
+#define PlasmaMLPALLASMPIMessenger_H
+
+/**
+ * @class PlasmaMLPALLASMPIMessenger
+ * @brief Provides UI commands to share the events of a job between MPI ranks
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * This class sets the size of the chunks handed out to the ranks and the
+ * seed of the job, and runs the job. The commands are created by the master
+ * and act on the process-wide PlasmaMLPALLASMPIDriver, so they are not
+ * broadcast to the worker threads.
+ */
+
+#include "G4UIcommand.hh"
+#include "G4UIcmdWithAnInteger.hh"                 // for G4UIcmdWithAnInteger
+#include "G4UIdirectory.hh"                        // for G4UIdirectory
+#include "G4UImessenger.hh"
+
+class G4UIcmdWithAnInteger;
+class G4UIcommand;
+class G4UIdirectory;
+
+class PlasmaMLPALLASMPIDriver;
+
+class PlasmaMLPALLASMPIMessenger : public G4UImessenger
+{
+public:
+    /**
+     * @brief Constructor
+     * @param driver Pointer to the MPI driver
+     */
+    PlasmaMLPALLASMPIMessenger(PlasmaMLPALLASMPIDriver *driver);
+
+    /// Destructor
+    ~PlasmaMLPALLASMPIMessenger();
+
+    /**
+     * @brief Executes a command with a new value
+     * @param command Pointer to the issued command
+     * @param newValue String representation of the new value
+     */
+    virtual void SetNewValue(G4UIcommand *command, G4String newValue) final;
+
+    /**
+     * @brief Retrieves the current value of a command
+     * @param command Pointer to the command
+     * @return String representing the current value
+     */
+    virtual G4String GetCurrentValue(G4UIcommand *command) final;
+
+private:
+    /// Associated MPI driver
+    PlasmaMLPALLASMPIDriver *fDriver = nullptr;
+
+    G4UIdirectory *fMPIDir = nullptr;                 ///< Directory /PlasmaMLPALLAS/mpi
+
+    G4UIcmdWithAnInteger *fSetChunkEventsCmd = nullptr; ///< Set the events per chunk
+    G4UIcmdWithAnInteger *fSetSeedCmd = nullptr;      ///< Set the seed of the job
+    G4UIcmdWithAnInteger *fBeamOnCmd = nullptr;       ///< Run the job on all the ranks
+};
+
+#endif
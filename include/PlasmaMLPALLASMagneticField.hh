@@ -15,11 +15,15 @@
  * Responsibilities:
  *  - Store and provide access to magnetic field parameters (dipole strength, quadrupole gradients, lengths, drifts)
  *  - Compute the field value at any given point for use in particle tracking
- *  - Allow toggling between constant-field mode and mapped-field mode
- *  - Provide fitting functions for magnetic field profile parameterization
+ *  - Allow toggling between constant-field mode, fitted-profile mode and a
+ *    measured 3D map shared by all threads
+ *  - Provide fitting functions for magnetic field profile parameterization,
+ *    tabulated once on regular grids for the mapped-field mode
  *
  * Key features:
- *  - Configurable for up to four quadrupoles (`NumQuadrupoles`)
+ *  - Lattice of any number of quadrupoles (`NumQuadrupoles` in the baseline
+ *    PALLAS beamline), sorted once when the parameters are set and searched
+ *    by bisection along the beam axis
  *  - Units consistent with CLHEP system (tesla, mm, etc.)
  *  - Command interface for runtime parameter changes
  *
@@ -29,12 +33,115 @@
 
 // --- Includes ---
 #include "G4MagneticField.hh"       ///< Base class for defining a magnetic field in Geant4
-#include <array>                    ///< For fixed-size gradient and length storage
+#include "PlasmaMLPALLASFieldMap.hh" ///< Shared measured 3D dipole map
+#include "PlasmaMLPALLASFieldParameters.hh" ///< Settings pushed between runs
+#include "PlasmaMLPALLASFieldStatistics.hh" ///< Optional per-region call counters
+#include <algorithm>                ///< For std::min / std::max in the profile interpolation
+#include <array>                    ///< For the bounding boxes
+#include <memory>                   ///< For the shared field map
+#include <vector>                   ///< For the lattice and the tabulated profile samples
 #include <CLHEP/Units/SystemOfUnits.h> ///< Units definitions (T, mm, etc.)
 
-/// Number of quadrupoles in the beamline model
+/// Number of quadrupoles in the baseline PALLAS beamline model
 constexpr size_t NumQuadrupoles = 4;
 
+/// Half-width of the square quadrupole aperture in x and z: the gradients
+/// only apply for -20 < x < 20 and -20 < z < 20 mm (open bounds), as in the
+/// original sequential Q1..Q4 tests of GetFieldValue
+constexpr G4double QuadrupoleHalfAperture = 20. * CLHEP::mm;
+
+/**
+ * @struct LatticeElement
+ * @brief One quadrupole of the lattice, at its absolute position along y.
+ */
+struct LatticeElement {
+    G4double begin = 0.;     ///< Entrance along y (mm)
+    G4double end = 0.;       ///< Exit along y (mm)
+    G4double gradient = 0.;  ///< Gradient (Geant4 units)
+    size_t index = 0;        ///< Quadrupole index (0-based)
+};
+
+/**
+ * @struct FieldBox
+ * @brief Axis-aligned bounding box of one field source.
+ *
+ * Outside every box the field is zero. A box is exclusive when no source of
+ * higher precedence (a quadrupole for the dipole) overlaps it, so that a
+ * point found inside it needs no further search. A field-free box is a slab
+ * along y between two sources, cached to skip the search in the drifts.
+ */
+struct FieldBox {
+    std::array<G4double, 3> min{};               ///< Lower corner (mm)
+    std::array<G4double, 3> max{};               ///< Upper corner (mm), excluded
+    const LatticeElement* quad = nullptr;        ///< Quadrupole of the box, nullptr for the dipole
+    G4bool exclusive = true;                     ///< No source of higher precedence overlaps the box
+    G4bool field = true;                         ///< False for a field-free slab
+
+    /** Whether a point [x, y, z] lies in the box */
+    G4bool Contains(const G4double point[3]) const
+    {
+        return point[0] >= min[0] && point[0] < max[0] && point[1] >= min[1] && point[1] < max[1] &&
+               point[2] >= min[2] && point[2] < max[2];
+    }
+};
+
+/**
+ * @class PlasmaMLPALLASFieldProfile
+ * @brief One-dimensional field profile tabulated on a regular grid.
+ *
+ * The profile is sampled once from an analytic function and then evaluated
+ * with a linear interpolation that has no data-dependent branch: the index is
+ * clamped into the table and points outside the range are zeroed by a select.
+ * The table is immutable after construction, so one instance can be read
+ * concurrently by all the threads.
+ */
+class PlasmaMLPALLASFieldProfile
+{
+public:
+    /**
+     * @brief Sample a function on a regular grid.
+     * @param xmin First node (mm)
+     * @param xmax Last node (mm)
+     * @param step Grid spacing (mm)
+     * @param f Function of the position in mm
+     */
+    template <typename F>
+    PlasmaMLPALLASFieldProfile(G4double xmin, G4double xmax, G4double step, F f)
+        : fMin(xmin), fMax(xmax)
+    {
+        const size_t n = std::max<size_t>(2, static_cast<size_t>((xmax - xmin) / step + 0.5) + 1);
+        fInvStep = (n - 1) / (xmax - xmin);
+        fValues.resize(n);
+        for (size_t i = 0; i < n; ++i)
+            fValues[i] = f(xmin + i / fInvStep);
+    }
+
+    /**
+     * @brief Interpolated value of the profile.
+     * @param x Position (mm)
+     * @return Profile value, 0 outside [xmin, xmax]
+     */
+    G4double Value(G4double x) const
+    {
+        const G4double last = G4double(fValues.size() - 1);
+        const G4double t = (x - fMin) * fInvStep;
+        const G4double tc = std::min(std::max(t, 0.), last);
+        const size_t i = std::min(static_cast<size_t>(tc), fValues.size() - 2);
+        const G4double v = fValues[i] + (tc - i) * (fValues[i + 1] - fValues[i]);
+        return (t >= 0. && t <= last) ? v : 0.;
+    }
+
+    G4double GetMin() const { return fMin; }                  /**< First node (mm) */
+    G4double GetMax() const { return fMax; }                  /**< Last node (mm) */
+    size_t GetSize() const { return fValues.size(); }         /**< Number of nodes */
+
+private:
+    G4double fMin = 0.;            ///< First node (mm)
+    G4double fMax = 0.;            ///< Last node (mm)
+    G4double fInvStep = 1.;        ///< Inverse of the grid spacing (1/mm)
+    std::vector<G4double> fValues; ///< Profile at the nodes
+};
+
 /**
  * @class PlasmaMLPALLASMagneticField
  * @brief Implements the PALLAS magnetic field configuration for dipole and quadrupole elements.
@@ -66,51 +173,99 @@ public:
 
     /**
      * @brief Set the gradient of a quadrupole.
-     * @param index Quadrupole index (0-based, < NumQuadrupoles)
+     * @param index Quadrupole index (0-based); the lattice grows if needed
      * @param gradient Gradient value in tesla/meter
      */
     void SetGradient(size_t index, G4double gradient);
 
+    /**
+     * @brief Set the dipole field, the gradients and the drifts of Q1..Q4 at once.
+     * @param parameters Snapshot published by the geometry
+     * @return True if any value changed
+     *
+     * Unlike the single setters, nothing is printed and the lattice is
+     * rebuilt once, only if a gradient or a drift changed.
+     */
+    G4bool SetParameters(const PlasmaMLPALLASFieldParameters& parameters);
+
+    /**
+     * @brief Append a quadrupole after the last one of the lattice.
+     * @param drift Distance from the exit of the previous quadrupole (mm)
+     * @param length Length (mm)
+     * @param gradient Gradient (tesla/meter)
+     */
+    void AddQuadrupole(G4double drift, G4double length, G4double gradient);
+
+    /** Number of quadrupoles of the lattice */
+    size_t GetNumberOfQuadrupoles() const { return gradients.size(); }
+
+    /** Lattice sorted along y */
+    const std::vector<LatticeElement>& GetLattice() const { return fLattice; }
+
+    /** Bounding boxes of the quadrupoles (lattice order) and of the dipole (last, if any) */
+    const std::vector<FieldBox>& GetFieldBoxes() const { return fBoxes; }
+
     /**
      * @brief Get the gradient of a quadrupole.
-     * @param index Quadrupole index (0-based, < NumQuadrupoles)
+     * @param index Quadrupole index (0-based, < GetNumberOfQuadrupoles())
      * @return Gradient value in tesla/meter
      */
     G4double GetGradient(size_t index) const;
 
     /**
      * @brief Set the length of a quadrupole.
-     * @param index Quadrupole index (0-based, < NumQuadrupoles)
+     * @param index Quadrupole index (0-based); the lattice grows if needed
      * @param length Length in mm
      */
     void SetQLength(size_t index, G4double length);
 
     /**
      * @brief Get the length of a quadrupole.
-     * @param index Quadrupole index (0-based, < NumQuadrupoles)
+     * @param index Quadrupole index (0-based, < GetNumberOfQuadrupoles())
      * @return Length in mm
      */
     G4double GetQLength(size_t index) const;
 
     /**
      * @brief Set the drift distance before a quadrupole.
-     * @param index Quadrupole index (0-based, < NumQuadrupoles)
+     * @param index Quadrupole index (0-based); the lattice grows if needed
      * @param drift Distance in mm
      */
     void SetQDrift(size_t index, G4double drift);
 
     /**
      * @brief Get the drift distance before a quadrupole.
-     * @param index Quadrupole index (0-based, < NumQuadrupoles)
+     * @param index Quadrupole index (0-based, < GetNumberOfQuadrupoles())
      * @return Drift distance in mm
      */
     G4double GetQDrift(size_t index) const;
 
     /**
-     * @brief Enable or disable mapped magnetic field usage.
-     * @param val True to use a field map, false for constant/parameterized fields
+     * @brief Select the dipole field model.
+     * @param val 0 for the constant dipole, 1 for the fitted profiles, 2 for the 3D field map
+     */
+    void SetMapBFieldStatus(G4int val);
+
+    /**
+     * @brief Set the measured 3D dipole map used with status 2.
+     * @param map Map shared by the fields of all threads
+     */
+    void SetFieldMap(std::shared_ptr<const PlasmaMLPALLASFieldMap> map);
+
+    /**
+     * @brief Compare the tabulated dipole profiles with the analytic fits.
+     * @param nSamples Number of positions tested in each profile
+     *
+     * Prints the maximum and RMS deviations of each profile, and of their
+     * product, over the tabulated ranges.
+     */
+    static void ValidateDipoleProfiles(size_t nSamples);
+
+    /**
+     * @brief Count the field calls per region.
+     * @param statistics Counters of the thread owning this field (nullptr to stop counting)
      */
-    void SetMapBFieldStatus(G4bool val);
+    void SetStatistics(PlasmaMLPALLASFieldStatistics* statistics) { fStatistics = statistics; }
 
 private:
     /**
@@ -120,11 +275,58 @@ private:
      */
     void DefineCommands();
 
+    /**
+     * @brief Make room for quadrupole index in the parameter arrays.
+     */
+    void Reserve(size_t index);
+
+    /**
+     * @brief Rebuild the sorted lattice from the drifts, lengths and gradients.
+     */
+    void UpdateLattice();
+
+    /**
+     * @brief Rebuild the bounding boxes from the lattice and the dipole model.
+     */
+    void UpdateBoxes();
+
+    /**
+     * @brief Find the source containing a point.
+     * @param point Position [x, y, z] (mm)
+     * @return Box of the source of highest precedence, or nullptr outside every source
+     */
+    const FieldBox* FindBox(const G4double point[3]) const;
+
+    /**
+     * @brief Field-free slab along y around a point outside every source.
+     * @param y Position along the beam axis (mm)
+     * @return The slab, or nullptr if a source spans y (point beside it in x or z)
+     */
+    const FieldBox* FindDriftSlab(G4double y) const;
+
+    /**
+     * @brief Find the quadrupole containing a position along y.
+     * @param y Position along the beam axis (mm)
+     * @return Element of the lattice, or nullptr in a drift
+     */
+    const LatticeElement* FindQuadrupole(G4double y) const;
+
     G4double ConstantDipoleBField = 0.0 * CLHEP::tesla; ///< Constant dipole field value
-    std::array<G4double, NumQuadrupoles> gradients = {}; ///< Quadrupole gradients [T/m]
-    std::array<G4double, NumQuadrupoles> qlength = {};   ///< Quadrupole lengths [mm]
-    std::array<G4double, NumQuadrupoles> qdrift = {};    ///< Quadrupole drifts [mm]
-    G4bool StatusMapBField = false;                      ///< Mapped-field usage flag
+    std::vector<G4double> gradients = std::vector<G4double>(NumQuadrupoles, 0.); ///< Quadrupole gradients [T/m]
+    std::vector<G4double> qlength = std::vector<G4double>(NumQuadrupoles, 0.);   ///< Quadrupole lengths [mm]
+    std::vector<G4double> qdrift = std::vector<G4double>(NumQuadrupoles, 0.);    ///< Quadrupole drifts [mm]
+    std::vector<LatticeElement> fLattice;                ///< Quadrupoles sorted by entrance along y
+    std::vector<FieldBox> fBoxes;                        ///< Bounding boxes of the field sources
+    /// Box of the last exclusive hit: one field per thread, so no sharing
+    mutable const FieldBox* fLastBox = nullptr;
+    /// Field-free slab of the last drift hit (pointed to by fLastBox)
+    mutable FieldBox fDriftSlab;
+    G4int StatusMapBField = 0;                           ///< Dipole model (0 constant, 1 fit, 2 3D map)
+    std::shared_ptr<const PlasmaMLPALLASFieldMap> fFieldMap; ///< Shared 3D dipole map (status 2)
+    PlasmaMLPALLASFieldStatistics* fStatistics = nullptr; ///< Call counters of the thread (optional)
+
+    const PlasmaMLPALLASFieldProfile &fProfileS;         ///< Dipole profile along the beam (y, mm)
+    const PlasmaMLPALLASFieldProfile &fProfileY;         ///< Dipole profile across the gap (z, mm)
 };
 
 /**
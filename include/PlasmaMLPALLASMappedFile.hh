@@ -0,0 +1,50 @@
+#ifndef PlasmaMLPALLASMappedFile_h
+#define PlasmaMLPALLASMappedFile_h 1
+
+/**
+ * @class PlasmaMLPALLASMappedFile
+ * @brief Read-only memory mapping of a whole file (RAII).
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The file is mapped once and shared by every thread reading it: pages are
+ * loaded on demand by the kernel and shared through the page cache, so large
+ * binary inputs are neither copied per thread nor read upfront. The mapping
+ * is released when the object is destroyed.
+ */
+
+#include "globals.hh"
+#include <cstddef>
+
+class PlasmaMLPALLASMappedFile
+{
+public:
+    /**
+     * @brief Map a file in read-only mode
+     * @param path File to map
+     *
+     * On failure, IsOpen() returns false and GetError() describes the problem.
+     */
+    explicit PlasmaMLPALLASMappedFile(const G4String& path);
+
+    /// Unmap the file
+    ~PlasmaMLPALLASMappedFile();
+
+    PlasmaMLPALLASMappedFile(const PlasmaMLPALLASMappedFile&) = delete;            /**< Delete copy constructor */
+    PlasmaMLPALLASMappedFile& operator=(const PlasmaMLPALLASMappedFile&) = delete; /**< Delete assignment operator */
+
+    bool IsOpen() const { return fData != nullptr; }           /**< True if the file is mapped */
+    const char* GetData() const { return fData; }              /**< Start of the mapped region */
+    size_t GetSize() const { return fSize; }                   /**< Size of the mapped region (bytes) */
+    const G4String& GetPath() const { return fPath; }          /**< Path of the mapped file */
+    const G4String& GetError() const { return fError; }        /**< Reason of the failure, if any */
+
+private:
+    G4String fPath;                 /**< Path of the mapped file */
+    G4String fError;                /**< Reason of the failure, if any */
+    const char* fData = nullptr;    /**< Start of the mapped region */
+    size_t fSize = 0;               /**< Size of the mapped region (bytes) */
+};
+
+#endif
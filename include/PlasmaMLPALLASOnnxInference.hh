@@ -11,56 +11,173 @@
 
 #include <onnxruntime_cxx_api.h>
 #include "globals.hh"
+#include <memory>
+#include <array>
+#include <string>
+#include <vector>
 
 /**
- * @struct BeamParameters
- * @brief Structure storing the physical parameters of a generated beam.
+ * @brief One row of model inputs: laser focal position, normalized amplitude,
+ *        plasma density and gas pressure, in this order.
  */
-struct BeamParameters {
-    G4double Ekin;   ///< Kinetic energy of the beam particle
-    G4double dEkin;  ///< Energy spread
+using OnnxInputRow = std::array<G4double, 4>;
+
+/**
+ * @struct OnnxGridAxis
+ * @brief Regularly spaced values of one model input used to build a scan grid.
+ */
+struct OnnxGridAxis {
+    G4double min = 0.;  ///< First value of the axis
+    G4double max = 0.;  ///< Last value of the axis
+    size_t n = 1;       ///< Number of points (a single point uses min)
+
+    /**
+     * @brief Value of point i of the axis
+     */
+    G4double Value(size_t i) const;
+
+    /**
+     * @brief Parse an axis specification
+     * @param spec Either a single value or "min:max:n"
+     * @param axis Parsed axis
+     * @return True if the specification is valid
+     */
+    static bool Parse(const std::string& spec, OnnxGridAxis& axis);
+
+    /**
+     * @brief Number of points of the cartesian product of four axes
+     */
+    static size_t GridSize(const std::array<OnnxGridAxis, 4>& axes);
+
+    /**
+     * @brief Input row of one point of the cartesian product of four axes
+     * @param axes Grid axes for Xoff, A0, CN2 and Pressure
+     * @param index Point index, Pressure varying fastest and Xoff slowest
+     */
+    static OnnxInputRow GridPoint(const std::array<OnnxGridAxis, 4>& axes, size_t index);
+};
+
+/**
+ * @struct BeamMoments
+ * @brief Beam moments predicted by the ONNX model for one set of laser/plasma inputs.
+ *
+ * These values only depend on the model inputs, so they are shared by every
+ * primary generated with the same laser/plasma configuration.
+ */
+struct BeamMoments {
+    G4double Ekin;   ///< Mean kinetic energy of the beam
+    G4double dEkin;  ///< Relative energy spread
     G4double Q;      ///< Beam charge
     G4double epsb;   ///< Beam emittance
-    G4double x;      ///< X position
-    G4double xp;     ///< X momentum component
-    G4double z;      ///< Z position
-    G4double zp;     ///< Z momentum component
 };
 
+struct PlasmaMLPALLASOnnxModel;
+
 /**
  * @class PlasmaMLPALLASOnnxInference
  * @brief Class for performing ONNX model inference to generate plasma beam parameters.
  *
- * This class wraps an ONNX runtime session and provides a convenient
- * interface for generating beam parameters given laser and plasma conditions.
+ * This class is a per-thread run context on top of the process-wide
+ * PlasmaMLPALLASOnnxSession. It provides a convenient interface for generating
+ * beam parameters given laser and plasma conditions and holds the per-thread
+ * state (moment cache, memory info); the model itself is shared.
  */
 class PlasmaMLPALLASOnnxInference {
 public:
     /**
      * @brief Constructor
-     * @param modelPath Path to the ONNX model file
      *
-     * Initializes the ONNX runtime environment and loads the specified model.
+     * The model is not loaded here: the shared session is acquired on the
+     * first inference, with the options set through /PlasmaMLPALLAS/onnx/.
+     */
+    PlasmaMLPALLASOnnxInference();
+
+    /**
+     * @brief Predict the beam moments for N input rows with a single session run
+     * @param inputs Laser/plasma input rows
+     * @return One BeamMoments per input row, in the same order
+     *
+     * This bypasses the single-point cache used by PredictMoments().
+     */
+    std::vector<BeamMoments> PredictMomentsBatch(const std::vector<OnnxInputRow>& inputs);
+
+    /**
+     * @brief Predict the moments of a full input grid and write them to a CSV file
+     * @param axes Grid axes for Xoff, A0, CN2 and Pressure
+     * @param fileName Output CSV file
+     * @param batchSize Maximum number of rows sent to the model in one run
+     * @return Number of grid points written
+     *
+     * No Geant4 event is needed: this is meant to pre-screen working points.
      */
-    PlasmaMLPALLASOnnxInference(const std::string& modelPath);
+    size_t DumpMomentsGrid(const std::array<OnnxGridAxis, 4>& axes, const std::string& fileName, size_t batchSize = 4096);
 
     /**
-     * @brief Generate beam parameters using the ONNX model
+     * @brief Predict the beam moments for a laser/plasma configuration
      * @param fXof Laser focal position
      * @param fA0 Laser normalized amplitude
      * @param fCN2 Plasma density
      * @param fPressure Gas pressure
-     * @return BeamParameters structure with the generated beam values
+     * @return Beam moments in physical units
+     *
+     * The ONNX session is only run when the rescaled inputs differ from the
+     * previous call; otherwise the cached moments are returned directly.
+     */
+    const BeamMoments& PredictMoments(G4double fXof, G4double fA0, G4double fCN2, G4double fPressure);
+
+    /**
+     * @brief Discard the cached moments so that the next prediction runs the model
+     */
+    void ClearCache() { cacheValid = false; }
+
+    /**
+     * @brief Get the number of times the ONNX session has actually been run
      */
-    BeamParameters GenerateBeam(G4double fXof, G4double fA0, G4double fCN2, G4double fPressure);
+    size_t GetNumberOfInferences() const { return nInferences; }
 
 private:
-    Ort::Env env;                           ///< ONNX runtime environment
-    Ort::SessionOptions sessionOptions;     ///< Session options for ONNX runtime
-    std::unique_ptr<Ort::Session> session;  ///< ONNX runtime session for inference
+    /**
+     * @brief Run the ONNX session on one rescaled input row through the pre-bound tensors
+     * @param rescaledInputs Model inputs normalised between 0 and 1
+     * @return Beam moments in physical units
+     *
+     * Inputs and outputs live in per-thread buffers bound once with Ort::IoBinding,
+     * so this path does not allocate once the binding exists.
+     */
+    BeamMoments RunSingle(const std::array<G4double, 4>& rescaledInputs);
+
+    /**
+     * @brief Run the ONNX session on rescaled inputs and convert the outputs to physical units
+     * @param rescaledInputs Row-major [nRows x 4] model inputs normalised between 0 and 1
+     * @param nRows Number of input rows
+     * @param moments Output moments, resized to nRows
+     */
+    void RunInference(std::vector<double>& rescaledInputs, size_t nRows, std::vector<BeamMoments>& moments);
+
+    /**
+     * @brief Bind the per-thread single-row buffers to a (new) shared model
+     * @param model Model used for the following inferences
+     */
+    void BindModel(const std::shared_ptr<PlasmaMLPALLASOnnxModel>& model);
+
     Ort::MemoryInfo memoryInfo;             ///< Memory information for input/output
-    std::vector<const char*> inputNodeNames;///< Names of input nodes in the ONNX model
-    std::vector<const char*> outputNodeNames;///< Names of output nodes in the ONNX model
+    Ort::RunOptions runOptions;             ///< Run options reused for every inference
+
+    std::shared_ptr<PlasmaMLPALLASOnnxModel> boundModel; ///< Model the binding refers to
+    std::unique_ptr<Ort::IoBinding> ioBinding;           ///< Binding of the single-row buffers
+    std::array<double, 4> inputBufferDouble{};           ///< Single-row input (double models)
+    std::array<float, 4> inputBufferFloat{};             ///< Single-row input (float models)
+    std::array<double, 4> outputBufferDouble{};          ///< Single-row output (double models)
+    std::array<float, 4> outputBufferFloat{};            ///< Single-row output (float models)
+    Ort::Value inputTensor{nullptr};                     ///< Tensor wrapping the single-row input buffer
+    Ort::Value outputTensor{nullptr};                    ///< Tensor wrapping the single-row output buffer
+    std::vector<float> batchInputFloat;                  ///< Float copy of batched inputs (float models)
+
+    std::array<G4double, 4> cachedInputs{};  ///< Rescaled inputs of the cached prediction
+    BeamMoments cachedMoments{};             ///< Moments predicted for cachedInputs
+    G4bool cacheValid = false;               ///< True once cachedMoments holds a prediction
+    size_t cachedVersion = 0;                ///< Shared session version used for cachedMoments
+    size_t nInferences = 0;                  ///< Number of ONNX session runs
 };
 
 #endif
@@ -3,100 +3,113 @@
 
 /**
  * @class OnnxParameters
- * @brief Singleton class to manage ONNX beam parameters in a thread-safe way.
+ * @brief Per-thread staging area of the beam parameters set from the UI.
  * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
  * @date 2025
  * @copyright PALLAS Project - GEANT4 Collaboration
  *
- * This class provides thread-safe getters and setters for parameters used by 
- * ONNX models. It ensures that updates and reads are synchronized across multiple threads.
+ * The generator commands are broadcast, so each thread replays them on its
+ * own instance before its run starts: no locking is needed. The values are
+ * never read during the event loop; they are frozen once per run into an
+ * immutable PlasmaMLPALLASRunConfig snapshot at BeginOfRunAction.
  */
 
-#include <atomic>
+#include <string>
 
 class OnnxParameters {
 public:
     /**
-     * @brief Access the singleton instance.
-     * @return Reference to the singleton instance of OnnxParameters.
+     * @brief Access the instance of the calling thread.
+     * @return Reference to the thread-local instance of OnnxParameters.
      */
     static OnnxParameters& Instance() {
-        static OnnxParameters instance;
+        static thread_local OnnxParameters instance;
         return instance;
     }
 
-    /// @name Thread-safe setters
+    /// @name Setters
     ///@{
-    void SetStatusONNX(int status) {
-        std::lock_guard<std::mutex> lock(updateMutex);
-        StatusONNX.store(status, std::memory_order_release);
-    }
-
-    void SetXoff(double x) {
-        std::lock_guard<std::mutex> lock(updateMutex);
-        Xoff.store(x, std::memory_order_release);
-    }
+    void SetStatusONNX(int status) { StatusONNX = status; }
+    void SetXoff(double x) { Xoff = x; }
+    void SetA0(double a0) { A0 = a0; }
+    void SetCN2(double cn2) { CN2 = cn2; }
+    void SetPressure(double p) { Pressure = p; }
 
-    void SetA0(double a0) {
-        std::lock_guard<std::mutex> lock(updateMutex);
-        A0.store(a0, std::memory_order_release);
+    /**
+     * @brief Set the Twiss parameters of the sampled source in the x plane.
+     * @param alpha Twiss alpha
+     * @param beta Twiss beta (Geant4 length units)
+     * @param ratio Emittance of the plane relative to the predicted epsb
+     */
+    void SetTwissX(double alpha, double beta, double ratio) {
+        AlphaX = alpha;
+        BetaX = beta;
+        EmittanceRatioX = ratio;
     }
 
-    void SetCN2(double cn2) {
-        std::lock_guard<std::mutex> lock(updateMutex);
-        CN2.store(cn2, std::memory_order_release);
+    /**
+     * @brief Set the Twiss parameters of the sampled source in the z plane.
+     * @param alpha Twiss alpha
+     * @param beta Twiss beta (Geant4 length units)
+     * @param ratio Emittance of the plane relative to the predicted epsb
+     */
+    void SetTwissZ(double alpha, double beta, double ratio) {
+        AlphaZ = alpha;
+        BetaZ = beta;
+        EmittanceRatioZ = ratio;
     }
 
-    void SetPressure(double p) {
-        std::lock_guard<std::mutex> lock(updateMutex);
-        Pressure.store(p, std::memory_order_release);
-    }
+    /**
+     * @brief Set the number of primaries generated in each event.
+     * @param n Bunch size (>= 1)
+     */
+    void SetBunchSize(int n) { BunchSize = n; }
 
-    void SetParticleName(const std::string& name) {
-        std::lock_guard<std::mutex> lock(particleNameMutex);
-        ParticleName = name;
-    }
+    void SetParticleName(const std::string& name) { ParticleName = name; }
+    void SetPhaseSpaceFile(const std::string& path) { PhaseSpaceFile = path; }
     ///@}
 
-    /// @name Thread-safe getters
+    /// @name Getters
     ///@{
-    int GetStatusONNX() const {
-        return StatusONNX.load(std::memory_order_acquire);
-    }
-
-    double GetXoff() const {
-        return Xoff.load(std::memory_order_acquire);
-    }
-
-    double GetA0() const {
-        return A0.load(std::memory_order_acquire);
-    }
-
-    double GetCN2() const {
-        return CN2.load(std::memory_order_acquire);
-    }
-
-    double GetPressure() const {
-        return Pressure.load(std::memory_order_acquire);
-    }
-
-    std::string GetParticleName() const {
-        std::lock_guard<std::mutex> lock(particleNameMutex);
-        return ParticleName;
-    }
+    int GetStatusONNX() const { return StatusONNX; }
+    double GetXoff() const { return Xoff; }
+    double GetA0() const { return A0; }
+    double GetCN2() const { return CN2; }
+    double GetPressure() const { return Pressure; }
+
+    double GetAlphaX() const { return AlphaX; }
+    double GetBetaX() const { return BetaX; }
+    double GetEmittanceRatioX() const { return EmittanceRatioX; }
+    double GetAlphaZ() const { return AlphaZ; }
+    double GetBetaZ() const { return BetaZ; }
+    double GetEmittanceRatioZ() const { return EmittanceRatioZ; }
+
+    int GetBunchSize() const { return BunchSize; }
+
+    const std::string& GetParticleName() const { return ParticleName; }
+    const std::string& GetPhaseSpaceFile() const { return PhaseSpaceFile; }
     ///@}
 
 private:
-    std::atomic<int> StatusONNX{0};      /**< Atomic storage for ONNX status */
-    std::atomic<double> Xoff{0.0};       /**< Atomic storage for X offset */
-    std::atomic<double> A0{0.0};         /**< Atomic storage for beam amplitude */
-    std::atomic<double> CN2{0.0};        /**< Atomic storage for CN2 */
-    std::atomic<double> Pressure{0.0};   /**< Atomic storage for pressure */
-
-    mutable std::mutex particleNameMutex; /**< Mutex to protect ParticleName */
-    std::string ParticleName;             /**< Name of the particle */
-
-    mutable std::mutex updateMutex;       /**< Mutex to protect full updates */
+    int StatusONNX = 0;      /**< ONNX status */
+    double Xoff = 0.0;       /**< X offset */
+    double A0 = 0.0;         /**< Beam amplitude */
+    double CN2 = 0.0;        /**< CN2 */
+    double Pressure = 0.0;   /**< Pressure */
+
+    // Source optics: the defaults (alpha = 0, beta = 1 mm, eps_x = epsb/2.5,
+    // eps_z = epsb) reproduce the historical sampling
+    double AlphaX = 0.0;            /**< Twiss alpha, x plane */
+    double BetaX = 1.0;             /**< Twiss beta, x plane (mm) */
+    double EmittanceRatioX = 0.4;   /**< eps_x / epsb */
+    double AlphaZ = 0.0;            /**< Twiss alpha, z plane */
+    double BetaZ = 1.0;             /**< Twiss beta, z plane (mm) */
+    double EmittanceRatioZ = 1.0;   /**< eps_z / epsb */
+
+    int BunchSize = 1;              /**< Primaries per event */
+
+    std::string ParticleName;       /**< Name of the particle */
+    std::string PhaseSpaceFile;     /**< Binary phase-space file (status 2) */
 
     /**
      * @brief Private constructor for singleton pattern.
@@ -0,0 +1,118 @@
+#ifndef PlasmaMLPALLASOnnxSession_h
+#define PlasmaMLPALLASOnnxSession_h 1
+
+/**
+ * @class PlasmaMLPALLASOnnxSession
+ * @brief Process-wide ONNX runtime session shared by all worker threads.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The model is loaded and optimised once per process, whatever the number of
+ * worker threads. `Ort::Session::Run` is thread-safe, so every worker uses the
+ * same session through its own PlasmaMLPALLASOnnxInference run context, which
+ * only holds per-thread buffers and the moment cache. The input/output node
+ * names and tensor types are discovered from the model when it is loaded.
+ *
+ * The singleton is first created by the master (PlasmaMLPALLASActionInitialization),
+ * which therefore owns the associated UI commands. The model path and the ORT
+ * threading options are set through /PlasmaMLPALLAS/onnx/ and the session is
+ * (re)loaded lazily on the first inference following a change.
+ */
+
+#include <onnxruntime_cxx_api.h>
+#include "globals.hh"
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+class PlasmaMLPALLASOnnxSessionMessenger;
+
+/**
+ * @struct PlasmaMLPALLASOnnxModel
+ * @brief Loaded ONNX session together with the description of its input/output.
+ *
+ * Node names and element types are read from the model when it is loaded,
+ * so that inference does not rely on hard-coded names or tensor types.
+ */
+struct PlasmaMLPALLASOnnxModel {
+    /**
+     * @brief Load the model and read the description of its single input and output
+     * @param env ONNX runtime environment
+     * @param path ONNX model file
+     * @param options Session options
+     */
+    PlasmaMLPALLASOnnxModel(Ort::Env& env, const G4String& path, const Ort::SessionOptions& options);
+
+    Ort::Session session;                      ///< ONNX runtime session
+    std::string inputName;                     ///< Name of the input node
+    std::string outputName;                    ///< Name of the output node
+    ONNXTensorElementDataType inputType;       ///< Element type of the input tensor (float or double)
+    ONNXTensorElementDataType outputType;      ///< Element type of the output tensor (float or double)
+};
+
+class PlasmaMLPALLASOnnxSession
+{
+public:
+    /**
+     * @brief Access the singleton instance.
+     * @return Reference to the process-wide session.
+     */
+    static PlasmaMLPALLASOnnxSession& Instance();
+
+    /**
+     * @brief Get the shared model, loading it if needed.
+     * @return Shared pointer keeping the session alive while it is used.
+     */
+    std::shared_ptr<PlasmaMLPALLASOnnxModel> GetModel();
+
+    /**
+     * @brief Configuration version, incremented each time a setting changes.
+     *
+     * Run contexts compare it with the version of their cached prediction to
+     * know when the model may have changed. Reading it does not lock.
+     */
+    size_t GetVersion() const { return fVersion.load(std::memory_order_acquire); }
+
+    /// @name Configuration
+    ///@{
+    void SetModelPath(const G4String& path);   /**< Set the ONNX model file */
+    void SetIntraOpNumThreads(G4int n);        /**< Set ORT intra-op threads (0 = ORT default) */
+    void SetInterOpNumThreads(G4int n);        /**< Set ORT inter-op threads (0 = ORT default) */
+
+    G4String GetModelPath() const;             /**< Get the ONNX model file */
+    G4int GetIntraOpNumThreads() const;        /**< Get ORT intra-op threads */
+    G4int GetInterOpNumThreads() const;        /**< Get ORT inter-op threads */
+    ///@}
+
+private:
+    PlasmaMLPALLASOnnxSession();
+    ~PlasmaMLPALLASOnnxSession();
+
+    PlasmaMLPALLASOnnxSession(const PlasmaMLPALLASOnnxSession&) = delete;            /**< Delete copy constructor */
+    PlasmaMLPALLASOnnxSession& operator=(const PlasmaMLPALLASOnnxSession&) = delete; /**< Delete assignment operator */
+
+    /**
+     * @brief Load the model with the current options. Must be called with fMutex held.
+     */
+    void Load();
+
+    /**
+     * @brief Drop the current session and bump the version. Must be called with fMutex held.
+     */
+    void Invalidate();
+
+    Ort::Env fEnv;                            /**< ONNX runtime environment (one per process) */
+    std::shared_ptr<PlasmaMLPALLASOnnxModel> fModel; /**< Shared model, null until first use */
+
+    G4String fModelPath = "model2.onnx";      /**< Path of the ONNX model */
+    G4int fIntraOpNumThreads = 1;             /**< ORT intra-op thread pool size */
+    G4int fInterOpNumThreads = 1;             /**< ORT inter-op thread pool size */
+
+    std::atomic<size_t> fVersion{0};          /**< Configuration version */
+    mutable std::mutex fMutex;                /**< Protects the session and its configuration */
+
+    PlasmaMLPALLASOnnxSessionMessenger* fMessenger = nullptr; /**< UI commands /PlasmaMLPALLAS/onnx/ */
+};
+
+#endif
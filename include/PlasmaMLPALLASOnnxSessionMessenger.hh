@@ -0,0 +1,65 @@
+#ifndef PlasmaMLPALLASOnnxSessionMessenger_H
+#define PlasmaMLPALLASOnnxSessionMessenger_H
+
+/**
+ * @class PlasmaMLPALLASOnnxSessionMessenger
+ * @brief Provides UI commands to configure the shared ONNX session
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * This class allows the user to choose the ONNX model file and the ONNX
+ * runtime threading options via the Geant4 UI. The commands are created by
+ * the master and act on the process-wide PlasmaMLPALLASOnnxSession, so they
+ * are not broadcast to the worker threads.
+ */
+
+#include "G4UIcmdWithAString.hh"                   // for G4UIcmdWithAString
+#include "G4UIcmdWithAnInteger.hh"                 // for G4UIcmdWithAnInteger
+#include "G4UIdirectory.hh"                        // for G4UIdirectory
+#include "G4UImessenger.hh"
+
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithAString;
+class G4UIdirectory;
+
+class PlasmaMLPALLASOnnxSession;
+
+class PlasmaMLPALLASOnnxSessionMessenger : public G4UImessenger
+{
+public:
+    /**
+     * @brief Constructor
+     * @param session Pointer to the shared ONNX session
+     */
+    PlasmaMLPALLASOnnxSessionMessenger(PlasmaMLPALLASOnnxSession *session);
+
+    /// Destructor
+    ~PlasmaMLPALLASOnnxSessionMessenger();
+
+    /**
+     * @brief Executes a command with a new value
+     * @param command Pointer to the issued command
+     * @param newValue String representation of the new value
+     */
+    virtual void SetNewValue(G4UIcommand *command, G4String newValue) final;
+
+    /**
+     * @brief Retrieves the current value of a command
+     * @param command Pointer to the command
+     * @return String representing the current value
+     */
+    virtual G4String GetCurrentValue(G4UIcommand *command) final;
+
+private:
+    /// Associated shared session
+    PlasmaMLPALLASOnnxSession *fSession = nullptr;
+
+    G4UIdirectory *fOnnxDir = nullptr;                  ///< Directory /PlasmaMLPALLAS/onnx
+
+    G4UIcmdWithAString *fModelPathCmd = nullptr;        ///< ONNX model file
+    G4UIcmdWithAnInteger *fIntraOpThreadsCmd = nullptr; ///< ORT intra-op threads
+    G4UIcmdWithAnInteger *fInterOpThreadsCmd = nullptr; ///< ORT inter-op threads
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef PlasmaMLPALLASOptimiser_h
+#define PlasmaMLPALLASOptimiser_h 1
+
+/**
+ * @class PlasmaMLPALLASOptimiser
+ * @brief In-process Nelder-Mead optimisation of the Q1..Q4 gradients.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * Each candidate is one Geant4 run of the initialised kernel: its gradients
+ * are set with the /PlasmaMLPALLAS/field/ commands (pushed into the existing
+ * fields at BeginOfRunAction) and /run/beamOn is called. The objective is the
+ * rms spot size of the primaries on BS1_YAG, read from the merged
+ * PlasmaMLPALLASSpotAccumulable of the master run action.
+ *
+ * The runs start with few events. When the spread of the simplex values is
+ * within the statistical error of the best one, the number of events is
+ * doubled (up to the maximum) and the simplex re-evaluated, so that the long
+ * runs are only spent near convergence. The search stops when the simplex is
+ * smaller than the tolerance in every gradient at the maximum number of
+ * events, or after the maximum number of evaluations. The best gradients are
+ * then applied and run once more with the maximum number of events.
+ *
+ * All the evaluations are written to the same output file, keyed by the
+ * ScanIndex branch (the final run has the last index). The singleton is
+ * created by the master (PlasmaMLPALLASActionInitialization), which owns the
+ * /PlasmaMLPALLAS/optimise/ commands.
+ */
+
+#include "globals.hh"
+#include "G4SystemOfUnits.hh"
+#include <array>
+#include <atomic>
+#include <vector>
+
+class PlasmaMLPALLASOptimiserMessenger;
+
+class PlasmaMLPALLASOptimiser
+{
+public:
+    /// Gradients of Q1..Q4
+    using Gradients = std::array<G4double, 4>;
+
+    /** User settings of the optimisation */
+    struct Settings {
+        std::array<G4bool, 4> active{true, true, true, true}; ///< Quadrupoles whose gradient is optimised
+        G4double initialStep = 2. * tesla / m;                ///< Size of the initial simplex
+        G4double tolerance = 0.05 * tesla / m;                ///< Simplex size at convergence
+        G4int minEvents = 200;                                ///< Events per evaluation at start
+        G4int maxEvents = 3200;                               ///< Events per evaluation near convergence
+        G4int maxEvaluations = 200;                           ///< Maximum number of runs
+        G4String objective = "spot";                          ///< "spot", "x" or "z"
+        G4long minEntries = 10;                               ///< Primaries on the screen needed for a valid evaluation
+    };
+
+    /**
+     * @brief Access the singleton instance.
+     * @return Reference to the process-wide optimiser.
+     */
+    static PlasmaMLPALLASOptimiser& Instance();
+
+    /** Names accepted for the objective */
+    static const std::vector<G4String>& GetObjectiveNames();
+
+    /** Settings used by the next Run */
+    Settings& GetSettings() { return fSettings; }
+
+    /**
+     * @brief Optimise from the current gradients of the geometry (master thread, Idle state).
+     */
+    void Run();
+
+    /// @name Accessors for the run actions
+    ///@{
+    G4int GetEvaluationIndex() const { return fEvaluationIndex.load(); }   /**< Index of the running evaluation */
+    G4int GetEventsPerEvaluation() const { return fEvents.load(); }        /**< Events of the running evaluation */
+    G4bool IsRunning() const { return fRunning.load(); }                  /**< Whether an optimisation is in progress */
+    G4bool KeepOutputOpen() const { return fKeepOutputOpen.load(); }      /**< Whether more evaluations follow the current run */
+    ///@}
+
+private:
+    PlasmaMLPALLASOptimiser();
+    ~PlasmaMLPALLASOptimiser();
+
+    PlasmaMLPALLASOptimiser(const PlasmaMLPALLASOptimiser&) = delete;            /**< Delete copy constructor */
+    PlasmaMLPALLASOptimiser& operator=(const PlasmaMLPALLASOptimiser&) = delete; /**< Delete assignment operator */
+
+    /** Objective of one evaluation, with its statistical error */
+    struct Evaluation {
+        G4double value = 0.;
+        G4double error = 0.;
+    };
+
+    /** Apply the gradients with the UI commands */
+    void ApplyGradients(const Gradients& gradients) const;
+
+    /** Run one candidate with the current number of events */
+    Evaluation Evaluate(const Gradients& gradients);
+
+    Settings fSettings;
+
+    // Read by the run actions of every thread
+    std::atomic<G4int> fEvaluationIndex{0};   /**< Index of the running evaluation */
+    std::atomic<G4int> fEvents{0};            /**< Events of the running evaluation */
+    std::atomic<G4bool> fRunning{false};      /**< An optimisation is in progress */
+    std::atomic<G4bool> fKeepOutputOpen{false}; /**< More evaluations follow the current run */
+
+    PlasmaMLPALLASOptimiserMessenger* fMessenger = nullptr; /**< UI commands /PlasmaMLPALLAS/optimise/ */
+};
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef PlasmaMLPALLASOptimiserMessenger_H
+#define PlasmaMLPALLASOptimiserMessenger_H
+
+/**
+ * @class PlasmaMLPALLASOptimiserMessenger
+ * @brief Provides UI commands to configure and run the quadrupole gradient optimisation
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The commands are created by the master and act on the process-wide
+ * PlasmaMLPALLASOptimiser, so they are not broadcast to the worker threads.
+ */
+
+#include "G4UIcommand.hh"
+#include "G4UIcmdWithAnInteger.hh"                 // for G4UIcmdWithAnInteger
+#include "G4UIcmdWithADoubleAndUnit.hh"            // for G4UIcmdWithADoubleAndUnit
+#include "G4UIcmdWithAString.hh"                   // for G4UIcmdWithAString
+#include "G4UIcmdWithoutParameter.hh"              // for G4UIcmdWithoutParameter
+#include "G4UIdirectory.hh"                        // for G4UIdirectory
+#include "G4UImessenger.hh"
+
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAString;
+class G4UIcmdWithoutParameter;
+class G4UIcommand;
+class G4UIdirectory;
+
+class PlasmaMLPALLASOptimiser;
+
+class PlasmaMLPALLASOptimiserMessenger : public G4UImessenger
+{
+public:
+    /**
+     * @brief Constructor
+     * @param optimiser Pointer to the optimiser
+     */
+    PlasmaMLPALLASOptimiserMessenger(PlasmaMLPALLASOptimiser *optimiser);
+
+    /// Destructor
+    ~PlasmaMLPALLASOptimiserMessenger();
+
+    /**
+     * @brief Executes a command with a new value
+     * @param command Pointer to the issued command
+     * @param newValue String representation of the new value
+     */
+    virtual void SetNewValue(G4UIcommand *command, G4String newValue) final;
+
+    /**
+     * @brief Retrieves the current value of a command
+     * @param command Pointer to the command
+     * @return String representing the current value
+     */
+    virtual G4String GetCurrentValue(G4UIcommand *command) final;
+
+private:
+    /// Associated optimiser
+    PlasmaMLPALLASOptimiser *fOptimiser = nullptr;
+
+    G4UIdirectory *fOptimiseDir = nullptr;               ///< Directory /PlasmaMLPALLAS/optimise
+
+    G4UIcommand *fActiveCmd = nullptr;                   ///< Select the optimised gradients
+    G4UIcmdWithADoubleAndUnit *fInitialStepCmd = nullptr; ///< Size of the initial simplex
+    G4UIcmdWithADoubleAndUnit *fToleranceCmd = nullptr;  ///< Simplex size at convergence
+    G4UIcommand *fEventsCmd = nullptr;                   ///< Events per evaluation (start, convergence)
+    G4UIcmdWithAnInteger *fMaxEvaluationsCmd = nullptr; ///< Maximum number of runs
+    G4UIcmdWithAnInteger *fMinEntriesCmd = nullptr;      ///< Primaries needed on the screen
+    G4UIcmdWithAString *fObjectiveCmd = nullptr;         ///< Objective on BS1_YAG
+    G4UIcmdWithoutParameter *fRunCmd = nullptr;          ///< Run the optimisation
+};
+
+#endif
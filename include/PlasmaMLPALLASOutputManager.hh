@@ -0,0 +1,297 @@
+#ifndef PlasmaMLPALLASOutputManager_h
+#define PlasmaMLPALLASOutputManager_h 1
+
+/**
+ * @class PlasmaMLPALLASOutputManager
+ * @brief Final ROOT file of the run and in-process merging of the worker outputs.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The output is written once, to <directory>/<name>.root
+ * (/PlasmaMLPALLAS/output/setDirectory, default ../Resultats, and
+ * setFileName, default the name given on the command line):
+ *  - sequential runs fill a TFile at that path;
+ *  - multi-threaded runs go through a ROOT::TBufferMerger opened by the
+ *    master at BeginOfRunAction: each worker fills the trees of its own
+ *    in-memory TBufferMergerFile, whose content is merged into the final
+ *    file when the worker writes it at EndOfRunAction. The master closes the
+ *    merger after the workers, at its own EndOfRunAction.
+ *
+ * Nothing is written to the working directory and no hadd is needed, so the
+ * number of worker files no longer has to match the number of threads.
+ *
+ * The tables are TTrees by default, or RNTuples with setFormat rntuple: the
+ * master then opens the final file with one RNTupleParallelWriter per table
+ * instead of the merger, and the workers fill their own contexts of these
+ * writers (see PlasmaMLPALLASOutputTable). Both formats use the codec of
+ * setCompression (zstd, lz4, zlib, lzma or none, ROOT default otherwise)
+ * and the cluster size of setClusterSize (zipped bytes of a TTree cluster,
+ * through SetAutoFlush, or of an RNTuple cluster).
+ * setEventOutput false writes only the per-run tables (GlobalInput and the
+ * beam moments of BeamSummary), not the per-primary and per-hit ones.
+ * setTable and setColumns select the tables and the columns more finely,
+ * with wildcard patterns (* and ?) applied in order, the last matching rule
+ * winning; ScanIndex is always written.
+ * The YAG screens are also binned into images by every thread (see
+ * PlasmaMLPALLASScreenImage), merged at the end of the run and written by
+ * the master as TH2D (setImageFormat th2, default) or as one row of raw
+ * pixels per run in the ScreenImages table (raw); setImageBinning sets the
+ * grid of an image and setTable also selects the images by name.
+ * setFlushEvents and setFlushSize bound the memory of long runs: each
+ * thread writes its tables every N events or filled bytes (baskets and
+ * clusters flushed, worker file merged and emptied), instead of only at
+ * EndOfRunAction. A checkpointed job (PlasmaMLPALLASCheckpoint) writes one
+ * file per chunk, <name>_chunk<k>.root, merged into the final file by
+ * MergeFiles once the last chunk is done.
+ * setWriterThreads N moves the filling and the compression of the tables
+ * to N writer threads shared by all the Geant4 threads
+ * (PlasmaMLPALLASAsyncWriter); each table queues at most setQueueSize
+ * entries before its Geant4 thread waits. 0 (default) fills synchronously.
+ * A scan or an optimisation keeps the files and the merger open for all its
+ * points. The singleton is created by the master
+ * (PlasmaMLPALLASActionInitialization), which owns the /PlasmaMLPALLAS/output/
+ * commands.
+ */
+
+#include "globals.hh"
+#include "PlasmaMLPALLASOutputTable.hh"
+#include "PlasmaMLPALLASScreenImage.hh"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class TFile;
+namespace ROOT { class TBufferMerger; }
+class PlasmaMLPALLASOutputMessenger;
+
+class PlasmaMLPALLASOutputManager
+{
+public:
+    /**
+     * @brief Access the singleton instance.
+     * @return Reference to the process-wide output manager.
+     */
+    static PlasmaMLPALLASOutputManager& Instance();
+
+    /// @name Configuration
+    ///@{
+    void SetDirectory(const G4String& directory) { fDirectory = directory; } /**< Directory of the final file */
+    const G4String& GetDirectory() const { return fDirectory; }
+    void SetFileName(const G4String& name) { fFileName = name; }            /**< Name of the final file (empty: command line) */
+    const G4String& GetFileName() const { return fFileName; }
+    ///@}
+
+    /// Layout of the tables in the file
+    enum class Format { TTree, RNTuple };
+
+    /** Names of the formats, in the order of Format ("ttree", "rntuple") */
+    static const std::vector<G4String>& GetFormatNames();
+
+    /** Names of the codecs ("default", "zstd", "lz4", "zlib", "lzma", "none") */
+    static const std::vector<G4String>& GetCodecNames();
+
+    /// @name Format and compression (set before the run)
+    ///@{
+    /**
+     * @brief Select the format of the tables.
+     * @return False if RNTuple is not compiled in (format unchanged)
+     */
+    G4bool SetFormat(Format format);
+    Format GetFormat() const { return fFormat; }
+
+    /**
+     * @brief Select the codec of the file.
+     * @param codec Codec name ("default" keeps the ROOT default of the format)
+     * @param level Compression level 1-9, 0 for the default level of the codec
+     * @return False if the codec is unknown (settings unchanged)
+     */
+    G4bool SetCompression(const G4String& codec, G4int level);
+    const G4String& GetCodec() const { return fCodec; }
+    G4int GetCompressionLevel() const { return fCompressionLevel; }
+
+    /** ROOT compression settings (algorithm x 100 + level), -1 for the ROOT default */
+    G4int GetCompressionSettings() const;
+
+    /** Zipped bytes of a cluster, 0 for the ROOT default */
+    void SetClusterSize(Long64_t bytes) { fClusterSize = bytes > 0 ? bytes : 0; }
+    Long64_t GetClusterSize() const { return fClusterSize; }
+
+    /** Write the per-event tables (Input, QuadrupolesTracking, collimators, YAG screens) */
+    void SetEventOutput(G4bool eventOutput) { fEventOutput = eventOutput; }
+    G4bool GetEventOutput() const { return fEventOutput; }
+
+    /** Events of a thread between two flushes of its tables, 0 to flush at the end of the run only */
+    void SetFlushEvents(G4int events) { fFlushEvents = events > 0 ? events : 0; }
+    G4int GetFlushEvents() const { return fFlushEvents; }
+
+    /** Uncompressed bytes filled by a thread between two flushes of its tables, 0 for no limit */
+    void SetFlushSize(Long64_t bytes) { fFlushSize = bytes > 0 ? bytes : 0; }
+    Long64_t GetFlushSize() const { return fFlushSize; }
+
+    /** Writer threads filling the tables, 0 to fill them in the Geant4 threads */
+    void SetWriterThreads(G4int nThreads) { fWriterThreads = nThreads > 0 ? nThreads : 0; }
+    G4int GetWriterThreads() const { return fWriterThreads; }
+
+    /** Entries queued per table before the Geant4 thread waits for the writer */
+    void SetQueueSize(G4int rows) { fQueueSize = rows > 2 ? rows : 2; }
+    G4int GetQueueSize() const { return fQueueSize; }
+    ///@}
+
+    /// Form of the images of the YAG screens
+    enum class ImageFormat { TH2, Raw };
+
+    /** Names of the image formats, in the order of ImageFormat ("th2", "raw") */
+    static const std::vector<G4String>& GetImageFormatNames();
+
+    /** Names of the images, in the order in which the run action fills them */
+    static const std::vector<G4String>& GetImageNames();
+
+    /// @name Images of the YAG screens (set before the run)
+    ///@{
+    void SetImageFormat(ImageFormat format) { fImageFormat = format; }
+    ImageFormat GetImageFormat() const { return fImageFormat; }
+
+    /**
+     * @brief Set the grid of an image.
+     * @param image Name of the image (GetImageNames())
+     * @param binning Bins and ranges (mm, MeV for the energy axis)
+     * @return False if the image is unknown or the grid empty (binning unchanged)
+     */
+    G4bool SetImageBinning(const G4String& image, const PlasmaMLPALLASScreenImage::Binning& binning);
+    const PlasmaMLPALLASScreenImage::Binning& GetImageBinning(const G4String& image) const;
+    ///@}
+
+    /// @name Selection of the tables and columns (set before the run)
+    ///@{
+    /**
+     * @brief Add a rule enabling or disabling tables.
+     * @param table Table name or wildcard pattern (* and ?)
+     * @param enabled Whether the matching tables are written
+     */
+    void SetTableEnabled(const G4String& table, G4bool enabled) { fTableRules.push_back({table, "", enabled}); }
+
+    /**
+     * @brief Add a rule enabling or disabling columns.
+     * @param table Table name or wildcard pattern
+     * @param column Column name or wildcard pattern (Q2*, *Mom_*...)
+     * @param enabled Whether the matching columns are written
+     */
+    void SetColumnsEnabled(const G4String& table, const G4String& column, G4bool enabled) { fColumnRules.push_back({table, column, enabled}); }
+
+    /** Forget all the table and column rules */
+    void ClearSelection() { fTableRules.clear(); fColumnRules.clear(); }
+
+    /** Whether a table is written (last matching setTable rule, enabled by default) */
+    G4bool IsTableEnabled(const G4String& table) const;
+
+    /** Whether a column of a table is written (last matching setColumns rule, enabled by default) */
+    G4bool IsColumnEnabled(const G4String& table, const G4String& column) const;
+
+    /** Rules as "table[.column]=on|off", comma separated */
+    G4String GetSelection() const;
+    ///@}
+
+    /**
+     * @brief Path of the final file, its directory created if needed.
+     * @param defaultName Name of the command line, used without setFileName
+     * @return <directory>/<name>.root, or <directory>/<name>_chunk<k>.root in a chunk of a checkpointed job
+     */
+    G4String GetOutputPath(const G4String& defaultName) const;
+
+    /** Chunk of a checkpointed job written by the next runs, -1 for the final file */
+    void SetChunkIndex(G4int chunk) { fChunkIndex = chunk; }
+    G4int GetChunkIndex() const { return fChunkIndex; }
+
+    /**
+     * @brief Merge closed files into the final file (end of a checkpointed job, master thread).
+     * @param inputs Files to merge, in order
+     * @param defaultName Name of the command line
+     * @return False if the merge failed (the inputs are kept)
+     */
+    G4bool MergeFiles(const std::vector<G4String>& inputs, const G4String& defaultName);
+
+    /**
+     * @brief Open the merger of the final file (master of a multi-threaded run).
+     * @param defaultName Name of the command line
+     * @param tables Tables of the run (one parallel writer each in the RNTuple format)
+     */
+    void OpenMerger(const G4String& defaultName, const std::vector<const PlasmaMLPALLASOutputTable*>& tables);
+
+    /** Whether a merger is open */
+    G4bool IsMerging() const { return fMerger != nullptr || fMergedFile != nullptr; }
+
+    /** Final file of the RNTuple parallel writers, where the master writes its histograms (nullptr otherwise) */
+    TFile* GetMergedFile() const { return fMergedFile.get(); }
+
+    /**
+     * @brief File of the calling thread: a file of the merger if it is open, the final file otherwise.
+     * @param defaultName Name of the command line
+     * @return File to create the tables in (gDirectory is set to it), nullptr for the
+     *         workers of the RNTuple parallel writers
+     */
+    std::shared_ptr<TFile> OpenFile(const G4String& defaultName);
+
+    /** @brief Write the merged file and close the merger (master, after the workers). */
+    void CloseMerger();
+
+    /**
+     * @brief Writer threads of the tables, started at the first call.
+     * @return nullptr with setWriterThreads 0
+     */
+    PlasmaMLPALLASAsyncWriter* GetAsyncWriter();
+
+#ifdef PLASMAMLPALLAS_WITH_RNTUPLE
+    /** Parallel writer of a table opened by OpenMerger, nullptr if none */
+    PlasmaMLPALLASRNTuple::RNTupleParallelWriter* GetParallelWriter(const G4String& table) const;
+
+    /** RNTuple options of the compression and cluster size settings */
+    PlasmaMLPALLASRNTuple::RNTupleWriteOptions GetWriteOptions() const;
+#endif
+
+private:
+    PlasmaMLPALLASOutputManager();
+    ~PlasmaMLPALLASOutputManager();
+
+    PlasmaMLPALLASOutputManager(const PlasmaMLPALLASOutputManager&) = delete;            /**< Delete copy constructor */
+    PlasmaMLPALLASOutputManager& operator=(const PlasmaMLPALLASOutputManager&) = delete; /**< Delete assignment operator */
+
+    G4String fDirectory = "../Resultats";            /**< Directory of the final file */
+    G4String fFileName;                              /**< Name of the final file (empty: command line) */
+    G4String fMergerPath;                            /**< Path of the final file of the open merger */
+    Format fFormat = Format::TTree;                  /**< Layout of the tables */
+    G4String fCodec = "default";                     /**< Codec of the file */
+    G4int fCompressionLevel = 0;                     /**< Level of the codec, 0 for its default */
+    Long64_t fClusterSize = 0;                       /**< Zipped bytes of a cluster, 0 for the ROOT default */
+    G4bool fEventOutput = true;                      /**< Per-event tables written */
+    G4int fFlushEvents = 0;                          /**< Events between flushes, 0 for none */
+    Long64_t fFlushSize = 0;                         /**< Filled bytes between flushes, 0 for none */
+    G4int fChunkIndex = -1;                          /**< Chunk of a checkpointed job, -1 for none */
+    G4int fWriterThreads = 0;                        /**< Writer threads, 0 for synchronous filling */
+    G4int fQueueSize = 1024;                         /**< Entries queued per table */
+    ImageFormat fImageFormat = ImageFormat::TH2;     /**< Form of the screen images */
+    std::map<G4String, PlasmaMLPALLASScreenImage::Binning> fImageBinnings; /**< Grid per image */
+
+    /// Rule of the table and column selection
+    struct SelectionRule
+    {
+        G4String table;
+        G4String column;
+        G4bool enabled;
+    };
+    std::vector<SelectionRule> fTableRules;          /**< setTable rules, in command order (column unused) */
+    std::vector<SelectionRule> fColumnRules;         /**< setColumns rules, in command order */
+    std::unique_ptr<ROOT::TBufferMerger> fMerger;    /**< Merger of the worker files (multi-threaded TTree runs) */
+    std::shared_ptr<TFile> fMergedFile;              /**< Final file of the parallel writers (multi-threaded RNTuple runs) */
+#ifdef PLASMAMLPALLAS_WITH_RNTUPLE
+    std::map<G4String, std::unique_ptr<PlasmaMLPALLASRNTuple::RNTupleParallelWriter>> fParallelWriters; /**< Writer per table */
+#endif
+
+    std::unique_ptr<PlasmaMLPALLASAsyncWriter> fAsyncWriter; /**< Writer threads, shared by the Geant4 threads */
+    std::mutex fAsyncWriterMutex;                    /**< Guards the creation of the writer threads */
+
+    PlasmaMLPALLASOutputMessenger* fMessenger = nullptr; /**< UI commands /PlasmaMLPALLAS/output/ */
+};
+
+#endif
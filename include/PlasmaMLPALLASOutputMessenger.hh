@@ -0,0 +1,81 @@
+#ifndef PlasmaMLPALLASOutputMessenger_H
+#define PlasmaMLPALLASOutputMessenger_H
+
+/**
+ * @class PlasmaMLPALLASOutputMessenger
+ * @brief Provides UI commands to configure the final ROOT file
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The output manager belongs to the master: the commands are not broadcast
+ * to the worker threads.
+ */
+
+#include "G4UIcommand.hh"
+#include "G4UIcmdWithABool.hh"                     // for G4UIcmdWithABool
+#include "G4UIcmdWithADouble.hh"                   // for G4UIcmdWithADouble
+#include "G4UIcmdWithAnInteger.hh"                 // for G4UIcmdWithAnInteger
+#include "G4UIcmdWithAString.hh"                   // for G4UIcmdWithAString
+#include "G4UIdirectory.hh"                        // for G4UIdirectory
+#include "G4UImessenger.hh"
+
+class G4UIcmdWithABool;
+class G4UIcmdWithADouble;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithAString;
+class G4UIcommand;
+class G4UIdirectory;
+
+class PlasmaMLPALLASOutputManager;
+
+class PlasmaMLPALLASOutputMessenger : public G4UImessenger
+{
+public:
+    /**
+     * @brief Constructor
+     * @param output Pointer to the output manager
+     */
+    PlasmaMLPALLASOutputMessenger(PlasmaMLPALLASOutputManager *output);
+
+    /// Destructor
+    ~PlasmaMLPALLASOutputMessenger();
+
+    /**
+     * @brief Executes a command with a new value
+     * @param command Pointer to the issued command
+     * @param newValue String representation of the new value
+     */
+    virtual void SetNewValue(G4UIcommand *command, G4String newValue) final;
+
+    /**
+     * @brief Retrieves the current value of a command
+     * @param command Pointer to the command
+     * @return String representing the current value
+     */
+    virtual G4String GetCurrentValue(G4UIcommand *command) final;
+
+private:
+    /// Associated output manager
+    PlasmaMLPALLASOutputManager *fOutput = nullptr;
+
+    G4UIdirectory *fOutputDir = nullptr;         ///< Directory /PlasmaMLPALLAS/output
+
+    G4UIcmdWithAString *fDirectoryCmd = nullptr; ///< Directory of the final file
+    G4UIcmdWithAString *fFileNameCmd = nullptr;  ///< Name of the final file
+    G4UIcmdWithAString *fFormatCmd = nullptr;    ///< TTree or RNTuple tables
+    G4UIcommand *fCompressionCmd = nullptr;      ///< Codec and level
+    G4UIcmdWithADouble *fClusterSizeCmd = nullptr; ///< Zipped size of a cluster
+    G4UIcmdWithABool *fEventOutputCmd = nullptr;   ///< Per-event tables on or off
+    G4UIcommand *fTableCmd = nullptr;              ///< Rule enabling or disabling tables
+    G4UIcommand *fColumnsCmd = nullptr;            ///< Rule enabling or disabling columns
+    G4UIcommand *fClearSelectionCmd = nullptr;     ///< Forget the table and column rules
+    G4UIcmdWithAnInteger *fFlushEventsCmd = nullptr;   ///< Events between flushes of the tables
+    G4UIcmdWithADouble *fFlushSizeCmd = nullptr;       ///< Filled size between flushes of the tables
+    G4UIcmdWithAnInteger *fWriterThreadsCmd = nullptr; ///< Writer threads of the tables
+    G4UIcmdWithAnInteger *fQueueSizeCmd = nullptr;     ///< Entries queued per table
+    G4UIcmdWithAString *fImageFormatCmd = nullptr;     ///< TH2D or raw screen images
+    G4UIcommand *fImageBinningCmd = nullptr;           ///< Grid of a screen image
+};
+
+#endif
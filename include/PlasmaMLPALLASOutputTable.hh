@@ -0,0 +1,233 @@
+#ifndef PlasmaMLPALLASOutputTable_h
+#define PlasmaMLPALLASOutputTable_h 1
+
+/**
+ * @class PlasmaMLPALLASOutputTable
+ * @brief One output table of the run action (Input, BSYAG...), written as a TTree or as an RNTuple.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The run action declares the columns of each table once, bound to the
+ * members of its statistics structures; Fill() then writes the current
+ * values of those members as one entry. The format is the one selected by
+ * /PlasmaMLPALLAS/output/setFormat (PlasmaMLPALLASOutputManager):
+ *  - ttree (default): a TTree in the file of the thread, one branch per
+ *    column (leaf lists for the scalars, vector<> branches for the hits);
+ *  - rntuple: an RNTuple of the same name and fields. In multi-threaded
+ *    runs each worker fills an RNTupleFillContext of the parallel writer
+ *    opened by the master in the final file; in sequential runs the writer
+ *    is appended to the file of the run.
+ *
+ * With writer threads (/PlasmaMLPALLAS/output/setWriterThreads), Fill()
+ * only copies the values into a free row of fixed layout and pushes it to
+ * the queue of the table: a writer thread (PlasmaMLPALLASAsyncWriter)
+ * copies it into the variables of the branches or fields and does the
+ * filling and the compression. The rows are recycled through a second
+ * queue; when none is free the Geant4 thread waits for the writer
+ * (back-pressure), so a table never holds more than setQueueSize rows.
+ *
+ * Flush() writes the entries filled so far (baskets of the tree, current
+ * cluster of the RNTuple) in the middle of a run, so that the memory used
+ * by a long run stays bounded; the run action calls it every
+ * /PlasmaMLPALLAS/output/setFlushEvents events or setFlushSize bytes.
+ *
+ * Only the columns enabled by /PlasmaMLPALLAS/output/setColumns become
+ * branches or fields; the others keep being updated by the run action but
+ * are not written.
+ *
+ * The RNTuple format needs ROOT >= 6.34 and is compiled in when CMake
+ * finds ROOT::ROOTNTuple (PLASMAMLPALLAS_WITH_RNTUPLE).
+ */
+
+#include "globals.hh"
+#include "PlasmaMLPALLASAsyncWriter.hh"
+#include "PlasmaMLPALLASRingBuffer.hh"
+#include "Rtypes.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef PLASMAMLPALLAS_WITH_RNTUPLE
+#include "RVersion.h"
+#include "ROOT/RNTupleModel.hxx"
+#include "ROOT/RNTupleWriter.hxx"
+#include "ROOT/RNTupleWriteOptions.hxx"
+#include "ROOT/RNTupleParallelWriter.hxx"
+#include "ROOT/RNTupleFillContext.hxx"
+#include "ROOT/RField.hxx"
+
+/// RNTuple classes, out of ROOT::Experimental since ROOT 6.36
+namespace PlasmaMLPALLASRNTuple
+{
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 36, 0)
+    using ROOT::REntry;
+    using ROOT::RField;
+    using ROOT::RNTupleModel;
+    using ROOT::RNTupleWriteOptions;
+    using ROOT::RNTupleWriter;
+#else
+    using ROOT::Experimental::REntry;
+    using ROOT::Experimental::RField;
+    using ROOT::Experimental::RNTupleModel;
+    using ROOT::Experimental::RNTupleWriteOptions;
+    using ROOT::Experimental::RNTupleWriter;
+#endif
+    using ROOT::Experimental::RNTupleFillContext;
+    using ROOT::Experimental::RNTupleParallelWriter;
+}
+#endif
+
+class TFile;
+class TTree;
+
+class PlasmaMLPALLASOutputTable : public PlasmaMLPALLASAsyncWriter::Channel
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param name Name of the tree or RNTuple
+     * @param title Title of the tree (description of the RNTuple)
+     */
+    PlasmaMLPALLASOutputTable(const G4String& name, const G4String& title);
+    ~PlasmaMLPALLASOutputTable() override;
+
+    PlasmaMLPALLASOutputTable(const PlasmaMLPALLASOutputTable&) = delete;            /**< Delete copy constructor */
+    PlasmaMLPALLASOutputTable& operator=(const PlasmaMLPALLASOutputTable&) = delete; /**< Delete assignment operator */
+
+    /// @name Columns, bound to the variable written by Fill()
+    ///@{
+    void AddColumn(const G4String& name, int* address);
+    void AddColumn(const G4String& name, float* address);
+    void AddColumn(const G4String& name, Long64_t* address);
+    void AddColumn(const G4String& name, std::vector<float>* address);
+    void AddColumn(const G4String& name, std::vector<int>* address);
+    void AddColumn(const G4String& name, std::vector<std::string>* address);
+    ///@}
+
+    const G4String& GetName() const { return fName; }
+
+    /**
+     * @brief Create the tree or the RNTuple writer of the thread.
+     * @param file File of the thread (unused by the workers of a parallel RNTuple writer)
+     */
+    void Open(TFile* file);
+
+    /** Whether Open() was called since the last Close() */
+    G4bool IsOpen() const;
+
+    /** @brief Write one entry with the current values of the columns (queued with writer threads). */
+    void Fill();
+
+    /**
+     * @brief Flush the RNTuple of the thread; the tree is written with its file, and deleted by it.
+     *
+     * With writer threads, waits until the queued rows are written first.
+     */
+    void Close();
+
+    /**
+     * @brief Write the entries filled so far (with writer threads, once the queued rows are written).
+     *
+     * The baskets of a tree go to its file, the cluster of an RNTuple is flushed or committed.
+     */
+    void Flush();
+
+    /** Uncompressed bytes filled since Open() or the last Flush() (counted with setFlushSize only) */
+    Long64_t GetFilledBytes() const { return fFilledBytes; }
+
+    /** @brief Write the queued rows (writer thread). */
+    G4bool Drain() override;
+
+#ifdef PLASMAMLPALLAS_WITH_RNTUPLE
+    /** Model of the RNTuple (fields of the columns, no default entry) */
+    std::unique_ptr<PlasmaMLPALLASRNTuple::RNTupleModel> CreateModel() const;
+#endif
+
+private:
+    /// Type of a column
+    enum class Type { Int, Float, Long64, VectorFloat, VectorInt, VectorString };
+
+    static constexpr size_t kNTypes = 6;
+
+    /// Column and the variable it reads
+    struct Column
+    {
+        G4String name;
+        Type type;
+        void* address;
+        size_t slot;  ///< Index among the columns of its type in a Row
+    };
+
+    /// Values of all the columns of one entry, handed over to a writer thread
+    struct Row
+    {
+        std::vector<int> ints;
+        std::vector<float> floats;
+        std::vector<Long64_t> longs;
+        std::vector<std::vector<float>> floatVectors;
+        std::vector<std::vector<int>> intVectors;
+        std::vector<std::vector<std::string>> stringVectors;
+    };
+
+    /** Add a column of a type */
+    void AddColumn(const G4String& name, Type type, void* address);
+
+    /** Columns written with the selection of the output manager */
+    std::vector<Column> SelectedColumns() const;
+
+    /** Variable written for a column: the one of the run action, or the slot of the bound row */
+    void* Address(const Column& column) const;
+
+    /** Empty row with one slot per column */
+    std::unique_ptr<Row> MakeRow() const;
+
+    /** @brief Copy the values of the open columns into a row (Geant4 thread). */
+    void Encode(Row& row) const;
+
+    /** @brief Copy a row into the bound row (writer thread). */
+    void Decode(const Row& row);
+
+    /** @brief Fill the tree or the RNTuple from the bound variables. */
+    void Write();
+
+    /** @brief Wait until the writer thread has written every queued row. */
+    void WaitWritten() const;
+
+    /** Uncompressed size of the current values of the open columns */
+    Long64_t RowBytes() const;
+
+    /** @brief Create a branch per selected column. */
+    void CreateBranches();
+
+    G4String fName;                  ///< Name of the tree or RNTuple
+    G4String fTitle;                 ///< Title of the tree
+    std::vector<Column> fColumns;    ///< Columns in definition order
+    std::array<size_t, kNTypes> fTypeCount{}; ///< Columns per type
+    std::vector<Column> fOpenColumns; ///< Columns written since Open()
+    TTree* fTree = nullptr;          ///< Tree of the thread (owned by its file)
+    G4bool fCountBytes = false;      ///< Count the filled bytes (setFlushSize)
+    Long64_t fFilledBytes = 0;       ///< Bytes filled since the last flush
+
+    // Asynchronous output
+    PlasmaMLPALLASAsyncWriter* fAsync = nullptr;               ///< Writer threads draining the table, nullptr if synchronous
+    std::unique_ptr<Row> fBound;                               ///< Row read by the branches or fields (writer thread)
+    std::vector<std::unique_ptr<Row>> fRows;                   ///< Rows queued or free
+    std::unique_ptr<PlasmaMLPALLASRingBuffer<Row*>> fQueued;   ///< Rows to write (Geant4 thread to writer)
+    std::unique_ptr<PlasmaMLPALLASRingBuffer<Row*>> fFree;     ///< Written rows (writer to Geant4 thread)
+    size_t fPushed = 0;                                        ///< Rows queued by the Geant4 thread
+    std::atomic<size_t> fWritten{0};                           ///< Rows written by the writer thread
+
+#ifdef PLASMAMLPALLAS_WITH_RNTUPLE
+    /** @brief Bind the selected columns to the entry of the thread. */
+    void Bind();
+
+    std::unique_ptr<PlasmaMLPALLASRNTuple::RNTupleWriter> fWriter;          ///< Writer of a sequential run
+    std::shared_ptr<PlasmaMLPALLASRNTuple::RNTupleFillContext> fContext;    ///< Context of a worker
+    std::unique_ptr<PlasmaMLPALLASRNTuple::REntry> fEntry;                  ///< Entry bound to the columns
+#endif
+};
+
+#endif
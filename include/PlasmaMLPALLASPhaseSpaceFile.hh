@@ -0,0 +1,82 @@
+#ifndef PlasmaMLPALLASPhaseSpaceFile_h
+#define PlasmaMLPALLASPhaseSpaceFile_h 1
+
+/**
+ * @class PlasmaMLPALLASPhaseSpaceFile
+ * @brief Memory-mapped binary phase-space file used as a primary source.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The file holds the macro-particles of a PIC-simulated bunch in the
+ * simulation frame (y is the beam axis):
+ *  - a 16-byte header: the magic "PMLPSPC1" and the number of records (uint64)
+ *  - the records, eight native doubles each (see PhaseSpaceRecord)
+ *
+ * One mapping is shared by all worker threads. Primaries are read in place
+ * from the mapped region, so no thread ever copies the bunch. Files are
+ * produced from a CSV table with ConvertCSV (`--phasespace` mode of the
+ * executable).
+ */
+
+#include "globals.hh"
+#include "PlasmaMLPALLASMappedFile.hh"
+#include <cstdint>
+#include <memory>
+
+/**
+ * @struct PhaseSpaceRecord
+ * @brief One macro-particle of the phase-space file.
+ */
+struct PhaseSpaceRecord {
+    G4double x;       ///< X position (mm)
+    G4double y;       ///< Y position (mm)
+    G4double z;       ///< Z position (mm)
+    G4double ux;      ///< X component of the momentum (any normalisation)
+    G4double uy;      ///< Y component of the momentum
+    G4double uz;      ///< Z component of the momentum
+    G4double Ekin;    ///< Kinetic energy (MeV)
+    G4double weight;  ///< Number of real particles represented
+};
+
+static_assert(sizeof(PhaseSpaceRecord) == 8 * sizeof(double), "PhaseSpaceRecord must be packed");
+
+class PlasmaMLPALLASPhaseSpaceFile
+{
+public:
+    /**
+     * @brief Get the mapping of a phase-space file, shared by all threads.
+     * @param path Binary phase-space file
+     * @return File mapping, created on first request and released with its last user
+     */
+    static std::shared_ptr<const PlasmaMLPALLASPhaseSpaceFile> Open(const G4String& path);
+
+    /**
+     * @brief Convert a CSV table into a binary phase-space file.
+     * @param csvFile Input with the columns x,y,z,ux,uy,uz,Ekin,weight (mm, MeV); non-numeric lines are skipped
+     * @param binaryFile Output binary file
+     * @return Number of records written
+     */
+    static size_t ConvertCSV(const G4String& csvFile, const G4String& binaryFile);
+
+    /** Number of macro-particles in the file */
+    size_t GetNumberOfRecords() const { return fCount; }
+
+    /**
+     * @brief Access a record in place; indices past the end wrap around the file.
+     * @param i Record index
+     */
+    const PhaseSpaceRecord& GetRecord(size_t i) const { return fRecords[i % fCount]; }
+
+    /** Path of the mapped file */
+    const G4String& GetPath() const { return fMapping.GetPath(); }
+
+private:
+    explicit PlasmaMLPALLASPhaseSpaceFile(const G4String& path);
+
+    PlasmaMLPALLASMappedFile fMapping;            /**< Read-only mapping of the whole file */
+    const PhaseSpaceRecord* fRecords = nullptr;   /**< First record, inside the mapping */
+    size_t fCount = 0;                            /**< Number of records */
+};
+
+#endif
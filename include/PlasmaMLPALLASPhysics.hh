@@ -17,6 +17,11 @@
  * - Includes EM Option3 physics for improved multiple scattering accuracy
  * - Registers radioactive decay physics for isotope handling
  * - Configures nuclide table thresholds for short-lived isotopes
+ * - Selectable preset (/PlasmaMLPALLAS/physics/setPreset, before /run/initialize):
+ *   "full" (default, the list above), "dose" (standard hadronics without HP
+ *   data nor radioactive decay) or "optics" (EM, decay and fast simulation only)
+ * - Production cuts per region: YAG screens, collimator jaws and the rest of
+ *   the beamline (default region of the world)
  *
  * @note This physics list is optimized for applications involving
  *      plasma physics and detailed nuclear interactions.
@@ -50,8 +55,10 @@
 #include "G4EmExtraPhysics.hh"            ///< Extra EM processes (gamma-nuclear, synchrotron, etc.)
 
 // --- Hadronic Physics (Elastic & Inelastic) ---
+#include "G4HadronElasticPhysics.hh"      ///< Hadron elastic scattering (no HP data)
 #include "G4HadronElasticPhysicsHP.hh"    ///< High-precision neutron elastic scattering
 #include "G4HadronElasticPhysicsXS.hh"    ///< Cross-section based hadron elastic scattering
+#include "G4HadronPhysicsQGSP_BIC.hh"     ///< Binary cascade (no HP data)
 #include "G4HadronPhysicsQGSP_BIC_HP.hh"  ///< Binary cascade + HP neutron physics
 #include "G4HadronPhysicsFTFP_BERT_HP.hh" ///< FTFP_BERT with HP neutron models
 #include "G4HadronPhysicsINCLXX.hh"       ///< Liège intranuclear cascade
@@ -64,6 +71,11 @@
 
 // --- Stopping Physics ---
 #include "G4StoppingPhysics.hh"           ///< Stopping of charged particles (e.g., muons)
+#include "G4FastSimulationPhysics.hh"     ///< Fast simulation (linear-optics transport)
+
+#include <vector>
+
+class PlasmaMLPALLASPhysicsMessenger;
 
 
 // =============================
@@ -93,6 +105,37 @@ public:
     /// Destructor
     virtual ~PlasmaMLPALLASPhysics();
 
+    /// Set of the hadronic and decay modules
+    enum class Preset { Optics, Dose, Full };
+
+    /// Regions with their own production cut
+    enum class CutRegion { Beamline, YAG, Collimators };
+
+    /** Names of the presets, in the order of Preset */
+    static const std::vector<G4String>& GetPresetNames();
+
+    /** Names of the cut regions, in the order of CutRegion */
+    static const std::vector<G4String>& GetCutRegionNames();
+
+    /**
+     * @brief Replace the modules of the current preset (PreInit state only).
+     *
+     * EM, decay and fast simulation are common to all the presets.
+     */
+    void SetPreset(Preset preset);
+    Preset GetPreset() const { return fPreset; }
+
+    /**
+     * @brief Production cut of a region.
+     *
+     * Applied at the next initialisation, or directly to the region if it
+     * already exists (Idle state: the tables are rebuilt at the next run).
+     * The YAG and collimator regions follow the default (beamline) cut until
+     * their own cut is set.
+     */
+    void SetRegionCut(CutRegion region, G4double cut);
+    G4double GetRegionCut(CutRegion region) const;
+
 protected:
     /**
      * @brief Defines default production thresholds for secondary particles.
@@ -101,6 +144,22 @@ protected:
      * Adjust this method to modify cut values globally.
      */
     virtual void SetCuts() override;
+
+private:
+    /// Register the modules of fPreset
+    void RegisterPresetPhysics();
+
+    /// Give its own production cuts to a region of the store (if it exists), the default ones if cut < 0
+    static void SetRegionProductionCuts(const G4String& regionName, G4double cut);
+
+    /// Cut of a region, the default cut while unset
+    G4double EffectiveCut(G4double cut) const { return cut < 0. ? defaultCutValue : cut; }
+
+    Preset fPreset = Preset::Full;                     ///< Current preset
+    std::vector<G4VPhysicsConstructor*> fModules;      ///< Registered modules
+    G4double fYAGCut = -1.;                            ///< Cut in the YAG screens (< 0: default cut)
+    G4double fCollimatorCut = -1.;                     ///< Cut in the collimator jaws (< 0: default cut)
+    PlasmaMLPALLASPhysicsMessenger* fMessenger = nullptr; ///< UI commands
 };
 
 #endif // PlasmaMLPALLASPhysics_h
@@ -0,0 +1,62 @@
+#ifndef PlasmaMLPALLASPhysicsMessenger_H
+#define PlasmaMLPALLASPhysicsMessenger_H
+
+/**
+ * @class PlasmaMLPALLASPhysicsMessenger
+ * @brief Provides UI commands to select the physics preset and the production cuts of the regions
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The physics list is shared by all the threads and configured on the master,
+ * so the commands are not broadcast.
+ */
+
+#include "G4UIcommand.hh"
+#include "G4UIcmdWithAString.hh"                   // for G4UIcmdWithAString
+#include "G4UIdirectory.hh"                        // for G4UIdirectory
+#include "G4UImessenger.hh"
+
+class G4UIcmdWithAString;
+class G4UIcommand;
+class G4UIdirectory;
+
+class PlasmaMLPALLASPhysics;
+
+class PlasmaMLPALLASPhysicsMessenger : public G4UImessenger
+{
+public:
+    /**
+     * @brief Constructor
+     * @param physics Pointer to the physics list
+     */
+    PlasmaMLPALLASPhysicsMessenger(PlasmaMLPALLASPhysics *physics);
+
+    /// Destructor
+    ~PlasmaMLPALLASPhysicsMessenger();
+
+    /**
+     * @brief Executes a command with a new value
+     * @param command Pointer to the issued command
+     * @param newValue String representation of the new value
+     */
+    virtual void SetNewValue(G4UIcommand *command, G4String newValue) final;
+
+    /**
+     * @brief Retrieves the current value of a command
+     * @param command Pointer to the command
+     * @return String representing the current value
+     */
+    virtual G4String GetCurrentValue(G4UIcommand *command) final;
+
+private:
+    /// Associated physics list
+    PlasmaMLPALLASPhysics *fPhysics = nullptr;
+
+    G4UIdirectory *fPhysicsDir = nullptr;     ///< Directory /PlasmaMLPALLAS/physics
+
+    G4UIcmdWithAString *fPresetCmd = nullptr; ///< Set of hadronic and decay modules
+    G4UIcommand *fRegionCutCmd = nullptr;     ///< Production cut of a region
+};
+
+#endif
@@ -19,7 +19,9 @@
 #include "G4ParticleGun.hh"
 #include "G4GeneralParticleSource.hh"
 #include "PlasmaMLPALLASOnnxInference.hh"
-#include "PlasmaMLPALLASOnnxParameters.hh"
+#include "PlasmaMLPALLASBeamSampler.hh"
+#include "PlasmaMLPALLASRunConfig.hh"
+#include "PlasmaMLPALLASPhaseSpaceFile.hh"
 
 // Forward declarations
 class G4ParticleGun;
@@ -48,16 +50,22 @@ public:
     void GeneratePrimaries(G4Event *anEvent) override;
 
     /**
-     * @brief Update the particle definition based on current parameters.
+     * @brief Install the immutable configuration of the run.
+     * @param config Snapshot published at BeginOfRunAction.
      */
-    void UpdateParticleDefinition();
+    void SetRunConfig(std::shared_ptr<const PlasmaMLPALLASRunConfig> config);
 
-    /// @name Laser & beam parameters (retrieved from OnnxParameters)
+    /**
+     * @brief Get the configuration of the current run.
+     */
+    const PlasmaMLPALLASRunConfig &GetRunConfig() const { return *fRunConfig; }
+
+    /// @name Laser & beam parameters (retrieved from the run configuration)
     ///@{
-    double GetML_Xoff() const { return OnnxParameters::Instance().GetXoff(); }       /**< Get X-offset from ONNX parameters */
-    double GetML_A0() const { return OnnxParameters::Instance().GetA0(); }           /**< Get amplitude from ONNX parameters */
-    double GetML_CN2() const { return OnnxParameters::Instance().GetCN2(); }         /**< Get CN2 turbulence parameter */
-    double GetML_Pressure() const { return OnnxParameters::Instance().GetPressure(); } /**< Get pressure value */
+    double GetML_Xoff() const { return fRunConfig->xoff; }         /**< Get X-offset from ONNX parameters */
+    double GetML_A0() const { return fRunConfig->a0; }             /**< Get amplitude from ONNX parameters */
+    double GetML_CN2() const { return fRunConfig->cn2; }           /**< Get CN2 turbulence parameter */
+    double GetML_Pressure() const { return fRunConfig->pressure; } /**< Get pressure value */
     ///@}
 
     /// @name Beam properties
@@ -66,48 +74,40 @@ public:
     double GetdEkin() const { return dEkin * 100.; }        /**< Get energy spread (%) */
     double GetQ() const { return Q * 1e12; }                /**< Get charge (pC) */
     double GetEPSB() const { return epsb * 1e6; }           /**< Get beam emittance (µm) */
+    int GetBunchSize() const { return fRunConfig->bunchSize; } /**< Get number of primaries per event */
     ///@}
 
 private:
     PlasmaMLPALLASPrimaryGeneratorMessenger* fPrimaryGeneratorMessenger = nullptr; /**< Messenger for user interface commands */
 
-    std::unique_ptr<PlasmaMLPALLASOnnxInference> onnxInference; /**< ONNX inference engine */
+    std::unique_ptr<PlasmaMLPALLASOnnxInference> onnxInference; /**< Per-thread run context on the shared ONNX session */
+    PlasmaMLPALLASBeamSampler beamSampler;                      /**< Per-thread block sampler of the source phase space */
     G4ParticleGun* particleGun = nullptr;                       /**< Particle gun for primary generation */
     G4GeneralParticleSource* particleSource = nullptr;          /**< General particle source */
-    G4ParticleDefinition* particleDefinition = nullptr;         /**< Definition of the particle to generate */
+    std::shared_ptr<const PlasmaMLPALLASRunConfig> fRunConfig;  /**< Configuration of the current run */
+    std::shared_ptr<const PlasmaMLPALLASPhaseSpaceFile> phaseSpaceFile; /**< Shared mapping of the phase-space file (status 2) */
+    bool phaseSpaceWrapped = false;                             /**< Whether the end of the phase-space file was reported */
 
     /**
-     * @brief Display progress of event generation.
-     * @param progress Current progress (0.0–1.0).
-     * @param startTime Time when event generation started.
+     * @brief Set the weight of the vertices generated in the current call.
+     * @param anEvent Event holding the vertices.
+     * @param firstVertex Index of the first vertex to weight.
+     * @param weight Statistical weight of each primary.
      */
-    void ShowProgress(double progress, std::chrono::high_resolution_clock::time_point startTime);
+    void SetVertexWeights(G4Event *anEvent, G4int firstVertex, G4double weight);
 
     size_t NEventsGenerated = 0;   /**< Number of events already generated */
     size_t currentEvent = 0;       /**< Current event index */
     size_t numThreads = 0;         /**< Number of threads */
     bool flag_MT = false;          /**< Flag indicating multithreading mode */
-    int threadID = 0;              /**< Thread ID */
     int eventID = 0;               /**< Event ID */
     int nEvent = 0;                /**< Number of events processed */
-    std::chrono::duration<double> elapsedTime; /**< Elapsed time since start */
-    bool isStartTimeInitialized = false;       /**< Flag indicating start time initialized */
-    std::chrono::high_resolution_clock::time_point startTime; /**< Start time */
-    double progressRemaining = 0.;             /**< Remaining progress fraction */
-    double averageTimePerProgress = 0.;        /**< Average time per progress step */
-    double estimatedRemainingTime = 0.;        /**< Estimated remaining time (s) */
 
     // Beam physical parameters
     double Ekin = 1.;   /**< Kinetic energy (MeV) */
     double dEkin = 1.;  /**< Energy spread (%) */
     double Q = 1.;      /**< Beam charge (pC) */
     double epsb = 1.;   /**< Beam emittance (µm) */
-
-    // ONNX session
-    std::unique_ptr<Ort::Session> fSession;          /**< ONNX Runtime session */
-    const OrtMemoryInfo* fMemory_info = nullptr;     /**< Memory information for ONNX session */
-    std::vector<const char*> fInput_node_names = {"input"};   /**< Input node names for ONNX */
-    std::vector<const char*> fOutput_node_names = {"output"}; /**< Output node names for ONNX */
 };
 
 #endif
@@ -17,6 +17,7 @@
 #include "G4UIcmdWithADouble.hh"                   // for G4UIcmdWithADouble
 #include "G4UIcmdWithAnInteger.hh"                 // for G4UIcmdWithAnInteger
 #include "G4UIdirectory.hh"                        // for G4UIdirectory
+#include "G4UIparameter.hh"                        // for G4UIparameter
 #include "PlasmaMLPALLASOnnxParameters.hh"
 #include "G4UImessenger.hh"
 
@@ -59,6 +60,14 @@ public:
     virtual G4String GetCurrentValue(G4UIcommand *command) final;
 
 private:
+    /**
+     * @brief Create a command taking the Twiss alpha, beta and emittance ratio of one plane
+     * @param path Command path
+     * @param plane Plane name used in the guidance
+     * @return New command
+     */
+    G4UIcommand *CreateTwissCommand(const G4String &path, const G4String &plane);
+
     /// Associated primary generator action
     PlasmaMLPALLASPrimaryGeneratorAction *fPrimaryGeneratorAction = nullptr;
 
@@ -70,6 +79,10 @@ private:
     // Gun-related commands
     G4UIcmdWithAnInteger *fGunStatusONNXCmd = nullptr; ///< ONNX usage status
     G4UIcmdWithAString  *fGunParticleNameCmd = nullptr;///< Primary particle name
+    G4UIcmdWithAnInteger *fGunBunchSizeCmd = nullptr;  ///< Number of primaries per event
+    G4UIcmdWithAString  *fGunPhaseSpaceFileCmd = nullptr; ///< Binary phase-space file (status 2)
+    G4UIcommand *fGunTwissXCmd = nullptr;              ///< Source Twiss parameters, x plane
+    G4UIcommand *fGunTwissZCmd = nullptr;              ///< Source Twiss parameters, z plane
 
     // Laser-related commands
     G4UIcmdWithADouble *fLaserOffsetCmd = nullptr;                 ///< Laser focus offset (ML parameter)
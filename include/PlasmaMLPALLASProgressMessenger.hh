@@ -0,0 +1,64 @@
+#ifndef PlasmaMLPALLASProgressMessenger_H
+#define PlasmaMLPALLASProgressMessenger_H
+
+/**
+ * @class PlasmaMLPALLASProgressMessenger
+ * @brief Provides UI commands to configure the progress report
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * This class allows the user to choose the format and the period of the
+ * progress report via the Geant4 UI. The commands are created by the master
+ * and act on the process-wide PlasmaMLPALLASProgressMonitor, so they are not
+ * broadcast to the worker threads.
+ */
+
+#include "G4UIcmdWithAString.hh"                   // for G4UIcmdWithAString
+#include "G4UIcmdWithADoubleAndUnit.hh"            // for G4UIcmdWithADoubleAndUnit
+#include "G4UIdirectory.hh"                        // for G4UIdirectory
+#include "G4UImessenger.hh"
+
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAString;
+class G4UIdirectory;
+
+class PlasmaMLPALLASProgressMonitor;
+
+class PlasmaMLPALLASProgressMessenger : public G4UImessenger
+{
+public:
+    /**
+     * @brief Constructor
+     * @param monitor Pointer to the progress monitor
+     */
+    PlasmaMLPALLASProgressMessenger(PlasmaMLPALLASProgressMonitor *monitor);
+
+    /// Destructor
+    ~PlasmaMLPALLASProgressMessenger();
+
+    /**
+     * @brief Executes a command with a new value
+     * @param command Pointer to the issued command
+     * @param newValue String representation of the new value
+     */
+    virtual void SetNewValue(G4UIcommand *command, G4String newValue) final;
+
+    /**
+     * @brief Retrieves the current value of a command
+     * @param command Pointer to the command
+     * @return String representing the current value
+     */
+    virtual G4String GetCurrentValue(G4UIcommand *command) final;
+
+private:
+    /// Associated progress monitor
+    PlasmaMLPALLASProgressMonitor *fMonitor = nullptr;
+
+    G4UIdirectory *fProgressDir = nullptr;             ///< Directory /PlasmaMLPALLAS/progress
+
+    G4UIcmdWithAString *fModeCmd = nullptr;            ///< Report format (bar, machine, off)
+    G4UIcmdWithADoubleAndUnit *fIntervalCmd = nullptr; ///< Report period
+};
+
+#endif
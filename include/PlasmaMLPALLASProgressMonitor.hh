@@ -0,0 +1,125 @@
+#ifndef PlasmaMLPALLASProgressMonitor_h
+#define PlasmaMLPALLASProgressMonitor_h 1
+
+/**
+ * @class PlasmaMLPALLASProgressMonitor
+ * @brief Throttled progress and throughput report of the event loop.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * Each thread owns one event counter on its own cache line and only bumps it
+ * at the end of an event, with no shared write and no clock read. A reporter
+ * thread, started by the master at BeginOfRunAction, aggregates the counters
+ * on a timer (1 s by default) and prints the overall and per-thread event
+ * rates with an ETA, either as a progress bar or as machine-readable lines.
+ *
+ * The singleton is created by the master (PlasmaMLPALLASActionInitialization),
+ * which owns the /PlasmaMLPALLAS/progress/ commands.
+ */
+
+#include "globals.hh"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class PlasmaMLPALLASProgressMessenger;
+
+class PlasmaMLPALLASProgressMonitor
+{
+public:
+    /// Output format of the report
+    enum class Mode { Off, Bar, Machine };
+
+    /**
+     * @brief Event counter of one thread, alone on its cache line.
+     *
+     * Only its owner thread writes it, so the increment is a plain relaxed
+     * load/store and never a locked read-modify-write.
+     */
+    struct alignas(64) Counter {
+        std::atomic<std::uint64_t> events{0}; ///< Events completed by the thread
+        G4int threadID = 0;                   ///< Geant4 thread ID of the owner
+
+        /** Count one completed event (owner thread only) */
+        void Increment() { events.store(events.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+    };
+
+    /**
+     * @brief Access the singleton instance.
+     * @return Reference to the process-wide monitor.
+     */
+    static PlasmaMLPALLASProgressMonitor& Instance();
+
+    /**
+     * @brief Get a counter for the calling thread.
+     * @return Counter with a stable address for the lifetime of the process
+     */
+    Counter& RegisterThread();
+
+    /**
+     * @brief Start reporting a run (master thread).
+     * @param nEvents Number of events to process in the run
+     */
+    void Start(G4int nEvents);
+
+    /**
+     * @brief Stop the reporter and print the final summary (master thread).
+     */
+    void Stop();
+
+    /// @name Configuration
+    ///@{
+    void SetMode(Mode mode) { fMode = mode; }              /**< Set the output format */
+    void SetInterval(G4double seconds) { fInterval = seconds; } /**< Set the report period (s) */
+
+    Mode GetMode() const { return fMode; }                 /**< Get the output format */
+    G4double GetInterval() const { return fInterval; }     /**< Get the report period (s) */
+    ///@}
+
+private:
+    PlasmaMLPALLASProgressMonitor();
+    ~PlasmaMLPALLASProgressMonitor();
+
+    PlasmaMLPALLASProgressMonitor(const PlasmaMLPALLASProgressMonitor&) = delete;            /**< Delete copy constructor */
+    PlasmaMLPALLASProgressMonitor& operator=(const PlasmaMLPALLASProgressMonitor&) = delete; /**< Delete assignment operator */
+
+    /**
+     * @brief Body of the reporter thread.
+     */
+    void Loop();
+
+    /**
+     * @brief Aggregate the counters and print one report.
+     * @param final Whether this is the summary printed at the end of the run
+     */
+    void Report(bool final);
+
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<std::unique_ptr<Counter>> fCounters; /**< One counter per registered thread */
+    std::vector<std::uint64_t> fBaseline;            /**< Counter values at the start of the run */
+    std::vector<std::uint64_t> fLast;                /**< Counter values at the previous report */
+    std::mutex fCountersMutex;                       /**< Protects the counter list */
+
+    Mode fMode = Mode::Bar;                          /**< Output format */
+    G4double fInterval = 1.;                         /**< Report period (s) */
+
+    G4int fEventsToProcess = 0;                      /**< Events of the current run */
+    Clock::time_point fStartTime;                    /**< Start of the current run */
+    Clock::time_point fLastTime;                     /**< Time of the previous report */
+
+    std::thread fReporter;                           /**< Reporter thread */
+    std::mutex fStopMutex;                           /**< Protects fStopRequested */
+    std::condition_variable fStopCondition;          /**< Wakes the reporter up on Stop() */
+    bool fStopRequested = false;                     /**< Set by Stop() */
+
+    PlasmaMLPALLASProgressMessenger* fMessenger = nullptr; /**< UI commands /PlasmaMLPALLAS/progress/ */
+};
+
+#endif
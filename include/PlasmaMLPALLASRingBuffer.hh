@@ -0,0 +1,88 @@
+#ifndef PlasmaMLPALLASRingBuffer_h
+#define PlasmaMLPALLASRingBuffer_h 1
+
+/**
+ * @class PlasmaMLPALLASRingBuffer
+ * @brief Bounded lock-free queue with one producer thread and one consumer thread.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The producer only writes the tail and the consumer only writes the head,
+ * each on its own cache line: a push or a pop is one acquire load of the
+ * other index (skipped while the cached copy says there is room or data)
+ * and one release store, with no lock and no read-modify-write. The
+ * capacity is rounded up to a power of two.
+ *
+ * Used by the asynchronous output (PlasmaMLPALLASOutputTable) to hand the
+ * rows of a worker thread over to a writer thread, and back.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+template <typename T>
+class PlasmaMLPALLASRingBuffer
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param capacity Minimum number of elements held
+     */
+    explicit PlasmaMLPALLASRingBuffer(std::size_t capacity) : fSlots(RoundUp(capacity)), fMask(fSlots.size() - 1) {}
+
+    PlasmaMLPALLASRingBuffer(const PlasmaMLPALLASRingBuffer&) = delete;            /**< Delete copy constructor */
+    PlasmaMLPALLASRingBuffer& operator=(const PlasmaMLPALLASRingBuffer&) = delete; /**< Delete assignment operator */
+
+    /** @brief Append an element (producer thread). @return False if the queue is full */
+    bool TryPush(const T& value)
+    {
+        const std::size_t tail = fTail.load(std::memory_order_relaxed);
+        if (tail - fHeadCache == fSlots.size())
+        {
+            fHeadCache = fHead.load(std::memory_order_acquire);
+            if (tail - fHeadCache == fSlots.size())
+                return false;
+        }
+        fSlots[tail & fMask] = value;
+        fTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** @brief Take the oldest element (consumer thread). @return False if the queue is empty */
+    bool TryPop(T& value)
+    {
+        const std::size_t head = fHead.load(std::memory_order_relaxed);
+        if (head == fTailCache)
+        {
+            fTailCache = fTail.load(std::memory_order_acquire);
+            if (head == fTailCache)
+                return false;
+        }
+        value = fSlots[head & fMask];
+        fHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t Capacity() const { return fSlots.size(); }
+
+private:
+    static std::size_t RoundUp(std::size_t n)
+    {
+        std::size_t capacity = 1;
+        while (capacity < n)
+            capacity <<= 1;
+        return capacity;
+    }
+
+    std::vector<T> fSlots;
+    const std::size_t fMask;
+
+    alignas(64) std::atomic<std::size_t> fHead{0}; ///< Next element to pop (written by the consumer)
+    std::size_t fTailCache = 0;                    ///< Tail last seen by the consumer
+    alignas(64) std::atomic<std::size_t> fTail{0}; ///< Next slot to fill (written by the producer)
+    std::size_t fHeadCache = 0;                    ///< Head last seen by the producer
+};
+
+#endif
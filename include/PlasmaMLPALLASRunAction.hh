@@ -13,7 +13,7 @@
  * It handles:
  *  - Collection and storage of run-wide statistics
  *  - ROOT file and tree creation for data output
- *  - Synchronization in multithreaded runs
+ *  - Synchronization in multithreaded runs (file open and close only)
  *  - Coordination with primary generator and geometry configuration
  *
  * The associated `RunTallyGlobalInput` struct stores simulation configuration
@@ -40,10 +40,17 @@
 #include "TFile.h"                  // ROOT file I/O
 #include "TTree.h"
 #include "TBranch.h"
+#include <memory>
 #include <mutex>
 #include "PlasmaMLPALLASPrimaryGeneratorAction.hh"
 #include "PlasmaMLPALLASGeometryConstruction.hh"
 #include "PlasmaMLPALLASEventAction.hh" 
+#include "PlasmaMLPALLASSpotAccumulable.hh"
+#include "PlasmaMLPALLASBeamMoments.hh"
+#include "PlasmaMLPALLASScreenImage.hh"
+#include "PlasmaMLPALLASFieldStatistics.hh"
+#include "PlasmaMLPALLASOutputTable.hh"
+#include <array>
 
 
 // Forward declarations
@@ -84,6 +91,18 @@ struct RunTallyGlobalInput {
   float Q3Q4Distance = 0.0;       
   float B_Dipole = 0.0;           
   int B_Dipole_Map = 0;            
+  int BunchSize = 1;
+
+  // --- Field cost counters of the thread (/PlasmaMLPALLAS/field/setStatusFieldStatistics) ---
+  std::array<Long64_t, PlasmaMLPALLASFieldStatistics::kNumRegions> FieldCalls{};
+  std::array<Long64_t, PlasmaMLPALLASFieldStatistics::kNumDrivers> ChordSteps{};
+  std::array<Long64_t, PlasmaMLPALLASFieldStatistics::kNumDrivers> FieldTracks{};
+  std::array<float, PlasmaMLPALLASFieldStatistics::kNumDrivers> FieldTime{};
+  float RunTime = 0.0;
+
+  // --- Kills of the thread per kill zone (/PlasmaMLPALLAS/killzone/) ---
+  std::vector<std::string> KillZoneNames;
+  std::vector<int> KillZoneCounts;
 
   /**
    * @brief Populate structure from generator and geometry settings.
@@ -114,24 +133,36 @@ public:
   /// Destructor
   ~PlasmaMLPALLASRunAction();
 
+  /// Name of the spot accumulable of the primaries on BS1_YAG
+  static constexpr const char* BSYAGSpotName = "BSYAGSpot";
+
   /// Called at the start of each run
   void BeginOfRunAction(const G4Run* run) override;
 
   /// Called at the end of each run
   void EndOfRunAction(const G4Run* run) override;
 
-  /// Generic template to update cumulative statistics in a ROOT tree
+  /// Generic template to hand a row over to an output table (buffers swapped, not copied)
   template<typename T>
-  void UpdateStatistics(T& stats, const T& newStats, TTree* tree);
+  void UpdateStatistics(T& stats, T& newStats, PlasmaMLPALLASOutputTable& table);
+
+  /// Generic template to fill one row per selected primary (tables of the thread, no lock)
+  template<typename T, typename Selector>
+  void UpdateStatistics(T& stats, const std::vector<T>& rows, PlasmaMLPALLASOutputTable& table, Selector select);
 
   // --- Specific statistics update methods ---
-  void UpdateStatisticsGlobalInput(RunTallyGlobalInput);
-  void UpdateStatisticsInput(RunTallyInput);
-  void UpdateStatisticsQuadrupoles(RunTallyQuadrupoles);
-  void UpdateStatisticsHorizontalColl(RunTallyCollimators);
-  void UpdateStatisticsVerticalColl(RunTallyCollimators);
-  void UpdateStatisticsBSYAG(RunTallyYAG);
-  void UpdateStatisticsBSPECYAG(RunTallyYAG);
+  void UpdateStatisticsGlobalInput(RunTallyGlobalInput&);
+  void UpdateStatisticsInput(const std::vector<RunTallyInput>&);
+  void UpdateStatisticsQuadrupoles(const std::vector<RunTallyQuadrupoles>&);
+  void UpdateStatisticsHorizontalColl(const std::vector<RunTallyCollimators>&);
+  void UpdateStatisticsVerticalColl(const std::vector<RunTallyCollimators>&);
+  /// The YAG tally of the event is swapped with the row of the run action: it gets back
+  /// the buffers of the previous row, to be cleared (capacity kept) at the next event
+  void UpdateStatisticsBSYAG(RunTallyYAG&);
+  void UpdateStatisticsBSPECYAG(RunTallyYAG&);
+
+  /// Count the event of the thread and flush its tables every setFlushEvents events or setFlushSize bytes
+  void EndOfEvent();
 
   /// Set the primary generator reference
   void SetPrimaryGenerator(PlasmaMLPALLASPrimaryGeneratorAction* gen);
@@ -140,6 +171,27 @@ public:
   void SetGeometry(PlasmaMLPALLASGeometryConstruction* geom);
 
 private:
+  /// Declare the columns of the tables, bound to the statistics structures
+  void DefineTables();
+
+  /// Create the ROOT file and the tables of the thread
+  void OpenOutput();
+
+  /// Tables of the final file, in writing order (per-event ones only with event output)
+  std::vector<PlasmaMLPALLASOutputTable*> GetTables();
+
+  /// Tables filled by this thread: the beam summary and the raw images on the master, the others on the workers
+  std::vector<PlasmaMLPALLASOutputTable*> GetThreadTables();
+
+  /// Write the entries filled so far by the thread (tables and file of the thread)
+  void FlushOutput();
+
+  /// Fill the BeamSummary row of the run from the merged moments (master)
+  void WriteBeamSummary();
+
+  /// Write the merged screen images as TH2D, or as the ScreenImages row of the run (master)
+  void WriteImages();
+
   // --- Output configuration ---
   G4String suffixe;     ///< File suffix for ROOT outputs
   G4String fileName;    ///< Base file name for ROOT outputs
@@ -153,25 +205,48 @@ private:
   RunTallyYAG StatsBSYAG;
   RunTallyYAG StatsBSPECYAG;
 
+  /// Moments of the primaries on BS1_YAG, merged into the master at EndOfRunAction
+  PlasmaMLPALLASSpotAccumulable fBSYAGSpot{BSYAGSpotName};
+
+  /// Planes of the beam moments: input, entrance and exit of Q1..Q4, YAG screens
+  enum MomentsPlane { kInputPlane = 0, kQuadrupolePlanes = 1, kBSYAGPlane = 9, kBSPECYAGPlane = 10, kNPlanes = 11 };
+  std::vector<std::unique_ptr<PlasmaMLPALLASBeamMoments>> fMoments;  ///< Beam moments per plane, merged into the master
+  std::vector<PlasmaMLPALLASBeamMoments::Summary> fMomentsSummary;    ///< Values of the BeamSummary columns per plane
+  std::vector<float> fPrimaryWeights;  ///< Weights of the primaries of the event, by track ID - 1
+
+  /// Images of the YAG screens, in the order of PlasmaMLPALLASOutputManager::GetImageNames()
+  enum ScreenImage { kBSYAGHits = 0, kBSYAGEdep, kBSPECYAGHits, kBSPECYAGEdep, kBSPECYAGSpectrum, kNImages };
+  std::vector<std::unique_ptr<PlasmaMLPALLASScreenImage>> fImages; ///< Screen images, merged into the master
+  std::vector<PlasmaMLPALLASScreenImage::Raw> fImagesRaw;          ///< Values of the ScreenImages columns per image
+  std::vector<G4bool> fImageEnabled;   ///< Images selected by setTable (read at BeginOfRunAction)
+
   size_t NEventsGenerated; ///< Number of events generated in the run
   G4bool flag_MT;          ///< Multithreading enabled flag
 
-  // --- ROOT file and trees ---
-  TFile *f = nullptr;
-  TTree *Tree_GlobalInput = nullptr;
-  TTree *Tree_Input = nullptr;
-  TTree *Tree_Quadrupoles = nullptr;
-  TTree *Tree_HorizontalColl = nullptr;
-  TTree *Tree_VerticalColl = nullptr;
-  TTree *Tree_BSYAG = nullptr;
-  TTree *Tree_BSPECYAG = nullptr;
-  TBranch *RunBranch = nullptr;
+  // --- ROOT file and tables (TTrees or RNTuples) ---
+  std::shared_ptr<TFile> f;   ///< Final file (sequential) or file of the merger (worker)
+  G4bool fOutputOpen = false; ///< The tables of the thread are open
+  G4bool fEventOutput = true; ///< Per-event tables written (setEventOutput, read when the output opens)
+  G4bool fRawImages = false;  ///< Screen images in the ScreenImages table (setImageFormat raw, read when the output opens)
+  PlasmaMLPALLASOutputTable Table_GlobalInput{"GlobalInput", "Global Input Information"};
+  PlasmaMLPALLASOutputTable Table_Input{"Input", "Input Information"};
+  PlasmaMLPALLASOutputTable Table_Quadrupoles{"QuadrupolesTracking", "Quadrupoles Tracking Information"};
+  PlasmaMLPALLASOutputTable Table_HorizontalColl{"Horizontal_Coll", "Horizontal Collimator Information"};
+  PlasmaMLPALLASOutputTable Table_VerticalColl{"Vertical_Coll", "Vertical Collimator Information"};
+  PlasmaMLPALLASOutputTable Table_BSYAG{"BSYAG", "BS YAG Information"};
+  PlasmaMLPALLASOutputTable Table_BSPECYAG{"BSPECYAG", "BSPEC YAG Information"};
+  PlasmaMLPALLASOutputTable Table_BeamSummary{"BeamSummary", "Beam moments per run"};
+  PlasmaMLPALLASOutputTable Table_ScreenImages{"ScreenImages", "Screen images per run"};
+  int fScanIndex = 0;   ///< Index of the scan point, written in every table
+  G4int fFlushEvents = 0;       ///< Events between flushes (setFlushEvents, read at BeginOfRunAction)
+  Long64_t fFlushSize = 0;      ///< Filled bytes between flushes (setFlushSize, read at BeginOfRunAction)
+  G4int fEventsSinceFlush = 0;  ///< Events of the thread since the last flush
 
   time_t start; ///< Start time of the run
 
   // --- Thread-safety ---
   static std::atomic<int> activeThreads;
-  static G4Mutex fileMutex;
+  static G4Mutex fileMutex;   ///< Creation and closing of the files only, never held by TTree::Fill
 
 protected:
   PlasmaMLPALLASPrimaryGeneratorAction* fPrimaryGenerator = nullptr; ///< Primary generator reference
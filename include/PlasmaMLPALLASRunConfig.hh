@@ -0,0 +1,52 @@
+#ifndef PlasmaMLPALLASRunConfig_h
+#define PlasmaMLPALLASRunConfig_h 1
+
+/**
+ * @class PlasmaMLPALLASRunConfig
+ * @brief Immutable snapshot of the generator configuration of one run.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The snapshot is published by each thread at BeginOfRunAction from the
+ * values staged in OnnxParameters, with the particle definition already
+ * resolved. The event loop then only reads this thread-owned, constant
+ * object: no atomic, lock or particle table lookup is left per event.
+ */
+
+#include "globals.hh"
+#include "PlasmaMLPALLASBeamSampler.hh"
+#include <cstdint>
+#include <memory>
+
+class G4ParticleDefinition;
+
+struct PlasmaMLPALLASRunConfig
+{
+    std::uint64_t version = 0;                     ///< Publication number (0 before the first run)
+
+    G4String particleName;                         ///< Name of the primary particle
+    G4ParticleDefinition* particle = nullptr;      ///< Resolved primary particle (nullptr if unknown)
+
+    G4int statusONNX = 0;                          ///< Generation mode (0 GPS, 1 ONNX, 2 phase-space file)
+    G4double xoff = 0.;                            ///< Laser focus offset
+    G4double a0 = 0.;                              ///< Normalized vector potential
+    G4double cn2 = 0.;                             ///< Dopant fraction in the target chamber
+    G4double pressure = 0.;                        ///< Gas pressure
+
+    TwissParameters twissX{0., 1., 0.4};           ///< Source optics, x plane
+    TwissParameters twissZ;                        ///< Source optics, z plane
+
+    G4int bunchSize = 1;                           ///< Primaries per event
+    G4long firstEvent = 0;                         ///< Events of the job before this run (chunks of a checkpointed or MPI job)
+
+    G4String phaseSpaceFile;                       ///< Binary phase-space file read in mode 2
+
+    /**
+     * @brief Freeze the parameters staged by the calling thread into a new snapshot.
+     * @return New immutable configuration, with a fresh version number
+     */
+    static std::shared_ptr<const PlasmaMLPALLASRunConfig> Publish();
+};
+
+#endif
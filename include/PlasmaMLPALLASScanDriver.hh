@@ -0,0 +1,99 @@
+#ifndef PlasmaMLPALLASScanDriver_h
+#define PlasmaMLPALLASScanDriver_h 1
+
+/**
+ * @class PlasmaMLPALLASScanDriver
+ * @brief In-process scan of ONNX working points in one initialised kernel.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The scan holds a list of (Xoff, A0, CN2, Pressure) tuples, filled point by
+ * point or from a grid. Running it applies the /PlasmaMLPALLAS/laser/ commands
+ * of each point (so that they are broadcast to the worker threads like any
+ * macro command) and calls /run/beamOn, without rebuilding the geometry, the
+ * physics tables or the ONNX session between points.
+ *
+ * All the points are written to the same output file: the run actions keep
+ * their file open until the last point and tag every tree entry with the
+ * index of the point, read here at BeginOfRunAction.
+ *
+ * The singleton is created by the master (PlasmaMLPALLASActionInitialization),
+ * which owns the /PlasmaMLPALLAS/scan/ commands.
+ */
+
+#include "globals.hh"
+#include <array>
+#include <atomic>
+#include <vector>
+
+struct OnnxGridAxis;
+class PlasmaMLPALLASScanMessenger;
+
+class PlasmaMLPALLASScanDriver
+{
+public:
+    /// One working point: Xoff, A0, CN2 and Pressure, in this order
+    using Point = std::array<G4double, 4>;
+
+    /**
+     * @brief Access the singleton instance.
+     * @return Reference to the process-wide scan driver.
+     */
+    static PlasmaMLPALLASScanDriver& Instance();
+
+    /**
+     * @brief Append one working point to the scan.
+     * @param point Laser/plasma inputs of the point
+     */
+    void AddPoint(const Point& point);
+
+    /**
+     * @brief Append the cartesian product of four input axes to the scan.
+     * @param axes Grid axes for Xoff, A0, CN2 and Pressure
+     * @return Number of points appended
+     */
+    size_t AddGrid(const std::array<OnnxGridAxis, 4>& axes);
+
+    /**
+     * @brief Remove all the points of the scan.
+     */
+    void Clear() { fPoints.clear(); }
+
+    /**
+     * @brief Run every point of the scan (master thread, Idle state).
+     * @param nEventsPerPoint Number of events simulated for each point
+     */
+    void Run(G4int nEventsPerPoint);
+
+    /// @name Accessors for the run actions
+    ///@{
+    const std::vector<Point>& GetPoints() const { return fPoints; }                   /**< Points of the scan */
+    G4int GetScanIndex() const { return fScanIndex.load(); }                           /**< Index of the running point (0 outside a scan) */
+    G4int GetEventsPerPoint() const { return fEventsPerPoint.load(); }                 /**< Events of each point of the running scan */
+    G4bool IsRunning() const { return fRunning.load(); }                               /**< Whether a scan is in progress */
+    G4bool KeepOutputOpen() const { return fKeepOutputOpen.load(); }                   /**< Whether more points follow the current run */
+    G4bool HasRun() const { return fHasRun; }                                          /**< Whether a scan has been run in this process */
+    ///@}
+
+private:
+    PlasmaMLPALLASScanDriver();
+    ~PlasmaMLPALLASScanDriver();
+
+    PlasmaMLPALLASScanDriver(const PlasmaMLPALLASScanDriver&) = delete;            /**< Delete copy constructor */
+    PlasmaMLPALLASScanDriver& operator=(const PlasmaMLPALLASScanDriver&) = delete; /**< Delete assignment operator */
+
+    std::vector<Point> fPoints;               /**< Working points of the scan */
+
+    // Read by the run actions of every thread
+    std::atomic<G4int> fScanIndex{0};         /**< Index of the running point */
+    std::atomic<G4int> fEventsPerPoint{0};    /**< Events of each point */
+    std::atomic<G4bool> fRunning{false};      /**< A scan is in progress */
+    std::atomic<G4bool> fKeepOutputOpen{false}; /**< More points follow the current run */
+
+    G4bool fHasRun = false;                   /**< A scan has been run */
+
+    PlasmaMLPALLASScanMessenger* fMessenger = nullptr; /**< UI commands /PlasmaMLPALLAS/scan/ */
+};
+
+#endif
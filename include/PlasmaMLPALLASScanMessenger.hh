@@ -0,0 +1,70 @@
+#ifndef PlasmaMLPALLASScanMessenger_H
+#define PlasmaMLPALLASScanMessenger_H
+
+/**
+ * @class PlasmaMLPALLASScanMessenger
+ * @brief Provides UI commands to define and run a scan of ONNX working points
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * This class allows the user to fill the list of (Xoff, A0, CN2, Pressure)
+ * working points point by point or from a grid, and to run them all in the
+ * current kernel. The commands are created by the master and act on the
+ * process-wide PlasmaMLPALLASScanDriver, so they are not broadcast to the
+ * worker threads.
+ */
+
+#include "G4UIcommand.hh"
+#include "G4UIcmdWithAnInteger.hh"                 // for G4UIcmdWithAnInteger
+#include "G4UIcmdWithoutParameter.hh"              // for G4UIcmdWithoutParameter
+#include "G4UIdirectory.hh"                        // for G4UIdirectory
+#include "G4UImessenger.hh"
+
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithoutParameter;
+class G4UIcommand;
+class G4UIdirectory;
+
+class PlasmaMLPALLASScanDriver;
+
+class PlasmaMLPALLASScanMessenger : public G4UImessenger
+{
+public:
+    /**
+     * @brief Constructor
+     * @param driver Pointer to the scan driver
+     */
+    PlasmaMLPALLASScanMessenger(PlasmaMLPALLASScanDriver *driver);
+
+    /// Destructor
+    ~PlasmaMLPALLASScanMessenger();
+
+    /**
+     * @brief Executes a command with a new value
+     * @param command Pointer to the issued command
+     * @param newValue String representation of the new value
+     */
+    virtual void SetNewValue(G4UIcommand *command, G4String newValue) final;
+
+    /**
+     * @brief Retrieves the current value of a command
+     * @param command Pointer to the command
+     * @return String representing the current value
+     */
+    virtual G4String GetCurrentValue(G4UIcommand *command) final;
+
+private:
+    /// Associated scan driver
+    PlasmaMLPALLASScanDriver *fDriver = nullptr;
+
+    G4UIdirectory *fScanDir = nullptr;           ///< Directory /PlasmaMLPALLAS/scan
+
+    G4UIcommand *fAddPointCmd = nullptr;         ///< Append one working point
+    G4UIcommand *fSetGridCmd = nullptr;          ///< Append a grid of working points
+    G4UIcmdWithoutParameter *fClearCmd = nullptr; ///< Remove all the points
+    G4UIcmdWithoutParameter *fListCmd = nullptr; ///< Print the points
+    G4UIcmdWithAnInteger *fRunCmd = nullptr;     ///< Run all the points
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef PlasmaMLPALLASScreenImage_h
+#define PlasmaMLPALLASScreenImage_h 1
+
+/**
+ * @class PlasmaMLPALLASScreenImage
+ * @brief Binned image of a YAG screen, accumulated by every thread and merged at the end of the run.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * Replaces the histogramming of the per-hit vectors of the BSYAG and
+ * BSPECYAG tables by the routine analysis: each passage adds its weight
+ * (counts) or its deposited energy (light of the camera) to a bin of a
+ * fixed grid, and the worker images are summed into the master one by
+ * G4AccumulableManager. The bins follow the global numbering of ROOT
+ * (under- and overflows included), so the image maps to a TH2D as is; the
+ * raw form keeps the in-range pixels only, row after row, as a camera does.
+ */
+
+#include "G4VAccumulable.hh"
+#include <vector>
+
+class PlasmaMLPALLASScreenImage : public G4VAccumulable
+{
+public:
+    /// Grid of the image: horizontal axis u, vertical axis v
+    struct Binning
+    {
+        G4int nx = 100;
+        G4double xmin = -5., xmax = 5.;
+        G4int ny = 100;
+        G4double ymin = -5., ymax = 5.;
+    };
+
+    /// In-range pixels of the image, written in the raw format
+    struct Raw
+    {
+        std::vector<float> pixels; ///< nx x ny values, row v = ymin first
+        int nx = 0, ny = 0;
+        float xmin = 0., xmax = 0., ymin = 0., ymax = 0.;
+    };
+
+    /**
+     * @brief Constructor.
+     * @param name Name of the image in the output
+     * @param binning Grid of the image
+     */
+    PlasmaMLPALLASScreenImage(const G4String& name, const Binning& binning);
+
+    /** @brief Change the grid (before the run: the image is emptied). */
+    void SetBinning(const Binning& binning);
+    const Binning& GetBinning() const { return fBinning; }
+
+    /**
+     * @brief Add one passage.
+     * @param u Horizontal coordinate
+     * @param v Vertical coordinate
+     * @param weight Value added to the bin (ignored if zero or not a number)
+     */
+    void Fill(G4double u, G4double v, G4double weight);
+
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+
+    G4long GetEntries() const { return fEntries; } /**< Number of passages filled */
+
+    /** Content of a bin in the global numbering of ROOT, i + (nx + 2) j */
+    G4double GetBinContent(G4int bin) const { return fBins[static_cast<size_t>(bin)]; }
+    G4int GetNumberOfBins() const { return static_cast<G4int>(fBins.size()); }
+
+    /** In-range pixels and grid, in single precision */
+    Raw GetRaw() const;
+
+private:
+    /** Index of a coordinate along an axis: 0 underflow, n + 1 overflow */
+    static G4int AxisBin(G4double value, G4int n, G4double min, G4double max);
+
+    Binning fBinning;
+    G4long fEntries = 0;
+    std::vector<G4double> fBins; ///< (nx + 2) x (ny + 2) bins
+};
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef PlasmaMLPALLASSensitiveDetectors_h
+#define PlasmaMLPALLASSensitiveDetectors_h 1
+
+/**
+ * @file PlasmaMLPALLASSensitiveDetectors.hh
+ * @brief Sensitive detectors of the quadrupole boundaries, the collimators and the YAG screens.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The detectors are attached to the scored logical volumes in
+ * PlasmaMLPALLASGeometryConstruction::ConstructSDandField (one instance per
+ * thread), so only the steps made inside these volumes reach user code.
+ * They reproduce the selections of the former stepping action, except for
+ * the quadrupoles:
+ *  - quadrupoles: primaries entering (pre-step point on the boundary) and
+ *    leaving into the holder (post-step point), Q1..Q4 for one detector.
+ *    The former stepping action also let any secondary crossing a boundary
+ *    overwrite the record of the event; the tallies are now one row per
+ *    primary, so the secondaries are left out on purpose;
+ *  - collimators: first entry of a primary in the horizontal collimator, and
+ *    first step of a primary in the vertical one if it did not touch the
+ *    horizontal one before;
+ *  - YAG screens: one hit per passage of any particle, closed when the
+ *    particle leaves into the holder or stops.
+ *
+ * The hits collections are turned into the RunTally* structures by
+ * PlasmaMLPALLASEventAction::EndOfEventAction.
+ */
+
+#include "G4VSensitiveDetector.hh"
+#include "PlasmaMLPALLASHits.hh"
+#include "PlasmaMLPALLASVolumeRoles.hh"
+#include <vector>
+
+/**
+ * @class PlasmaMLPALLASQuadrupoleSD
+ * @brief Boundary crossings of the quadrupole field volumes by the primaries.
+ */
+class PlasmaMLPALLASQuadrupoleSD : public G4VSensitiveDetector
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param name Name of the detector (collection "<name>/Hits")
+     * @param volumeRoles Role table of the geometry
+     */
+    PlasmaMLPALLASQuadrupoleSD(const G4String& name, const PlasmaMLPALLASVolumeRoles& volumeRoles);
+
+    void Initialize(G4HCofThisEvent* hce) override;
+    G4bool ProcessHits(G4Step* step, G4TouchableHistory*) override;
+
+private:
+    /** @brief Store the crossing of a step point. */
+    void AddHit(const G4Track* track, const G4StepPoint* point, QuadID quad, PositionType posType, G4double energy);
+
+    const PlasmaMLPALLASVolumeRoles& fVolumeRoles;              ///< Role of the physical volumes
+    PlasmaMLPALLASQuadrupoleHitsCollection* fHits = nullptr; ///< Hits of the current event
+};
+
+/**
+ * @class PlasmaMLPALLASCollimatorSD
+ * @brief First interaction of the primaries with the horizontal and vertical collimators.
+ *
+ * One detector for both collimators, as the vertical tally depends on the
+ * horizontal one: two collections, "<name>/Horizontal" and "<name>/Vertical".
+ */
+class PlasmaMLPALLASCollimatorSD : public G4VSensitiveDetector
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param name Name of the detector
+     * @param volumeRoles Role table of the geometry
+     */
+    PlasmaMLPALLASCollimatorSD(const G4String& name, const PlasmaMLPALLASVolumeRoles& volumeRoles);
+
+    void Initialize(G4HCofThisEvent* hce) override;
+    G4bool ProcessHits(G4Step* step, G4TouchableHistory*) override;
+
+private:
+    /** @brief Flag of a primary, growing with the track IDs of the bunch. */
+    static char& Flag(std::vector<char>& flags, G4int trackID);
+
+    const PlasmaMLPALLASVolumeRoles& fVolumeRoles;             ///< Role of the physical volumes
+    PlasmaMLPALLASCollimatorHitsCollection* fHorizontal = nullptr; ///< Horizontal hits of the current event
+    PlasmaMLPALLASCollimatorHitsCollection* fVertical = nullptr;   ///< Vertical hits of the current event
+    std::vector<char> fHorizontalFlags; ///< Primaries already seen by the horizontal collimator
+    std::vector<char> fVerticalFlags;   ///< Primaries already seen by the vertical collimator
+};
+
+/**
+ * @class PlasmaMLPALLASYAGSD
+ * @brief Passages of the particles through a YAG screen.
+ */
+class PlasmaMLPALLASYAGSD : public G4VSensitiveDetector
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param name Name of the detector (collection "<name>/Hits")
+     * @param volumeRoles Role table of the geometry
+     */
+    PlasmaMLPALLASYAGSD(const G4String& name, const PlasmaMLPALLASVolumeRoles& volumeRoles);
+
+    void Initialize(G4HCofThisEvent* hce) override;
+    G4bool ProcessHits(G4Step* step, G4TouchableHistory*) override;
+
+    /** Hits of the current event so far (see PlasmaMLPALLASStackingAction) */
+    size_t GetNumberOfHits() const { return fHits ? fHits->entries() : 0; }
+
+private:
+    const PlasmaMLPALLASVolumeRoles& fVolumeRoles;       ///< Role of the physical volumes
+    PlasmaMLPALLASYAGHitsCollection* fHits = nullptr; ///< Hits of the current event
+    PlasmaMLPALLASYAGHit* fOpenHit = nullptr;         ///< Passage in progress
+};
+
+#endif
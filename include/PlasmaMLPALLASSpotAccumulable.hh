@@ -0,0 +1,74 @@
+#ifndef PlasmaMLPALLASSpotAccumulable_h
+#define PlasmaMLPALLASSpotAccumulable_h 1
+
+/**
+ * @class PlasmaMLPALLASSpotAccumulable
+ * @brief Weighted first and second moments of the primaries reaching a screen.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * Each run action owns one accumulable per screen, registered in the
+ * G4AccumulableManager of its thread: the sums are reset at BeginOfRunAction
+ * and the worker sums are merged into the master ones at EndOfRunAction, so
+ * that the master reads the spot of the whole run (PlasmaMLPALLASOptimiser)
+ * without going back to the ROOT trees.
+ */
+
+#include "G4VAccumulable.hh"
+#include <algorithm>
+#include <cmath>
+
+class PlasmaMLPALLASSpotAccumulable : public G4VAccumulable
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param name Name under which the accumulable is registered
+     */
+    explicit PlasmaMLPALLASSpotAccumulable(const G4String& name) : G4VAccumulable(name) {}
+
+    /**
+     * @brief Add one particle on the screen.
+     * @param x Position along x (mm)
+     * @param z Position along z (mm)
+     * @param weight Statistical weight
+     */
+    void Fill(G4double x, G4double z, G4double weight)
+    {
+        ++fEntries;
+        fSumW += weight;
+        fSumWX += weight * x;
+        fSumWX2 += weight * x * x;
+        fSumWZ += weight * z;
+        fSumWZ2 += weight * z * z;
+    }
+
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+
+    G4long GetEntries() const { return fEntries; }                          /**< Number of particles */
+    G4double GetSumOfWeights() const { return fSumW; }                      /**< Sum of the weights */
+    G4double GetMeanX() const { return fSumW > 0. ? fSumWX / fSumW : 0.; }  /**< Weighted mean along x (mm) */
+    G4double GetMeanZ() const { return fSumW > 0. ? fSumWZ / fSumW : 0.; }  /**< Weighted mean along z (mm) */
+    G4double GetSigmaX() const { return Sigma(fSumWX, fSumWX2); }           /**< Weighted rms along x (mm) */
+    G4double GetSigmaZ() const { return Sigma(fSumWZ, fSumWZ2); }           /**< Weighted rms along z (mm) */
+
+private:
+    G4double Sigma(G4double sum, G4double sum2) const
+    {
+        if (fSumW <= 0.)
+            return 0.;
+        const G4double mean = sum / fSumW;
+        return std::sqrt(std::max(sum2 / fSumW - mean * mean, 0.));
+    }
+
+    G4long fEntries = 0;
+    G4double fSumW = 0.;
+    G4double fSumWX = 0.;
+    G4double fSumWX2 = 0.;
+    G4double fSumWZ = 0.;
+    G4double fSumWZ2 = 0.;
+};
+
+#endif
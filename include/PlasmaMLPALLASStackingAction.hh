@@ -0,0 +1,78 @@
+#ifndef PlasmaMLPALLASStackingAction_h
+#define PlasmaMLPALLASStackingAction_h 1
+
+/**
+ * @class PlasmaMLPALLASStackingAction
+ * @brief Kill and defer policies of the secondary particles.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The optics tallies (input, quadrupoles, collimators) only use the
+ * primaries, while the showers started in the chambers and shieldings
+ * dominate the CPU time of high-charge runs. Policies
+ * (/PlasmaMLPALLAS/stack/setPolicy):
+ *  - all: every particle is tracked (default)
+ *  - primaries: the secondaries are killed at birth
+ *  - deferYAG: the secondaries wait until the primaries of the event are
+ *    done, and are only tracked if a primary left a hit on a YAG screen;
+ *    otherwise they are dropped
+ *
+ * Whatever the policy, a secondary below the kinetic energy threshold of its
+ * species (/PlasmaMLPALLAS/stack/setKillThreshold) is killed at birth.
+ * One instance per thread, configured by its own messenger (commands
+ * broadcast to the workers).
+ */
+
+#include "G4UserStackingAction.hh"
+#include "globals.hh"
+#include <unordered_map>
+#include <vector>
+
+class G4ParticleDefinition;
+class PlasmaMLPALLASStackingMessenger;
+
+class PlasmaMLPALLASStackingAction : public G4UserStackingAction
+{
+public:
+    /// Handling of the secondaries
+    enum class Policy { All, Primaries, DeferYAG };
+
+    PlasmaMLPALLASStackingAction();
+    ~PlasmaMLPALLASStackingAction() override;
+
+    /** @brief Classify a new (or resumed) track: primaries are always urgent. */
+    G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track) override;
+
+    /** @brief Drop the deferred secondaries if no primary reached a YAG screen. */
+    void NewStage() override;
+
+    /** @brief Reset the stage of the event. */
+    void PrepareNewEvent() override;
+
+    /** Names of the policies, in the order of Policy */
+    static const std::vector<G4String>& GetPolicyNames();
+
+    void SetPolicy(Policy policy) { fPolicy = policy; }
+    Policy GetPolicy() const { return fPolicy; }
+
+    /**
+     * @brief Kill the secondaries of a species below a kinetic energy.
+     * @param particle Species (nullptr ignored)
+     * @param threshold Kinetic energy, 0 to remove the threshold
+     */
+    void SetKillThreshold(const G4ParticleDefinition* particle, G4double threshold);
+    void ClearKillThresholds() { fKillThresholds.clear(); }
+    const std::unordered_map<const G4ParticleDefinition*, G4double>& GetKillThresholds() const { return fKillThresholds; }
+
+private:
+    /** @brief Whether a primary of the current event left a hit on a YAG screen. */
+    static G4bool YAGHit();
+
+    PlasmaMLPALLASStackingMessenger* fMessenger = nullptr; ///< Commands of /PlasmaMLPALLAS/stack/
+    Policy fPolicy = Policy::All;                           ///< Handling of the secondaries
+    std::unordered_map<const G4ParticleDefinition*, G4double> fKillThresholds; ///< Kinetic energy thresholds per species
+    G4bool fDeferredStage = false; ///< The deferred secondaries of the event are being tracked
+};
+
+#endif
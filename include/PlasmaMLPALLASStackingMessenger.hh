@@ -0,0 +1,65 @@
+#ifndef PlasmaMLPALLASStackingMessenger_H
+#define PlasmaMLPALLASStackingMessenger_H
+
+/**
+ * @class PlasmaMLPALLASStackingMessenger
+ * @brief Provides UI commands to configure the policies of the stacking action
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * Each thread owns a stacking action and its messenger; the commands are
+ * broadcast to the worker threads.
+ */
+
+#include "G4UIcommand.hh"
+#include "G4UIcmdWithAString.hh"                   // for G4UIcmdWithAString
+#include "G4UIcmdWithoutParameter.hh"              // for G4UIcmdWithoutParameter
+#include "G4UIdirectory.hh"                        // for G4UIdirectory
+#include "G4UImessenger.hh"
+
+class G4UIcmdWithAString;
+class G4UIcmdWithoutParameter;
+class G4UIcommand;
+class G4UIdirectory;
+
+class PlasmaMLPALLASStackingAction;
+
+class PlasmaMLPALLASStackingMessenger : public G4UImessenger
+{
+public:
+    /**
+     * @brief Constructor
+     * @param stacking Pointer to the stacking action of the thread
+     */
+    PlasmaMLPALLASStackingMessenger(PlasmaMLPALLASStackingAction *stacking);
+
+    /// Destructor
+    ~PlasmaMLPALLASStackingMessenger();
+
+    /**
+     * @brief Executes a command with a new value
+     * @param command Pointer to the issued command
+     * @param newValue String representation of the new value
+     */
+    virtual void SetNewValue(G4UIcommand *command, G4String newValue) final;
+
+    /**
+     * @brief Retrieves the current value of a command
+     * @param command Pointer to the command
+     * @return String representing the current value
+     */
+    virtual G4String GetCurrentValue(G4UIcommand *command) final;
+
+private:
+    /// Associated stacking action
+    PlasmaMLPALLASStackingAction *fStacking = nullptr;
+
+    G4UIdirectory *fStackDir = nullptr;                   ///< Directory /PlasmaMLPALLAS/stack
+
+    G4UIcmdWithAString *fPolicyCmd = nullptr;             ///< Handling of the secondaries
+    G4UIcommand *fKillThresholdCmd = nullptr;             ///< Kinetic energy threshold of a species
+    G4UIcmdWithoutParameter *fClearKillThresholdsCmd = nullptr; ///< Remove all the thresholds
+};
+
+#endif
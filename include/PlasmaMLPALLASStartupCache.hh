@@ -0,0 +1,109 @@
+#ifndef PlasmaMLPALLASStartupCache_h
+#define PlasmaMLPALLASStartupCache_h 1
+
+/**
+ * @class PlasmaMLPALLASStartupCache
+ * @brief On-disk cache of the tessellated GDML solids and of the physics tables.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * Short batch jobs spend most of their time parsing the GDML models and
+ * building the physics tables. With a cache directory
+ * (/PlasmaMLPALLAS/cache/setDirectory, before /run/initialize):
+ *  - each GDML model is stored after its first parse as a binary list of
+ *    triangles (geometry/<model>.bin), rebuilt as a G4TessellatedSolid by the
+ *    next jobs as long as the GDML file keeps its size and time stamp (see
+ *    PlasmaMLPALLASGDMLLoader);
+ *  - the physics tables are stored after the first run
+ *    (/run/particle/storePhysicsTable) in physics/<key>, and retrieved by the
+ *    next jobs. The key hashes the Geant4 version, the physics preset, the
+ *    production cuts and the logical volumes with their materials, so a
+ *    different configuration never reads tables built for another one.
+ *
+ * Entries are written under a temporary name and renamed once complete, so
+ * that concurrent jobs sharing the directory only see finished entries.
+ *
+ * The singleton is created by the master (PlasmaMLPALLASActionInitialization),
+ * which owns the /PlasmaMLPALLAS/cache/ commands.
+ */
+
+#include "globals.hh"
+
+class G4VUserPhysicsList;
+struct PlasmaMLPALLASTessellatedMesh;
+class PlasmaMLPALLASStartupCacheMessenger;
+
+class PlasmaMLPALLASStartupCache
+{
+public:
+    /**
+     * @brief Access the singleton instance.
+     * @return Reference to the process-wide cache.
+     */
+    static PlasmaMLPALLASStartupCache& Instance();
+
+    /// @name Configuration
+    ///@{
+    void SetDirectory(const G4String& directory) { fDirectory = directory; } /**< Set the cache directory (empty: no cache) */
+    const G4String& GetDirectory() const { return fDirectory; }             /**< Get the cache directory */
+    G4bool IsEnabled() const { return !fDirectory.empty(); }                /**< Whether a directory is set */
+    ///@}
+
+    /// @name Geometry
+    ///@{
+    /**
+     * @brief Triangles of a GDML model, from the cache.
+     * @param gdmlFile Path to the GDML file
+     * @param mesh Triangles of the model
+     * @return False if the model is not cached or has changed
+     */
+    G4bool LoadMesh(const G4String& gdmlFile, PlasmaMLPALLASTessellatedMesh& mesh) const;
+
+    /**
+     * @brief Store the triangles of a freshly read GDML model (master).
+     * @param gdmlFile Path to the GDML file
+     * @param mesh Triangles of the model (nothing is done if it comes from the cache)
+     */
+    void StoreMesh(const G4String& gdmlFile, const PlasmaMLPALLASTessellatedMesh& mesh) const;
+    ///@}
+
+    /// @name Physics tables
+    ///@{
+    /**
+     * @brief Retrieve the tables of this configuration if they are cached (master, at SetCuts).
+     * @param physicsList Physics list being initialised
+     * @param configuration Description of the physics settings (preset, cuts)
+     */
+    void PreparePhysicsTables(G4VUserPhysicsList* physicsList, const G4String& configuration);
+
+    /**
+     * @brief Forget the tables of the current configuration (settings changed after /run/initialize).
+     * @param physicsList Physics list of the run
+     */
+    void DiscardPhysicsTables(G4VUserPhysicsList* physicsList);
+
+    /**
+     * @brief Store the tables built by the last run, if they were not retrieved (master, Idle state).
+     */
+    void StorePhysicsTables();
+    ///@}
+
+private:
+    PlasmaMLPALLASStartupCache();
+    ~PlasmaMLPALLASStartupCache();
+
+    PlasmaMLPALLASStartupCache(const PlasmaMLPALLASStartupCache&) = delete;            /**< Delete copy constructor */
+    PlasmaMLPALLASStartupCache& operator=(const PlasmaMLPALLASStartupCache&) = delete; /**< Delete assignment operator */
+
+    /** Cache entry of a GDML model */
+    G4String GeometryEntry(const G4String& gdmlFile) const;
+
+    G4String fDirectory;                  /**< Cache directory (empty: disabled) */
+    G4String fPhysicsEntry;               /**< Tables of the current configuration */
+    G4bool fPhysicsRetrieved = false;     /**< The current tables are already in the cache */
+
+    PlasmaMLPALLASStartupCacheMessenger* fMessenger = nullptr; /**< UI commands /PlasmaMLPALLAS/cache/ */
+};
+
+#endif
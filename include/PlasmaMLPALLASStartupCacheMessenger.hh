@@ -0,0 +1,59 @@
+#ifndef PlasmaMLPALLASStartupCacheMessenger_H
+#define PlasmaMLPALLASStartupCacheMessenger_H
+
+/**
+ * @class PlasmaMLPALLASStartupCacheMessenger
+ * @brief Provides UI commands to configure the startup cache
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The commands are created by the master and act on the process-wide
+ * PlasmaMLPALLASStartupCache, so they are not broadcast to the worker threads.
+ */
+
+#include "G4UIcmdWithAString.hh"                   // for G4UIcmdWithAString
+#include "G4UIdirectory.hh"                        // for G4UIdirectory
+#include "G4UImessenger.hh"
+
+class G4UIcmdWithAString;
+class G4UIdirectory;
+
+class PlasmaMLPALLASStartupCache;
+
+class PlasmaMLPALLASStartupCacheMessenger : public G4UImessenger
+{
+public:
+    /**
+     * @brief Constructor
+     * @param cache Pointer to the startup cache
+     */
+    PlasmaMLPALLASStartupCacheMessenger(PlasmaMLPALLASStartupCache *cache);
+
+    /// Destructor
+    ~PlasmaMLPALLASStartupCacheMessenger();
+
+    /**
+     * @brief Executes a command with a new value
+     * @param command Pointer to the issued command
+     * @param newValue String representation of the new value
+     */
+    virtual void SetNewValue(G4UIcommand *command, G4String newValue) final;
+
+    /**
+     * @brief Retrieves the current value of a command
+     * @param command Pointer to the command
+     * @return String representing the current value
+     */
+    virtual G4String GetCurrentValue(G4UIcommand *command) final;
+
+private:
+    /// Associated startup cache
+    PlasmaMLPALLASStartupCache *fCache = nullptr;
+
+    G4UIdirectory *fCacheDir = nullptr;          ///< Directory /PlasmaMLPALLAS/cache
+
+    G4UIcmdWithAString *fDirectoryCmd = nullptr; ///< Cache directory
+};
+
+#endif
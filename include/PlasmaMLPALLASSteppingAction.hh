@@ -8,18 +8,25 @@
  * @date 2025
  * @copyright PALLAS Project - GEANT4 Collaboration
  *
- * This class records tracking information at each step of a particle inside
- * the simulation. It extracts position, momentum, deposited energy and
- * other metadata (volume, process, etc.) for later analysis.
- *
- * It also handles quadrupole-related information and collimator updates.
+ * The scoring is done by the sensitive detectors of the quadrupoles, the
+ * collimators and the YAG screens (PlasmaMLPALLASSensitiveDetectors.hh), and
+ * the input of the primaries is read from the primary vertices
+ * (PlasmaMLPALLASEventAction). This class is only left with the kill logic:
+ * particles leaving into the world, primaries reaching a collimator when
+ * their tracking there is disabled, and the kill zones of the lost particles
+ * (PlasmaMLPALLASKillZones, /PlasmaMLPALLAS/killzone/). The volumes are
+ * classified with the volume-role table of the geometry (no string compare
+ * per step).
  */
 
 #include "G4UserSteppingAction.hh"
-#include "PlasmaMLPALLASRunAction.hh"
-#include "PlasmaMLPALLASQuadrupoleUtils.hh"
+#include "PlasmaMLPALLASVolumeRoles.hh"
 #include "G4GenericMessenger.hh"
 
+class G4Step;
+class PlasmaMLPALLASKillZones;
+class PlasmaMLPALLASKillZonesMessenger;
+
 class PlasmaMLPALLASSteppingAction : public G4UserSteppingAction
 {
 public:
@@ -27,78 +34,35 @@ public:
      * @brief Constructor.
      *
      * Initializes the stepping action and messenger.
+     *
+     * @param volumeRoles Role table of the geometry (rebuilt with the geometry, same object)
      */
-    PlasmaMLPALLASSteppingAction();
+    explicit PlasmaMLPALLASSteppingAction(const PlasmaMLPALLASVolumeRoles& volumeRoles);
 
     /**
      * @brief Destructor.
      */
     ~PlasmaMLPALLASSteppingAction() override;
 
-    /**
-     * @brief Store the initial particle information at the beginning of an event.
-     *
-     * @param evtac Pointer to the event action where data will be stored.
-     */
-    void SetInputInformations(PlasmaMLPALLASEventAction* evtac) const;
-
-    /**
-     * @brief Store quadrupole crossing information.
-     *
-     * @param evtac Pointer to the event action.
-     * @param quad Identifier of the quadrupole.
-     * @param posType Position type (pre-step or post-step).
-     */
-    void SetQuadrupoleInformation(PlasmaMLPALLASEventAction* evtac, QuadID quad, PositionType posType) const;
-
     /**
      * @brief Stepping action executed at each Geant4 step.
      *
-     * Extracts step information (positions, momenta, energy deposition, etc.)
-     * and stores it for later analysis. Also manages collimator updates.
+     * Kills the particles entering the world, the primaries in a
+     * collimator when the collimator tracking is disabled, and the tracks
+     * caught by a kill zone.
      *
      * @param step Current Geant4 step.
      */
     void UserSteppingAction(const G4Step* step) override;
 
 private:
-    /**
-     * @struct StepPoint
-     * @brief Helper structure to store spatial and momentum coordinates of a step.
-     */
-    struct StepPoint {
-        G4double x = 0.0;  ///< X position [mm]
-        G4double y = 0.0;  ///< Y position [mm]
-        G4double z = 0.0;  ///< Z position [mm]
-        G4double px = 0.0; ///< X component of momentum direction
-        G4double py = 0.0; ///< Y component of momentum direction
-        G4double pz = 0.0; ///< Z component of momentum direction
-    };
-
     // --- Configuration & control ---
+    const PlasmaMLPALLASVolumeRoles& fVolumeRoles; ///< Role of the physical volumes
     G4GenericMessenger* sMessenger = nullptr; ///< Command messenger for UI interaction
+    PlasmaMLPALLASKillZones& fKillZones;      ///< Kill zones of the thread
+    PlasmaMLPALLASKillZonesMessenger* fKillZonesMessenger = nullptr; ///< Commands of /PlasmaMLPALLAS/killzone/
     G4bool TrackingStatus = true;             ///< Enable/disable general tracking
     G4bool TrackingStatusCollimators = true;  ///< Enable/disable collimator tracking
-
-    // --- Track information ---
-    G4Track* theTrack = nullptr;   ///< Pointer to the current track
-    G4String particleName;         ///< Particle name
-    G4int particleID = 0;          ///< PDG particle ID
-    G4int parentID = 0;            ///< Parent track ID
-    G4int trackID = 0;             ///< Current track ID
-    G4int stepNo = 0;              ///< Step number in the current track
-    G4String endproc;              ///< Process at track end
-    G4String volumeNamePreStep;    ///< Volume name at pre-step point
-    G4String volumeNamePostStep;   ///< Volume name at post-step point
-
-    // --- Energy ---
-    G4double energy = 0.0;           ///< Kinetic energy [MeV]
-    G4double energyDeposited = 0.0;  ///< Deposited energy [keV]
-
-    // --- Step coordinates ---
-    StepPoint preStep;   ///< Pre-step point (position & momentum)
-    StepPoint postStep;  ///< Post-step point (position & momentum)
-
 };
 
 #endif // PlasmaMLPALLASSteppingAction_h
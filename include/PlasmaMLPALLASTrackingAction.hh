@@ -0,0 +1,63 @@
+#ifndef PlasmaMLPALLASTrackingAction_h
+#define PlasmaMLPALLASTrackingAction_h 1
+
+/**
+ * @class PlasmaMLPALLASTrackingAction
+ * @brief Selection and decimation of the trajectories stored for the visualization.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * With /tracking/storeTrajectory on (vis.mac), Geant4 keeps every step of
+ * every track of the accumulated events, which exhausts the memory of the
+ * full geometry with showers. Before each track this action decides whether
+ * its trajectory is stored (/PlasmaMLPALLAS/trajectory/):
+ *  - never if no visualization driver is active (batch jobs), whatever
+ *    /tracking/storeTrajectory says;
+ *  - primaries only, and/or one track out of N (track ID 1, N+1, 2N+1...);
+ *  - with at most a given number of points (PlasmaMLPALLASTrajectory),
+ *    otherwise with the trajectory type of /tracking/storeTrajectory.
+ *
+ * The storeTrajectory value set by the user is restored after each track.
+ * One instance per thread, configured by its own messenger (commands
+ * broadcast to the workers).
+ */
+
+#include "G4UserTrackingAction.hh"
+#include "globals.hh"
+
+class PlasmaMLPALLASTrackingMessenger;
+
+class PlasmaMLPALLASTrackingAction : public G4UserTrackingAction
+{
+public:
+    PlasmaMLPALLASTrackingAction();
+    ~PlasmaMLPALLASTrackingAction() override;
+
+    /** @brief Select the trajectory of the track (or switch it off). */
+    void PreUserTrackingAction(const G4Track* track) override;
+
+    /** @brief Restore the storeTrajectory value of the user. */
+    void PostUserTrackingAction(const G4Track* track) override;
+
+    /** Store the trajectories of the primaries only */
+    void SetPrimariesOnly(G4bool primariesOnly) { fPrimariesOnly = primariesOnly; }
+    G4bool GetPrimariesOnly() const { return fPrimariesOnly; }
+
+    /** Store one trajectory out of N (1: all) */
+    void SetEveryNth(G4int n) { fEveryNth = n > 1 ? n : 1; }
+    G4int GetEveryNth() const { return fEveryNth; }
+
+    /** Maximum number of points of a trajectory (0: one point per step) */
+    void SetMaxPoints(G4int maxPoints) { fMaxPoints = maxPoints > 0 ? maxPoints : 0; }
+    G4int GetMaxPoints() const { return fMaxPoints; }
+
+private:
+    PlasmaMLPALLASTrackingMessenger* fMessenger = nullptr; ///< Commands of /PlasmaMLPALLAS/trajectory/
+    G4bool fPrimariesOnly = false;   ///< Trajectories of the primaries only
+    G4int fEveryNth = 1;             ///< One trajectory out of N
+    G4int fMaxPoints = 0;            ///< Cap on the points, 0 for none
+    G4int fStoreTrajectory = 0;      ///< storeTrajectory value of the user, restored after the track
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef PlasmaMLPALLASTrackingMessenger_H
+#define PlasmaMLPALLASTrackingMessenger_H
+
+/**
+ * @class PlasmaMLPALLASTrackingMessenger
+ * @brief Provides UI commands to select and decimate the stored trajectories
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * Each thread owns a tracking action and its messenger; the commands are
+ * broadcast to the worker threads.
+ */
+
+#include "G4UIcommand.hh"
+#include "G4UIcmdWithABool.hh"                     // for G4UIcmdWithABool
+#include "G4UIcmdWithAnInteger.hh"                 // for G4UIcmdWithAnInteger
+#include "G4UIdirectory.hh"                        // for G4UIdirectory
+#include "G4UImessenger.hh"
+
+class G4UIcmdWithABool;
+class G4UIcmdWithAnInteger;
+class G4UIcommand;
+class G4UIdirectory;
+
+class PlasmaMLPALLASTrackingAction;
+
+class PlasmaMLPALLASTrackingMessenger : public G4UImessenger
+{
+public:
+    /**
+     * @brief Constructor
+     * @param tracking Pointer to the tracking action of the thread
+     */
+    PlasmaMLPALLASTrackingMessenger(PlasmaMLPALLASTrackingAction *tracking);
+
+    /// Destructor
+    ~PlasmaMLPALLASTrackingMessenger();
+
+    /**
+     * @brief Executes a command with a new value
+     * @param command Pointer to the issued command
+     * @param newValue String representation of the new value
+     */
+    virtual void SetNewValue(G4UIcommand *command, G4String newValue) final;
+
+    /**
+     * @brief Retrieves the current value of a command
+     * @param command Pointer to the command
+     * @return String representing the current value
+     */
+    virtual G4String GetCurrentValue(G4UIcommand *command) final;
+
+private:
+    /// Associated tracking action
+    PlasmaMLPALLASTrackingAction *fTracking = nullptr;
+
+    G4UIdirectory *fTrajectoryDir = nullptr;              ///< Directory /PlasmaMLPALLAS/trajectory
+
+    G4UIcmdWithABool *fPrimariesOnlyCmd = nullptr;        ///< Trajectories of the primaries only
+    G4UIcmdWithAnInteger *fEveryNthCmd = nullptr;         ///< One trajectory out of N
+    G4UIcmdWithAnInteger *fMaxPointsCmd = nullptr;        ///< Cap on the points of a trajectory
+};
+
+#endif
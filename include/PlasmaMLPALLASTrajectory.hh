@@ -0,0 +1,95 @@
+#ifndef PlasmaMLPALLASTrajectory_h
+#define PlasmaMLPALLASTrajectory_h 1
+
+/**
+ * @class PlasmaMLPALLASTrajectory
+ * @brief Trajectory keeping at most a given number of points.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * G4Trajectory stores one point per step, which in the field regions and
+ * the showers of the full geometry means thousands of points per track.
+ * This trajectory keeps the start point and one step end out of a stride:
+ * when the cap is reached, every other point is dropped and the stride is
+ * doubled, so the kept points stay evenly spread along the whole track. The
+ * last step end is always kept, so that the drawn track ends where the
+ * particle stopped.
+ *
+ * Created by the tracking action when /PlasmaMLPALLAS/trajectory/setMaxPoints
+ * is set; drawn by the default G4VTrajectory methods.
+ */
+
+#include "G4VTrajectory.hh"
+#include "G4Allocator.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+#include <vector>
+
+class G4Track;
+class G4TrajectoryPoint;
+class G4ParticleDefinition;
+
+class PlasmaMLPALLASTrajectory : public G4VTrajectory
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param track Track of the trajectory (start point, particle)
+     * @param maxPoints Maximum number of points (>= 2)
+     */
+    PlasmaMLPALLASTrajectory(const G4Track* track, G4int maxPoints);
+    ~PlasmaMLPALLASTrajectory() override;
+
+    inline void* operator new(size_t);
+    inline void operator delete(void* trajectory);
+
+    G4int GetTrackID() const override { return fTrackID; }
+    G4int GetParentID() const override { return fParentID; }
+    G4String GetParticleName() const override;
+    G4double GetCharge() const override;
+    G4int GetPDGEncoding() const override;
+    G4ThreeVector GetInitialMomentum() const override { return fInitialMomentum; }
+
+    G4int GetPointEntries() const override;
+    G4VTrajectoryPoint* GetPoint(G4int i) const override;
+
+    /** @brief Add the end of a step (kept if it falls on the stride). */
+    void AppendStep(const G4Step* step) override;
+
+    /** @brief Append the points of the next part of a suspended track (all but its start). */
+    void MergeTrajectory(G4VTrajectory* secondTrajectory) override;
+
+private:
+    /** @brief Add a step end: kept if it falls on the stride, held as the end point otherwise. */
+    void AddPosition(const G4ThreeVector& position);
+
+    /** @brief Drop every other point and double the stride. */
+    void Compact();
+
+    std::vector<G4TrajectoryPoint*> fPoints;      ///< Start and step ends on the stride
+    G4TrajectoryPoint* fEnd = nullptr;            ///< Last step end when it is not on the stride
+    const G4ParticleDefinition* fParticle = nullptr;
+    G4ThreeVector fInitialMomentum;
+    G4int fTrackID = 0;
+    G4int fParentID = 0;
+    G4int fMaxPoints = 2;                         ///< Cap, fEnd included
+    G4long fStride = 1;                           ///< Steps between two kept points
+    G4long fSteps = 0;                            ///< Steps appended so far
+};
+
+extern G4ThreadLocal G4Allocator<PlasmaMLPALLASTrajectory>* PlasmaMLPALLASTrajectoryAllocator;
+
+inline void* PlasmaMLPALLASTrajectory::operator new(size_t)
+{
+    if (!PlasmaMLPALLASTrajectoryAllocator)
+        PlasmaMLPALLASTrajectoryAllocator = new G4Allocator<PlasmaMLPALLASTrajectory>;
+    return (void*)PlasmaMLPALLASTrajectoryAllocator->MallocSingle();
+}
+
+inline void PlasmaMLPALLASTrajectory::operator delete(void* trajectory)
+{
+    PlasmaMLPALLASTrajectoryAllocator->FreeSingle((PlasmaMLPALLASTrajectory*)trajectory);
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef PlasmaMLPALLASVolumeRoles_h
+#define PlasmaMLPALLASVolumeRoles_h 1
+
+/**
+ * @class PlasmaMLPALLASVolumeRoles
+ * @brief Role of each physical volume for the stepping action, indexed by instance ID.
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr> - Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ *
+ * The table is filled from the names of the physical volumes once, at the
+ * end of PlasmaMLPALLASGeometryConstruction::Construct() (master thread), and
+ * then only read by the stepping actions of all threads: each step point is
+ * classified with one array access instead of string compares. Volumes
+ * without a role (the beamline elements, the chambers...) map to None.
+ */
+
+#include "globals.hh"
+#include "G4VPhysicalVolume.hh"
+#include "PlasmaMLPALLASQuadrupoleUtils.hh"
+#include <cstdint>
+#include <vector>
+
+/// Volumes the stepping action reacts to
+enum class VolumeRole : std::uint8_t {
+    None,
+    World,
+    Holder,
+    Q1,
+    Q2,
+    Q3,
+    Q4,
+    HorizontalCollimator,
+    VerticalCollimator,
+    BSYAG,
+    BSPECYAG
+};
+
+/** Whether the role is one of the Q1..Q4 field volumes */
+inline G4bool IsQuadrupole(VolumeRole role)
+{
+    return role >= VolumeRole::Q1 && role <= VolumeRole::Q4;
+}
+
+/** Quadrupole of a Q1..Q4 role */
+inline QuadID ToQuadID(VolumeRole role)
+{
+    return static_cast<QuadID>(static_cast<int>(role) - static_cast<int>(VolumeRole::Q1) + static_cast<int>(QuadID::Q1));
+}
+
+class PlasmaMLPALLASVolumeRoles
+{
+public:
+    /**
+     * @brief Rebuild the table from the physical volume store.
+     */
+    void Build();
+
+    /**
+     * @brief Role of a physical volume.
+     * @param volume Volume of a step point (nullptr out of the world)
+     * @return Role, None for a volume without role or outside the world
+     */
+    VolumeRole Get(const G4VPhysicalVolume* volume) const
+    {
+        if (!volume)
+            return VolumeRole::None;
+        const size_t id = volume->GetInstanceID();
+        return id < fRoles.size() ? fRoles[id] : VolumeRole::None;
+    }
+
+private:
+    std::vector<VolumeRole> fRoles; ///< Role per physical volume instance ID
+};
+
+#endif
@@ -21,6 +21,7 @@
 
 
 #include "Geometry.hh"
+#include "PlasmaMLPALLASStartupCache.hh"
 
 // ***********************
 // Constructor
@@ -48,11 +49,36 @@ Geometry::~Geometry()
 {
 }
 
+/**
+ * @brief Read the GDML models of the geometry concurrently.
+ *
+ * The triangles are kept until GetGDMLVolume asks for them, then released.
+ *
+ * @param requests GDML files and volume names the geometry will ask for.
+ */
+void Geometry::PreloadGDMLVolumes(const std::vector<PlasmaMLPALLASGDMLLoader::Request>& requests)
+{
+  Loader.Preload(requests);
+}
+
+/**
+ * @brief Release the preloaded models that were not asked for.
+ */
+void Geometry::ReleaseGDMLVolumes()
+{
+  Loader.Clear();
+}
+
 /**
  * @brief Load and retrieve a GDML-defined volume.
  *
- * This method uses a GDML parser to read a geometry description from a GDML file,
- * retrieve the specified volume, and assign it the provided material.
+ * The solid is built from the triangles preloaded by PreloadGDMLVolumes or
+ * kept in the startup cache, tessellated or as a fitted proxy depending on
+ * the CAD mode of the volume (see PlasmaMLPALLASCADModels). Otherwise this method
+ * uses a GDML parser to read a geometry description from a GDML file,
+ * retrieve the specified volume, and assign it the provided material; the
+ * parser is released once the volume is extracted. A freshly read model is
+ * stored in the startup cache for the next jobs.
  *
  * @param path Path to the GDML file.
  * @param VName Name of the volume inside the GDML file.
@@ -63,13 +89,24 @@ G4LogicalVolume* Geometry::GetGDMLVolume(const char* path, const char* VName, G4
 {
   Material = material;
 
-  G4GDMLParser* parser = new G4GDMLParser();
+  PlasmaMLPALLASStartupCache& cache = PlasmaMLPALLASStartupCache::Instance();
+  PlasmaMLPALLASTessellatedMesh mesh;
+  if (Loader.Take(G4String(path), G4String(VName), mesh) || cache.LoadMesh(G4String(path), mesh))
+  {
+    LogicalVolume = CADModels.Build(mesh, Material, G4String(VName));
+    cache.StoreMesh(G4String(path), mesh);
+    return LogicalVolume;
+  }
+
+  G4GDMLParser parser;
   // Create tessellated volume of the requested component
-  parser->Clear();
-  parser->Read(G4String(path), false);
-  LogicalVolume = parser->GetVolume(G4String(VName));
+  parser.Read(G4String(path), false);
+  LogicalVolume = parser.GetVolume(G4String(VName));
   LogicalVolume->SetMaterial(Material);
 
+  if (PlasmaMLPALLASGDMLLoader::ToMesh(LogicalVolume->GetSolid(), mesh))
+    cache.StoreMesh(G4String(path), mesh);
+
   return LogicalVolume;
 }
 
@@ -131,3 +168,27 @@ G4LogicalVolume *Geometry::GetFakeDiagsChamber()
 
   return LogicalVolume;
 }
+
+/**
+ * @brief Create the vacuum volume carrying the dipole field.
+ *
+ * This box encloses the dipole chamber and the dipole yoke (x within
+ * +-180 mm, y from 3100 to 3782 mm, z from -290 to 272 mm in the holder),
+ * outside of which the fitted field is below 1 % of its peak. It stops short of
+ * the Section3 supports and of the diagnostic chamber.
+ *
+ * @return Pointer to the created G4LogicalVolume.
+ */
+G4LogicalVolume *Geometry::GetDipoleFieldVolume()
+{
+  Material = G4NistManager::Instance()->FindOrBuildMaterial("G4_Galactic");
+
+  Box = new G4Box("DipoleFieldBox",
+                  180 *CLHEP::mm,
+                  341 *CLHEP::mm,
+                  281 *CLHEP::mm);
+
+  LogicalVolume = new G4LogicalVolume(Box, Material, "DipoleFieldVolume", 0, 0, 0);
+
+  return LogicalVolume;
+}
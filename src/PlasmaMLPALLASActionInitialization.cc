@@ -9,6 +9,7 @@
  *   - Run action
  *   - Event action
  *   - Stepping action
+ *   - Stacking and tracking actions
  *
  * In multithreaded mode, this class also defines master-thread-specific actions such as RunAction.
  * It stores configuration parameters such as the number of events, number of threads, and output suffix,
@@ -25,6 +26,13 @@
 
 
 #include "PlasmaMLPALLASActionInitialization.hh"
+#include "PlasmaMLPALLASOnnxSession.hh"
+#include "PlasmaMLPALLASProgressMonitor.hh"
+#include "PlasmaMLPALLASScanDriver.hh"
+#include "PlasmaMLPALLASOptimiser.hh"
+#include "PlasmaMLPALLASCheckpoint.hh"
+#include "PlasmaMLPALLASStartupCache.hh"
+#include "PlasmaMLPALLASOutputManager.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -48,7 +56,17 @@ PlasmaMLPALLASActionInitialization::PlasmaMLPALLASActionInitialization(
       numThreads(Ncores),
       flag_MT(pMT),
       fGeometry(geometry)
-{}
+{
+    // The shared ONNX session, the progress monitor, the scan driver, the optimiser, the checkpoint, the startup cache and the
+    // output manager (and their UI commands) belong to the master: create them here, before any worker thread asks for them.
+    PlasmaMLPALLASOnnxSession::Instance();
+    PlasmaMLPALLASProgressMonitor::Instance();
+    PlasmaMLPALLASScanDriver::Instance();
+    PlasmaMLPALLASOptimiser::Instance();
+    PlasmaMLPALLASCheckpoint::Instance().SetOutputName(suff);
+    PlasmaMLPALLASStartupCache::Instance();
+    PlasmaMLPALLASOutputManager::Instance();
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -81,6 +99,8 @@ void PlasmaMLPALLASActionInitialization::BuildForMaster() const
  * - RunAction
  * - EventAction
  * - SteppingAction
+ * - StackingAction (policies of the secondaries)
+ * - TrackingAction (selection and decimation of the trajectories)
  */
 void PlasmaMLPALLASActionInitialization::Build() const
 {
@@ -101,5 +121,7 @@ void PlasmaMLPALLASActionInitialization::Build() const
     SetUserAction(generator);
     SetUserAction(runAction);
     SetUserAction(eventAction);
-    SetUserAction(new PlasmaMLPALLASSteppingAction());
+    SetUserAction(new PlasmaMLPALLASSteppingAction(fGeometry->GetVolumeRoles()));
+    SetUserAction(new PlasmaMLPALLASStackingAction());
+    SetUserAction(new PlasmaMLPALLASTrackingAction());
 }
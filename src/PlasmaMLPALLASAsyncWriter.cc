@@ -0,0 +1,108 @@
+/**
+ * @file PlasmaMLPALLASAsyncWriter.cc
+ * @brief Implementation of the writer threads of the asynchronous output.
+ *
+ * A writer thread holds its own mutex during a pass over its channels, so
+ * registering or removing a channel waits for the pass in progress and a
+ * channel is never drained after Unregister() returned. The Geant4 threads
+ * only take that mutex when a table opens or closes.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASAsyncWriter.hh"
+#include <algorithm>
+#include <chrono>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASAsyncWriter::PlasmaMLPALLASAsyncWriter(G4int nThreads)
+{
+    for (G4int i = 0; i < std::max(nThreads, 1); ++i)
+    {
+        fThreads.push_back(std::make_unique<WriterThread>());
+        WriterThread& writer = *fThreads.back();
+        writer.thread = std::thread(&PlasmaMLPALLASAsyncWriter::Loop, this, std::ref(writer));
+    }
+}
+
+PlasmaMLPALLASAsyncWriter::~PlasmaMLPALLASAsyncWriter()
+{
+    fStop.store(true, std::memory_order_relaxed);
+    for (auto& writer : fThreads)
+        writer->thread.join();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASAsyncWriter::Register(Channel* channel, const void* group)
+{
+    std::lock_guard<std::mutex> registration(fRegistrationMutex);
+
+    WriterThread* target = nullptr;
+    size_t fewest = 0;
+    for (auto& writer : fThreads)
+    {
+        std::lock_guard<std::mutex> lock(writer->mutex);
+        if (group && std::find(writer->groups.begin(), writer->groups.end(), group) != writer->groups.end())
+        {
+            target = writer.get();
+            break;
+        }
+        if (!target || writer->channels.size() < fewest)
+        {
+            target = writer.get();
+            fewest = writer->channels.size();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(target->mutex);
+    target->channels.push_back(channel);
+    target->groups.push_back(group);
+}
+
+void PlasmaMLPALLASAsyncWriter::Unregister(Channel* channel)
+{
+    for (auto& writer : fThreads)
+    {
+        std::lock_guard<std::mutex> lock(writer->mutex);
+        auto& channels = writer->channels;
+        const auto it = std::find(channels.begin(), channels.end(), channel);
+        if (it == channels.end())
+            continue;
+        writer->groups.erase(writer->groups.begin() + (it - channels.begin()));
+        channels.erase(it);
+    }
+}
+
+G4bool PlasmaMLPALLASAsyncWriter::IsIdle() const
+{
+    for (const auto& writer : fThreads)
+    {
+        std::lock_guard<std::mutex> lock(writer->mutex);
+        if (!writer->channels.empty())
+            return false;
+    }
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASAsyncWriter::Loop(WriterThread& writer)
+{
+    while (!fStop.load(std::memory_order_relaxed))
+    {
+        G4bool busy = false;
+        {
+            std::lock_guard<std::mutex> lock(writer.mutex);
+            for (Channel* channel : writer.channels)
+                busy |= channel->Drain();
+        }
+        // Nothing queued: the Geant4 threads are tracking, do not spin on their queues
+        if (!busy)
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+}
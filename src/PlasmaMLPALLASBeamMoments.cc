@@ -0,0 +1,131 @@
+/**
+ * @file PlasmaMLPALLASBeamMoments.cc
+ * @brief Implementation of the streaming beam moments of a plane.
+ *
+ * Welford update for a particle of weight w, with W the sum of the weights:
+ * d = v - <v>, <v> += d w / W, C(a,b) += w d_a (b - <b>), the second factor
+ * taken with the updated mean. Merging two sets A and B adds
+ * d_a d_b W_A W_B / W to C_A + C_B, d being the difference of their means.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASBeamMoments.hh"
+#include <algorithm>
+#include <cmath>
+
+// Pairs of variables of the co-moments: x and z phase spaces (sigma matrices), energy spread
+const std::array<std::array<int, 2>, PlasmaMLPALLASBeamMoments::kNPairs> PlasmaMLPALLASBeamMoments::kPairs = {{
+    {kX, kX}, {kX, kXp}, {kXp, kXp}, {kZ, kZ}, {kZ, kZp}, {kZp, kZp}, {kE, kE}}};
+
+namespace
+{
+    /** Emittance and Twiss parameters of a 2x2 sigma matrix */
+    void Twiss(G4double s11, G4double s12, G4double s22, float& emit, float& alpha, float& beta, float& gamma)
+    {
+        const G4double det = s11 * s22 - s12 * s12;
+        if (det <= 0.)
+            return; // no or degenerate phase space (single particle, no angle)
+        const G4double eps = std::sqrt(det);
+        emit = eps;
+        alpha = -s12 / eps;
+        beta = s11 / eps;
+        gamma = s22 / eps;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASBeamMoments::PlasmaMLPALLASBeamMoments(const G4String& name, G4bool angles)
+    : G4VAccumulable(name), fAngles(angles)
+{
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASBeamMoments::Fill(G4double x, G4double xp, G4double z, G4double zp, G4double energy, G4double weight)
+{
+    if (!(weight > 0.))
+        return;
+
+    const std::array<G4double, kNVariables> v = {x, fAngles ? xp : 0., z, fAngles ? zp : 0., energy};
+    ++fEntries;
+    fSumW += weight;
+
+    std::array<G4double, kNVariables> d;
+    for (int i = 0; i < kNVariables; ++i)
+    {
+        d[i] = v[i] - fMean[i];
+        fMean[i] += d[i] * weight / fSumW;
+    }
+    for (int p = 0; p < kNPairs; ++p)
+        fComoment[p] += weight * d[kPairs[p][0]] * (v[kPairs[p][1]] - fMean[kPairs[p][1]]);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASBeamMoments::Merge(const G4VAccumulable& other)
+{
+    const auto& moments = static_cast<const PlasmaMLPALLASBeamMoments&>(other);
+    if (moments.fSumW <= 0.)
+        return;
+
+    const G4double sumW = fSumW + moments.fSumW;
+    std::array<G4double, kNVariables> d;
+    for (int i = 0; i < kNVariables; ++i)
+        d[i] = moments.fMean[i] - fMean[i];
+    for (int p = 0; p < kNPairs; ++p)
+        fComoment[p] += moments.fComoment[p] + d[kPairs[p][0]] * d[kPairs[p][1]] * fSumW * moments.fSumW / sumW;
+    for (int i = 0; i < kNVariables; ++i)
+        fMean[i] += d[i] * moments.fSumW / sumW;
+
+    fEntries += moments.fEntries;
+    fSumW = sumW;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASBeamMoments::Reset()
+{
+    fEntries = 0;
+    fSumW = 0.;
+    fMean.fill(0.);
+    fComoment.fill(0.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASBeamMoments::Summary PlasmaMLPALLASBeamMoments::GetSummary() const
+{
+    Summary s;
+    s.entries = static_cast<int>(fEntries);
+    s.weight = fSumW;
+    if (fSumW <= 0.)
+        return s;
+
+    // Sigma matrix elements, in the order of kPairs
+    std::array<G4double, kNPairs> sigma;
+    for (int p = 0; p < kNPairs; ++p)
+        sigma[p] = fComoment[p] / fSumW;
+    auto rms = [](G4double variance) { return std::sqrt(std::max(variance, 0.)); };
+
+    s.mean_x = fMean[kX];
+    s.rms_x = rms(sigma[0]);
+    s.mean_z = fMean[kZ];
+    s.rms_z = rms(sigma[3]);
+    s.mean_E = fMean[kE];
+    s.rms_E = rms(sigma[6]);
+    if (fAngles)
+    {
+        s.mean_xp = fMean[kXp];
+        s.rms_xp = rms(sigma[2]);
+        s.mean_zp = fMean[kZp];
+        s.rms_zp = rms(sigma[5]);
+        Twiss(sigma[0], sigma[1], sigma[2], s.emit_x, s.alpha_x, s.beta_x, s.gamma_x);
+        Twiss(sigma[3], sigma[4], sigma[5], s.emit_z, s.alpha_z, s.beta_z, s.gamma_z);
+    }
+    return s;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file PlasmaMLPALLASBeamSampler.cc
+ * @brief Implementation of the block phase-space sampler of the PALLAS source.
+ *
+ * For each plane, the sampled coordinates follow the Twiss parametrisation
+ * used so far by PlasmaMLPALLASOnnxInference:
+ *  - u = sqrt(eps * beta) * n1
+ *  - u' = -sqrt(eps / beta) * (alpha * n1 + n2)
+ * where n1 and n2 are independent standard normal variates and
+ * eps = emittanceRatio * epsb. The kinetic energy is Gaussian, with mean Ekin
+ * and standard deviation dEkin * Ekin.
+ *
+ * Normal variates are generated by blocks: one `flatArray` call fills the
+ * uniforms of the whole block, and the Box-Muller transform runs over
+ * contiguous arrays that the compiler can vectorise.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASBeamSampler.hh"
+#include "Randomize.hh"
+#include "CLHEP/Units/PhysicalConstants.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Constructor
+ * @param blockSize Number of primaries sampled per block
+ *
+ * The block size is kept even so that the Box-Muller pairs exactly cover the
+ * kNComponents arrays.
+ */
+PlasmaMLPALLASBeamSampler::PlasmaMLPALLASBeamSampler(size_t blockSize)
+    : fBlockSize(std::max<size_t>(2, blockSize + (blockSize % 2))),
+      fCursor(fBlockSize),
+      fNormals(kNComponents * fBlockSize)
+{
+    // Historical optics: alpha = 0, beta = 1, eps_x = epsb / 2.5, eps_z = epsb
+    fTwissX.emittanceRatio = 1. / 2.5;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Fill a new block of standard normal variates
+ */
+void PlasmaMLPALLASBeamSampler::Refill()
+{
+    const size_t n = fNormals.size();
+    G4double* v = fNormals.data();
+
+    G4Random::getTheEngine()->flatArray(static_cast<int>(n), v);
+
+    // Box-Muller on pairs (v[2i], v[2i+1]), in place
+    for (size_t i = 0; i < n; i += 2)
+    {
+        const G4double r = std::sqrt(-2. * std::log(std::max(v[i], DBL_MIN)));
+        const G4double psi = CLHEP::twopi * v[i + 1];
+        v[i] = r * std::cos(psi);
+        v[i + 1] = r * std::sin(psi);
+    }
+
+    fCursor = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Draw the next primary from the pre-sampled block
+ * @param moments Beam moments (mean energy, relative spread, emittance)
+ * @return Sampled phase-space coordinates and kinetic energy
+ */
+PhaseSpaceSample PlasmaMLPALLASBeamSampler::Next(const BeamMoments& moments)
+{
+    if (fCursor == fBlockSize)
+        Refill();
+
+    const G4double* n = fNormals.data() + fCursor;
+    ++fCursor;
+
+    const G4double epsX = fTwissX.emittanceRatio * moments.epsb;
+    const G4double epsZ = fTwissZ.emittanceRatio * moments.epsb;
+
+    const G4double nx = n[kX * fBlockSize];
+    const G4double nz = n[kZ * fBlockSize];
+
+    PhaseSpaceSample sample;
+    sample.x = std::sqrt(epsX * fTwissX.beta) * nx;
+    sample.xp = -std::sqrt(epsX / fTwissX.beta) * (fTwissX.alpha * nx + n[kXp * fBlockSize]);
+    sample.z = std::sqrt(epsZ * fTwissZ.beta) * nz;
+    sample.zp = -std::sqrt(epsZ / fTwissZ.beta) * (fTwissZ.alpha * nz + n[kZp * fBlockSize]);
+    sample.Ekin = moments.Ekin * (1. + moments.dEkin * n[kE * fBlockSize]);
+
+    return sample;
+}
@@ -0,0 +1,561 @@
+/**
+ * @file PlasmaMLPALLASCADModels.cc
+ * @brief Implementation of the proxies and voxel limits of the tessellated CAD parts.
+ *
+ * A part is sampled on a fixed number of points of its bounding box, drawn
+ * from a generator of its own (the Geant4 random engine of the run is not
+ * touched). A point is inside the triangles if a ray along +z from it
+ * crosses them an odd number of times; the triangles are binned on a grid
+ * of the xy plane so that a ray only tests the triangles above its cell.
+ *
+ * The proxy shapes all enclose the vertices of the part, apart from the bore
+ * of a hollow tube, so their overlap is the part volume over the shape
+ * volume for a part fully covered (box of a plate, tube of a pipe).
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASCADModels.hh"
+#include "PlasmaMLPALLASGDMLLoader.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4Material.hh"
+#include "G4TessellatedSolid.hh"
+#include "G4Box.hh"
+#include "G4Tubs.hh"
+#include "G4ExtrudedSolid.hh"
+#include "G4Polycone.hh"
+#include "G4DisplacedSolid.hh"
+#include "G4TwoVector.hh"
+#include "G4Transform3D.hh"
+#include "G4RotationMatrix.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ios.hh"
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <random>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+    constexpr size_t kSamples = 20000;   ///< Points sampled per part
+    constexpr size_t kGrid = 64;         ///< Cells per side of the ray grid
+    constexpr size_t kMaxHullPoints = 64; ///< Larger hulls are not turned into extrusions
+    constexpr size_t kMaxPlanes = 256;    ///< Parts with more vertex planes along an axis get no polycone
+    constexpr size_t kMaxSections = 64;   ///< Larger profiles are not turned into polycones
+    constexpr double kPlaneTolerance = 1e-3 * CLHEP::mm;  ///< Vertex planes closer than that are merged
+    constexpr double kRadiusTolerance = 0.05 * CLHEP::mm; ///< Sections closer than that in radius are merged
+
+    /** Triangles of a part, binned on the xy plane for the ray parity test */
+    class MeshSampler
+    {
+    public:
+        MeshSampler(const std::vector<double>& vertices, const G4ThreeVector& low, const G4ThreeVector& high)
+            : fVertices(vertices), fLow(low), fHigh(high), fCells(kGrid * kGrid)
+        {
+            for (size_t t = 0; t + 9 <= vertices.size(); t += 9)
+            {
+                const double *v = &vertices[t];
+                const size_t x0 = Cell(std::min({v[0], v[3], v[6]}), 0), x1 = Cell(std::max({v[0], v[3], v[6]}), 0);
+                const size_t y0 = Cell(std::min({v[1], v[4], v[7]}), 1), y1 = Cell(std::max({v[1], v[4], v[7]}), 1);
+                for (size_t i = x0; i <= x1; ++i)
+                    for (size_t j = y0; j <= y1; ++j)
+                        fCells[i * kGrid + j].push_back(t);
+            }
+        }
+
+        /** Odd number of triangles above the point */
+        G4bool Inside(const G4ThreeVector& p) const
+        {
+            G4int crossings = 0;
+            for (size_t t : fCells[Cell(p.x(), 0) * kGrid + Cell(p.y(), 1)])
+            {
+                const double *v = &fVertices[t];
+                const double d = (v[3] - v[0]) * (v[7] - v[1]) - (v[6] - v[0]) * (v[4] - v[1]);
+                if (d == 0.)
+                    continue;
+                const double u = ((p.x() - v[0]) * (v[7] - v[1]) - (v[6] - v[0]) * (p.y() - v[1])) / d;
+                const double w = ((v[3] - v[0]) * (p.y() - v[1]) - (p.x() - v[0]) * (v[4] - v[1])) / d;
+                if (u < 0. || w < 0. || u + w > 1.)
+                    continue;
+                if (v[2] + u * (v[5] - v[2]) + w * (v[8] - v[2]) > p.z())
+                    ++crossings;
+            }
+            return crossings % 2 == 1;
+        }
+
+    private:
+        size_t Cell(double value, G4int axis) const
+        {
+            const double extent = fHigh[axis] - fLow[axis];
+            if (extent <= 0.)
+                return 0;
+            const double cell = (value - fLow[axis]) / extent * kGrid;
+            return static_cast<size_t>(std::clamp(cell, 0., static_cast<double>(kGrid - 1)));
+        }
+
+        const std::vector<double>& fVertices;
+        G4ThreeVector fLow, fHigh;
+        std::vector<std::vector<size_t>> fCells;
+    };
+
+    /** Section of a polycone between two planes, in the frame of its axis */
+    struct Section
+    {
+        G4double z0, z1;     ///< Planes of the section
+        G4double rmin, rmax; ///< Radii of the section
+    };
+
+    /** Shape fitted to a part, in the frame of its axis (local z along the axis) */
+    struct Candidate
+    {
+        enum class Kind { Box, Tube, Extrusion, Polycone } kind = Kind::Box;
+        G4String shape;                ///< Report name of the shape
+        G4int axis = -1;               ///< Axis of the shape (-1: box)
+        G4double rmin = 0., rmax = 0.; ///< Radii of a tube
+        std::vector<G4TwoVector> hull; ///< Counter-clockwise polygon of an extrusion
+        std::vector<Section> sections; ///< Step profile of a polycone, along the axis
+        G4double volume = 0.;          ///< Volume of the shape
+        size_t common = 0, merged = 0; ///< Samples in both, and in either, the part and the shape
+    };
+
+    /** Local x and y of a global coordinate index, local z being the axis */
+    std::array<G4int, 2> Transverse(G4int axis) { return {(axis + 1) % 3, (axis + 2) % 3}; }
+
+    /** Convex hull (Andrew's monotone chain), counter-clockwise */
+    std::vector<G4TwoVector> ConvexHull(std::vector<G4TwoVector> points)
+    {
+        std::sort(points.begin(), points.end(), [](const G4TwoVector &a, const G4TwoVector &b)
+                  { return a.x() < b.x() || (a.x() == b.x() && a.y() < b.y()); });
+        points.erase(std::unique(points.begin(), points.end()), points.end());
+        if (points.size() < 3)
+            return {};
+
+        auto cross = [](const G4TwoVector &o, const G4TwoVector &a, const G4TwoVector &b)
+        { return (a.x() - o.x()) * (b.y() - o.y()) - (a.y() - o.y()) * (b.x() - o.x()); };
+
+        std::vector<G4TwoVector> hull(2 * points.size());
+        size_t k = 0;
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            while (k >= 2 && cross(hull[k - 2], hull[k - 1], points[i]) <= 0.)
+                --k;
+            hull[k++] = points[i];
+        }
+        for (size_t i = points.size() - 1, lower = k + 1; i-- > 0;)
+        {
+            while (k >= lower && cross(hull[k - 2], hull[k - 1], points[i]) <= 0.)
+                --k;
+            hull[k++] = points[i];
+        }
+        hull.resize(k - 1);
+        return hull;
+    }
+
+    G4bool InsideHull(const std::vector<G4TwoVector>& hull, const G4TwoVector& p)
+    {
+        for (size_t i = 0; i < hull.size(); ++i)
+        {
+            const G4TwoVector &a = hull[i], &b = hull[(i + 1) % hull.size()];
+            if ((b.x() - a.x()) * (p.y() - a.y()) - (b.y() - a.y()) * (p.x() - a.x()) < 0.)
+                return false;
+        }
+        return true;
+    }
+
+    G4double HullArea(const std::vector<G4TwoVector>& hull)
+    {
+        G4double area = 0.;
+        for (size_t i = 0; i < hull.size(); ++i)
+        {
+            const G4TwoVector &a = hull[i], &b = hull[(i + 1) % hull.size()];
+            area += a.x() * b.y() - b.x() * a.y();
+        }
+        return 0.5 * area;
+    }
+
+    /**
+     * @brief Step profile of a part along an axis.
+     *
+     * The CAD exports are cylinders, cones and planes, so the cross-section
+     * only changes at the planes of the vertices: each slab between two
+     * consecutive planes gets the radial extent of the cut of the triangles
+     * at its middle, from the axis if the axis point is inside the part.
+     *
+     * @return Sections of the profile, empty if the part is too detailed or
+     *         has a gap along the axis
+     */
+    std::vector<Section> Profile(const std::vector<double>& v, const MeshSampler& sampler,
+                                 const G4ThreeVector& centre, G4int axis)
+    {
+        const auto [i, j] = Transverse(axis);
+        std::vector<double> planes;
+        planes.reserve(v.size() / 3);
+        for (size_t p = static_cast<size_t>(axis); p < v.size(); p += 3)
+            planes.push_back(v[p]);
+        std::sort(planes.begin(), planes.end());
+        planes.erase(std::unique(planes.begin(), planes.end(),
+                                 [](double a, double b) { return b - a < kPlaneTolerance; }),
+                     planes.end());
+        if (planes.size() < 2 || planes.size() > kMaxPlanes)
+            return {};
+
+        std::vector<Section> sections;
+        for (size_t k = 0; k + 1 < planes.size(); ++k)
+        {
+            const double h = 0.5 * (planes[k] + planes[k + 1]);
+            double r2min = DBL_MAX, r2max = -1.;
+            for (size_t t = 0; t + 9 <= v.size(); t += 9)
+                for (size_t e = 0; e < 3; ++e)
+                {
+                    const double *a = &v[t + 3 * e], *b = &v[t + 3 * ((e + 1) % 3)];
+                    if ((a[axis] - h) * (b[axis] - h) >= 0.)
+                        continue;
+                    const double f = (h - a[axis]) / (b[axis] - a[axis]);
+                    const double x = a[i] + f * (b[i] - a[i]) - centre[i];
+                    const double y = a[j] + f * (b[j] - a[j]) - centre[j];
+                    r2min = std::min(r2min, x * x + y * y);
+                    r2max = std::max(r2max, x * x + y * y);
+                }
+            if (r2max < 0.)
+                return {};
+
+            G4ThreeVector onAxis = centre;
+            onAxis[axis] = h;
+            const Section section{planes[k] - centre[axis], planes[k + 1] - centre[axis],
+                                  sampler.Inside(onAxis) ? 0. : std::sqrt(r2min), std::sqrt(r2max)};
+            if (!sections.empty() && std::abs(sections.back().rmin - section.rmin) < kRadiusTolerance &&
+                std::abs(sections.back().rmax - section.rmax) < kRadiusTolerance)
+            {
+                Section &last = sections.back();
+                last.z1 = section.z1;
+                last.rmin = std::min(last.rmin, section.rmin);
+                last.rmax = std::max(last.rmax, section.rmax);
+            }
+            else
+                sections.push_back(section);
+        }
+        return sections.size() <= kMaxSections ? sections : std::vector<Section>();
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const std::vector<G4String>& PlasmaMLPALLASCADModels::GetModeNames()
+{
+    static const std::vector<G4String> names = {"tessellated", "proxy"};
+    return names;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PlasmaMLPALLASCADModels::SetMode(const G4String &mode, const G4String &volume)
+{
+    if (mode == "tessellated")
+        fModes[volume] = Mode::Tessellated;
+    else if (mode == "proxy")
+        fModes[volume] = Mode::Proxy;
+    else
+        return false;
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASCADModels::SetVoxelLimits(const G4String &volume, G4int smartless, G4int maxVoxels)
+{
+    fSmartless[volume] = smartless;
+    fMaxVoxels[volume] = maxVoxels;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+template <typename T>
+T PlasmaMLPALLASCADModels::Find(const std::map<G4String, T> &values, const G4String &volume, T fallback)
+{
+    auto it = values.find(volume);
+    if (it == values.end())
+        it = values.find("all");
+    return it == values.end() ? fallback : it->second;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Build the logical volume of a CAD part.
+ * @param mesh Triangles of the part
+ * @param material Material of the part
+ * @param volume Name of the logical volume
+ * @return New logical volume
+ *
+ * In proxy mode, the part is fitted with its bounding box and, along each
+ * axis, a full and a hollow tube, a convex extrusion and a stepped polycone
+ * following the cross-section of the part; the shape with the
+ * largest overlap replaces the triangles if its overlap reaches the
+ * tolerance. The density of the proxy material is scaled by the ratio of the
+ * part volume to the shape volume.
+ */
+G4LogicalVolume *PlasmaMLPALLASCADModels::Build(const PlasmaMLPALLASTessellatedMesh &mesh, G4Material *material,
+                                                const G4String &volume)
+{
+    if (Find(fModes, volume, Mode::Tessellated) == Mode::Tessellated)
+        return new G4LogicalVolume(PlasmaMLPALLASGDMLLoader::BuildSolid(mesh, Find(fMaxVoxels, volume, -1)),
+                                   material, volume);
+
+    const std::vector<double> &v = mesh.vertices;
+    Fit fit;
+    fit.volume = volume;
+
+    // Bounding box and volume of the triangles (divergence theorem)
+    G4ThreeVector low(DBL_MAX, DBL_MAX, DBL_MAX), high(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+    for (size_t i = 0; i + 3 <= v.size(); i += 3)
+        for (G4int k = 0; k < 3; ++k)
+        {
+            low[k] = std::min(low[k], v[i + k]);
+            high[k] = std::max(high[k], v[i + k]);
+        }
+    for (size_t t = 0; t + 9 <= v.size(); t += 9)
+    {
+        const G4ThreeVector a(v[t], v[t + 1], v[t + 2]), b(v[t + 3], v[t + 4], v[t + 5]), c(v[t + 6], v[t + 7], v[t + 8]);
+        fit.meshVolume += a.dot(b.cross(c)) / 6.;
+    }
+    fit.meshVolume = std::abs(fit.meshVolume);
+
+    const G4ThreeVector centre = 0.5 * (low + high);
+    const G4ThreeVector size = high - low;
+    if (fit.meshVolume <= 0. || size.x() <= 0. || size.y() <= 0. || size.z() <= 0.)
+    {
+        G4ExceptionDescription msg;
+        msg << volume << ": the triangles enclose no volume, the part stays tessellated";
+        G4Exception("PlasmaMLPALLASCADModels::Build", "CAD0002", JustWarning, msg);
+        fFits.push_back(fit);
+        return new G4LogicalVolume(PlasmaMLPALLASGDMLLoader::BuildSolid(mesh, Find(fMaxVoxels, volume, -1)),
+                                   material, volume);
+    }
+
+    // Candidate shapes
+    const MeshSampler sampler(v, low, high);
+    std::vector<Candidate> candidates(1);
+    candidates[0].shape = "box";
+    candidates[0].volume = size.x() * size.y() * size.z();
+    const char *axisNames[3] = {"x", "y", "z"};
+    for (G4int axis = 0; axis < 3; ++axis)
+    {
+        const auto [i, j] = Transverse(axis);
+        G4double r2min = DBL_MAX, r2max = 0.;
+        std::vector<G4TwoVector> points;
+        points.reserve(v.size() / 3);
+        for (size_t p = 0; p + 3 <= v.size(); p += 3)
+        {
+            const G4TwoVector local(v[p + i] - centre[i], v[p + j] - centre[j]);
+            r2min = std::min(r2min, local.mag2());
+            r2max = std::max(r2max, local.mag2());
+            points.push_back(local);
+        }
+
+        Candidate tube;
+        tube.kind = Candidate::Kind::Tube;
+        tube.shape = G4String("tube_") + axisNames[axis];
+        tube.axis = axis;
+        tube.rmax = std::sqrt(r2max);
+        tube.volume = pi * r2max * size[axis];
+        candidates.push_back(tube);
+
+        if (std::sqrt(r2min) > 0.01 * tube.rmax)
+        {
+            tube.shape = G4String("hollow_tube_") + axisNames[axis];
+            tube.rmin = std::sqrt(r2min);
+            tube.volume = pi * (r2max - r2min) * size[axis];
+            candidates.push_back(tube);
+        }
+
+        Candidate extrusion;
+        extrusion.hull = ConvexHull(std::move(points));
+        if (extrusion.hull.size() >= 3 && extrusion.hull.size() <= kMaxHullPoints)
+        {
+            extrusion.kind = Candidate::Kind::Extrusion;
+            extrusion.shape = G4String("extrusion_") + axisNames[axis];
+            extrusion.axis = axis;
+            extrusion.volume = HullArea(extrusion.hull) * size[axis];
+            candidates.push_back(std::move(extrusion));
+        }
+
+        Candidate polycone;
+        polycone.sections = Profile(v, sampler, centre, axis);
+        if (polycone.sections.size() > 1)
+        {
+            polycone.kind = Candidate::Kind::Polycone;
+            polycone.shape = G4String("polycone_") + axisNames[axis];
+            polycone.axis = axis;
+            for (const Section &section : polycone.sections)
+                polycone.volume += pi * (section.rmax * section.rmax - section.rmin * section.rmin) *
+                                   (section.z1 - section.z0);
+            candidates.push_back(std::move(polycone));
+        }
+    }
+
+    // Overlap of each shape with the triangles
+    std::mt19937_64 engine(20250101);
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    size_t inside = 0;
+    for (size_t s = 0; s < kSamples; ++s)
+    {
+        const G4ThreeVector point(low.x() + size.x() * uniform(engine), low.y() + size.y() * uniform(engine),
+                                  low.z() + size.z() * uniform(engine));
+        const G4bool inPart = sampler.Inside(point);
+        inside += inPart;
+        for (Candidate &candidate : candidates)
+        {
+            G4bool inShape = true;
+            if (candidate.axis >= 0)
+            {
+                const auto [i, j] = Transverse(candidate.axis);
+                const G4TwoVector local(point[i] - centre[i], point[j] - centre[j]);
+                G4double rmin = candidate.rmin, rmax = candidate.rmax;
+                if (candidate.kind == Candidate::Kind::Polycone)
+                {
+                    const G4double z = point[candidate.axis] - centre[candidate.axis];
+                    const auto section = std::lower_bound(candidate.sections.begin(), candidate.sections.end(), z,
+                                                          [](const Section &a, G4double b) { return a.z1 < b; });
+                    rmin = section == candidate.sections.end() ? 0. : section->rmin;
+                    rmax = section == candidate.sections.end() ? 0. : section->rmax;
+                }
+                inShape = candidate.kind == Candidate::Kind::Extrusion
+                              ? InsideHull(candidate.hull, local)
+                              : local.mag2() >= rmin * rmin && local.mag2() <= rmax * rmax;
+            }
+            candidate.common += inPart && inShape;
+            candidate.merged += inPart || inShape;
+        }
+    }
+
+    auto overlap = [](const Candidate &c) { return c.merged ? static_cast<G4double>(c.common) / c.merged : 0.; };
+    const Candidate &best = *std::max_element(candidates.begin(), candidates.end(),
+                                              [&](const Candidate &a, const Candidate &b)
+                                              { return overlap(a) < overlap(b); });
+    fit.shape = best.shape;
+    fit.proxyVolume = best.volume;
+    fit.overlap = overlap(best);
+    fit.missed = inside ? 1. - static_cast<G4double>(best.common) / inside : 0.;
+    fit.used = fit.overlap >= fProxyTolerance;
+    fFits.push_back(fit);
+
+    if (!fit.used)
+        return new G4LogicalVolume(PlasmaMLPALLASGDMLLoader::BuildSolid(mesh, Find(fMaxVoxels, volume, -1)),
+                                   material, volume);
+
+    // Shape placed in the frame of the part: local z along the axis
+    const G4String name = mesh.solidName + "_proxy";
+    G4VSolid *shape = nullptr;
+    G4RotationMatrix rotation;
+    if (best.kind == Candidate::Kind::Box)
+        shape = new G4Box(name + "_shape", size.x() / 2., size.y() / 2., size.z() / 2.);
+    else
+    {
+        const auto [i, j] = Transverse(best.axis);
+        G4ThreeVector localX, localY, localZ;
+        localX[i] = 1.;
+        localY[j] = 1.;
+        localZ[best.axis] = 1.;
+        rotation.rotateAxes(localX, localY, localZ);
+
+        if (best.kind == Candidate::Kind::Tube)
+            shape = new G4Tubs(name + "_shape", best.rmin, best.rmax, size[best.axis] / 2., 0., twopi);
+        else if (best.kind == Candidate::Kind::Extrusion)
+        {
+            // G4ExtrudedSolid expects a clockwise polygon
+            std::vector<G4TwoVector> polygon(best.hull.rbegin(), best.hull.rend());
+            shape = new G4ExtrudedSolid(name + "_shape", polygon, size[best.axis] / 2.);
+        }
+        else
+        {
+            // Two planes per section: steps between the sections
+            std::vector<G4double> z, rInner, rOuter;
+            for (const Section &section : best.sections)
+                for (G4double plane : {section.z0, section.z1})
+                {
+                    z.push_back(plane);
+                    rInner.push_back(section.rmin);
+                    rOuter.push_back(section.rmax);
+                }
+            shape = new G4Polycone(name + "_shape", 0., twopi, static_cast<G4int>(z.size()), z.data(), rInner.data(),
+                                   rOuter.data());
+        }
+    }
+    auto solid = new G4DisplacedSolid(name, shape, G4Transform3D(rotation, centre));
+
+    // Same mass as the part
+    const G4String materialName = material->GetName() + "_" + volume + "_proxy";
+    G4Material *diluted = G4Material::GetMaterial(materialName, false);
+    if (!diluted)
+        diluted = new G4Material(materialName, material->GetDensity() * fit.meshVolume / fit.proxyVolume, material);
+
+    return new G4LogicalVolume(solid, diluted, volume);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Apply the smartless values and print the report of the proxies.
+ *
+ * Called at the end of PlasmaMLPALLASGeometryConstruction::Construct, once
+ * all the volumes are in the store; the report is cleared for the next
+ * construction.
+ */
+void PlasmaMLPALLASCADModels::EndConstruction()
+{
+    for (G4LogicalVolume *logical : *G4LogicalVolumeStore::GetInstance())
+    {
+        const G4int smartless = Find(fSmartless, logical->GetName(), -1);
+        if (smartless > 0)
+            logical->SetSmartless(smartless);
+    }
+
+    if (fFits.empty())
+        return;
+
+    G4int kept = 0;
+    G4cout << "CAD proxies (minimum overlap " << fProxyTolerance << "):" << G4endl;
+    for (const Fit &fit : fFits)
+    {
+        G4cout << "  " << fit.volume << ": ";
+        if (fit.shape.empty())
+            G4cout << "no volume, tessellated";
+        else
+            G4cout << (fit.used ? "" : "kept tessellated, best ") << fit.shape << " overlap " << fit.overlap
+                   << ", part outside " << 100. * fit.missed << " %, volume " << fit.meshVolume / cm3 << " -> "
+                   << fit.proxyVolume / cm3 << " cm3 (density x" << fit.meshVolume / fit.proxyVolume << ")";
+        G4cout << G4endl;
+        kept += !fit.used;
+    }
+
+    if (kept > 0)
+    {
+        G4ExceptionDescription msg;
+        msg << kept << " of " << fFits.size() << " CAD parts in proxy mode stay tessellated: no proxy reaches the"
+            << " minimum overlap (/PlasmaMLPALLAS/geometry/setProxyTolerance)";
+        G4Exception("PlasmaMLPALLASCADModels::EndConstruction", "CAD0001", JustWarning, msg);
+    }
+    fFits.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASCADModels::Print() const
+{
+    G4cout << "CAD parts: default mode "
+           << GetModeNames()[static_cast<size_t>(Find(fModes, "all", Mode::Tessellated))]
+           << ", proxy tolerance " << fProxyTolerance << G4endl;
+    for (const auto &[volume, mode] : fModes)
+        if (volume != "all")
+            G4cout << "  " << volume << ": " << GetModeNames()[static_cast<size_t>(mode)] << G4endl;
+    for (const auto &[volume, smartless] : fSmartless)
+        G4cout << "  " << volume << ": smartless " << smartless << ", max voxels " << fMaxVoxels.at(volume) << G4endl;
+}
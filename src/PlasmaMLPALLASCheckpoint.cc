@@ -0,0 +1,242 @@
+/**
+ * @file PlasmaMLPALLASCheckpoint.cc
+ * @brief Implementation of the resumable jobs split into chunks of events.
+ *
+ * Each chunk is one Geant4 run of the already initialised kernel, with the
+ * chunk index set in the output manager so that it writes and closes a file
+ * of its own. A chunk is recorded in the checkpoint only once its run ended
+ * with all its events: a job killed in the middle of a chunk simulates that
+ * chunk again, from the engine state saved after the previous one.
+ *
+ * The checkpoint is a text file of "key value" lines, followed by the line
+ * "rng" and the full state of the random engine of the master
+ * (G4Random::saveFullState).
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASCheckpoint.hh"
+#include "PlasmaMLPALLASCheckpointMessenger.hh"
+#include "PlasmaMLPALLASOutputManager.hh"
+#include "PlasmaMLPALLASScanDriver.hh"
+#include "PlasmaMLPALLASOptimiser.hh"
+#include "G4RunManager.hh"
+#include "G4Run.hh"
+#include "G4UImanager.hh"
+#include "Randomize.hh"
+#include "G4ios.hh"
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    /// First line of a checkpoint file
+    const char* kHeader = "PlasmaMLPALLAS checkpoint";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASCheckpoint& PlasmaMLPALLASCheckpoint::Instance()
+{
+    static PlasmaMLPALLASCheckpoint instance;
+    return instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASCheckpoint::PlasmaMLPALLASCheckpoint()
+{
+    fMessenger = new PlasmaMLPALLASCheckpointMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASCheckpoint::~PlasmaMLPALLASCheckpoint()
+{
+    delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PlasmaMLPALLASCheckpoint::GetFile() const
+{
+    if (!fFile.empty())
+        return fFile;
+    const G4String path = PlasmaMLPALLASOutputManager::Instance().GetOutputPath(fOutputName);
+    return fs::path(path.c_str()).replace_extension(".checkpoint").string();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PlasmaMLPALLASCheckpoint::Load(const G4String& path, State& state)
+{
+    std::ifstream in(path.c_str());
+    std::string line;
+    if (!in || !std::getline(in, line) || line != kHeader)
+        return false;
+
+    while (std::getline(in, line))
+    {
+        if (line == "rng")
+        {
+            std::ostringstream rng;
+            rng << in.rdbuf();
+            state.rng = rng.str();
+            return state.eventsTotal > 0 && state.chunkEvents > 0 && !state.rng.empty() &&
+                   state.files.size() == static_cast<size_t>(state.chunksDone);
+        }
+
+        std::istringstream is(line);
+        std::string key;
+        is >> key;
+        if (key == "eventsTotal")
+            is >> state.eventsTotal;
+        else if (key == "chunkEvents")
+            is >> state.chunkEvents;
+        else if (key == "chunksDone")
+            is >> state.chunksDone;
+        else if (key == "eventsDone")
+            is >> state.eventsDone;
+        else if (key == "file")
+        {
+            std::string file;
+            std::getline(is >> std::ws, file);
+            state.files.push_back(file);
+        }
+    }
+    return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PlasmaMLPALLASCheckpoint::Save(const G4String& path, const State& state)
+{
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp);
+        out << kHeader << '\n'
+            << "eventsTotal " << state.eventsTotal << '\n'
+            << "chunkEvents " << state.chunkEvents << '\n'
+            << "chunksDone " << state.chunksDone << '\n'
+            << "eventsDone " << state.eventsDone << '\n';
+        for (const G4String& file : state.files)
+            out << "file " << file << '\n';
+        out << "rng\n" << state.rng;
+        if (!out.flush())
+            return false;
+    }
+
+    std::error_code ec;
+    fs::rename(tmp, path.c_str(), ec);
+    return !ec;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Run a job of N events in chunks, resuming it from its checkpoint
+ * @param nEvents Number of events of the whole job
+ *
+ * A checkpoint written for another number of events or chunk size is not
+ * resumed: the job starts again and overwrites it.
+ */
+void PlasmaMLPALLASCheckpoint::Run(G4long nEvents)
+{
+    if (fRunning || PlasmaMLPALLASScanDriver::Instance().IsRunning() || PlasmaMLPALLASOptimiser::Instance().IsRunning())
+    {
+        G4Exception("PlasmaMLPALLASCheckpoint::Run", "CKPT0001", JustWarning,
+                    "A checkpointed job cannot run within a scan, an optimisation or another job.");
+        return;
+    }
+
+    PlasmaMLPALLASOutputManager& output = PlasmaMLPALLASOutputManager::Instance();
+    const G4String path = GetFile();
+
+    State state;
+    if (Load(path, state) && state.eventsTotal == nEvents && state.chunkEvents == fChunkEvents)
+    {
+        std::istringstream rng(state.rng);
+        G4Random::restoreFullState(rng);
+        G4cout << "### Resuming " << path << " : " << state.chunksDone << " chunks, "
+               << state.eventsDone << "/" << nEvents << " events done" << G4endl;
+    }
+    else
+    {
+        if (fs::exists(path.c_str()))
+        {
+            G4ExceptionDescription msg;
+            msg << "Checkpoint " << path << " does not match a job of " << nEvents << " events in chunks of "
+                << fChunkEvents << " (or cannot be read): the job starts from the beginning.";
+            G4Exception("PlasmaMLPALLASCheckpoint::Run", "CKPT0002", JustWarning, msg);
+        }
+        state = State();
+        state.eventsTotal = nEvents;
+        state.chunkEvents = fChunkEvents;
+        G4Random::setTheSeed(time(NULL));
+    }
+
+    G4UImanager* UI = G4UImanager::GetUIpointer();
+    fRunning = true;
+
+    while (state.eventsDone < nEvents)
+    {
+        const G4long n = std::min<G4long>(fChunkEvents, nEvents - state.eventsDone);
+        fChunkIndex = state.chunksDone;
+        fEventOffset = state.eventsDone;
+        output.SetChunkIndex(state.chunksDone);
+        const G4String file = output.GetOutputPath(fOutputName);
+
+        G4cout << "### Chunk " << state.chunksDone << " : events " << state.eventsDone << " to "
+               << state.eventsDone + n - 1 << " of " << nEvents << " in " << file << G4endl;
+        UI->ApplyCommand("/run/beamOn " + std::to_string(n));
+
+        // An aborted run leaves the chunk out of the checkpoint, to be simulated again
+        const G4Run* run = G4RunManager::GetRunManager()->GetCurrentRun();
+        if (!run || run->GetNumberOfEvent() < n)
+        {
+            G4Exception("PlasmaMLPALLASCheckpoint::Run", "CKPT0003", JustWarning,
+                        "Chunk not completed: the job stops, resubmit it to resume from the checkpoint.");
+            break;
+        }
+
+        state.files.push_back(file);
+        state.chunksDone++;
+        state.eventsDone += n;
+        std::ostringstream rng;
+        G4Random::saveFullState(rng);
+        state.rng = rng.str();
+        if (!Save(path, state))
+        {
+            G4ExceptionDescription msg;
+            msg << "Cannot write the checkpoint " << path << ": the job would not resume from this chunk.";
+            G4Exception("PlasmaMLPALLASCheckpoint::Run", "CKPT0004", JustWarning, msg);
+        }
+    }
+
+    output.SetChunkIndex(-1);
+    fRunning = false;
+    fChunkIndex = 0;
+    fEventOffset = 0;
+    fHasRun = true;
+
+    if (state.eventsDone < nEvents)
+        return;
+
+    // Complete job: one output file, as without chunks
+    if (output.MergeFiles(state.files, fOutputName))
+    {
+        std::error_code ec;
+        for (const G4String& file : state.files)
+            fs::remove(file.c_str(), ec);
+        fs::remove(path.c_str(), ec);
+        G4cout << "### Job of " << nEvents << " events merged into " << output.GetOutputPath(fOutputName) << G4endl;
+    }
+}
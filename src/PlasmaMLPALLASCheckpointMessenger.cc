@@ -0,0 +1,102 @@
+#include "PlasmaMLPALLASCheckpointMessenger.hh"
+#include "PlasmaMLPALLASCheckpoint.hh"
+
+/**
+ * @file PlasmaMLPALLASCheckpointMessenger.cc
+ * @brief User interface (UI) messenger for the resumable jobs in chunks of events.
+ *
+ * Commands are organized in the /PlasmaMLPALLAS/checkpoint/ directory and allow users to:
+ *  - Set the checkpoint file of the job.
+ *  - Set the number of events of each chunk.
+ *  - Run the job, or resume it from its checkpoint.
+ *
+ * @authors Arnaud HUBER
+ * @authors Alexei SYTOV
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Constructor.
+ * @param checkpoint Pointer to the checkpoint driver.
+ */
+PlasmaMLPALLASCheckpointMessenger::PlasmaMLPALLASCheckpointMessenger(PlasmaMLPALLASCheckpoint *checkpoint)
+    : G4UImessenger(), fCheckpoint(checkpoint)
+{
+    fCheckpointDir = new G4UIdirectory("/PlasmaMLPALLAS/checkpoint/");
+    fCheckpointDir->SetGuidance("Resumable jobs in chunks of events UI commands");
+
+    /**
+     * @brief Command to set the checkpoint file.
+     */
+    fSetFileCmd = new G4UIcmdWithAString("/PlasmaMLPALLAS/checkpoint/setFile", this);
+    fSetFileCmd->SetGuidance("Checkpoint file of the job, resumed when it matches the job");
+    fSetFileCmd->SetGuidance("Default: the output file with the .checkpoint extension");
+    fSetFileCmd->SetParameterName("File", false);
+    fSetFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fSetFileCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the number of events of each chunk.
+     */
+    fSetChunkEventsCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/checkpoint/setChunkEvents", this);
+    fSetChunkEventsCmd->SetGuidance("Events of each chunk (one run and one closed file per chunk)");
+    fSetChunkEventsCmd->SetParameterName("Events", false);
+    fSetChunkEventsCmd->SetRange("Events>=1");
+    fSetChunkEventsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fSetChunkEventsCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to run or resume the job.
+     *
+     * Parameter: NEvents (integer, events of the whole job)
+     */
+    fBeamOnCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/checkpoint/beamOn", this);
+    fBeamOnCmd->SetGuidance("Simulate NEvents in chunks of setChunkEvents events, skipping the chunks of the checkpoint");
+    fBeamOnCmd->SetGuidance("The chunk files are merged into the output file once the last one is done");
+    fBeamOnCmd->SetParameterName("NEvents", false);
+    fBeamOnCmd->SetRange("NEvents>=1");
+    fBeamOnCmd->AvailableForStates(G4State_Idle);
+    fBeamOnCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Destructor.
+ */
+PlasmaMLPALLASCheckpointMessenger::~PlasmaMLPALLASCheckpointMessenger()
+{
+    delete fSetFileCmd;
+    delete fSetChunkEventsCmd;
+    delete fBeamOnCmd;
+    delete fCheckpointDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASCheckpointMessenger::SetNewValue(G4UIcommand *aCommand, G4String aNewValue)
+{
+    if (aCommand == fSetFileCmd)
+        fCheckpoint->SetFile(aNewValue);
+    else if (aCommand == fSetChunkEventsCmd)
+        fCheckpoint->SetChunkEvents(fSetChunkEventsCmd->GetNewIntValue(aNewValue));
+    else if (aCommand == fBeamOnCmd)
+        fCheckpoint->Run(fBeamOnCmd->GetNewIntValue(aNewValue));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PlasmaMLPALLASCheckpointMessenger::GetCurrentValue(G4UIcommand *aCommand)
+{
+    G4String cv;
+
+    if (aCommand == fSetFileCmd)
+        cv = fCheckpoint->GetFile();
+    else if (aCommand == fSetChunkEventsCmd)
+        cv = fSetChunkEventsCmd->ConvertToString(fCheckpoint->GetChunkEvents());
+
+    return cv;
+}
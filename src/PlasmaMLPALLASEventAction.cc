@@ -7,11 +7,13 @@
  * 
  * The responsibilities of this class include:
  *  - Resetting all per-event statistics at the beginning of an event.
- *  - Collecting input, collimator, beam stop, YAG detector, and quadrupole statistics during the event.
+ *  - Collecting input, collimator, beam stop, YAG detector, and quadrupole statistics during the event,
+ *    per primary when the event holds a bunch of primaries.
  *  - Passing per-event statistics to the run-level action (PlasmaMLPALLASRunAction) at the end of the event.
  *
  * The class works in conjunction with:
- *  - PlasmaMLPALLASSteppingAction: for per-step updates within an event.
+ *  - PlasmaMLPALLASSensitiveDetectors: hits collections of the quadrupoles,
+ *    collimators and YAG screens, turned into tallies at the end of the event.
  *  - PlasmaMLPALLASRunAction: to accumulate run-level statistics.
  *
  * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
@@ -21,18 +23,25 @@
  */
 
 
-#include "PlasmaMLPALLASSteppingAction.hh"    ///< Stepping action header (per-step updates)
 #include "PlasmaMLPALLASEventAction.hh"       ///< Event action header
 #include "PlasmaMLPALLASRunAction.hh"         ///< Run action header (for statistics accumulation)
+#include "PlasmaMLPALLASHits.hh"              ///< Hits of the sensitive detectors
+#include "G4SDManager.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4HCtable.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
 
 /**
  * @brief Constructor for PlasmaMLPALLASEventAction
  * @param suff Suffix used for naming ROOT branches or output files
  *
- * Initializes the event action and stores the provided suffix.
+ * Initializes the event action, stores the provided suffix and registers
+ * the event counter of the calling thread with the progress monitor.
  */
 PlasmaMLPALLASEventAction::PlasmaMLPALLASEventAction(const char *suff) 
-    : suffixe(suff) 
+    : suffixe(suff),
+      fProgressCounter(PlasmaMLPALLASProgressMonitor::Instance().RegisterThread())
 {}
 
 /**
@@ -47,6 +56,8 @@ PlasmaMLPALLASEventAction::~PlasmaMLPALLASEventAction() {}
  * @param evt Pointer to the current G4Event
  *
  * Resets all per-event statistics and counters to initial empty states.
+ * The per-primary arrays are sized to the number of primary vertices, which
+ * are already generated at this point; their capacity is kept across events.
  * This includes:
  * - Input-related counters
  * - Horizontal and vertical collimator statistics
@@ -55,29 +66,35 @@ PlasmaMLPALLASEventAction::~PlasmaMLPALLASEventAction() {}
  */
 void PlasmaMLPALLASEventAction::BeginOfEventAction(const G4Event *evt)
 {
-    /** Reset input statistics */
-    StatsInput = {};
+    const size_t nPrimaries = evt->GetNumberOfPrimaryVertex();
+
+    /** Reset input statistics and read them from the primary vertices */
+    StatsInput.assign(nPrimaries, RunTallyInput{});
+    FillInput(evt);
 
     /** Reset horizontal and vertical collimator statistics */
-    StatsHorizontalColl = {};
-    StatsVerticalColl = {};
+    StatsHorizontalColl.assign(nPrimaries, RunTallyCollimators{});
+    StatsVerticalColl.assign(nPrimaries, RunTallyCollimators{});
 
-    /** Reset Beam Stop (BS) and BSPEC YAG detector statistics */
-    StatsBSYAG = {};
-    StatsBSPECYAG = {};
+    /** Reset Beam Stop (BS) and BSPEC YAG detector statistics, keeping the buffers */
+    StatsBSYAG.Clear();
+    StatsBSPECYAG.Clear();
 
     /** Reset Quadrupole statistics */
-    StatsQuadrupoles = {};
+    StatsQuadrupoles.assign(nPrimaries, RunTallyQuadrupoles{});
 }
 
 /**
  * @brief Called at the end of each event
  * @param evt Pointer to the current G4Event
  *
- * Updates run-level statistics by passing the per-event data to the
- * PlasmaMLPALLASRunAction. Only non-empty or relevant data are updated
- * for input, BS YAG, and BSPEC YAG statistics, while quadrupole and
- * collimator statistics are always updated.
+ * Builds the detector tallies from the hits collections, then
+ * updates run-level statistics by passing the per-event data to the
+ * PlasmaMLPALLASRunAction. The per-primary arrays are handed over at once,
+ * and the YAG tallies are swapped with the rows of the run action: the
+ * buffers go back and forth between the two without being copied.
+ * Only valid input rows and flagged collimator rows are written, YAG
+ * statistics only when not empty, and one quadrupole row per primary.
  */
 void PlasmaMLPALLASEventAction::EndOfEventAction(const G4Event *evt)
 {
@@ -85,9 +102,11 @@ void PlasmaMLPALLASEventAction::EndOfEventAction(const G4Event *evt)
     PlasmaMLPALLASRunAction *runac = 
         (PlasmaMLPALLASRunAction *)(G4RunManager::GetRunManager()->GetUserRunAction());
 
-    /** Update input energy statistics if valid */
-    if (StatsInput.energy > 0) 
-        runac->UpdateStatisticsInput(StatsInput);
+    /** Turn the hits of the sensitive detectors into tallies */
+    FillFromHits(evt);
+
+    /** Update input energy statistics of the valid primaries */
+    runac->UpdateStatisticsInput(StatsInput);
 
     /** Update Beam Stop YAG statistics if not empty */
     if (!StatsBSYAG.energy.empty()) 
@@ -97,18 +116,157 @@ void PlasmaMLPALLASEventAction::EndOfEventAction(const G4Event *evt)
     if (!StatsBSPECYAG.energy.empty()) 
         runac->UpdateStatisticsBSPECYAG(StatsBSPECYAG);
 
-    /** Always update quadrupole and collimator statistics */
+    /** Always update quadrupole statistics, flagged collimator statistics only */
     runac->UpdateStatisticsQuadrupoles(StatsQuadrupoles);
+    runac->UpdateStatisticsHorizontalColl(StatsHorizontalColl);
+    runac->UpdateStatisticsVerticalColl(StatsVerticalColl);
+
+    /** Flush the tables of the thread when the limits of setFlushEvents/setFlushSize are reached */
+    runac->EndOfEvent();
+
+    /** Count the event for the progress report (thread-owned counter, no clock read) */
+    fProgressCounter.Increment();
+}
 
-    if(StatsHorizontalColl.GetFlag()==true)
+/**
+ * @brief Fill the input tallies from the primary vertices
+ * @param evt Pointer to the current G4Event
+ *
+ * The primaries are turned into tracks in the order of the vertices, so
+ * the k-th primary particle gets track ID k. Its first step starts at the
+ * vertex with the generated kinetic energy and direction, and its weight is
+ * the product of the vertex and particle weights.
+ */
+void PlasmaMLPALLASEventAction::FillInput(const G4Event *evt)
+{
+    G4int trackID = 0;
+    for (G4int i = 0; i < evt->GetNumberOfPrimaryVertex(); ++i)
     {
-      runac->UpdateStatisticsHorizontalColl(StatsHorizontalColl);
-      StatsHorizontalColl.ResetFlag();
+        const G4PrimaryVertex *vertex = evt->GetPrimaryVertex(i);
+        for (const G4PrimaryParticle *particle = vertex->GetPrimary(); particle; particle = particle->GetNext())
+        {
+            const G4ThreeVector position = vertex->GetPosition() / CLHEP::mm;
+            const G4ThreeVector &direction = particle->GetMomentumDirection();
+
+            auto &input = GetStatsInput(++trackID);
+            input.x = position.x();
+            input.xp = direction.x();
+            input.y = position.y();
+            input.yp = direction.y();
+            input.z = position.z();
+            input.zp = direction.z();
+            input.energy = particle->GetKineticEnergy() / CLHEP::MeV;
+            input.weight = vertex->GetWeight() * particle->GetWeight();
+        }
     }
+}
+
+/**
+ * @brief Resolve the hits collection IDs
+ *
+ * The collimator detector only exists when the collimators are displayed,
+ * so the IDs are resolved again whenever the collection table grows.
+ */
+void PlasmaMLPALLASEventAction::UpdateCollectionIDs()
+{
+    G4SDManager *sdManager = G4SDManager::GetSDMpointer();
+    const size_t numCollections = sdManager->GetHCtable()->entries();
+    if (numCollections == fNumCollections)
+        return;
+
+    fNumCollections = numCollections;
+    const auto id = [sdManager](const G4String &detector, const G4String &collection) {
+        return sdManager->FindSensitiveDetector(detector, false)
+                   ? sdManager->GetCollectionID(detector + "/" + collection) : -1;
+    };
+    fQuadrupoleHCID = id("Quadrupoles", "Hits");
+    fHorizontalCollHCID = id("Collimators", "Horizontal");
+    fVerticalCollHCID = id("Collimators", "Vertical");
+    fBSYAGHCID = id("BS1YAG", "Hits");
+    fBSPECYAGHCID = id("BSPEC1YAG", "Hits");
+}
 
-    if(StatsVerticalColl.GetFlag()==true)
+/**
+ * @brief Turn the hits collections of the event into the tallies
+ * @param evt Pointer to the current G4Event
+ *
+ * The hits are read in the order they were made, so a quadrupole crossed
+ * twice keeps its last crossing, and the YAG entries keep their order. The
+ * deposit of a passage still open at the end of the event (particle leaving
+ * the screen into another volume) is not added to the total.
+ */
+void PlasmaMLPALLASEventAction::FillFromHits(const G4Event *evt)
+{
+    G4HCofThisEvent *hce = evt->GetHCofThisEvent();
+    if (!hce)
+        return;
+
+    UpdateCollectionIDs();
+
+    const auto collection = [hce](G4int id) -> G4VHitsCollection * {
+        return id < 0 ? nullptr : hce->GetHC(id);
+    };
+
+    /** Quadrupole boundaries (energy at the entrance of Q1) */
+    if (auto hits = static_cast<PlasmaMLPALLASQuadrupoleHitsCollection *>(collection(fQuadrupoleHCID)))
     {
-      runac->UpdateStatisticsVerticalColl(StatsVerticalColl);
-      StatsVerticalColl.ResetFlag();
+        for (size_t i = 0; i < hits->entries(); ++i)
+        {
+            const PlasmaMLPALLASQuadrupoleHit *hit = (*hits)[i];
+            auto &stats = GetStatsQuadrupoles(hit->trackID);
+            if (hit->quad == QuadID::Q1 && hit->posType == PositionType::Begin)
+                stats.energy = hit->energy;
+
+            SetQuadrupoleValue(stats, hit->quad, hit->posType, VectorType::Position, Axis::X, hit->position.x());
+            SetQuadrupoleValue(stats, hit->quad, hit->posType, VectorType::Position, Axis::Y, hit->position.y());
+            SetQuadrupoleValue(stats, hit->quad, hit->posType, VectorType::Position, Axis::Z, hit->position.z());
+            SetQuadrupoleValue(stats, hit->quad, hit->posType, VectorType::Momentum, Axis::X, hit->direction.x());
+            SetQuadrupoleValue(stats, hit->quad, hit->posType, VectorType::Momentum, Axis::Y, hit->direction.y());
+            SetQuadrupoleValue(stats, hit->quad, hit->posType, VectorType::Momentum, Axis::Z, hit->direction.z());
+        }
     }
+
+    /** Collimators (one hit per primary at most) */
+    const auto fillCollimator = [this](G4VHitsCollection *collection, std::vector<RunTallyCollimators> &tallies) {
+        auto hits = static_cast<PlasmaMLPALLASCollimatorHitsCollection *>(collection);
+        if (!hits)
+            return;
+        for (size_t i = 0; i < hits->entries(); ++i)
+        {
+            const PlasmaMLPALLASCollimatorHit *hit = (*hits)[i];
+            auto &tally = PrimarySlot(tallies, hit->trackID);
+            tally.SetXInteraction(hit->position.x());
+            tally.SetYInteraction(hit->position.y());
+            tally.SetZInteraction(hit->position.z());
+            tally.SetEnergy(hit->energy);
+            tally.SetWeight(hit->weight);
+            tally.ActiveFlag();
+        }
+    };
+    fillCollimator(collection(fHorizontalCollHCID), StatsHorizontalColl);
+    fillCollimator(collection(fVerticalCollHCID), StatsVerticalColl);
+
+    /** YAG screens (one entry per passage) */
+    const auto fillYAG = [](G4VHitsCollection *collection, RunTallyYAG &tally) {
+        auto hits = static_cast<PlasmaMLPALLASYAGHitsCollection *>(collection);
+        if (!hits)
+            return;
+        tally.Reserve(hits->entries());
+        for (size_t i = 0; i < hits->entries(); ++i)
+        {
+            const PlasmaMLPALLASYAGHit *hit = (*hits)[i];
+            tally.AddXExit(hit->x);
+            tally.AddYExit(hit->y);
+            tally.AddZExit(hit->z);
+            tally.AddParentID(hit->parentID);
+            tally.AddParticleID(hit->particleID);
+            tally.AddEnergy(hit->energy);
+            tally.AddWeight(hit->weight);
+            tally.AddDeposit(hit->depositedEnergy);
+            if (hit->closed)
+                tally.AddTotalDepositedEnergy(hit->depositedEnergy);
+        }
+    };
+    fillYAG(collection(fBSYAGHCID), StatsBSYAG);
+    fillYAG(collection(fBSPECYAGHCID), StatsBSPECYAG);
 }
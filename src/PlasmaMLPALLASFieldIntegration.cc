@@ -0,0 +1,144 @@
+/**
+ * @file PlasmaMLPALLASFieldIntegration.cc
+ * @brief Implementation of the field integration settings and presets.
+ *
+ * Each call builds a complete, independent chain (equation of motion,
+ * stepper, driver, chord finder, field manager), as every worker thread
+ * needs its own.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASFieldIntegration.hh"
+#include "G4FieldManager.hh"
+#include "G4ChordFinder.hh"
+#include "G4Mag_UsualEqRhs.hh"
+#include "G4ClassicalRK4.hh"
+#include "G4DormandPrince745.hh"
+#include "G4IntegrationDriver.hh"
+#include "G4FSALDormandPrince745.hh"
+#include "G4FSALBogackiShampine45.hh"
+#include "G4FSALIntegrationDriver.hh"
+#include "G4ios.hh"
+#include <algorithm>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const std::vector<G4String>& PlasmaMLPALLASFieldIntegration::GetStepperNames()
+{
+    static const std::vector<G4String> names = {
+        "ClassicalRK4", "DormandPrince745", "FSALDormandPrince745", "FSALBogackiShampine45", "ExactHelix"};
+    return names;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const std::vector<G4String>& PlasmaMLPALLASFieldIntegration::GetPresetNames()
+{
+    static const std::vector<G4String> names = {"reference", "optics-fast"};
+    return names;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Settings of a named preset
+ * @param preset Preset name
+ * @param quadrupoles Settings of the quadrupole volumes
+ * @param dipole Settings of the dipole field volume
+ * @return False if the preset is unknown
+ *
+ * "optics-fast" uses DormandPrince745 in both regions: the dipole field
+ * volume is larger than the hard-edged field, so the exact helix would step
+ * across the field edges.
+ */
+G4bool PlasmaMLPALLASFieldIntegration::ApplyPreset(const G4String& preset,
+                                                    PlasmaMLPALLASFieldIntegration& quadrupoles,
+                                                    PlasmaMLPALLASFieldIntegration& dipole)
+{
+    if (preset == "reference")
+    {
+        quadrupoles = PlasmaMLPALLASFieldIntegration();
+        dipole = PlasmaMLPALLASFieldIntegration();
+        return true;
+    }
+
+    if (preset == "optics-fast")
+    {
+        PlasmaMLPALLASFieldIntegration fast;
+        fast.stepper = "DormandPrince745";
+        fast.minStep = 0.01 * mm;
+        fast.deltaChord = 0.5 * mm;
+        fast.deltaOneStep = 0.05 * mm;
+        fast.deltaIntersection = 0.01 * mm;
+        fast.minEpsilon = 1e-4;
+        fast.maxEpsilon = 5e-3;
+
+        quadrupoles = fast;
+        dipole = fast;
+        return true;
+    }
+
+    return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Build a field manager with these settings
+ * @param field Magnetic field of the region
+ * @return New field manager
+ */
+G4FieldManager* PlasmaMLPALLASFieldIntegration::CreateFieldManager(G4MagneticField* field) const
+{
+    auto* equation = new G4Mag_UsualEqRhs(field);
+
+    G4ChordFinder* chordFinder = nullptr;
+    if (stepper == "DormandPrince745")
+    {
+        auto* s = new G4DormandPrince745(equation);
+        chordFinder = new G4ChordFinder(
+            new G4IntegrationDriver<G4DormandPrince745>(minStep, s, s->GetNumberOfVariables()));
+    }
+    else if (stepper == "FSALDormandPrince745")
+    {
+        auto* s = new G4FSALDormandPrince745(equation);
+        chordFinder = new G4ChordFinder(
+            new G4FSALIntegrationDriver<G4FSALDormandPrince745>(minStep, s, s->GetNumberOfVariables()));
+    }
+    else if (stepper == "FSALBogackiShampine45")
+    {
+        auto* s = new G4FSALBogackiShampine45(equation);
+        chordFinder = new G4ChordFinder(
+            new G4FSALIntegrationDriver<G4FSALBogackiShampine45>(minStep, s, s->GetNumberOfVariables()));
+    }
+    else
+        chordFinder = new G4ChordFinder(field, minStep, new G4ClassicalRK4(equation));
+
+    chordFinder->SetDeltaChord(deltaChord);
+
+    auto* fieldMgr = new G4FieldManager(field, chordFinder);
+    fieldMgr->SetDeltaOneStep(deltaOneStep);
+    fieldMgr->SetDeltaIntersection(deltaIntersection);
+    // Each setter rejects a value beyond the other bound, so go through a valid pair
+    fieldMgr->SetMinimumEpsilonStep(std::min(minEpsilon, fieldMgr->GetMaximumEpsilonStep()));
+    fieldMgr->SetMaximumEpsilonStep(maxEpsilon);
+    fieldMgr->SetMinimumEpsilonStep(minEpsilon);
+
+    return fieldMgr;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASFieldIntegration::Print(const G4String& region) const
+{
+    G4cout << "Field integration (" << region << ") : " << stepper
+           << ", min step = " << minStep / mm << " mm"
+           << ", delta chord = " << deltaChord / mm << " mm"
+           << ", delta one step = " << deltaOneStep / mm << " mm"
+           << ", delta intersection = " << deltaIntersection / mm << " mm"
+           << ", epsilon = [" << minEpsilon << ", " << maxEpsilon << "]" << G4endl;
+}
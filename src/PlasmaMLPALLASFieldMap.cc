@@ -0,0 +1,294 @@
+/**
+ * @file PlasmaMLPALLASFieldMap.cc
+ * @brief Implementation of the memory-mapped 3D field map.
+ *
+ * Mappings are kept in a process-wide registry by path, like the phase-space
+ * files: the fields of all worker threads built from the same file share one
+ * mapping, which is released with its last user.
+ *
+ * The interpolation computes the eight corner weights once and accumulates
+ * the three components of each corner together; the nodes are stored
+ * interleaved, so each corner is one contiguous 12-byte load. Points outside
+ * the grid are handled by clamping the cell index and zeroing the result, so
+ * that the arithmetic has no data-dependent branch.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASFieldMap.hh"
+#include "CLHEP/Units/SystemOfUnits.h"
+#include "G4ios.hh"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+    constexpr char kMagic[8] = {'P', 'M', 'L', 'B', 'M', 'A', 'P', '1'};
+
+    /**
+     * @brief Header of the binary field map file
+     */
+    struct FieldMapHeader {
+        char magic[8];
+        std::uint64_t n[3];
+        double min[3];
+        double step[3];
+    };
+
+    static_assert(sizeof(FieldMapHeader) == 80, "FieldMapHeader must be packed");
+
+    /**
+     * @brief Regular axis spanned by a set of node coordinates
+     * @param values Coordinates of all the nodes along the axis (mm)
+     * @param n Number of distinct coordinates
+     * @param min First coordinate
+     * @param step Grid spacing
+     * @return True if the distinct coordinates are regularly spaced (at least two)
+     */
+    bool FindRegularAxis(std::vector<double> values, size_t& n, double& min, double& step)
+    {
+        constexpr double tolerance = 1e-6; // mm
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end(),
+                                 [](double a, double b) { return std::abs(a - b) < tolerance; }),
+                     values.end());
+
+        n = values.size();
+        if (n < 2)
+            return false;
+
+        min = values.front();
+        step = (values.back() - values.front()) / (n - 1);
+        for (size_t i = 0; i < n; ++i)
+            if (std::abs(values[i] - (min + i * step)) > 1e-3 * step)
+                return false;
+
+        return true;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Map the file and check its header against its size
+ * @param path Binary field map file
+ */
+PlasmaMLPALLASFieldMap::PlasmaMLPALLASFieldMap(const G4String& path)
+    : fMapping(path)
+{
+    if (!fMapping.IsOpen())
+    {
+        G4Exception("PlasmaMLPALLASFieldMap", "FMP0001", FatalException,
+                    ("Cannot map field map file " + path + ": " + fMapping.GetError()).c_str());
+        return;
+    }
+
+    FieldMapHeader header;
+    if (fMapping.GetSize() < sizeof(header))
+    {
+        G4Exception("PlasmaMLPALLASFieldMap", "FMP0002", FatalException,
+                    ("Field map file " + path + " is too short.").c_str());
+        return;
+    }
+
+    std::memcpy(&header, fMapping.GetData(), sizeof(header));
+    const std::uint64_t nNodes = header.n[0] * header.n[1] * header.n[2];
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.n[0] < 2 || header.n[1] < 2 || header.n[2] < 2 ||
+        !(header.step[0] > 0. && header.step[1] > 0. && header.step[2] > 0.) ||
+        fMapping.GetSize() != sizeof(header) + nNodes * 3 * sizeof(float))
+    {
+        G4Exception("PlasmaMLPALLASFieldMap", "FMP0002", FatalException,
+                    ("Field map file " + path + " has an invalid header or size.").c_str());
+        return;
+    }
+
+    fValues = reinterpret_cast<const float*>(fMapping.GetData() + sizeof(header));
+    for (size_t a = 0; a < 3; ++a)
+    {
+        fNodes[a] = header.n[a];
+        fMin[a] = header.min[a] * CLHEP::mm;
+        fInvStep[a] = 1. / (header.step[a] * CLHEP::mm);
+    }
+
+    G4cout << "Field map " << path << " mapped: " << fNodes[0] << " x " << fNodes[1] << " x " << fNodes[2]
+           << " nodes from (" << header.min[0] << ", " << header.min[1] << ", " << header.min[2]
+           << ") mm, step (" << header.step[0] << ", " << header.step[1] << ", " << header.step[2] << ") mm" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Get the mapping of a field map file, shared by all threads
+ * @param path Binary field map file
+ * @return Existing mapping of the file, or a new one
+ */
+std::shared_ptr<const PlasmaMLPALLASFieldMap> PlasmaMLPALLASFieldMap::Open(const G4String& path)
+{
+    static std::mutex registryMutex;
+    static std::map<std::string, std::weak_ptr<const PlasmaMLPALLASFieldMap>> registry;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    std::shared_ptr<const PlasmaMLPALLASFieldMap> map = registry[path].lock();
+    if (!map)
+    {
+        map.reset(new PlasmaMLPALLASFieldMap(path));
+        registry[path] = map;
+    }
+
+    return map;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Trilinear interpolation of the three field components
+ * @param point Position [x, y, z] in global coordinates
+ * @param bField Output field [Bx, By, Bz], 0 outside the grid
+ */
+void PlasmaMLPALLASFieldMap::GetValue(const G4double point[3], G4double bField[3]) const
+{
+    G4bool inside = true;
+    size_t index[3];
+    G4double frac[3];
+    for (size_t a = 0; a < 3; ++a)
+    {
+        const G4double last = G4double(fNodes[a] - 1);
+        const G4double t = (point[a] - fMin[a]) * fInvStep[a];
+        const G4double tc = std::min(std::max(t, 0.), last);
+        index[a] = std::min(static_cast<size_t>(tc), fNodes[a] - 2);
+        frac[a] = tc - index[a];
+        inside = inside && t >= 0. && t <= last;
+    }
+
+    const size_t sx = 3;
+    const size_t sy = 3 * fNodes[0];
+    const size_t sz = sy * fNodes[1];
+    const float* c000 = fValues + index[2] * sz + index[1] * sy + index[0] * sx;
+
+    const G4double gx = 1. - frac[0], gy = 1. - frac[1], gz = 1. - frac[2];
+    const G4double weights[8] = {gx * gy * gz, frac[0] * gy * gz, gx * frac[1] * gz, frac[0] * frac[1] * gz,
+                                 gx * gy * frac[2], frac[0] * gy * frac[2], gx * frac[1] * frac[2], frac[0] * frac[1] * frac[2]};
+    const size_t offsets[8] = {0, sx, sy, sx + sy, sz, sx + sz, sy + sz, sx + sy + sz};
+
+    G4double b[3] = {0., 0., 0.};
+    for (size_t k = 0; k < 8; ++k)
+    {
+        const float* corner = c000 + offsets[k];
+        for (size_t c = 0; c < 3; ++c)
+            b[c] += weights[k] * corner[c];
+    }
+
+    const G4double scale = inside ? CLHEP::tesla : 0.;
+    for (size_t c = 0; c < 3; ++c)
+        bField[c] = b[c] * scale;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Convert a text table into a binary field map file
+ * @param csvFile Input table (x,y,z,Bx,By,Bz per line, in mm and tesla)
+ * @param binaryFile Output binary file
+ * @return Number of nodes written
+ *
+ * Commas, semicolons and tabs are accepted as separators, and lines that do
+ * not hold six numbers (headers, comments) are skipped. The grid is deduced
+ * from the distinct coordinates: it must be regular and every node must be
+ * given exactly once.
+ */
+size_t PlasmaMLPALLASFieldMap::ConvertCSV(const G4String& csvFile, const G4String& binaryFile)
+{
+    std::ifstream in(csvFile);
+    if (!in)
+    {
+        G4Exception("PlasmaMLPALLASFieldMap", "FMP0003", FatalException,
+                    ("Cannot convert " + csvFile + " into " + binaryFile).c_str());
+        return 0;
+    }
+
+    std::vector<std::array<double, 6>> rows;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        for (char& c : line)
+            if (c == ',' || c == ';' || c == '\t')
+                c = ' ';
+
+        std::istringstream is(line);
+        std::array<double, 6> row;
+        if (!(is >> row[0] >> row[1] >> row[2] >> row[3] >> row[4] >> row[5]))
+            continue;
+        rows.push_back(row);
+    }
+
+    FieldMapHeader header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    for (size_t a = 0; a < 3; ++a)
+    {
+        std::vector<double> coordinates(rows.size());
+        for (size_t i = 0; i < rows.size(); ++i)
+            coordinates[i] = rows[i][a];
+
+        size_t n = 0;
+        if (!FindRegularAxis(coordinates, n, header.min[a], header.step[a]))
+        {
+            G4Exception("PlasmaMLPALLASFieldMap", "FMP0004", FatalException,
+                        (csvFile + " is not a regular grid with at least two nodes along each axis.").c_str());
+            return 0;
+        }
+        header.n[a] = n;
+    }
+
+    const size_t nNodes = header.n[0] * header.n[1] * header.n[2];
+    std::vector<float> values(3 * nNodes, 0.f);
+    std::vector<bool> filled(nNodes, false);
+    for (const auto& row : rows)
+    {
+        size_t index = 0;
+        for (size_t a = 3; a-- > 0;)
+            index = index * header.n[a] + static_cast<size_t>(std::lround((row[a] - header.min[a]) / header.step[a]));
+
+        if (filled[index])
+        {
+            G4Exception("PlasmaMLPALLASFieldMap", "FMP0004", FatalException,
+                        (csvFile + " gives the same node more than once.").c_str());
+            return 0;
+        }
+        filled[index] = true;
+        for (size_t c = 0; c < 3; ++c)
+            values[3 * index + c] = static_cast<float>(row[3 + c]);
+    }
+
+    if (rows.size() != nNodes)
+    {
+        G4Exception("PlasmaMLPALLASFieldMap", "FMP0004", FatalException,
+                    (csvFile + " does not give every node of its grid.").c_str());
+        return 0;
+    }
+
+    std::ofstream out(binaryFile, std::ios::binary);
+    if (!out)
+    {
+        G4Exception("PlasmaMLPALLASFieldMap", "FMP0003", FatalException,
+                    ("Cannot convert " + csvFile + " into " + binaryFile).c_str());
+        return 0;
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+
+    return nNodes;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file PlasmaMLPALLASFieldStatistics.cc
+ * @brief Implementation of the per-thread field cost counters.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASFieldStatistics.hh"
+#include "G4ios.hh"
+#include <numeric>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const std::array<const char*, PlasmaMLPALLASFieldStatistics::kNumRegions>& PlasmaMLPALLASFieldStatistics::GetRegionNames()
+{
+    static const std::array<const char*, kNumRegions> names = {"Dipole", "Q1", "Q2", "Q3", "Q4", "QExtra", "Drift"};
+    return names;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const std::array<const char*, PlasmaMLPALLASFieldStatistics::kNumDrivers>& PlasmaMLPALLASFieldStatistics::GetDriverNames()
+{
+    static const std::array<const char*, kNumDrivers> names = {"Quadrupoles", "Dipole"};
+    return names;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASFieldStatistics& PlasmaMLPALLASFieldStatistics::Local()
+{
+    static G4ThreadLocal PlasmaMLPALLASFieldStatistics* statistics = nullptr;
+    if (!statistics)
+        statistics = new PlasmaMLPALLASFieldStatistics();
+    return *statistics;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASFieldStatistics::Reset()
+{
+    fieldCalls.fill(0);
+    chordSteps.fill(0);
+    tracks.fill(0);
+    driverTime.fill(0.);
+    runTime = 0.;
+    start = std::chrono::steady_clock::now();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASFieldStatistics::Stop()
+{
+    runTime = std::chrono::duration<G4double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASFieldStatistics::Print() const
+{
+    const G4long calls = std::accumulate(fieldCalls.begin(), fieldCalls.end(), G4long(0));
+    const G4double propagation = std::accumulate(driverTime.begin(), driverTime.end(), 0.);
+
+    G4cout << "### Field statistics : " << calls << " field calls (";
+    for (size_t i = 0; i < fieldCalls.size(); ++i)
+        G4cout << (i ? ", " : "") << GetRegionNames()[i] << " " << fieldCalls[i];
+    G4cout << ")" << G4endl;
+
+    for (size_t i = 0; i < chordSteps.size(); ++i)
+    {
+        if (tracks[i] == 0)
+            continue;
+        G4cout << "    " << GetDriverNames()[i] << " driver : " << chordSteps[i] << " chord steps, "
+               << tracks[i] << " tracks (" << G4double(chordSteps[i]) / tracks[i] << " steps per track), "
+               << driverTime[i] << " s" << G4endl;
+    }
+
+    G4cout << "    Field propagation " << propagation << " s, physics and navigation "
+           << runTime - propagation << " s of " << runTime << " s" << G4endl;
+}
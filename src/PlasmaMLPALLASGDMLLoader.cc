@@ -0,0 +1,304 @@
+/**
+ * @file PlasmaMLPALLASGDMLLoader.cc
+ * @brief Implementation of the concurrent reader of the tessellated GDML exports.
+ *
+ * The reader walks the tags of the file once: the positions of the define
+ * block are kept by name, the triangular facets of each tessellated solid are
+ * resolved against them (ABSOLUTE or RELATIVE vertices, optional lunit), and
+ * the solidref of the requested volume selects the solid. Coordinates are
+ * plain numbers in these exports; anything that would need the GDML
+ * expression evaluator makes the reader give up on the file.
+ *
+ * The worker threads only read files and fill vectors: no Geant4 object is
+ * created and nothing is printed until the master builds the solids.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASGDMLLoader.hh"
+#include "PlasmaMLPALLASStartupCache.hh"
+#include "G4TessellatedSolid.hh"
+#include "G4TriangularFacet.hh"
+#include "G4ios.hh"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+    /**
+     * @brief Value of an attribute of a tag
+     * @param tag Text of the tag, without the angle brackets
+     * @param key Name of the attribute
+     * @param value Value between the quotes
+     * @return False if the tag has no such attribute
+     */
+    bool Attribute(std::string_view tag, std::string_view key, std::string_view &value)
+    {
+        for (size_t pos = tag.find(key); pos != std::string_view::npos; pos = tag.find(key, pos + 1))
+        {
+            const size_t quote = pos + key.size() + 1;
+            if ((pos == 0 || tag[pos - 1] == ' ' || tag[pos - 1] == '\t' || tag[pos - 1] == '\n' || tag[pos - 1] == '\r') &&
+                quote < tag.size() && tag[quote - 1] == '=' && (tag[quote] == '"' || tag[quote] == '\''))
+            {
+                const size_t end = tag.find(tag[quote], quote + 1);
+                if (end == std::string_view::npos)
+                    return false;
+                value = tag.substr(quote + 1, end - quote - 1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Plain number (no GDML expression)
+     */
+    bool Number(std::string_view text, double &value)
+    {
+        const std::string copy(text);
+        char *end = nullptr;
+        value = std::strtod(copy.c_str(), &end);
+        return !copy.empty() && end == copy.c_str() + copy.size();
+    }
+
+    /**
+     * @brief Length unit of a tag in mm (GDML default: mm)
+     */
+    bool LengthUnit(std::string_view tag, std::string_view key, double &unit)
+    {
+        std::string_view name;
+        if (!Attribute(tag, key, name) || name == "mm")
+            unit = 1.;
+        else if (name == "um")
+            unit = 1.e-3;
+        else if (name == "cm")
+            unit = 10.;
+        else if (name == "m")
+            unit = 1000.;
+        else
+            return false;
+        return true;
+    }
+
+    struct Vertex
+    {
+        double x, y, z;
+    };
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PlasmaMLPALLASGDMLLoader::ReadGDML(const G4String &file, const G4String &volume,
+                                          PlasmaMLPALLASTessellatedMesh &mesh)
+{
+    std::ifstream in(file, std::ios::binary);
+    if (!in)
+        return false;
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    const std::string content = buffer.str();
+    const std::string_view text(content);
+
+    std::unordered_map<std::string_view, Vertex> positions;
+    std::unordered_map<std::string_view, std::vector<double>> solids;
+    std::vector<double> *facets = nullptr; // Tessellated solid being read (nullptr: not valid)
+    std::string_view currentSolid, currentVolume, solidRef;
+    G4bool inDefine = false;
+
+    for (size_t open = text.find('<'); open != std::string_view::npos; open = text.find('<', open + 1))
+    {
+        const size_t close = text.find('>', open);
+        if (close == std::string_view::npos)
+            return false;
+        std::string_view tag = text.substr(open + 1, close - open - 1);
+        if (!tag.empty() && tag.back() == '/')
+            tag.remove_suffix(1);
+        const std::string_view name = tag.substr(0, tag.find_first_of(" \t\r\n"));
+
+        if (name == "define")
+            inDefine = true;
+        else if (name == "/define")
+            inDefine = false;
+        else if (name == "position" && inDefine)
+        {
+            std::string_view id, x, y, z;
+            Vertex v;
+            double unit = 1.;
+            if (!Attribute(tag, "name", id) || !Attribute(tag, "x", x) || !Attribute(tag, "y", y) ||
+                !Attribute(tag, "z", z) || !Number(x, v.x) || !Number(y, v.y) || !Number(z, v.z) ||
+                !LengthUnit(tag, "unit", unit))
+                return false;
+            positions[id] = {v.x * unit, v.y * unit, v.z * unit};
+        }
+        else if (name == "tessellated")
+        {
+            if (!Attribute(tag, "name", currentSolid))
+                return false;
+            facets = &solids[currentSolid];
+        }
+        else if (name == "/tessellated")
+            facets = nullptr;
+        else if (name == "triangular" && facets)
+        {
+            std::string_view ids[3], type;
+            double unit = 1.;
+            if (!Attribute(tag, "vertex1", ids[0]) || !Attribute(tag, "vertex2", ids[1]) ||
+                !Attribute(tag, "vertex3", ids[2]) || !LengthUnit(tag, "lunit", unit))
+                return false;
+            const G4bool relative = Attribute(tag, "type", type) && type == "RELATIVE";
+
+            Vertex v[3];
+            for (int i = 0; i < 3; ++i)
+            {
+                const auto it = positions.find(ids[i]);
+                if (it == positions.end())
+                    return false;
+                v[i] = {it->second.x * unit, it->second.y * unit, it->second.z * unit};
+                if (relative && i > 0)
+                    v[i] = {v[0].x + v[i].x, v[0].y + v[i].y, v[0].z + v[i].z};
+                facets->insert(facets->end(), {v[i].x, v[i].y, v[i].z});
+            }
+        }
+        else if (name == "quadrangular" && facets)
+        {
+            // Not handled: the solid is left to G4GDMLParser if it is the one requested
+            solids.erase(currentSolid);
+            facets = nullptr;
+        }
+        else if (name == "volume")
+        {
+            if (!Attribute(tag, "name", currentVolume))
+                return false;
+        }
+        else if (name == "/volume")
+            currentVolume = std::string_view();
+        else if (name == "solidref" && currentVolume == std::string_view(volume))
+        {
+            if (!Attribute(tag, "ref", solidRef))
+                return false;
+        }
+    }
+
+    const auto solid = solids.find(solidRef);
+    if (solidRef.empty() || solid == solids.end() || solid->second.empty())
+        return false;
+
+    mesh.solidName = G4String(std::string(solidRef));
+    mesh.vertices = std::move(solid->second);
+    mesh.fromCache = false;
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Read the files concurrently.
+ *
+ * Each thread takes the next request, tries the startup cache, then the
+ * GDML reader. The results are only stored in the map once all threads are
+ * done, so the map is never written concurrently.
+ */
+void PlasmaMLPALLASGDMLLoader::Preload(const std::vector<Request> &requests)
+{
+    fMeshes.clear();
+
+    std::vector<PlasmaMLPALLASTessellatedMesh> meshes(requests.size());
+    std::vector<char> loaded(requests.size(), 0);
+    std::atomic<size_t> next{0};
+    const PlasmaMLPALLASStartupCache &cache = PlasmaMLPALLASStartupCache::Instance();
+
+    auto work = [&]() {
+        for (size_t i = next++; i < requests.size(); i = next++)
+        {
+            if (cache.LoadMesh(requests[i].file, meshes[i]))
+                loaded[i] = 1;
+            else
+                loaded[i] = ReadGDML(requests[i].file, requests[i].volume, meshes[i]);
+        }
+    };
+
+    const size_t nThreads = std::min<size_t>(requests.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < nThreads; ++t)
+        threads.emplace_back(work);
+    work();
+    for (auto &thread : threads)
+        thread.join();
+
+    size_t nLoaded = 0;
+    for (size_t i = 0; i < requests.size(); ++i)
+        if (loaded[i])
+        {
+            fMeshes[{requests[i].file, requests[i].volume}] = std::move(meshes[i]);
+            ++nLoaded;
+        }
+
+    G4cout << nLoaded << "/" << requests.size() << " GDML models preloaded on " << nThreads << " threads" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PlasmaMLPALLASGDMLLoader::Take(const G4String &file, const G4String &volume,
+                                      PlasmaMLPALLASTessellatedMesh &mesh)
+{
+    const auto it = fMeshes.find({file, volume});
+    if (it == fMeshes.end())
+        return false;
+
+    mesh = std::move(it->second);
+    fMeshes.erase(it);
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4TessellatedSolid *PlasmaMLPALLASGDMLLoader::BuildSolid(const PlasmaMLPALLASTessellatedMesh &mesh, G4int maxVoxels)
+{
+    auto solid = new G4TessellatedSolid(mesh.solidName);
+    if (maxVoxels > 0)
+        solid->SetMaxVoxels(maxVoxels); // before the voxelisation done by SetSolidClosed
+    const std::vector<double> &v = mesh.vertices;
+    for (size_t i = 0; i + 9 <= v.size(); i += 9)
+        solid->AddFacet(new G4TriangularFacet(G4ThreeVector(v[i], v[i + 1], v[i + 2]),
+                                              G4ThreeVector(v[i + 3], v[i + 4], v[i + 5]),
+                                              G4ThreeVector(v[i + 6], v[i + 7], v[i + 8]), ABSOLUTE));
+    solid->SetSolidClosed(true);
+    return solid;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PlasmaMLPALLASGDMLLoader::ToMesh(const G4VSolid *solid, PlasmaMLPALLASTessellatedMesh &mesh)
+{
+    auto tessellated = dynamic_cast<const G4TessellatedSolid *>(solid);
+    if (!tessellated)
+        return false;
+
+    mesh.solidName = solid->GetName();
+    mesh.vertices.clear();
+    mesh.vertices.reserve(9 * static_cast<size_t>(tessellated->GetNumberOfFacets()));
+    for (G4int i = 0; i < tessellated->GetNumberOfFacets(); ++i)
+    {
+        const G4VFacet *facet = tessellated->GetFacet(i);
+        if (facet->GetNumberOfVertices() != 3)
+            return false;
+        for (G4int j = 0; j < 3; ++j)
+        {
+            const G4ThreeVector vertex = facet->GetVertex(j);
+            mesh.vertices.insert(mesh.vertices.end(), {vertex.x(), vertex.y(), vertex.z()});
+        }
+    }
+    mesh.fromCache = false;
+    return true;
+}
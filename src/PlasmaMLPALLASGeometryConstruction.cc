@@ -29,13 +29,20 @@
  *  - **ConstructSimplifiedPALLASGeometry()**:
  *      - Constructs only Section4 to avoid track-stopping issues from CAD-based GDML files
  *  - **ConstructSDandField()**:
+ *      - Attaches the sensitive detectors of the quadrupoles, collimators and YAG screens
  *      - Initializes and configures the magnetic field
  *      - Sets dipole and quadrupole components, lengths, and drift distances
- *      - Creates and attaches a `G4FieldManager` with a Runge–Kutta stepper
+ *      - Creates a `G4FieldManager` with a Runge–Kutta stepper, attached to the quadrupole and dipole field volumes only
  *
  * Thread safety is ensured via:
  *  - `G4Mutex fieldManagerMutex` for synchronized access to the magnetic field manager
  *  - `G4ThreadLocal` instances of `PlasmaMLPALLASMagneticField` and `G4FieldManager`
+ *  - A versioned snapshot of the gradients, drifts and dipole field, published by their
+ *    setters and pushed into each thread's field at BeginOfRunAction (UpdateMagneticField)
+ *
+ * Distance changes after the construction move the quadrupoles and the collimators
+ * in place (UpdatePlacements): the workers copy the translations of the master at
+ * their next run, and only the voxels of the holder are rebuilt.
  *
  * Visualization colors for logical volumes:
  *  - "invis", "black", "white", "gray", "red", "orange", "yellow", "green", "cyan", "blue", "magenta"
@@ -49,6 +56,14 @@
 
 #include "PlasmaMLPALLASGeometryConstruction.hh"
 #include "PlasmaMLPALLASGeometryMessenger.hh"
+#include "PlasmaMLPALLASInstrumentedDriver.hh"
+#include "PlasmaMLPALLASSensitiveDetectors.hh"
+#include "G4SDManager.hh"
+#include "G4RegionStore.hh"
+#include "G4FastSimulationManager.hh"
+#include "G4AutoLock.hh"
+#include "G4RunManager.hh"
+#include "G4StateManager.hh"
 #include <Geant4/G4Types.hh>
 
 using namespace CLHEP;
@@ -61,6 +76,16 @@ G4ThreadLocal PlasmaMLPALLASMagneticField *PlasmaMLPALLASGeometryConstruction::f
 
 //! Thread-local field manager instance
 G4ThreadLocal G4FieldManager *PlasmaMLPALLASGeometryConstruction::fFieldMgr = nullptr;
+G4ThreadLocal G4FieldManager *PlasmaMLPALLASGeometryConstruction::fDipoleFieldMgr = nullptr;
+
+//! Mutex guarding the published field parameters
+G4Mutex fieldParametersMutex = G4MUTEX_INITIALIZER;
+
+//! Version of the field parameters applied to each thread's field
+G4ThreadLocal std::uint64_t PlasmaMLPALLASGeometryConstruction::fAppliedFieldVersion = 0;
+
+//! Thread-local linear-optics fast simulation model
+G4ThreadLocal PlasmaMLPALLASLinearOpticsModel *PlasmaMLPALLASGeometryConstruction::fLinearOpticsModel = nullptr;
 
 /**
  * @brief Constructor for PlasmaMLPALLASGeometryConstruction.
@@ -73,6 +98,150 @@ PlasmaMLPALLASGeometryConstruction::PlasmaMLPALLASGeometryConstruction()
 {
     Geom = new Geometry();
     fGeometryMessenger = new PlasmaMLPALLASGeometryMessenger(this);
+    PublishFieldParameters();
+}
+
+/**
+ * @brief Publish the current gradients, drifts and dipole field.
+ *
+ * Called by their setters (master thread, or the only thread); the threads
+ * pick the snapshot up at their next BeginOfRunAction.
+ */
+void PlasmaMLPALLASGeometryConstruction::PublishFieldParameters()
+{
+    static std::uint64_t lastVersion = 0;
+
+    auto parameters = std::make_shared<PlasmaMLPALLASFieldParameters>();
+    parameters->gradients = {fQ1Gradient, fQ2Gradient, fQ3Gradient, fQ4Gradient};
+    parameters->drifts = {fSourceQ1Distance, fQ1Q2Distance, fQ2Q3Distance, fQ3Q4Distance};
+    parameters->constantDipoleBField = fConstantDipoleBField;
+
+    G4AutoLock lock(&fieldParametersMutex);
+    parameters->version = ++lastVersion;
+    fFieldParameters = parameters;
+}
+
+/**
+ * @brief Push the latest field parameters into the field of the calling thread.
+ * @return True if the field was updated
+ *
+ * Only the values read by GetFieldValue change: the field managers, chord
+ * finders, volumes and physics tables are kept.
+ */
+G4bool PlasmaMLPALLASGeometryConstruction::UpdateMagneticField()
+{
+    if (!fMagneticField)
+        return false;
+
+    std::shared_ptr<const PlasmaMLPALLASFieldParameters> parameters;
+    {
+        G4AutoLock lock(&fieldParametersMutex);
+        parameters = fFieldParameters;
+    }
+
+    if (parameters->version == fAppliedFieldVersion)
+        return false;
+
+    // Quiet, with one lattice rebuild, and only if a value actually changed
+    fAppliedFieldVersion = parameters->version;
+    return fMagneticField->SetParameters(*parameters);
+}
+
+/**
+ * @brief Check whether the collimators start before the hand-off plane of the lattice.
+ * @return True if the linear-optics transport must stay off with the collimators displayed
+ */
+G4bool PlasmaMLPALLASGeometryConstruction::CollimatorsInsideLattice() const
+{
+    const std::array<G4double, 4> drifts = {fSourceQ1Distance, fQ1Q2Distance, fQ2Q3Distance, fQ3Q4Distance};
+    const std::array<G4double, 4> lengths = {fQ1Length, fQ2Length, fQ3Length, fQ4Length};
+
+    G4double position = 0.;
+    G4double handOff = PlasmaMLPALLASLinearOptics::HandOffDistance;
+    auto add = [&](G4double drift, G4double length)
+    {
+        position += drift + length;
+        if (length > 0.)
+            handOff = std::max(handOff, position + PlasmaMLPALLASLinearOptics::HandOffDistance);
+    };
+    for (size_t i = 0; i < drifts.size(); ++i)
+        add(drifts[i], lengths[i]);
+    for (const auto &quad : fExtraQuadrupoles)
+        add(quad[0], quad[1]);
+
+    return fSourceCollimatorsDistance < handOff;
+}
+
+/**
+ * @brief Move the quadrupoles and the collimators to the current distances.
+ *
+ * Called by the distance setters. The field drifts are published for the next
+ * BeginOfRunAction in every case. Once the geometry is built (Idle state), the
+ * translations of the field volumes, of the quadrupole models and of the
+ * collimator parts are changed in place and, if the geometry is closed, the
+ * voxels of the holder (their only mother) are rebuilt; the solids, logical
+ * volumes, regions, sensitive detectors and field managers are kept. The
+ * workers copy the new translations from the master at the start of their
+ * next run.
+ *
+ * Moving the collimators across the hand-off plane of the lattice changes the
+ * linear-optics set-up of ConstructSDandField: a full rebuild is asked instead.
+ */
+void PlasmaMLPALLASGeometryConstruction::UpdatePlacements()
+{
+    PublishFieldParameters();
+
+    if (!PhysicalHolder || G4StateManager::GetStateManager()->GetCurrentState() != G4State_Idle)
+        return;
+
+    const G4bool collimators = PhysicalPALLAS_Collimator_H1 != nullptr;
+    if (collimators && CollimatorsInsideLattice() != fCollimatorsInsideLattice)
+    {
+        G4cout << "Collimators moved across the quadrupole lattice: full geometry rebuild at the next run" << G4endl;
+        G4RunManager::GetRunManager()->ReinitializeGeometry();
+        return;
+    }
+
+    G4GeometryManager *manager = G4GeometryManager::GetInstance();
+    const G4bool closed = manager->IsGeometryClosed();
+    if (closed)
+        manager->OpenGeometry(PhysicalHolder);
+
+    auto moveTo = [](G4VPhysicalVolume *volume, G4double y)
+    {
+        if (!volume)
+            return;
+        G4ThreeVector translation = volume->GetTranslation();
+        translation.setY(y);
+        volume->SetTranslation(translation);
+    };
+
+    const auto volumePositions = GetQuadrupoleVolumePositions();
+    const auto modelPositions = GetQuadrupoleModelPositions();
+    // The field volumes, when built, carry the quadrupole volumes with them
+    const std::array<G4VPhysicalVolume *, 4> volumes = {PhysicalQ1FieldVolume ? PhysicalQ1FieldVolume : PhysicalQ1Volume,
+                                                        PhysicalQ2FieldVolume ? PhysicalQ2FieldVolume : PhysicalQ2Volume,
+                                                        PhysicalQ3FieldVolume ? PhysicalQ3FieldVolume : PhysicalQ3Volume,
+                                                        PhysicalQ4FieldVolume ? PhysicalQ4FieldVolume : PhysicalQ4Volume};
+    const std::array<G4VPhysicalVolume *, 4> models = {PhysicalPALLAS_QuadrupoleQ1, PhysicalPALLAS_QuadrupoleQ2,
+                                                       PhysicalPALLAS_QuadrupoleQ3, PhysicalPALLAS_QuadrupoleQ4};
+    for (size_t i = 0; i < volumes.size(); ++i)
+    {
+        moveTo(volumes[i], volumePositions[i]);
+        moveTo(models[i], modelPositions[i]);
+    }
+
+    for (G4VPhysicalVolume *volume : {PhysicalPALLAS_Collimator_H1, PhysicalPALLAS_Collimator_H2,
+                                      PhysicalPALLAS_Collimator_Arbre_H, PhysicalPALLAS_Collimator_Bride_H,
+                                      PhysicalPALLAS_Collimator_Palier_H, PhysicalPALLAS_Collimator_V1,
+                                      PhysicalPALLAS_Collimator_V2, PhysicalPALLAS_Collimator_Arbre_V,
+                                      PhysicalPALLAS_Collimator_Bride_V, PhysicalPALLAS_Collimator_Palier_V})
+        moveTo(volume, GetCollimatorsPosition());
+
+    if (closed)
+        manager->CloseGeometry(true, false, PhysicalHolder);
+
+    G4cout << "Quadrupoles and collimators moved in place (holder voxels rebuilt)" << G4endl;
 }
 
 /**
@@ -187,17 +356,25 @@ void PlasmaMLPALLASGeometryConstruction::CreateWorldAndHolder()
  * @brief Construct quadrupole volumes with simplified shapes.
  *
  * Creates approximate quadrupole representations using parameterized boxes
- * and places them in the beamline.
+ * and places them in the beamline. With the field volumes enabled, each box
+ * sits in an unrotated vacuum box carrying the quadrupole field (see
+ * ConstructSDandField): the rotated boxes alone would miss the corners of
+ * the square field aperture (QuadrupoleHalfAperture). These boxes would cut
+ * into the poles of the CAD models, so they are not built when the
+ * quadrupoles are displayed.
  */
 void PlasmaMLPALLASGeometryConstruction::ConstructQuadrupolesVolume()
 {
     G4RotationMatrix Rotation;
     Rotation.rotateY(45 * deg);
 
-    auto LogicalQ1Volume = Geom->GetQuadrupoleVolume("Q1", 34, fQ1Length, 34);
-    auto LogicalQ2Volume = Geom->GetQuadrupoleVolume("Q2", 41, fQ2Length, 41);
-    auto LogicalQ3Volume = Geom->GetQuadrupoleVolume("Q3", 49, fQ3Length, 49);
-    auto LogicalQ4Volume = Geom->GetQuadrupoleVolume("Q4", 44, fQ4Length, 44);
+    const std::array<G4double, 4> Width = {34, 41, 49, 44};
+    const std::array<G4double, 4> Length = {fQ1Length, fQ2Length, fQ3Length, fQ4Length};
+
+    LogicalQ1Volume = Geom->GetQuadrupoleVolume("Q1", Width[0], Length[0], Width[0]);
+    LogicalQ2Volume = Geom->GetQuadrupoleVolume("Q2", Width[1], Length[1], Width[1]);
+    LogicalQ3Volume = Geom->GetQuadrupoleVolume("Q3", Width[2], Length[2], Width[2]);
+    LogicalQ4Volume = Geom->GetQuadrupoleVolume("Q4", Width[3], Length[3], Width[3]);
 
     // Assign colors
     SetLogicalVolumeColor(LogicalQ1Volume, "gray");
@@ -206,22 +383,81 @@ void PlasmaMLPALLASGeometryConstruction::ConstructQuadrupolesVolume()
     SetLogicalVolumeColor(LogicalQ4Volume, "gray");
 
     // Place volumes
-    G4double Position_Q1 = fSourceQ1Distance + fQ1Length / 2;
-    G4double Position_Q2 = Position_Q1 + fQ1Length / 2 + fQ1Q2Distance + fQ2Length / 2;
-    G4double Position_Q3 = Position_Q2 + fQ2Length / 2 + fQ2Q3Distance + fQ3Length / 2;
-    G4double Position_Q4 = Position_Q3 + fQ3Length / 2 + fQ3Q4Distance + fQ4Length / 2;
+    const auto Position = GetQuadrupoleVolumePositions();
+    const std::array<G4LogicalVolume *, 4> Volumes = {LogicalQ1Volume, LogicalQ2Volume, LogicalQ3Volume, LogicalQ4Volume};
+    const std::array<G4String, 4> Names = {"Q1", "Q2", "Q3", "Q4"};
+    const std::array<G4LogicalVolume **, 4> FieldVolumes = {&LogicalQ1FieldVolume, &LogicalQ2FieldVolume,
+                                                            &LogicalQ3FieldVolume, &LogicalQ4FieldVolume};
+    const std::array<G4VPhysicalVolume **, 4> PhysicalFieldVolumes = {&PhysicalQ1FieldVolume, &PhysicalQ2FieldVolume,
+                                                                      &PhysicalQ3FieldVolume, &PhysicalQ4FieldVolume};
+    const std::array<G4VPhysicalVolume **, 4> PhysicalVolumes = {&PhysicalQ1Volume, &PhysicalQ2Volume,
+                                                                 &PhysicalQ3Volume, &PhysicalQ4Volume};
+
+    const G4bool fieldVolumes = fStatusFieldVolumes == 1 && fStatusDisplayQuadrupoles != 1;
+
+    for (size_t i = 0; i < Volumes.size(); ++i)
+    {
+        *FieldVolumes[i] = nullptr;
+        *PhysicalFieldVolumes[i] = nullptr;
+
+        G4LogicalVolume *Mother = LogicalHolder;
+        G4ThreeVector Centre(0, Position[i], 0);
 
-    new G4PVPlacement(G4Transform3D(Rotation, G4ThreeVector(0, Position_Q1, 0)),
-                      LogicalQ1Volume, "Q1Volume", LogicalHolder, false, 0);
+        if (fieldVolumes)
+        {
+            // Square enclosing both the field aperture and the rotated box (0.1 mm clearance)
+            const G4double HalfWidth = std::max(QuadrupoleHalfAperture / mm, Width[i] / std::sqrt(2.) + 0.1);
+            *FieldVolumes[i] = Geom->GetQuadrupoleVolume(Names[i] + "Field", 2 * HalfWidth, Length[i], 2 * HalfWidth);
+            SetLogicalVolumeColor(*FieldVolumes[i], "invis");
 
-    new G4PVPlacement(G4Transform3D(Rotation, G4ThreeVector(0, Position_Q2, 0)),
-                      LogicalQ2Volume, "Q2Volume", LogicalHolder, false, 0);
+            *PhysicalFieldVolumes[i] = new G4PVPlacement(G4Transform3D(DontRotate, Centre),
+                                                         *FieldVolumes[i], Names[i] + "FieldVolume", LogicalHolder, false, 0);
 
-    new G4PVPlacement(G4Transform3D(Rotation, G4ThreeVector(0, Position_Q3, 0)),
-                      LogicalQ3Volume, "Q3Volume", LogicalHolder, false, 0);
+            Mother = *FieldVolumes[i];
+            Centre = G4ThreeVector();
+        }
 
-    new G4PVPlacement(G4Transform3D(Rotation, G4ThreeVector(0, Position_Q4, 0)),
-                      LogicalQ4Volume, "Q4Volume", LogicalHolder, false, 0);
+        *PhysicalVolumes[i] = new G4PVPlacement(G4Transform3D(Rotation, Centre),
+                                                Volumes[i], Names[i] + "Volume", Mother, false, 0);
+    }
+}
+
+/**
+ * @brief Centres of the quadrupole field volumes.
+ * @return y of Q1..Q4 (mm), each drift counted from the exit of the previous one
+ */
+std::array<G4double, 4> PlasmaMLPALLASGeometryConstruction::GetQuadrupoleVolumePositions() const
+{
+    std::array<G4double, 4> Position;
+    Position[0] = fSourceQ1Distance + fQ1Length / 2;
+    Position[1] = Position[0] + fQ1Length / 2 + fQ1Q2Distance + fQ2Length / 2;
+    Position[2] = Position[1] + fQ2Length / 2 + fQ2Q3Distance + fQ3Length / 2;
+    Position[3] = Position[2] + fQ3Length / 2 + fQ3Q4Distance + fQ4Length / 2;
+    return Position;
+}
+
+/**
+ * @brief Origins of the quadrupole CAD models.
+ * @return y of Q1..Q4 (mm), with the offsets of the CAD frames
+ */
+std::array<G4double, 4> PlasmaMLPALLASGeometryConstruction::GetQuadrupoleModelPositions() const
+{
+    std::array<G4double, 4> Position;
+    Position[0] = fSourceQ1Distance - 140;
+    Position[1] = fSourceQ1Distance + fQ1Length + fQ1Q2Distance - 420;
+    Position[2] = fSourceQ1Distance + fQ1Length + fQ1Q2Distance + fQ2Length + fQ2Q3Distance - 720;
+    Position[3] = fSourceQ1Distance + fQ1Length + fQ1Q2Distance + fQ2Length + fQ2Q3Distance + fQ3Length + fQ3Q4Distance - 1570;
+    return Position;
+}
+
+/**
+ * @brief Origin of the collimator CAD models.
+ * @return y (mm): translation of 122.670433 mm due to CAD Files -> alignment with
+ *         front of first collimator to correspond to the distance source/collimator
+ */
+G4double PlasmaMLPALLASGeometryConstruction::GetCollimatorsPosition() const
+{
+    return fSourceCollimatorsDistance + 122.670433;
 }
 
 /**
@@ -246,22 +482,19 @@ void PlasmaMLPALLASGeometryConstruction::ConstructQuadrupoles()
     SetLogicalVolumeColor(LogicalPALLAS_QuadrupoleQ4, "cyan");
 
     // Place volumes
-    G4double Position_Q1 = fSourceQ1Distance - 140; 
-    G4double Position_Q2 = fSourceQ1Distance + fQ1Length + fQ1Q2Distance - 420;
-    G4double Position_Q3 = fSourceQ1Distance + fQ1Length + fQ1Q2Distance + fQ2Length + fQ2Q3Distance - 720;
-    G4double Position_Q4 = fSourceQ1Distance + fQ1Length + fQ1Q2Distance + fQ2Length + fQ2Q3Distance + fQ3Length + fQ3Q4Distance - 1570;
+    const auto Position = GetQuadrupoleModelPositions();
 
-    new G4PVPlacement(G4Transform3D(DontRotate, G4ThreeVector(0, Position_Q1, 0)),
-                      LogicalPALLAS_QuadrupoleQ1, "QuadrupoleQ1", LogicalHolder, false, 0);
+    PhysicalPALLAS_QuadrupoleQ1 = new G4PVPlacement(G4Transform3D(DontRotate, G4ThreeVector(0, Position[0], 0)),
+                                                    LogicalPALLAS_QuadrupoleQ1, "QuadrupoleQ1", LogicalHolder, false, 0);
 
-    new G4PVPlacement(G4Transform3D(DontRotate, G4ThreeVector(0, Position_Q2, 0)),
-                      LogicalPALLAS_QuadrupoleQ2, "QuadrupoleQ2", LogicalHolder, false, 0);
+    PhysicalPALLAS_QuadrupoleQ2 = new G4PVPlacement(G4Transform3D(DontRotate, G4ThreeVector(0, Position[1], 0)),
+                                                    LogicalPALLAS_QuadrupoleQ2, "QuadrupoleQ2", LogicalHolder, false, 0);
 
-    new G4PVPlacement(G4Transform3D(DontRotate, G4ThreeVector(0, Position_Q3, 0)),
-                      LogicalPALLAS_QuadrupoleQ3, "QuadrupoleQ3", LogicalHolder, false, 0);
+    PhysicalPALLAS_QuadrupoleQ3 = new G4PVPlacement(G4Transform3D(DontRotate, G4ThreeVector(0, Position[2], 0)),
+                                                    LogicalPALLAS_QuadrupoleQ3, "QuadrupoleQ3", LogicalHolder, false, 0);
 
-    new G4PVPlacement(G4Transform3D(DontRotate, G4ThreeVector(0, Position_Q4, 0)),
-                      LogicalPALLAS_QuadrupoleQ4, "QuadrupoleQ4", LogicalHolder, false, 0);
+    PhysicalPALLAS_QuadrupoleQ4 = new G4PVPlacement(G4Transform3D(DontRotate, G4ThreeVector(0, Position[3], 0)),
+                                                    LogicalPALLAS_QuadrupoleQ4, "QuadrupoleQ4", LogicalHolder, false, 0);
 }
 
 /**
@@ -526,8 +759,9 @@ void PlasmaMLPALLASGeometryConstruction::ConstructSection4Part()
         Geom->GetGDMLVolume("../gdml_models/S4/BS1_YAG.gdml", "BS1_YAG", YAG);
     LogicalPALLAS_BSPEC1YAG = Geom->GetGDMLVolume(
         "../gdml_models/S4/BSPEC1_YAG.gdml", "BSPEC1_YAG", YAG);
-    LogicalPALLAS_DiagsChamber = Geom->GetGDMLVolume(
-        "../gdml_models/S4/Diags_Chamber.gdml", "Diags_Chamber", Al);
+    // Not placed (see below): not loaded
+    // LogicalPALLAS_DiagsChamber = Geom->GetGDMLVolume(
+    //     "../gdml_models/S4/Diags_Chamber.gdml", "Diags_Chamber", Al);
     LogicalPALLAS_S4Tube =
         Geom->GetGDMLVolume("../gdml_models/S4/Tube.gdml", "Tube", Al);
     LogicalPALLAS_S4Tube1 =
@@ -543,21 +777,41 @@ void PlasmaMLPALLASGeometryConstruction::ConstructSection4Part()
     SetLogicalVolumeColor(LogicalPALLAS_Dipole, "red");
     SetLogicalVolumeColor(LogicalPALLAS_BSPEC1YAG, "yellow");
     SetLogicalVolumeColor(LogicalPALLAS_BS1YAG, "yellow");
-    SetLogicalVolumeColor(LogicalPALLAS_DiagsChamber, "yellow");
+    // SetLogicalVolumeColor(LogicalPALLAS_DiagsChamber, "yellow");
     SetLogicalVolumeColor(LogicalPALLAS_S4Tube, "yellow");
     SetLogicalVolumeColor(LogicalPALLAS_S4Tube1, "yellow");
     SetLogicalVolumeColor(LogicalPALLAS_S4Soufflet, "yellow");
     SetLogicalVolumeColor(LogicalPALLAS_S4Croix, "yellow");
     SetLogicalVolumeColor(LogicalFakeDiagsChamber, "yellow");
 
+    // Dipole field volume: encloses the chamber and the yoke, which are placed
+    // inside it. Not built with the collimators, which reach into it.
+    G4LogicalVolume *DipoleMother = LogicalHolder;
+    G4ThreeVector DipoleFieldCentre(0. * mm, 3441 * mm, -9 * mm);
+    G4ThreeVector DipoleOffset(0. * mm, 0 * mm, 0 * mm);
+    LogicalDipoleFieldVolume = nullptr;
+
+    if (fStatusFieldVolumes == 1 && fStatusDisplayCollimators != 1)
+    {
+        LogicalDipoleFieldVolume = Geom->GetDipoleFieldVolume();
+        SetLogicalVolumeColor(LogicalDipoleFieldVolume, "invis");
+
+        PhysicalDipoleFieldVolume = new G4PVPlacement(
+            G4Transform3D(DontRotate, DipoleFieldCentre),
+            LogicalDipoleFieldVolume, "DipoleFieldVolume", LogicalHolder, false, 0);
+
+        DipoleMother = LogicalDipoleFieldVolume;
+        DipoleOffset = -DipoleFieldCentre;
+    }
+
     // Place volumes
     PhysicalPALLAS_ChambreDipole = new G4PVPlacement(
-        G4Transform3D(DontRotate, G4ThreeVector(0. * mm, 0 * mm, 0 * mm)),
-        LogicalPALLAS_ChambreDipole, "ChambreDipole", LogicalHolder, false, 0);
+        G4Transform3D(DontRotate, DipoleOffset),
+        LogicalPALLAS_ChambreDipole, "ChambreDipole", DipoleMother, false, 0);
 
     PhysicalPALLAS_Dipole = new G4PVPlacement(
-        G4Transform3D(DontRotate, G4ThreeVector(0. * mm, 0 * mm, 0 * mm)),
-        LogicalPALLAS_Dipole, "Dipole", LogicalHolder, false, 0);
+        G4Transform3D(DontRotate, DipoleOffset),
+        LogicalPALLAS_Dipole, "Dipole", DipoleMother, false, 0);
 
     PhysicalPALLAS_BS1YAG = new G4PVPlacement(
         G4Transform3D(DontRotate, G4ThreeVector(0 * mm, 0 * mm, 0 * mm)),
@@ -665,60 +919,61 @@ void PlasmaMLPALLASGeometryConstruction::ConstructCollimators()
 
         // Place volumes
         // Translation of 122.670433mm due to CAD Files -> alignment with font of first collimator to correspond to the distance source/collimatr !!!
+        const G4double CollimatorsPosition = GetCollimatorsPosition();
         PhysicalPALLAS_Collimator_H1 = new G4PVPlacement(
-            rotationMatrix, G4ThreeVector(0 * mm, fSourceCollimatorsDistance + 122.670433, 0 * mm),
+            rotationMatrix, G4ThreeVector(0 * mm, CollimatorsPosition, 0 * mm),
             LogicalPALLAS_Collimator_H1, "HorizontalCollimator", LogicalHolder,
             false, 0);
 
         PhysicalPALLAS_Collimator_H2 = new G4PVPlacement(
-            rotationMatrix, G4ThreeVector(0 * mm, fSourceCollimatorsDistance + 122.670433, 0 * mm),
+            rotationMatrix, G4ThreeVector(0 * mm, CollimatorsPosition, 0 * mm),
             LogicalPALLAS_Collimator_H2, "HorizontalCollimator", LogicalHolder,
             false, 0);
 
         PhysicalPALLAS_Collimator_Arbre_H = new G4PVPlacement(
-            rotationMatrix, G4ThreeVector(0 * mm, fSourceCollimatorsDistance + 122.670433, 0 * mm),
+            rotationMatrix, G4ThreeVector(0 * mm, CollimatorsPosition, 0 * mm),
             LogicalPALLAS_Collimator_Arbre_H, "Arbre_H", LogicalHolder, false, 0);
 
         PhysicalPALLAS_Collimator_Bride_H = new G4PVPlacement(
-            rotationMatrix, G4ThreeVector(0 * mm, fSourceCollimatorsDistance + 122.670433, 0 * mm),
+            rotationMatrix, G4ThreeVector(0 * mm, CollimatorsPosition, 0 * mm),
             LogicalPALLAS_Collimator_Bride_H, "Bride_H", LogicalHolder, false, 0);
 
         PhysicalPALLAS_Collimator_Palier_H = new G4PVPlacement(
-            rotationMatrix, G4ThreeVector(0 * mm, fSourceCollimatorsDistance + 122.670433, 0 * mm),
+            rotationMatrix, G4ThreeVector(0 * mm, CollimatorsPosition, 0 * mm),
             LogicalPALLAS_Collimator_Palier_H, "Palier_H", LogicalHolder, false,
             0);
 
         // PhysicalPALLAS_Collimator_Soufflet_H = new G4PVPlacement(
-        //     rotationMatrix, G4ThreeVector(0 * mm, fSourceCollimatorsDistance + 122.670433, 0 * mm),
+        //     rotationMatrix, G4ThreeVector(0 * mm, CollimatorsPosition, 0 * mm),
         //     LogicalPALLAS_Collimator_Soufflet_H, "Soufflet_H", LogicalHolder,
         //     false, 0);
 
         // Translation of 0.4mm due to CAD Files -> alignment with propagation axes !!!
         PhysicalPALLAS_Collimator_V1 = new G4PVPlacement(
             rotationMatrix,
-            G4ThreeVector(-0.4 * mm, fSourceCollimatorsDistance + 122.670433, 0 * mm),
+            G4ThreeVector(-0.4 * mm, CollimatorsPosition, 0 * mm),
             LogicalPALLAS_Collimator_V1, "VerticalCollimator", LogicalHolder,
             false, 0);
 
         PhysicalPALLAS_Collimator_V2 = new G4PVPlacement(
             rotationMatrix,
-            G4ThreeVector(-0.4 * mm, fSourceCollimatorsDistance + 122.670433, 0 * mm),
+            G4ThreeVector(-0.4 * mm, CollimatorsPosition, 0 * mm),
             LogicalPALLAS_Collimator_V2, "VerticalCollimator", LogicalHolder,
             false, 0);
 
         PhysicalPALLAS_Collimator_Arbre_V = new G4PVPlacement(
             rotationMatrix,
-            G4ThreeVector(-0.4 * mm, fSourceCollimatorsDistance + 122.670433, 0 * mm),
+            G4ThreeVector(-0.4 * mm, CollimatorsPosition, 0 * mm),
             LogicalPALLAS_Collimator_Arbre_V, "Arbre_V", LogicalHolder, false, 0);
 
         PhysicalPALLAS_Collimator_Bride_V = new G4PVPlacement(
             rotationMatrix,
-            G4ThreeVector(-0.4 * mm, fSourceCollimatorsDistance + 122.670433, 0 * mm),
+            G4ThreeVector(-0.4 * mm, CollimatorsPosition, 0 * mm),
             LogicalPALLAS_Collimator_Bride_V, "Bride_V", LogicalHolder, false, 0);
 
         PhysicalPALLAS_Collimator_Palier_V = new G4PVPlacement(
             rotationMatrix,
-            G4ThreeVector(-0.4 * mm, fSourceCollimatorsDistance + 122.670433, 0 * mm),
+            G4ThreeVector(-0.4 * mm, CollimatorsPosition, 0 * mm),
             LogicalPALLAS_Collimator_Palier_V, "Palier_V", LogicalHolder, false,
             0);
 
@@ -748,13 +1003,14 @@ void PlasmaMLPALLASGeometryConstruction::ConstructSection4DumpPart()
         "../gdml_models/S4/Blindage_BD.gdml", "Blindage_BD", Pb);
     LogicalPALLAS_BlindageCBD = Geom->GetGDMLVolume(
         "../gdml_models/S4/Blindage_CBD.gdml", "Blindage_CBD", Pb);
-    LogicalPALLAS_ChassisDipoleYAG = Geom->GetGDMLVolume(
-        "../gdml_models/S4/Chassis_Dipole_YAG.gdml", "Chassis_Dipole_YAG", Al);
+    // Not placed (see below): not loaded
+    // LogicalPALLAS_ChassisDipoleYAG = Geom->GetGDMLVolume(
+    //     "../gdml_models/S4/Chassis_Dipole_YAG.gdml", "Chassis_Dipole_YAG", Al);
 
     // Assign colors
     SetLogicalVolumeColor(LogicalPALLAS_BlindageBD, "blue");
     SetLogicalVolumeColor(LogicalPALLAS_BlindageCBD, "blue");
-    SetLogicalVolumeColor(LogicalPALLAS_ChassisDipoleYAG, "blue");
+    // SetLogicalVolumeColor(LogicalPALLAS_ChassisDipoleYAG, "blue");
 
     // Place volumes
     PhysicalPALLAS_BlindageBD = new G4PVPlacement(
@@ -771,6 +1027,36 @@ void PlasmaMLPALLASGeometryConstruction::ConstructSection4DumpPart()
     //     false, 0);
 }
 
+/**
+ * @brief Detach the root volumes of a region before the stores are cleaned.
+ * @param region Region built by a previous Construct()
+ */
+static void ClearRootVolumes(G4Region *region)
+{
+    const std::vector<G4LogicalVolume *> roots(region->GetRootLogicalVolumeIterator(),
+                                               region->GetRootLogicalVolumeIterator() + region->GetNumberOfRootVolumes());
+    for (G4LogicalVolume *volume : roots)
+        region->RemoveRootLogicalVolume(volume, false);
+}
+
+/**
+ * @brief Sensitive detector of the calling thread, created and registered at the first call.
+ * @param name Name of the detector
+ * @param volumeRoles Role table of the geometry
+ */
+template <typename SD>
+static G4VSensitiveDetector *GetOrCreateDetector(const G4String &name, const PlasmaMLPALLASVolumeRoles &volumeRoles)
+{
+    G4SDManager *sdManager = G4SDManager::GetSDMpointer();
+    G4VSensitiveDetector *sd = sdManager->FindSensitiveDetector(name, false);
+    if (!sd)
+    {
+        sd = new SD(name, volumeRoles);
+        sdManager->AddNewDetector(sd);
+    }
+    return sd;
+}
+
 /**
  * @brief Construct sensitive detectors and define the magnetic field for the geometry.
  *
@@ -780,32 +1066,59 @@ void PlasmaMLPALLASGeometryConstruction::ConstructSection4DumpPart()
  * logical volume hierarchy.
  *
  * Steps performed:
+ * - Attach the sensitive detectors (quadrupole boundaries, collimators, YAG
+ *   screens), created once per thread.
  * - Create and configure a custom magnetic field (`PlasmaMLPALLASMagneticField`).
- * - Set dipole field and map field status.
+ * - Set dipole field and map field status (sharing the 3D field map, if any).
  * - Define quadrupole gradients, lengths, and drift distances.
- * - Initialize the `G4FieldManager` and attach a chord finder with a 
- *   Runge–Kutta 4th order stepper.
- * - Apply the magnetic field manager to all daughter logical volumes.
+ * - Build the `G4FieldManager` of each region (stepper, chord finder and
+ *   accuracies from the integration settings, see /PlasmaMLPALLAS/field/usePreset).
+ * - Apply the magnetic field manager to the quadrupole field volumes and to the
+ *   dipole field volume only (or to the whole holder, see
+ *   /PlasmaMLPALLAS/field/setStatusFieldVolumes).
+ * - Count the field calls and time the integration drivers of this thread
+ *   when the field statistics are enabled.
  *
  * @note The magnetic field configuration directly affects particle 
  *       transport and beam optics in the Geant4 simulation.
  */
 void PlasmaMLPALLASGeometryConstruction::ConstructSDandField()
 {
+    // --- Sensitive detectors -------------------------------------------------
+    /// One set per thread, kept if the geometry is rebuilt; only the scored
+    /// volumes reach user code (collimators only when they are displayed)
+    G4VSensitiveDetector *quadrupoles = GetOrCreateDetector<PlasmaMLPALLASQuadrupoleSD>("Quadrupoles", fVolumeRoles);
+    for (G4LogicalVolume *volume : {LogicalQ1Volume, LogicalQ2Volume, LogicalQ3Volume, LogicalQ4Volume})
+        SetSensitiveDetector(volume, quadrupoles);
+
+    if (fStatusDisplayCollimators == 1)
+    {
+        G4VSensitiveDetector *collimators = GetOrCreateDetector<PlasmaMLPALLASCollimatorSD>("Collimators", fVolumeRoles);
+        for (G4LogicalVolume *volume : {LogicalPALLAS_Collimator_H1, LogicalPALLAS_Collimator_H2,
+                                        LogicalPALLAS_Collimator_V1, LogicalPALLAS_Collimator_V2})
+            SetSensitiveDetector(volume, collimators);
+    }
+
+    SetSensitiveDetector(LogicalPALLAS_BS1YAG, GetOrCreateDetector<PlasmaMLPALLASYAGSD>("BS1YAG", fVolumeRoles));
+    SetSensitiveDetector(LogicalPALLAS_BSPEC1YAG, GetOrCreateDetector<PlasmaMLPALLASYAGSD>("BSPEC1YAG", fVolumeRoles));
+
     // --- Magnetic field configuration ---------------------------------------
     fMagneticField = new PlasmaMLPALLASMagneticField();
 
-    /// Set constant dipole magnetic field
-    fMagneticField->SetDipoleField(fConstantDipoleBField);
-
-    /// Enable or disable field map usage
+    /// Select the dipole model; the 3D map is mapped once and shared by all threads
     fMagneticField->SetMapBFieldStatus(fStatusMapBField);
+    if (fStatusMapBField == 2)
+    {
+        if (fFieldMapFile.empty())
+            G4Exception("PlasmaMLPALLASGeometryConstruction::ConstructSDandField", "FMP0005", FatalException,
+                        "setStatusMapBField 2 needs a field map: use /PlasmaMLPALLAS/field/setFieldMapFile.");
+        else
+            fMagneticField->SetFieldMap(PlasmaMLPALLASFieldMap::Open(fFieldMapFile));
+    }
 
-    /// Configure quadrupole gradients (Tesla = 0.001 * MV * ns / mm²)
-    fMagneticField->SetGradient(0, fQ1Gradient);
-    fMagneticField->SetGradient(1, fQ2Gradient);
-    fMagneticField->SetGradient(2, fQ3Gradient);
-    fMagneticField->SetGradient(3, fQ4Gradient);
+    /// Set the constant dipole field and the quadrupole gradients (Tesla = 0.001 * MV * ns / mm²)
+    fAppliedFieldVersion = 0;
+    UpdateMagneticField();
 
     /// Configure quadrupole lengths
     fMagneticField->SetQLength(0, GetQ1Length());
@@ -813,28 +1126,77 @@ void PlasmaMLPALLASGeometryConstruction::ConstructSDandField()
     fMagneticField->SetQLength(2, GetQ3Length());
     fMagneticField->SetQLength(3, GetQ4Length());
 
-    /// Configure quadrupole drift distances
-    fMagneticField->SetQDrift(0, GetSourceQ1Distance());
-    fMagneticField->SetQDrift(1, GetQ1Q2Distance());
-    fMagneticField->SetQDrift(2, GetQ2Q3Distance());
-    fMagneticField->SetQDrift(3, GetQ3Q4Distance());
+    /// Quadrupole drift distances come with the snapshot (they can change between runs)
+
+    /// Append the field-only quadrupoles of an upgraded lattice
+    for (const auto &quad : fExtraQuadrupoles)
+        fMagneticField->AddQuadrupole(quad[0], quad[1], quad[2]);
 
     // --- Field manager setup -------------------------------------------------
-    fFieldMgr = new G4FieldManager();
-    fFieldMgr->SetDetectorField(fMagneticField);
-    fFieldMgr->CreateChordFinder(fMagneticField);
-
-    /// Create a chord finder with stepper precision of 1 µm
-    G4ChordFinder *chordFinder = new G4ChordFinder(
-        fMagneticField,
-        1e-3 * mm,
-        new G4ClassicalRK4(new G4Mag_UsualEqRhs(fMagneticField))
-    );
-    fFieldMgr->SetChordFinder(chordFinder);
-
-    // --- Apply field manager to logical volume hierarchy --------------------
+    /// One field manager per region, built from the integration settings
+    fFieldMgr = fQuadrupoleIntegration.CreateFieldManager(fMagneticField);
+
+    // --- Apply field managers to the magnetised volumes ---------------------
+    /// Everything else is field-free and transported along straight lines.
+    /// Field-only quadrupoles have no volume, so they need the whole holder.
     G4bool forceToAllDaughters = true;
-    LogicalHolder->SetFieldManager(fFieldMgr, forceToAllDaughters);
+    const G4bool magnetVolumes = LogicalDipoleFieldVolume && LogicalQ1FieldVolume && fExtraQuadrupoles.empty();
+    if (magnetVolumes)
+    {
+        for (G4LogicalVolume *volume : {LogicalQ1FieldVolume, LogicalQ2FieldVolume, LogicalQ3FieldVolume, LogicalQ4FieldVolume})
+            volume->SetFieldManager(fFieldMgr, forceToAllDaughters);
+
+        fDipoleFieldMgr = fDipoleIntegration.CreateFieldManager(fMagneticField);
+        LogicalDipoleFieldVolume->SetFieldManager(fDipoleFieldMgr, forceToAllDaughters);
+    }
+    else
+    {
+        if (fStatusFieldVolumes == 1)
+            G4cout << "Field applied to the whole holder ("
+                   << (!LogicalDipoleFieldVolume ? "collimators displayed"
+                       : !LogicalQ1FieldVolume ? "quadrupoles displayed" : "field-only quadrupoles")
+                   << ")" << G4endl;
+        LogicalHolder->SetFieldManager(fFieldMgr, forceToAllDaughters);
+    }
+
+    // --- Optional cost counters ----------------------------------------------
+    /// The wrappers forward every call, so the integration itself is unchanged
+    if (fStatusFieldStatistics == 1)
+    {
+        fMagneticField->SetStatistics(&PlasmaMLPALLASFieldStatistics::Local());
+        PlasmaMLPALLASInstrumentedDriver::Install(fFieldMgr->GetChordFinder(), PlasmaMLPALLASFieldStatistics::kQuadrupoleDriver);
+        if (magnetVolumes)
+            PlasmaMLPALLASInstrumentedDriver::Install(fDipoleFieldMgr->GetChordFinder(), PlasmaMLPALLASFieldStatistics::kDipoleDriver);
+    }
+
+    // --- Linear-optics fast transport ----------------------------------------
+    /// The model reads the lattice of this thread's field and the mode at each
+    /// trigger, so it is always attached; mode 0 leaves every track to Geant4.
+    G4Region *linearOpticsRegion = G4RegionStore::GetInstance()->GetRegion("LinearOptics", false);
+    if (fLinearOpticsModel)
+    {
+        if (linearOpticsRegion && linearOpticsRegion->GetFastSimulationManager())
+            linearOpticsRegion->GetFastSimulationManager()->RemoveFastSimulationModel(fLinearOpticsModel);
+        delete fLinearOpticsModel;
+        fLinearOpticsModel = nullptr;
+    }
+
+    /// Nothing in the holder may stand between the quadrupoles: displayed
+    /// collimators upstream of the hand-off plane keep the full tracking
+    if (fStatusDisplayCollimators == 1 && CollimatorsInsideLattice())
+    {
+        if (fStatusLinearOptics != 0)
+            G4cout << "Linear-optics transport disabled (collimators inside the quadrupole lattice)" << G4endl;
+    }
+    else if (linearOpticsRegion)
+    {
+        std::vector<G4double> halfWidths;
+        for (G4LogicalVolume *volume : {LogicalQ1Volume, LogicalQ2Volume, LogicalQ3Volume, LogicalQ4Volume})
+            halfWidths.push_back(static_cast<G4Box *>(volume->GetSolid())->GetXHalfLength());
+
+        fLinearOpticsModel = new PlasmaMLPALLASLinearOpticsModel(
+            "LinearOpticsModel", linearOpticsRegion, fMagneticField, halfWidths, this);
+    }
 }
 
 /**
@@ -863,6 +1225,72 @@ void PlasmaMLPALLASGeometryConstruction::ConstructSimplifiedPALLASGeometry()
     ConstructSection4Part();
 }
 
+/**
+ * @brief List the GDML models placed for the current display flags.
+ *
+ * Read concurrently by Geometry::PreloadGDMLVolumes before the construction.
+ * A model asked for by a Construct*() method but missing from this list is
+ * still parsed, serially, when it is requested.
+ *
+ * @return File and volume name of each model
+ */
+std::vector<PlasmaMLPALLASGDMLLoader::Request> PlasmaMLPALLASGeometryConstruction::CollectGDMLModels() const
+{
+    const G4String dir = "../gdml_models/";
+    std::vector<PlasmaMLPALLASGDMLLoader::Request> models;
+    auto add = [&](const G4String &file, const G4String &volume)
+    { models.push_back({dir + file, volume}); };
+
+    if (fStatusDisplayGeometry == 1)
+    {
+        add("Assemblage_2_Cellules.gdml", "Assemblage_2_Cellules");
+        for (const char *name : {"Croix", "LIF_Hublot1", "LIF_Hublot2", "LIF_Hublot3", "LIF_Hublot4",
+                                 "LIF_Hublot5", "LIF_IBX_DD", "LIF_SQLT", "Marbre_Breadboard1",
+                                 "Marbre_Breadboard2", "OptoMeK"})
+            add(G4String("LIF/") + name + ".gdml", name);
+        for (const char *name : {"ATH500_DN100", "Base_Marbre", "Chambre_ISO"})
+            add(G4String("S1/") + name + ".gdml", name);
+        add("S2/ASM_Removal_Chamber.gdml", "ASMRemovalChamber");
+        add("S2/Assemblage_Breadboard_Thorlabs_Removal_Chamber.gdml", "Breadboard_Removal_Chamber");
+        add("S2/Chassis_PALLAS_Removal_Chamber.gdml", "Chassis_PALLAS_Removal_Chamber");
+        add("S2/Tube_ISO_1.gdml", "Tube_ISO_1");
+        add("S2/Tube_ISO_2.gdml", "Tube_ISO_2");
+        add("S3/ASM_Poutre.gdml", "ASM_Poutre");
+        add("S3/Station_YAG.gdml", "Station_YAG");
+        add("S4/Blindage_BD.gdml", "Blindage_BD");
+        add("S4/Blindage_CBD.gdml", "Blindage_CBD");
+    }
+
+    for (const char *name : {"Chambre_Dipole", "Dipole", "BS1_YAG", "BSPEC1_YAG", "Tube", "Tube1", "Soufflet", "Croix"})
+        add(G4String("S4/") + name + ".gdml", name);
+
+    if (fStatusDisplayCollimators == 1)
+    {
+        add("Collimators/Collimator_Mors_H_1.gdml", "Collimator_H1");
+        add("Collimators/Collimator_Mors_H_2.gdml", "Collimator_H2");
+        add("Collimators/Collimator_Mors_V_1.gdml", "Collimator_V1");
+        add("Collimators/Collimator_Mors_V_2.gdml", "Collimator_V2");
+        for (const char *part : {"Arbre", "Bride", "Palier"})
+            for (const char *axis : {"_H", "_V"})
+            {
+                const G4String name = G4String("Collimator_") + part + axis;
+                add("Collimators/" + name + ".gdml", name);
+            }
+    }
+
+    if (fStatusDisplayQuadrupoles == 1)
+    {
+        add("S1/Quadrupole_Q1.gdml", "Quadrupole_Q1");
+        add("S1/Quadrupole_Q2.gdml", "Quadrupole_Q2");
+        add("S2/QuadrupoleQ3.gdml", "Quadrupole_Q3");
+        add("S2/QuadrupoleQ4.gdml", "Quadrupole_Q4");
+    }
+
+    return models;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 /**
  * @brief Construct the full detector geometry for the simulation.
  *
@@ -873,12 +1301,17 @@ void PlasmaMLPALLASGeometryConstruction::ConstructSimplifiedPALLASGeometry()
  *
  * Steps performed:
  * - Clean existing geometry and volume stores to avoid duplication.
+ * - Read the GDML models placed for the display flags concurrently.
  * - Define common rotation matrices used for detector components.
  * - Create the world volume and geometry holder.
  * - Construct quadrupoles volume.
  * - Build either the full or simplified PALLAS geometry depending
  *   on configuration flags.
  * - Optionally construct collimators and quadrupoles if enabled.
+ * - Attach the YAG screens and the collimator jaws to their cut regions.
+ * - Release the preloaded GDML meshes, apply the voxel limits and report the CAD proxies.
+ * - Build the volume-role table read by the stepping actions.
+ * - Record the position of the collimators relative to the lattice (see UpdatePlacements).
  * - Return the fully initialized world volume.
  *
  * @return Pointer to the top-level physical volume (`PhysicalWorld`)
@@ -888,10 +1321,33 @@ G4VPhysicalVolume *PlasmaMLPALLASGeometryConstruction::Construct()
 {
     // --- Cleanup of previous geometry ----------------------------------------
     G4GeometryManager::GetInstance()->OpenGeometry();
+    G4Region *linearOpticsRegion = G4RegionStore::GetInstance()->FindOrCreateRegion("LinearOptics");
+    if (LogicalQ1Volume)
+        linearOpticsRegion->RemoveRootLogicalVolume(LogicalQ1Volume);
+    G4Region *yagRegion = G4RegionStore::GetInstance()->FindOrCreateRegion("YAGScreens");
+    G4Region *collimatorRegion = G4RegionStore::GetInstance()->FindOrCreateRegion("Collimators");
+    ClearRootVolumes(yagRegion);
+    ClearRootVolumes(collimatorRegion);
     G4PhysicalVolumeStore::GetInstance()->Clean();
     G4LogicalVolumeStore::GetInstance()->Clean();
     G4SolidStore::GetInstance()->Clean();
 
+    /// Placements moved by UpdatePlacements, set again only if built below
+    for (G4VPhysicalVolume **volume : {&PhysicalQ1Volume, &PhysicalQ2Volume, &PhysicalQ3Volume, &PhysicalQ4Volume,
+                                       &PhysicalQ1FieldVolume, &PhysicalQ2FieldVolume,
+                                       &PhysicalQ3FieldVolume, &PhysicalQ4FieldVolume,
+                                       &PhysicalPALLAS_QuadrupoleQ1, &PhysicalPALLAS_QuadrupoleQ2,
+                                       &PhysicalPALLAS_QuadrupoleQ3, &PhysicalPALLAS_QuadrupoleQ4,
+                                       &PhysicalPALLAS_Collimator_H1, &PhysicalPALLAS_Collimator_H2,
+                                       &PhysicalPALLAS_Collimator_Arbre_H, &PhysicalPALLAS_Collimator_Bride_H,
+                                       &PhysicalPALLAS_Collimator_Palier_H, &PhysicalPALLAS_Collimator_V1,
+                                       &PhysicalPALLAS_Collimator_V2, &PhysicalPALLAS_Collimator_Arbre_V,
+                                       &PhysicalPALLAS_Collimator_Bride_V, &PhysicalPALLAS_Collimator_Palier_V})
+        *volume = nullptr;
+
+    // --- Read the placed GDML models in parallel -----------------------------
+    Geom->PreloadGDMLVolumes(CollectGDMLModels());
+
     // --- Define common rotation matrices -------------------------------------
     DontRotate.rotateX(0.0 * deg);
     Flip.rotateZ(0 * deg);
@@ -908,6 +1364,9 @@ G4VPhysicalVolume *PlasmaMLPALLASGeometryConstruction::Construct()
     /// Construct quadrupoles container volume
     ConstructQuadrupolesVolume();
 
+    /// Envelope of the linear-optics fast transport (model attached in ConstructSDandField)
+    linearOpticsRegion->AddRootLogicalVolume(LogicalQ1Volume);
+
     /// Choose between full or simplified PALLAS geometry
     if(fStatusDisplayGeometry == 1) 
         ConstructFullPALLASGeometry();
@@ -918,10 +1377,31 @@ G4VPhysicalVolume *PlasmaMLPALLASGeometryConstruction::Construct()
     if(fStatusDisplayCollimators == 1) 
         ConstructCollimators();
 
+    /// Regions with their own production cuts (see PlasmaMLPALLASPhysics::SetCuts);
+    /// the rest of the beamline stays in the default region of the world
+    for (G4LogicalVolume *volume : {LogicalPALLAS_BS1YAG, LogicalPALLAS_BSPEC1YAG})
+        yagRegion->AddRootLogicalVolume(volume);
+    if (fStatusDisplayCollimators == 1)
+        for (G4LogicalVolume *volume : {LogicalPALLAS_Collimator_H1, LogicalPALLAS_Collimator_H2,
+                                        LogicalPALLAS_Collimator_V1, LogicalPALLAS_Collimator_V2})
+            collimatorRegion->AddRootLogicalVolume(volume);
+
     /// Optionally construct quadrupoles
     if(fStatusDisplayQuadrupoles == 1) 
         ConstructQuadrupoles();
 
+    /// Meshes of the models are no longer needed once the solids are built
+    Geom->ReleaseGDMLVolumes();
+
+    /// Voxel limits of the volumes and report of the CAD proxies
+    Geom->GetCADModels().EndConstruction();
+
+    /// Classify the placed volumes once for the stepping actions
+    fVolumeRoles.Build();
+
+    /// Linear-optics set-up of ConstructSDandField, kept while the placements move
+    fCollimatorsInsideLattice = CollimatorsInsideLattice();
+
     G4cout << "END OF THE DETECTOR CONSTRUCTION" << G4endl;
 
     // --- Return the fully constructed world volume ---------------------------
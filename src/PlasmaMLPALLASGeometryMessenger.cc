@@ -1,4 +1,6 @@
 #include "PlasmaMLPALLASGeometryMessenger.hh"
+#include "G4UIparameter.hh"
+#include <sstream>
 
 /**
  * @file PlasmaMLPALLASGeometryMessenger.cc
@@ -12,6 +14,7 @@
  *  - Creating UI directories and commands for geometry, display, and magnetic field controls.
  *  - Enabling/disabling visualization of geometry components (full geometry, quadrupoles, collimators).
  *  - Setting geometry parameters such as quadrupole lengths and distances between elements.
+ *  - Selecting the solids of the CAD parts (tessellated or fitted proxies) and their voxel limits.
  *  - Setting magnetic field gradients and dipole field options.
  *  - Passing user-specified values to the PlasmaMLPALLASGeometryConstruction class.
  *
@@ -173,6 +176,7 @@ PlasmaMLPALLASGeometryMessenger::PlasmaMLPALLASGeometryMessenger(PlasmaMLPALLASG
      */
     fGeometrySourceQ1DistanceCmd = new G4UIcmdWithADoubleAndUnit("/PlasmaMLPALLAS/geometry/setSourceQ1Distance", this);
     fGeometrySourceQ1DistanceCmd->SetGuidance("Set Source -- Q1 Distance");
+    fGeometrySourceQ1DistanceCmd->SetGuidance("Moves the built placements in place (holder voxels rebuilt).");
     fGeometrySourceQ1DistanceCmd->SetParameterName("SourceQ1Distance", false);
     fGeometrySourceQ1DistanceCmd->SetRange("SourceQ1Distance>0.");
     fGeometrySourceQ1DistanceCmd->SetUnitCategory("Length");
@@ -186,6 +190,7 @@ PlasmaMLPALLASGeometryMessenger::PlasmaMLPALLASGeometryMessenger(PlasmaMLPALLASG
      */
     fGeometryQ1Q2DistanceCmd = new G4UIcmdWithADoubleAndUnit("/PlasmaMLPALLAS/geometry/setQ1Q2Distance", this);
     fGeometryQ1Q2DistanceCmd->SetGuidance("Set Q1 -- Q2 Distance");
+    fGeometryQ1Q2DistanceCmd->SetGuidance("Moves the built placements in place (holder voxels rebuilt).");
     fGeometryQ1Q2DistanceCmd->SetParameterName("Q1Q2Distance", false);
     fGeometryQ1Q2DistanceCmd->SetRange("Q1Q2Distance>0.");
     fGeometryQ1Q2DistanceCmd->SetUnitCategory("Length");
@@ -199,6 +204,7 @@ PlasmaMLPALLASGeometryMessenger::PlasmaMLPALLASGeometryMessenger(PlasmaMLPALLASG
      */
     fGeometryQ2Q3DistanceCmd = new G4UIcmdWithADoubleAndUnit("/PlasmaMLPALLAS/geometry/setQ2Q3Distance", this);
     fGeometryQ2Q3DistanceCmd->SetGuidance("Set Q2 -- Q3 Distance");
+    fGeometryQ2Q3DistanceCmd->SetGuidance("Moves the built placements in place (holder voxels rebuilt).");
     fGeometryQ2Q3DistanceCmd->SetParameterName("Q2Q3Distance", false);
     fGeometryQ2Q3DistanceCmd->SetRange("Q2Q3Distance>0.");
     fGeometryQ2Q3DistanceCmd->SetUnitCategory("Length");
@@ -212,6 +218,7 @@ PlasmaMLPALLASGeometryMessenger::PlasmaMLPALLASGeometryMessenger(PlasmaMLPALLASG
      */
     fGeometryQ3Q4DistanceCmd = new G4UIcmdWithADoubleAndUnit("/PlasmaMLPALLAS/geometry/setQ3Q4Distance", this);
     fGeometryQ3Q4DistanceCmd->SetGuidance("Set Q3 -- Q4 Distance");
+    fGeometryQ3Q4DistanceCmd->SetGuidance("Moves the built placements in place (holder voxels rebuilt).");
     fGeometryQ3Q4DistanceCmd->SetParameterName("Q3Q4Distance", false);
     fGeometryQ3Q4DistanceCmd->SetRange("Q3Q4Distance>0.");
     fGeometryQ3Q4DistanceCmd->SetUnitCategory("Length");
@@ -225,12 +232,65 @@ PlasmaMLPALLASGeometryMessenger::PlasmaMLPALLASGeometryMessenger(PlasmaMLPALLASG
      */
     fGeometrySourceCollimatorsDistanceCmd = new G4UIcmdWithADoubleAndUnit("/PlasmaMLPALLAS/geometry/setSourceCollimatorsDistance", this);
     fGeometrySourceCollimatorsDistanceCmd->SetGuidance("Set Source -- Collimators Distance");
+    fGeometrySourceCollimatorsDistanceCmd->SetGuidance("Moves the built placements in place (holder voxels rebuilt).");
     fGeometrySourceCollimatorsDistanceCmd->SetParameterName("SourceCollimatorsDistance", false);
     fGeometrySourceCollimatorsDistanceCmd->SetRange("SourceCollimatorsDistance>0.");
     fGeometrySourceCollimatorsDistanceCmd->SetUnitCategory("Length");
     fGeometrySourceCollimatorsDistanceCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
     fGeometrySourceCollimatorsDistanceCmd->SetToBeBroadcasted(false);
 
+    /**
+     * @brief Command to select the solid of the CAD parts.
+     *
+     * Parameters: mode (tessellated or proxy), volume (logical volume name or all)
+     */
+    G4String cadModes;
+    for (const auto &name : PlasmaMLPALLASCADModels::GetModeNames())
+        cadModes += (cadModes.empty() ? "" : " ") + name;
+
+    fGeometryCADModeCmd = new G4UIcommand("/PlasmaMLPALLAS/geometry/setCADMode", this);
+    fGeometryCADModeCmd->SetGuidance("Build the GDML parts as tessellated solids or as fitted CSG/extruded proxies");
+    fGeometryCADModeCmd->SetGuidance("A proxy keeps the mass of its part and is only used above the proxy tolerance");
+    auto *cadModeParameter = new G4UIparameter("mode", 's', false);
+    cadModeParameter->SetParameterCandidates(cadModes);
+    fGeometryCADModeCmd->SetParameter(cadModeParameter);
+    auto *cadVolumeParameter = new G4UIparameter("volume", 's', true);
+    cadVolumeParameter->SetDefaultValue("all");
+    fGeometryCADModeCmd->SetParameter(cadVolumeParameter);
+    fGeometryCADModeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fGeometryCADModeCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the minimum overlap of a proxy with its part.
+     *
+     * Parameter: tolerance (Jaccard index, 0-1)
+     */
+    fGeometryProxyToleranceCmd = new G4UIcmdWithADouble("/PlasmaMLPALLAS/geometry/setProxyTolerance", this);
+    fGeometryProxyToleranceCmd->SetGuidance("Set the minimum overlap (common over union volume) of a proxy with its part");
+    fGeometryProxyToleranceCmd->SetParameterName("tolerance", false);
+    fGeometryProxyToleranceCmd->SetRange("tolerance>=0. && tolerance<=1.");
+    fGeometryProxyToleranceCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fGeometryProxyToleranceCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the navigation voxel limits of a logical volume.
+     *
+     * Parameters: volume (logical volume name or all), smartless, maxVoxels (tessellated parts)
+     */
+    fGeometryVoxelLimitsCmd = new G4UIcommand("/PlasmaMLPALLAS/geometry/setVoxelLimits", this);
+    fGeometryVoxelLimitsCmd->SetGuidance("Set the smartless value of a logical volume and the voxel limit of a tessellated part");
+    fGeometryVoxelLimitsCmd->SetGuidance("-1 keeps the Geant4 default");
+    fGeometryVoxelLimitsCmd->SetParameter(new G4UIparameter("volume", 's', false));
+    auto *smartlessParameter = new G4UIparameter("smartless", 'i', false);
+    smartlessParameter->SetParameterRange("smartless==-1 || smartless>0");
+    fGeometryVoxelLimitsCmd->SetParameter(smartlessParameter);
+    auto *maxVoxelsParameter = new G4UIparameter("maxVoxels", 'i', true);
+    maxVoxelsParameter->SetDefaultValue(-1);
+    maxVoxelsParameter->SetParameterRange("maxVoxels==-1 || maxVoxels>0");
+    fGeometryVoxelLimitsCmd->SetParameter(maxVoxelsParameter);
+    fGeometryVoxelLimitsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fGeometryVoxelLimitsCmd->SetToBeBroadcasted(false);
+
 
     //=====================================
     // Field Commands
@@ -245,6 +305,7 @@ PlasmaMLPALLASGeometryMessenger::PlasmaMLPALLASGeometryMessenger(PlasmaMLPALLASG
      */
     fFieldQ1GradientCmd = new G4UIcmdWithADoubleAndUnit("/PlasmaMLPALLAS/field/setQ1Gradient", this);
     fFieldQ1GradientCmd->SetGuidance("Set Q1 Gradient");
+    fFieldQ1GradientCmd->SetGuidance("Applied to the existing fields at the next run, without geometry rebuild");
     fFieldQ1GradientCmd->SetParameterName("Q1Gradient", false);
     //fFieldQ1GradientCmd->SetRange("Q1Gradient>-100 && Q1Gradient < 100");
     fFieldQ1GradientCmd->SetUnitCategory("MagneticGradient");
@@ -258,6 +319,7 @@ PlasmaMLPALLASGeometryMessenger::PlasmaMLPALLASGeometryMessenger(PlasmaMLPALLASG
      */
     fFieldQ2GradientCmd = new G4UIcmdWithADoubleAndUnit("/PlasmaMLPALLAS/field/setQ2Gradient", this);
     fFieldQ2GradientCmd->SetGuidance("Set Q2 Gradient");
+    fFieldQ2GradientCmd->SetGuidance("Applied to the existing fields at the next run, without geometry rebuild");
     fFieldQ2GradientCmd->SetParameterName("Q2Gradient", false);
     //fFieldQ2GradientCmd->SetRange("Q2Gradient>-100 && Q2Gradient < 100");
     fFieldQ2GradientCmd->SetUnitCategory("MagneticGradient");
@@ -271,6 +333,7 @@ PlasmaMLPALLASGeometryMessenger::PlasmaMLPALLASGeometryMessenger(PlasmaMLPALLASG
      */
     fFieldQ3GradientCmd = new G4UIcmdWithADoubleAndUnit("/PlasmaMLPALLAS/field/setQ3Gradient", this);
     fFieldQ3GradientCmd->SetGuidance("Set Q3 Gradient");
+    fFieldQ3GradientCmd->SetGuidance("Applied to the existing fields at the next run, without geometry rebuild");
     fFieldQ3GradientCmd->SetParameterName("Q3Gradient", false);
     //fFieldQ3GradientCmd->SetRange("Q3Gradient>-100 && Q3Gradient < 100");
     fFieldQ3GradientCmd->SetUnitCategory("MagneticGradient");
@@ -284,6 +347,7 @@ PlasmaMLPALLASGeometryMessenger::PlasmaMLPALLASGeometryMessenger(PlasmaMLPALLASG
      */
     fFieldQ4GradientCmd = new G4UIcmdWithADoubleAndUnit("/PlasmaMLPALLAS/field/setQ4Gradient", this);
     fFieldQ4GradientCmd->SetGuidance("Set Q4 Gradient");
+    fFieldQ4GradientCmd->SetGuidance("Applied to the existing fields at the next run, without geometry rebuild");
     fFieldQ4GradientCmd->SetParameterName("Q4Gradient", false);
     //fFieldQ4GradientCmd->SetRange("Q4Gradient>-100 && Q4Gradient < 100");
     fFieldQ4GradientCmd->SetUnitCategory("MagneticGradient");
@@ -293,14 +357,15 @@ PlasmaMLPALLASGeometryMessenger::PlasmaMLPALLASGeometryMessenger(PlasmaMLPALLASG
     /**
      * @brief Command to enable/disable use of Map Dipole spectrometer
      *
-     * Parameter: StatusMapBField (0 or 1)
-     * - 0: Disable Map B Field
-     * - 1: Enable Map B Field
+     * Parameter: StatusMapBField (0, 1 or 2)
+     * - 0: Disable Map B Field (constant dipole)
+     * - 1: Enable Map B Field (fitted profiles)
+     * - 2: Measured 3D field map (see setFieldMapFile)
      */
     fFieldStatusMapBFieldCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/field/setStatusMapBField", this);
-    fFieldStatusMapBFieldCmd->SetGuidance("Enable or disable the feature (0/1)");
+    fFieldStatusMapBFieldCmd->SetGuidance("Select the dipole model (0 constant / 1 fitted profiles / 2 3D field map)");
     fFieldStatusMapBFieldCmd->SetParameterName("StatusMapBField", false);
-    fFieldStatusMapBFieldCmd->SetRange("StatusMapBField==0 || StatusMapBField==1");
+    fFieldStatusMapBFieldCmd->SetRange("StatusMapBField>=0 && StatusMapBField<=2");
     fFieldStatusMapBFieldCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
     fFieldStatusMapBFieldCmd->SetToBeBroadcasted(false);
 
@@ -311,11 +376,196 @@ PlasmaMLPALLASGeometryMessenger::PlasmaMLPALLASGeometryMessenger(PlasmaMLPALLASG
      */
     fFieldConstantDipoleBFieldCmd = new G4UIcmdWithADoubleAndUnit("/PlasmaMLPALLAS/field/setConstantDipoleBField", this);
     fFieldConstantDipoleBFieldCmd->SetGuidance("Set Constant Dipole B Field value");
+    fFieldConstantDipoleBFieldCmd->SetGuidance("Applied to the existing fields at the next run, without geometry rebuild");
     fFieldConstantDipoleBFieldCmd->SetParameterName("ConstantDipoleBField", false);
     //fFieldConstantDipoleBFieldCmd->SetRange("abs(ConstantDipoleBField) > 0");
     fFieldConstantDipoleBFieldCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
     fFieldConstantDipoleBFieldCmd->SetToBeBroadcasted(false);
 
+    /**
+     * @brief Command to append a quadrupole to the field lattice, after the last one.
+     *
+     * Parameters: drift (mm) from the exit of the previous quadrupole, length (mm), gradient (T/m)
+     * The quadrupole only exists in the field (no volume is built for it).
+     */
+    fFieldAddQuadrupoleCmd = new G4UIcommand("/PlasmaMLPALLAS/field/addQuadrupole", this);
+    fFieldAddQuadrupoleCmd->SetGuidance("Append a field-only quadrupole after the last one of the lattice");
+    fFieldAddQuadrupoleCmd->SetGuidance("drift from the previous exit in mm, length in mm, gradient in T/m");
+    fFieldAddQuadrupoleCmd->SetParameter(new G4UIparameter("drift", 'd', false));
+    auto *lengthParameter = new G4UIparameter("length", 'd', false);
+    lengthParameter->SetParameterRange("length>0.");
+    fFieldAddQuadrupoleCmd->SetParameter(lengthParameter);
+    fFieldAddQuadrupoleCmd->SetParameter(new G4UIparameter("gradient", 'd', false));
+    fFieldAddQuadrupoleCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFieldAddQuadrupoleCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to remove the quadrupoles added with addQuadrupole.
+     */
+    fFieldClearQuadrupolesCmd = new G4UIcmdWithoutParameter("/PlasmaMLPALLAS/field/clearQuadrupoles", this);
+    fFieldClearQuadrupolesCmd->SetGuidance("Remove the field-only quadrupoles added with addQuadrupole");
+    fFieldClearQuadrupolesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFieldClearQuadrupolesCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the measured 3D field map used when Status Map B Field is 2.
+     *
+     * Parameter: FieldMapFile (string) binary map produced with ./PlasmaMLPALLAS --fieldmap
+     */
+    fFieldMapFileCmd = new G4UIcmdWithAString("/PlasmaMLPALLAS/field/setFieldMapFile", this);
+    fFieldMapFileCmd->SetGuidance("Set the binary 3D field map used with setStatusMapBField 2");
+    fFieldMapFileCmd->SetGuidance("Produced from a text table with ./PlasmaMLPALLAS --fieldmap in.csv out.bin");
+    fFieldMapFileCmd->SetParameterName("FieldMapFile", false);
+    fFieldMapFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFieldMapFileCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to check the tabulated dipole profiles used when Status Map B Field is enabled.
+     *
+     * Parameter: NSamples (integer) number of positions tested in each profile
+     */
+    fFieldValidateDipoleMapCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/field/validateDipoleMap", this);
+    fFieldValidateDipoleMapCmd->SetGuidance("Compare the tabulated dipole profiles with the analytic fits");
+    fFieldValidateDipoleMapCmd->SetGuidance("Prints the maximum and RMS deviations in tesla");
+    fFieldValidateDipoleMapCmd->SetParameterName("NSamples", true);
+    fFieldValidateDipoleMapCmd->SetDefaultValue(100000);
+    fFieldValidateDipoleMapCmd->SetRange("NSamples>0");
+    fFieldValidateDipoleMapCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFieldValidateDipoleMapCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to select the volumes carrying the magnetic field.
+     *
+     * Parameter: StatusFieldVolumes (0 or 1)
+     * - 0: Field integrated in the whole holder
+     * - 1: Field in the quadrupole and dipole volumes only, straight-line transport elsewhere
+     */
+    fFieldStatusFieldVolumesCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/field/setStatusFieldVolumes", this);
+    fFieldStatusFieldVolumesCmd->SetGuidance("Select the volumes carrying the field (0 whole holder / 1 quadrupole and dipole volumes)");
+    fFieldStatusFieldVolumesCmd->SetGuidance("The whole holder is used anyway with displayed collimators or field-only quadrupoles");
+    fFieldStatusFieldVolumesCmd->SetParameterName("StatusFieldVolumes", false);
+    fFieldStatusFieldVolumesCmd->SetRange("StatusFieldVolumes>=0 && StatusFieldVolumes<=1");
+    fFieldStatusFieldVolumesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFieldStatusFieldVolumesCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to select the linear-optics fast transport of the primaries.
+     *
+     * Parameter: StatusLinearOptics (0, 1 or 2)
+     * - 0: Full Geant4 tracking
+     * - 1: Transfer matrices from the Q1 entrance to the exit of the lattice, Geant4 afterwards
+     * - 2: Transfer matrices, then the primaries are killed (quadrupole tallies only)
+     */
+    fFieldStatusLinearOpticsCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/field/setStatusLinearOptics", this);
+    fFieldStatusLinearOpticsCmd->SetGuidance("Transport the primaries through the quadrupoles with transfer matrices");
+    fFieldStatusLinearOpticsCmd->SetGuidance("0 off / 1 matrices then Geant4 / 2 matrices then kill (quadrupole tallies only)");
+    fFieldStatusLinearOpticsCmd->SetGuidance("Particles outside an aperture or a quadrupole volume are tracked by Geant4");
+    fFieldStatusLinearOpticsCmd->SetParameterName("StatusLinearOptics", false);
+    fFieldStatusLinearOpticsCmd->SetRange("StatusLinearOptics>=0 && StatusLinearOptics<=2");
+    fFieldStatusLinearOpticsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFieldStatusLinearOpticsCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to count the field calls and time the field propagation.
+     *
+     * Parameter: StatusFieldStatistics (0 or 1)
+     * - 0: No counters
+     * - 1: Field calls per region, chord steps per track and propagation time of each thread,
+     *      printed at the end of the run and stored in the GlobalInput tree
+     */
+    fFieldStatusFieldStatisticsCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/field/setStatusFieldStatistics", this);
+    fFieldStatusFieldStatisticsCmd->SetGuidance("Count the field calls per region and time the field propagation (0 off / 1 on)");
+    fFieldStatusFieldStatisticsCmd->SetGuidance("Applied when the fields are built (/run/initialize)");
+    fFieldStatusFieldStatisticsCmd->SetParameterName("StatusFieldStatistics", false);
+    fFieldStatusFieldStatisticsCmd->SetRange("StatusFieldStatistics>=0 && StatusFieldStatistics<=1");
+    fFieldStatusFieldStatisticsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFieldStatusFieldStatisticsCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to select the stepper of a field region.
+     *
+     * Parameters: region (quadrupoles, dipole or all), stepper name
+     */
+    G4String steppers;
+    for (const auto &name : PlasmaMLPALLASFieldIntegration::GetStepperNames())
+        steppers += (steppers.empty() ? "" : " ") + name;
+
+    fFieldStepperCmd = new G4UIcommand("/PlasmaMLPALLAS/field/setStepper", this);
+    fFieldStepperCmd->SetGuidance("Select the stepper of a field region (the whole holder uses the quadrupole settings)");
+    fFieldStepperCmd->SetGuidance("ExactHelix is accepted as an alias of DormandPrince745 (no region holds a uniform field)");
+    auto *stepperRegionParameter = new G4UIparameter("region", 's', false);
+    stepperRegionParameter->SetParameterCandidates("quadrupoles dipole all");
+    fFieldStepperCmd->SetParameter(stepperRegionParameter);
+    auto *stepperParameter = new G4UIparameter("stepper", 's', false);
+    stepperParameter->SetParameterCandidates(steppers);
+    fFieldStepperCmd->SetParameter(stepperParameter);
+    fFieldStepperCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFieldStepperCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the step accuracies of a field region.
+     *
+     * Parameters: region, minStep, deltaChord, deltaOneStep, deltaIntersection (mm)
+     */
+    fFieldAccuracyCmd = new G4UIcommand("/PlasmaMLPALLAS/field/setAccuracy", this);
+    fFieldAccuracyCmd->SetGuidance("Set the minimum step, delta chord, delta one step and delta intersection (mm) of a field region");
+    auto *accuracyRegionParameter = new G4UIparameter("region", 's', false);
+    accuracyRegionParameter->SetParameterCandidates("quadrupoles dipole all");
+    fFieldAccuracyCmd->SetParameter(accuracyRegionParameter);
+    for (const char *name : {"minStep", "deltaChord", "deltaOneStep", "deltaIntersection"})
+    {
+        auto *parameter = new G4UIparameter(name, 'd', false);
+        parameter->SetParameterRange(G4String(name) + ">0.");
+        fFieldAccuracyCmd->SetParameter(parameter);
+    }
+    fFieldAccuracyCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFieldAccuracyCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the relative accuracy bounds of a field region.
+     *
+     * Parameters: region, minEpsilon, maxEpsilon
+     */
+    fFieldEpsilonCmd = new G4UIcommand("/PlasmaMLPALLAS/field/setEpsilon", this);
+    fFieldEpsilonCmd->SetGuidance("Set the minimum and maximum relative accuracy of a step in a field region");
+    auto *epsilonRegionParameter = new G4UIparameter("region", 's', false);
+    epsilonRegionParameter->SetParameterCandidates("quadrupoles dipole all");
+    fFieldEpsilonCmd->SetParameter(epsilonRegionParameter);
+    auto *minEpsilonParameter = new G4UIparameter("minEpsilon", 'd', false);
+    minEpsilonParameter->SetParameterRange("minEpsilon>0. && minEpsilon<=0.01");
+    fFieldEpsilonCmd->SetParameter(minEpsilonParameter);
+    auto *maxEpsilonParameter = new G4UIparameter("maxEpsilon", 'd', false);
+    maxEpsilonParameter->SetParameterRange("maxEpsilon>0. && maxEpsilon<=0.01");
+    fFieldEpsilonCmd->SetParameter(maxEpsilonParameter);
+    fFieldEpsilonCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFieldEpsilonCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to apply a named set of integration settings to both regions.
+     *
+     * Parameter: preset (reference or optics-fast)
+     */
+    G4String presets;
+    for (const auto &name : PlasmaMLPALLASFieldIntegration::GetPresetNames())
+        presets += (presets.empty() ? "" : " ") + name;
+
+    fFieldPresetCmd = new G4UIcmdWithAString("/PlasmaMLPALLAS/field/usePreset", this);
+    fFieldPresetCmd->SetGuidance("Apply a named set of field integration settings to all the regions");
+    fFieldPresetCmd->SetGuidance("reference: RK4, 1 um minimum step, Geant4 default accuracies (historical settings)");
+    fFieldPresetCmd->SetGuidance("optics-fast: DormandPrince745 in all the regions, looser accuracies");
+    fFieldPresetCmd->SetParameterName("preset", false);
+    fFieldPresetCmd->SetCandidates(presets);
+    fFieldPresetCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFieldPresetCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to print the integration settings of all the regions.
+     */
+    fFieldPrintIntegrationCmd = new G4UIcmdWithoutParameter("/PlasmaMLPALLAS/field/printIntegration", this);
+    fFieldPrintIntegrationCmd->SetGuidance("Print the field integration settings of each region");
+    fFieldPrintIntegrationCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFieldPrintIntegrationCmd->SetToBeBroadcasted(false);
+
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -340,12 +590,27 @@ PlasmaMLPALLASGeometryMessenger::~PlasmaMLPALLASGeometryMessenger()
     delete fGeometryQ2Q3DistanceCmd;
     delete fGeometryQ3Q4DistanceCmd;
     delete fGeometrySourceCollimatorsDistanceCmd;
+    delete fGeometryCADModeCmd;
+    delete fGeometryProxyToleranceCmd;
+    delete fGeometryVoxelLimitsCmd;
     delete fFieldQ1GradientCmd;
     delete fFieldQ2GradientCmd;
     delete fFieldQ3GradientCmd;
     delete fFieldQ4GradientCmd;
     delete fFieldStatusMapBFieldCmd;
     delete fFieldConstantDipoleBFieldCmd;
+    delete fFieldAddQuadrupoleCmd;
+    delete fFieldClearQuadrupolesCmd;
+    delete fFieldMapFileCmd;
+    delete fFieldValidateDipoleMapCmd;
+    delete fFieldStatusFieldVolumesCmd;
+    delete fFieldStatusLinearOpticsCmd;
+    delete fFieldStatusFieldStatisticsCmd;
+    delete fFieldStepperCmd;
+    delete fFieldAccuracyCmd;
+    delete fFieldEpsilonCmd;
+    delete fFieldPresetCmd;
+    delete fFieldPrintIntegrationCmd;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -412,6 +677,25 @@ void PlasmaMLPALLASGeometryMessenger::SetNewValue(G4UIcommand *aCommand, G4Strin
     {
         fGeometry->SetSourceCollimatorsDistance(fGeometrySourceCollimatorsDistanceCmd->GetNewDoubleValue(aNewValue));
     }
+    else if (aCommand == fGeometryCADModeCmd)
+    {
+        std::istringstream is(aNewValue);
+        G4String mode, volume = "all";
+        is >> mode >> volume;
+        fGeometry->GetCADModels().SetMode(mode, volume);
+    }
+    else if (aCommand == fGeometryProxyToleranceCmd)
+    {
+        fGeometry->GetCADModels().SetProxyTolerance(fGeometryProxyToleranceCmd->GetNewDoubleValue(aNewValue));
+    }
+    else if (aCommand == fGeometryVoxelLimitsCmd)
+    {
+        std::istringstream is(aNewValue);
+        G4String volume;
+        G4int smartless = -1, maxVoxels = -1;
+        is >> volume >> smartless >> maxVoxels;
+        fGeometry->GetCADModels().SetVoxelLimits(volume, smartless, maxVoxels);
+    }
     else if (aCommand == fFieldQ1GradientCmd)
     {
         fGeometry->SetQ1Gradient(fFieldQ1GradientCmd->GetNewDoubleValue(aNewValue));
@@ -436,6 +720,100 @@ void PlasmaMLPALLASGeometryMessenger::SetNewValue(G4UIcommand *aCommand, G4Strin
     {
         fGeometry->SetConstantDipoleBField(fFieldConstantDipoleBFieldCmd->GetNewDoubleValue(aNewValue));
     }
+    else if (aCommand == fFieldAddQuadrupoleCmd)
+    {
+        G4double drift = 0., length = 0., gradient = 0.;
+        std::istringstream is(aNewValue);
+        is >> drift >> length >> gradient;
+        fGeometry->AddQuadrupole(drift * mm, length * mm, gradient * tesla / m);
+    }
+    else if (aCommand == fFieldClearQuadrupolesCmd)
+    {
+        fGeometry->ClearExtraQuadrupoles();
+    }
+    else if (aCommand == fFieldMapFileCmd)
+    {
+        fGeometry->SetFieldMapFile(aNewValue);
+    }
+    else if (aCommand == fFieldValidateDipoleMapCmd)
+    {
+        PlasmaMLPALLASMagneticField::ValidateDipoleProfiles(fFieldValidateDipoleMapCmd->GetNewIntValue(aNewValue));
+    }
+    else if (aCommand == fFieldStatusFieldVolumesCmd)
+    {
+        fGeometry->SetStatusFieldVolumes(fFieldStatusFieldVolumesCmd->GetNewIntValue(aNewValue));
+    }
+    else if (aCommand == fFieldStatusLinearOpticsCmd)
+    {
+        fGeometry->SetStatusLinearOptics(fFieldStatusLinearOpticsCmd->GetNewIntValue(aNewValue));
+    }
+    else if (aCommand == fFieldStatusFieldStatisticsCmd)
+    {
+        fGeometry->SetStatusFieldStatistics(fFieldStatusFieldStatisticsCmd->GetNewIntValue(aNewValue));
+    }
+    else if (aCommand == fFieldStepperCmd || aCommand == fFieldAccuracyCmd || aCommand == fFieldEpsilonCmd)
+    {
+        std::istringstream is(aNewValue);
+        G4String region;
+        is >> region;
+
+        std::vector<PlasmaMLPALLASFieldIntegration *> integrations;
+        if (region != "dipole")
+            integrations.push_back(&fGeometry->GetQuadrupoleIntegration());
+        if (region != "quadrupoles")
+            integrations.push_back(&fGeometry->GetDipoleIntegration());
+
+        if (aCommand == fFieldStepperCmd)
+        {
+            G4String stepper;
+            is >> stepper;
+            // The exact helix steps across the edges of the non-uniform fields of every region
+            if (stepper == "ExactHelix")
+            {
+                G4cout << "ExactHelix needs a field uniform over the region: DormandPrince745 used instead" << G4endl;
+                stepper = "DormandPrince745";
+            }
+            for (auto *integration : integrations)
+                integration->stepper = stepper;
+        }
+        else if (aCommand == fFieldAccuracyCmd)
+        {
+            G4double minStep, deltaChord, deltaOneStep, deltaIntersection;
+            is >> minStep >> deltaChord >> deltaOneStep >> deltaIntersection;
+            for (auto *integration : integrations)
+            {
+                integration->minStep = minStep * mm;
+                integration->deltaChord = deltaChord * mm;
+                integration->deltaOneStep = deltaOneStep * mm;
+                integration->deltaIntersection = deltaIntersection * mm;
+            }
+        }
+        else
+        {
+            G4double minEpsilon, maxEpsilon;
+            is >> minEpsilon >> maxEpsilon;
+            if (minEpsilon > maxEpsilon)
+            {
+                G4cerr << "setEpsilon: minEpsilon must not exceed maxEpsilon, settings unchanged" << G4endl;
+                return;
+            }
+            for (auto *integration : integrations)
+            {
+                integration->minEpsilon = minEpsilon;
+                integration->maxEpsilon = maxEpsilon;
+            }
+        }
+    }
+    else if (aCommand == fFieldPresetCmd)
+    {
+        PlasmaMLPALLASFieldIntegration::ApplyPreset(aNewValue, fGeometry->GetQuadrupoleIntegration(),
+                                                    fGeometry->GetDipoleIntegration());
+    }
+    else if (aCommand == fFieldPrintIntegrationCmd)
+    {
+        fGeometry->GetQuadrupoleIntegration().Print("quadrupoles");
+        fGeometry->GetDipoleIntegration().Print("dipole");
+    }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -500,6 +878,10 @@ G4String PlasmaMLPALLASGeometryMessenger::GetCurrentValue(G4UIcommand *aCommand)
     {
         cv = fGeometrySourceCollimatorsDistanceCmd->ConvertToString(fGeometry->GetSourceCollimatorsDistance(), "m");
     }
+    else if (aCommand == fGeometryProxyToleranceCmd)
+    {
+        cv = fGeometryProxyToleranceCmd->ConvertToString(fGeometry->GetCADModels().GetProxyTolerance());
+    }
     else if (aCommand == fFieldQ1GradientCmd)
     {
         cv = fFieldQ1GradientCmd->ConvertToString(fGeometry->GetQ1Gradient(), "T/m");
@@ -520,6 +902,22 @@ G4String PlasmaMLPALLASGeometryMessenger::GetCurrentValue(G4UIcommand *aCommand)
     {
         cv = fFieldStatusMapBFieldCmd->ConvertToString(fGeometry->GetStatusMapBField());
     }
+    else if (aCommand == fFieldMapFileCmd)
+    {
+        cv = fGeometry->GetFieldMapFile();
+    }
+    else if (aCommand == fFieldStatusFieldVolumesCmd)
+    {
+        cv = fFieldStatusFieldVolumesCmd->ConvertToString(fGeometry->GetStatusFieldVolumes());
+    }
+    else if (aCommand == fFieldStatusLinearOpticsCmd)
+    {
+        cv = fFieldStatusLinearOpticsCmd->ConvertToString(fGeometry->GetStatusLinearOptics());
+    }
+    else if (aCommand == fFieldStatusFieldStatisticsCmd)
+    {
+        cv = fFieldStatusFieldStatisticsCmd->ConvertToString(fGeometry->GetStatusFieldStatistics());
+    }
     else if (aCommand == fFieldConstantDipoleBFieldCmd)
     {
         cv = fFieldConstantDipoleBFieldCmd->ConvertToString(fGeometry->GetConstantDipoleBField(), "T");
@@ -0,0 +1,15 @@
+/**
+ * @file PlasmaMLPALLASHits.cc
+ * @brief Thread-local allocators of the hits.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASHits.hh"
+
+G4ThreadLocal G4Allocator<PlasmaMLPALLASQuadrupoleHit> *PlasmaMLPALLASQuadrupoleHitAllocator = nullptr;
+G4ThreadLocal G4Allocator<PlasmaMLPALLASCollimatorHit> *PlasmaMLPALLASCollimatorHitAllocator = nullptr;
+G4ThreadLocal G4Allocator<PlasmaMLPALLASYAGHit> *PlasmaMLPALLASYAGHitAllocator = nullptr;
@@ -0,0 +1,85 @@
+/**
+ * @file PlasmaMLPALLASInstrumentedDriver.cc
+ * @brief Implementation of the counting and timing integration driver.
+ *
+ * The current track is read from the tracking manager of the thread: a track
+ * is counted once per driver, the first time one of its steps reaches it.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASInstrumentedDriver.hh"
+#include "G4ChordFinder.hh"
+#include "G4Event.hh"
+#include "G4EventManager.hh"
+#include "G4Track.hh"
+#include "G4TrackingManager.hh"
+#include <chrono>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASInstrumentedDriver::Install(G4ChordFinder* chordFinder, PlasmaMLPALLASFieldStatistics::Driver driver)
+{
+    chordFinder->SetIntegrationDriver(new PlasmaMLPALLASInstrumentedDriver(chordFinder->GetIntegrationDriver(), driver));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASInstrumentedDriver::PlasmaMLPALLASInstrumentedDriver(G4VIntegrationDriver* driver,
+                                                                   PlasmaMLPALLASFieldStatistics::Driver index)
+    : fDriver(driver), fStatistics(PlasmaMLPALLASFieldStatistics::Local()), fIndex(index)
+{
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASInstrumentedDriver::~PlasmaMLPALLASInstrumentedDriver()
+{
+    delete fDriver;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASInstrumentedDriver::CountTrack()
+{
+    G4EventManager* eventManager = G4EventManager::GetEventManager();
+    const G4Event* event = eventManager->GetConstCurrentEvent();
+    const G4Track* track = eventManager->GetTrackingManager()->GetTrack();
+    if (!event || !track)
+        return;
+
+    if (event->GetEventID() != fLastEventID || track->GetTrackID() != fLastTrackID)
+    {
+        fLastEventID = event->GetEventID();
+        fLastTrackID = track->GetTrackID();
+        ++fStatistics.tracks[fIndex];
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double PlasmaMLPALLASInstrumentedDriver::AdvanceChordLimited(G4FieldTrack& track, G4double hstep, G4double eps,
+                                                              G4double chordDistance)
+{
+    CountTrack();
+    ++fStatistics.chordSteps[fIndex];
+
+    const auto start = std::chrono::steady_clock::now();
+    const G4double step = fDriver->AdvanceChordLimited(track, hstep, eps, chordDistance);
+    fStatistics.driverTime[fIndex] += std::chrono::duration<G4double>(std::chrono::steady_clock::now() - start).count();
+    return step;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PlasmaMLPALLASInstrumentedDriver::AccurateAdvance(G4FieldTrack& track, G4double hstep, G4double eps,
+                                                         G4double hinitial)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const G4bool success = fDriver->AccurateAdvance(track, hstep, eps, hinitial);
+    fStatistics.driverTime[fIndex] += std::chrono::duration<G4double>(std::chrono::steady_clock::now() - start).count();
+    return success;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file PlasmaMLPALLASKillZones.cc
+ * @brief Implementation of the aperture, backward and energy cuts of the stepping action.
+ *
+ * The edges of the apertures split the beam axis into intervals; Build()
+ * stores for each interval the intersection of the apertures covering it
+ * (smallest radius, smallest half widths), with the counter of the aperture
+ * giving each limit. Outside the edges nothing is cut.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASKillZones.hh"
+#include "G4Track.hh"
+#include "G4StepPoint.hh"
+#include "G4UnitsTable.hh"
+#include "G4ios.hh"
+#include <algorithm>
+#include <cmath>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASKillZones &PlasmaMLPALLASKillZones::Local()
+{
+    static G4ThreadLocal PlasmaMLPALLASKillZones *zones = nullptr;
+    if (!zones)
+    {
+        zones = new PlasmaMLPALLASKillZones();
+        zones->Build();
+    }
+    return *zones;
+}
+
+const std::vector<G4String> &PlasmaMLPALLASKillZones::GetShapeNames()
+{
+    static const std::vector<G4String> names = {"cylinder", "box"};
+    return names;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASKillZones::AddAperture(const Aperture &aperture)
+{
+    const auto it = std::find_if(fApertures.begin(), fApertures.end(),
+                                 [&](const Aperture &a) { return a.name == aperture.name; });
+    if (it != fApertures.end())
+        *it = aperture;
+    else
+        fApertures.push_back(aperture);
+    Build();
+}
+
+void PlasmaMLPALLASKillZones::Clear()
+{
+    fApertures.clear();
+    fMinDirectionY = -1.;
+    fMinEnergy = 0.;
+    Build();
+}
+
+void PlasmaMLPALLASKillZones::SetBackwardCut(G4double minDirectionY)
+{
+    fMinDirectionY = minDirectionY;
+    Build();
+}
+
+void PlasmaMLPALLASKillZones::SetMinEnergy(G4double energy)
+{
+    fMinEnergy = energy;
+    Build();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASKillZones::Build()
+{
+    fEdges.clear();
+    for (const Aperture &aperture : fApertures)
+    {
+        fEdges.push_back(aperture.yMin);
+        fEdges.push_back(aperture.yMax);
+    }
+    std::sort(fEdges.begin(), fEdges.end());
+    fEdges.erase(std::unique(fEdges.begin(), fEdges.end()), fEdges.end());
+
+    fIntervals.assign(fEdges.empty() ? 0 : fEdges.size() - 1, Interval());
+    for (size_t i = 0; i < fIntervals.size(); ++i)
+    {
+        const G4double centre = 0.5 * (fEdges[i] + fEdges[i + 1]);
+        Interval &interval = fIntervals[i];
+        for (size_t a = 0; a < fApertures.size(); ++a)
+        {
+            const Aperture &aperture = fApertures[a];
+            if (centre < aperture.yMin || centre > aperture.yMax)
+                continue;
+
+            if (aperture.shape == Shape::Cylinder)
+            {
+                const G4double radius2 = aperture.halfX * aperture.halfX;
+                if (interval.radius2 < 0. || radius2 < interval.radius2)
+                {
+                    interval.radius2 = radius2;
+                    interval.radiusCounter = a;
+                }
+            }
+            else
+            {
+                if (interval.halfX < 0. || aperture.halfX < interval.halfX)
+                {
+                    interval.halfX = aperture.halfX;
+                    interval.boxXCounter = a;
+                }
+                if (interval.halfZ < 0. || aperture.halfZ < interval.halfZ)
+                {
+                    interval.halfZ = aperture.halfZ;
+                    interval.boxZCounter = a;
+                }
+            }
+        }
+    }
+
+    fCounts.assign(fApertures.size() + 2, 0);
+    fActive = !fApertures.empty() || fMinDirectionY > -1. || fMinEnergy > 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Check the end of a step.
+ *
+ * The energy and backward cuts come first (no lookup); the aperture of the
+ * interval is then found by bisection of the edges.
+ */
+G4bool PlasmaMLPALLASKillZones::Check(const G4Track *track, const G4StepPoint *point)
+{
+    if (fPrimariesOnly && track->GetParentID() != 0)
+        return false;
+
+    const size_t nApertures = fApertures.size();
+    if (point->GetKineticEnergy() < fMinEnergy)
+    {
+        ++fCounts[nApertures + 1];
+        return true;
+    }
+
+    if (point->GetMomentumDirection().y() < fMinDirectionY)
+    {
+        ++fCounts[nApertures];
+        return true;
+    }
+
+    if (fIntervals.empty())
+        return false;
+
+    // Intervals are [edge, next edge), except the last one which includes its end
+    const G4ThreeVector &position = point->GetPosition();
+    auto edge = std::upper_bound(fEdges.begin(), fEdges.end(), position.y());
+    if (edge == fEdges.end() && position.y() == fEdges.back())
+        --edge;
+    if (edge == fEdges.begin() || edge == fEdges.end())
+        return false;
+
+    const Interval &interval = fIntervals[static_cast<size_t>(edge - fEdges.begin()) - 1];
+    const G4double x = position.x();
+    const G4double z = position.z();
+
+    size_t counter = nApertures;
+    if (interval.radius2 >= 0. && x * x + z * z > interval.radius2)
+        counter = interval.radiusCounter;
+    else if (interval.halfX >= 0. && std::abs(x) > interval.halfX)
+        counter = interval.boxXCounter;
+    else if (interval.halfZ >= 0. && std::abs(z) > interval.halfZ)
+        counter = interval.boxZCounter;
+    else
+        return false;
+
+    ++fCounts[counter];
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::vector<G4String> PlasmaMLPALLASKillZones::GetCounterNames() const
+{
+    std::vector<G4String> names;
+    for (const Aperture &aperture : fApertures)
+        names.push_back(aperture.name);
+    names.push_back("Backward");
+    names.push_back("MinEnergy");
+    return names;
+}
+
+void PlasmaMLPALLASKillZones::Reset()
+{
+    std::fill(fCounts.begin(), fCounts.end(), 0);
+}
+
+void PlasmaMLPALLASKillZones::Print() const
+{
+    G4cout << "--- Kill zones (" << (fPrimariesOnly ? "primaries" : "all tracks") << ") ---" << G4endl;
+    for (size_t i = 0; i < fApertures.size(); ++i)
+    {
+        const Aperture &aperture = fApertures[i];
+        G4cout << "  " << aperture.name << ": " << GetShapeNames()[static_cast<size_t>(aperture.shape)]
+               << " y = [" << G4BestUnit(aperture.yMin, "Length") << ", " << G4BestUnit(aperture.yMax, "Length") << "]";
+        if (aperture.shape == Shape::Cylinder)
+            G4cout << " r = " << G4BestUnit(aperture.halfX, "Length");
+        else
+            G4cout << " |x| < " << G4BestUnit(aperture.halfX, "Length") << " |z| < " << G4BestUnit(aperture.halfZ, "Length");
+        G4cout << " killed = " << fCounts[i] << G4endl;
+    }
+    if (fMinDirectionY > -1.)
+        G4cout << "  Backward: direction y < " << fMinDirectionY << " killed = " << fCounts[fApertures.size()] << G4endl;
+    if (fMinEnergy > 0.)
+        G4cout << "  MinEnergy: E < " << G4BestUnit(fMinEnergy, "Energy") << " killed = " << fCounts[fApertures.size() + 1] << G4endl;
+}
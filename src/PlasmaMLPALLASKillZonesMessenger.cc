@@ -0,0 +1,182 @@
+#include "PlasmaMLPALLASKillZonesMessenger.hh"
+#include "PlasmaMLPALLASKillZones.hh"
+#include "G4UIparameter.hh"
+#include "G4UnitsTable.hh"
+#include <algorithm>
+#include <sstream>
+
+/**
+ * @file PlasmaMLPALLASKillZonesMessenger.cc
+ * @brief User interface (UI) messenger for the kill zones of the stepping action.
+ *
+ * Commands are organized in the /PlasmaMLPALLAS/killzone/ directory and allow users to:
+ *  - Kill the tracks leaving a cylinder or a box aperture over a range of y.
+ *  - Kill the tracks moving backwards or below a kinetic energy.
+ *  - Apply the cuts to the primaries only or to every track.
+ *
+ * @authors Arnaud HUBER
+ * @authors Alexei SYTOV
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Constructor.
+ * @param zones Kill-zone table of the thread.
+ */
+PlasmaMLPALLASKillZonesMessenger::PlasmaMLPALLASKillZonesMessenger(PlasmaMLPALLASKillZones *zones)
+    : G4UImessenger(), fZones(zones)
+{
+    fKillZoneDir = new G4UIdirectory("/PlasmaMLPALLAS/killzone/");
+    fKillZoneDir->SetGuidance("Kill zones of the lost particles UI commands");
+
+    /**
+     * @brief Command to add an aperture.
+     *
+     * Parameters: Name (string), Shape (string), YMin, YMax, HalfX, HalfZ (double), Unit (string)
+     */
+    G4String shapes;
+    for (const auto &name : PlasmaMLPALLASKillZones::GetShapeNames())
+        shapes += (shapes.empty() ? "" : " ") + name;
+
+    fAddApertureCmd = new G4UIcommand("/PlasmaMLPALLAS/killzone/addAperture", this);
+    fAddApertureCmd->SetGuidance("Kill the tracks outside an aperture between two positions along the beam axis (y):");
+    fAddApertureCmd->SetGuidance("  cylinder: sqrt(x^2 + z^2) > HalfX");
+    fAddApertureCmd->SetGuidance("  box: |x| > HalfX or |z| > HalfZ (HalfZ = HalfX if omitted)");
+    fAddApertureCmd->SetGuidance("An aperture with the same name is replaced; the name is the one of its counter.");
+    fAddApertureCmd->SetParameter(new G4UIparameter("Name", 's', false));
+    auto *shape = new G4UIparameter("Shape", 's', false);
+    shape->SetParameterCandidates(shapes);
+    fAddApertureCmd->SetParameter(shape);
+    fAddApertureCmd->SetParameter(new G4UIparameter("YMin", 'd', false));
+    fAddApertureCmd->SetParameter(new G4UIparameter("YMax", 'd', false));
+    auto *halfX = new G4UIparameter("HalfX", 'd', false);
+    halfX->SetParameterRange("HalfX>0.");
+    fAddApertureCmd->SetParameter(halfX);
+    auto *halfZ = new G4UIparameter("HalfZ", 'd', true);
+    halfZ->SetDefaultValue(-1.);
+    fAddApertureCmd->SetParameter(halfZ);
+    auto *unit = new G4UIparameter("Unit", 's', true);
+    unit->SetDefaultUnit("mm");
+    fAddApertureCmd->SetParameter(unit);
+    fAddApertureCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    /**
+     * @brief Command to kill the tracks moving backwards.
+     */
+    fBackwardCutCmd = new G4UIcmdWithADouble("/PlasmaMLPALLAS/killzone/setBackwardCut", this);
+    fBackwardCutCmd->SetGuidance("Kill the tracks whose direction cosine along y is below a value");
+    fBackwardCutCmd->SetGuidance("(0: any backward track, -1: no cut)");
+    fBackwardCutCmd->SetParameterName("MinDirectionY", false);
+    fBackwardCutCmd->SetRange("MinDirectionY>=-1. && MinDirectionY<=1.");
+    fBackwardCutCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    /**
+     * @brief Command to kill the tracks below a kinetic energy.
+     */
+    fMinEnergyCmd = new G4UIcmdWithADoubleAndUnit("/PlasmaMLPALLAS/killzone/setMinEnergy", this);
+    fMinEnergyCmd->SetGuidance("Kill the tracks below a kinetic energy (0 removes the cut)");
+    fMinEnergyCmd->SetParameterName("MinEnergy", false);
+    fMinEnergyCmd->SetRange("MinEnergy>=0.");
+    fMinEnergyCmd->SetUnitCategory("Energy");
+    fMinEnergyCmd->SetDefaultUnit("MeV");
+    fMinEnergyCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    /**
+     * @brief Command to select the tracks the cuts apply to.
+     */
+    fPrimariesOnlyCmd = new G4UIcmdWithABool("/PlasmaMLPALLAS/killzone/setPrimariesOnly", this);
+    fPrimariesOnlyCmd->SetGuidance("Apply the cuts to the primaries only (default) or to every track");
+    fPrimariesOnlyCmd->SetParameterName("PrimariesOnly", false);
+    fPrimariesOnlyCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    /**
+     * @brief Commands to remove and to print the cuts.
+     */
+    fClearCmd = new G4UIcmdWithoutParameter("/PlasmaMLPALLAS/killzone/clear", this);
+    fClearCmd->SetGuidance("Remove the apertures and the backward and energy cuts");
+    fClearCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fListCmd = new G4UIcmdWithoutParameter("/PlasmaMLPALLAS/killzone/list", this);
+    fListCmd->SetGuidance("Print the cuts and the kills of the last run");
+    fListCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Destructor.
+ */
+PlasmaMLPALLASKillZonesMessenger::~PlasmaMLPALLASKillZonesMessenger()
+{
+    delete fAddApertureCmd;
+    delete fBackwardCutCmd;
+    delete fMinEnergyCmd;
+    delete fPrimariesOnlyCmd;
+    delete fClearCmd;
+    delete fListCmd;
+    delete fKillZoneDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASKillZonesMessenger::SetNewValue(G4UIcommand *aCommand, G4String aNewValue)
+{
+    if (aCommand == fAddApertureCmd)
+    {
+        std::istringstream is(aNewValue);
+        G4String shape, unit;
+        G4double halfZ = -1.;
+        PlasmaMLPALLASKillZones::Aperture aperture;
+        is >> aperture.name >> shape >> aperture.yMin >> aperture.yMax >> aperture.halfX >> halfZ >> unit;
+
+        const auto &names = PlasmaMLPALLASKillZones::GetShapeNames();
+        aperture.shape = static_cast<PlasmaMLPALLASKillZones::Shape>(std::find(names.begin(), names.end(), shape) - names.begin());
+        if (halfZ <= 0.)
+            halfZ = aperture.halfX;
+
+        const G4double scale = G4UIcommand::ValueOf(unit);
+        aperture.yMin *= scale;
+        aperture.yMax *= scale;
+        aperture.halfX *= scale;
+        aperture.halfZ = halfZ * scale;
+        if (aperture.yMax < aperture.yMin)
+            std::swap(aperture.yMin, aperture.yMax);
+        fZones->AddAperture(aperture);
+    }
+    else if (aCommand == fBackwardCutCmd)
+        fZones->SetBackwardCut(fBackwardCutCmd->GetNewDoubleValue(aNewValue));
+    else if (aCommand == fMinEnergyCmd)
+        fZones->SetMinEnergy(fMinEnergyCmd->GetNewDoubleValue(aNewValue));
+    else if (aCommand == fPrimariesOnlyCmd)
+        fZones->SetPrimariesOnly(fPrimariesOnlyCmd->GetNewBoolValue(aNewValue));
+    else if (aCommand == fClearCmd)
+        fZones->Clear();
+    else if (aCommand == fListCmd)
+        fZones->Print();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PlasmaMLPALLASKillZonesMessenger::GetCurrentValue(G4UIcommand *aCommand)
+{
+    G4String cv;
+
+    if (aCommand == fAddApertureCmd)
+    {
+        std::ostringstream os;
+        for (const auto &aperture : fZones->GetApertures())
+            os << (os.tellp() > 0 ? ", " : "") << aperture.name;
+        cv = os.str();
+    }
+    else if (aCommand == fBackwardCutCmd)
+        cv = fBackwardCutCmd->ConvertToString(fZones->GetBackwardCut());
+    else if (aCommand == fMinEnergyCmd)
+        cv = fMinEnergyCmd->ConvertToString(fZones->GetMinEnergy(), "MeV");
+    else if (aCommand == fPrimariesOnlyCmd)
+        cv = fPrimariesOnlyCmd->ConvertToString(fZones->GetPrimariesOnly());
+
+    return cv;
+}
@@ -0,0 +1,147 @@
+/**
+ * @file PlasmaMLPALLASLinearOptics.cc
+ * @brief Implementation of the thick-lens transport through the quadrupole lattice.
+ *
+ * Each transverse plane is carried with the 2x2 thick-lens matrix of its
+ * strength (focusing, defocusing or drift) in the slopes x' = dx/dy and
+ * z' = dz/dy. The aperture is checked on the envelope of the trajectory in
+ * each quadrupole: the amplitude of the oscillation in a focusing plane, the
+ * larger end otherwise.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASLinearOptics.hh"
+#include "PlasmaMLPALLASMagneticField.hh"
+#include "CLHEP/Units/PhysicalConstants.h"
+#include <algorithm>
+#include <cmath>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+    /**
+     * @brief Thick-lens transport of one plane, x'' = -k x over a length.
+     * @param x Position, updated
+     * @param xp Slope, updated
+     * @param k Strength (1/mm^2, positive when focusing)
+     * @param length Length of the element
+     * @return Largest |x| reached inside the element
+     */
+    G4double ThickLens(G4double& x, G4double& xp, G4double k, G4double length)
+    {
+        const G4double x0 = x;
+        if (k > 0.)
+        {
+            const G4double w = std::sqrt(k);
+            const G4double c = std::cos(w * length), s = std::sin(w * length);
+            const G4double amplitude = std::hypot(x0, xp / w);
+            x = x0 * c + xp * s / w;
+            xp = -x0 * w * s + xp * c;
+            return amplitude;
+        }
+        if (k < 0.)
+        {
+            const G4double w = std::sqrt(-k);
+            const G4double c = std::cosh(w * length), s = std::sinh(w * length);
+            x = x0 * c + xp * s / w;
+            xp = x0 * w * s + xp * c;
+        }
+        else
+            x = x0 + xp * length;
+
+        return std::max(std::abs(x0), std::abs(x));
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASLinearOptics::PlasmaMLPALLASLinearOptics(const PlasmaMLPALLASMagneticField* field,
+                                                       std::vector<G4double> volumeHalfWidths)
+    : fField(field), fVolumeHalfWidths(std::move(volumeHalfWidths))
+{
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Transport a particle to the hand-off plane
+ * @param position Global start position
+ * @param direction Unit momentum direction
+ * @param charge Charge (eplus)
+ * @param momentum Momentum magnitude
+ * @param result Output crossings and final state
+ * @return False if Geant4 must track the particle instead
+ */
+G4bool PlasmaMLPALLASLinearOptics::Transport(const G4ThreeVector& position, const G4ThreeVector& direction,
+                                             G4double charge, G4double momentum, Result& result) const
+{
+    const std::vector<LatticeElement>& lattice = fField->GetLattice();
+    if (lattice.empty() || direction.y() <= 0. || momentum <= 0. ||
+        position.y() > lattice.front().begin + StartTolerance)
+        return false;
+
+    G4double x = position.x(), y = position.y(), z = position.z();
+    G4double xp = direction.x() / direction.y(), zp = direction.z() / direction.y();
+
+    result.crossings.clear();
+    result.pathLength = 0.;
+
+    const auto record = [&](size_t index, G4bool begin) {
+        Crossing crossing;
+        crossing.index = index;
+        crossing.begin = begin;
+        crossing.position.set(x, y, z);
+        crossing.direction = G4ThreeVector(xp, 1., zp).unit();
+        result.crossings.push_back(crossing);
+    };
+
+    const auto drift = [&](G4double to) {
+        const G4double length = to - y;
+        x += xp * length;
+        z += zp * length;
+        result.pathLength += length * std::sqrt(1. + xp * xp + zp * zp);
+        y = to;
+    };
+
+    // Inside the field aperture and, for Q1..Q4, inside the volume (square rotated by 45 degrees)
+    const auto inside = [&](size_t index, G4double ax, G4double az) {
+        if (ax >= QuadrupoleHalfAperture || az >= QuadrupoleHalfAperture)
+            return false;
+        return index >= fVolumeHalfWidths.size() || ax + az < fVolumeHalfWidths[index] * std::sqrt(2.);
+    };
+
+    for (const LatticeElement& element : lattice)
+    {
+        if (element.begin < y - StartTolerance)
+            return false;  // overlapping elements
+
+        drift(element.begin);
+        if (!inside(element.index, std::abs(x), std::abs(z)))
+            return false;
+        record(element.index, true);
+
+        // x'' = (q c / p) Bz = -k x and z'' = -(q c / p) Bx = -k z
+        const G4double k = charge * CLHEP::c_light * element.gradient / momentum;
+        const G4double length = element.end - element.begin;
+        const G4double slope2 = xp * xp + zp * zp;
+        const G4double ax = ThickLens(x, xp, k, length);
+        const G4double az = ThickLens(z, zp, k, length);
+        if (!inside(element.index, ax, az))
+            return false;
+
+        result.pathLength += length * std::sqrt(1. + 0.5 * (slope2 + xp * xp + zp * zp));
+        y = element.end;
+        record(element.index, false);
+    }
+
+    drift(y + HandOffDistance);
+    result.position.set(x, y, z);
+    result.direction = G4ThreeVector(xp, 1., zp).unit();
+
+    return true;
+}
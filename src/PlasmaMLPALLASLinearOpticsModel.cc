@@ -0,0 +1,113 @@
+/**
+ * @file PlasmaMLPALLASLinearOpticsModel.cc
+ * @brief Implementation of the linear-optics fast simulation model.
+ *
+ * The transport is computed in ModelTrigger, so that a refused particle is
+ * left to Geant4 without side effect, and applied in DoIt. The track is
+ * suspended by the fast simulation process after DoIt and relocated from its
+ * new position when it resumes.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASLinearOpticsModel.hh"
+#include "PlasmaMLPALLASGeometryConstruction.hh"
+#include "PlasmaMLPALLASEventAction.hh"
+#include "G4EventManager.hh"
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4Track.hh"
+#include "G4ParticleDefinition.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASLinearOpticsModel::PlasmaMLPALLASLinearOpticsModel(const G4String& name, G4Region* envelope,
+                                                                 const PlasmaMLPALLASMagneticField* field,
+                                                                 std::vector<G4double> volumeHalfWidths,
+                                                                 const PlasmaMLPALLASGeometryConstruction* geometry)
+    : G4VFastSimulationModel(name, envelope), fOptics(field, std::move(volumeHalfWidths)), fGeometry(geometry)
+{
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PlasmaMLPALLASLinearOpticsModel::IsApplicable(const G4ParticleDefinition& particle)
+{
+    return particle.GetPDGCharge() != 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Select the primaries handled by the matrices
+ * @param fastTrack Track in the envelope
+ * @return True if the mode is on and the transport through the lattice succeeded
+ */
+G4bool PlasmaMLPALLASLinearOpticsModel::ModelTrigger(const G4FastTrack& fastTrack)
+{
+    if (fGeometry->GetStatusLinearOptics() == 0)
+        return false;
+
+    const G4Track* track = fastTrack.GetPrimaryTrack();
+    if (track->GetParentID() != 0)
+        return false;
+
+    const G4DynamicParticle* particle = track->GetDynamicParticle();
+    return fOptics.Transport(track->GetPosition(), track->GetMomentumDirection(),
+                             particle->GetCharge(), particle->GetTotalMomentum(), fResult);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Fill the quadrupole tallies and move the primary to the hand-off plane
+ * @param fastTrack Track in the envelope
+ * @param fastStep Final state of the track
+ */
+void PlasmaMLPALLASLinearOpticsModel::DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep)
+{
+    const G4Track* track = fastTrack.GetPrimaryTrack();
+    auto evtac = static_cast<PlasmaMLPALLASEventAction *>(G4EventManager::GetEventManager()->GetUserEventAction());
+    auto &stats = evtac->GetStatsQuadrupoles(track->GetTrackID());
+
+    // Same values as the quadrupole detector, which skips this step: positions in mm,
+    // unit momentum direction, and the kinetic energy at the entrance of Q1
+    if (!fResult.crossings.empty() && fResult.crossings.front().index == 0)
+        stats.energy = track->GetKineticEnergy() / CLHEP::MeV;
+
+    for (const auto &crossing : fResult.crossings)
+    {
+        if (crossing.index >= 4)
+            continue;  // field-only quadrupoles have no tally
+
+        const QuadID quad = static_cast<QuadID>(crossing.index + 1);
+        const PositionType posType = crossing.begin ? PositionType::Begin : PositionType::End;
+        const G4ThreeVector position = crossing.position / CLHEP::mm;
+
+        SetQuadrupoleValue(stats, quad, posType, VectorType::Position, Axis::X, position.x());
+        SetQuadrupoleValue(stats, quad, posType, VectorType::Position, Axis::Y, position.y());
+        SetQuadrupoleValue(stats, quad, posType, VectorType::Position, Axis::Z, position.z());
+        SetQuadrupoleValue(stats, quad, posType, VectorType::Momentum, Axis::X, crossing.direction.x());
+        SetQuadrupoleValue(stats, quad, posType, VectorType::Momentum, Axis::Y, crossing.direction.y());
+        SetQuadrupoleValue(stats, quad, posType, VectorType::Momentum, Axis::Z, crossing.direction.z());
+    }
+
+    if (fGeometry->GetStatusLinearOptics() == 2)
+    {
+        fastStep.KillPrimaryTrack();
+        fastStep.ProposePrimaryTrackPathLength(fResult.pathLength);
+        return;
+    }
+
+    // No energy loss in vacuum: only the position, direction and times change
+    const G4double flightTime = fResult.pathLength / track->GetVelocity();
+    fastStep.ProposePrimaryTrackFinalPosition(fResult.position, false);
+    fastStep.ProposePrimaryTrackFinalMomentumDirection(fResult.direction, false);
+    fastStep.ProposePrimaryTrackPathLength(fResult.pathLength);
+    fastStep.ProposePrimaryTrackFinalTime(track->GetGlobalTime() + flightTime);
+    fastStep.ProposePrimaryTrackFinalProperTime(
+        track->GetProperTime() + flightTime * track->GetDynamicParticle()->GetMass() / track->GetTotalEnergy());
+}
@@ -0,0 +1,216 @@
+/**
+ * @file PlasmaMLPALLASMPIDriver.cc
+ * @brief Implementation of the jobs shared by the MPI ranks of an allocation.
+ *
+ * The chunk counter is a single integer in a window of rank 0: every rank
+ * takes its next chunk with MPI_Fetch_and_op under a shared passive-target
+ * lock, so the counter is only touched between two runs, never during the
+ * event loop. The Geant4 threads of a rank never call MPI (MPI_THREAD_FUNNELED).
+ *
+ * Each chunk is seeded with the pair (seed of the job, chunk index + 1) and
+ * starts its events at chunk index x chunk size in the job, so the chunk
+ * files are the same whatever the number of ranks and the order they were
+ * taken in.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASMPIDriver.hh"
+#include "PlasmaMLPALLASMPIMessenger.hh"
+#include "PlasmaMLPALLASOutputManager.hh"
+#include "PlasmaMLPALLASScanDriver.hh"
+#include "PlasmaMLPALLASOptimiser.hh"
+#include "PlasmaMLPALLASCheckpoint.hh"
+#include "G4RunManager.hh"
+#include "G4Run.hh"
+#include "G4UImanager.hh"
+#include "Randomize.hh"
+#include "G4ios.hh"
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <vector>
+
+#ifdef PLASMAMLPALLAS_WITH_MPI
+#include <mpi.h>
+#endif
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASMPIDriver& PlasmaMLPALLASMPIDriver::Instance()
+{
+    static PlasmaMLPALLASMPIDriver instance;
+    return instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASMPIDriver::PlasmaMLPALLASMPIDriver()
+{
+    fMessenger = new PlasmaMLPALLASMPIMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASMPIDriver::~PlasmaMLPALLASMPIDriver()
+{
+    delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASMPIDriver::Initialize(int* argc, char*** argv)
+{
+#ifdef PLASMAMLPALLAS_WITH_MPI
+    if (fInitialized)
+        return;
+    int provided = 0;
+    MPI_Init_thread(argc, argv, MPI_THREAD_FUNNELED, &provided);
+    MPI_Comm_rank(MPI_COMM_WORLD, &fRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &fSize);
+    fInitialized = true;
+#else
+    (void)argc;
+    (void)argv;
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASMPIDriver::Finalize()
+{
+#ifdef PLASMAMLPALLAS_WITH_MPI
+    if (fInitialized)
+        MPI_Finalize();
+#endif
+    fInitialized = false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Run a job of N events shared by all the ranks
+ * @param nEvents Number of events of the whole job
+ *
+ * A rank whose chunk ends before all its events (/run/abort) stops taking
+ * chunks; the job is then incomplete and rank 0 keeps the chunk files
+ * instead of merging them.
+ */
+void PlasmaMLPALLASMPIDriver::Run(G4long nEvents)
+{
+    if (fRunning || PlasmaMLPALLASScanDriver::Instance().IsRunning() || PlasmaMLPALLASOptimiser::Instance().IsRunning() ||
+        PlasmaMLPALLASCheckpoint::Instance().IsRunning())
+    {
+        G4Exception("PlasmaMLPALLASMPIDriver::Run", "MPI0001", JustWarning,
+                    "A distributed job cannot run within a scan, an optimisation or another job.");
+        return;
+    }
+
+    PlasmaMLPALLASOutputManager& output = PlasmaMLPALLASOutputManager::Instance();
+    const G4long nChunks = (nEvents + fChunkEvents - 1) / fChunkEvents;
+
+    // Seed of the job, the same on every rank
+    long seed = fSeed > 0 ? fSeed : static_cast<long>(time(NULL));
+
+#ifdef PLASMAMLPALLAS_WITH_MPI
+    MPI_Bcast(&seed, 1, MPI_LONG, 0, MPI_COMM_WORLD);
+
+    // Counter of the chunks handed out, in the memory of rank 0
+    long* counter = nullptr;
+    MPI_Win window;
+    MPI_Win_allocate(fRank == 0 ? sizeof(long) : 0, sizeof(long), MPI_INFO_NULL, MPI_COMM_WORLD, &counter, &window);
+    if (fRank == 0)
+    {
+        MPI_Win_lock(MPI_LOCK_EXCLUSIVE, 0, 0, window);
+        *counter = 0;
+        MPI_Win_unlock(0, window);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    auto nextChunk = [&window]()
+    {
+        long one = 1, chunk = 0;
+        MPI_Win_lock(MPI_LOCK_SHARED, 0, 0, window);
+        MPI_Fetch_and_op(&one, &chunk, MPI_LONG, 0, 0, MPI_SUM, window);
+        MPI_Win_unlock(0, window);
+        return static_cast<G4long>(chunk);
+    };
+#else
+    G4long counter = 0;
+    auto nextChunk = [&counter]() { return counter++; };
+#endif
+
+    G4UImanager* UI = G4UImanager::GetUIpointer();
+    G4long eventsDone = 0;
+    fRunning = true;
+
+    for (G4long chunk = nextChunk(); chunk < nChunks; chunk = nextChunk())
+    {
+        const G4long first = chunk * fChunkEvents;
+        const G4long n = std::min<G4long>(fChunkEvents, nEvents - first);
+        fEventOffset = first;
+        output.SetChunkIndex(static_cast<G4int>(chunk));
+
+        const long seeds[3] = {seed, static_cast<long>(chunk + 1), 0};
+        G4Random::setTheSeeds(seeds);
+
+        G4cout << "### Rank " << fRank << "/" << fSize << " chunk " << chunk << " : events " << first << " to "
+               << first + n - 1 << " of " << nEvents << G4endl;
+        UI->ApplyCommand("/run/beamOn " + std::to_string(n));
+
+        const G4Run* run = G4RunManager::GetRunManager()->GetCurrentRun();
+        if (!run || run->GetNumberOfEvent() < n)
+        {
+            G4Exception("PlasmaMLPALLASMPIDriver::Run", "MPI0002", JustWarning,
+                        "Chunk not completed: this rank stops taking chunks.");
+            break;
+        }
+        eventsDone += n;
+    }
+
+    output.SetChunkIndex(-1);
+    fRunning = false;
+    fEventOffset = 0;
+    fHasRun = true;
+
+    G4long eventsTotal = eventsDone;
+#ifdef PLASMAMLPALLAS_WITH_MPI
+    MPI_Win_free(&window);
+    long events = eventsDone, total = 0;
+    MPI_Allreduce(&events, &total, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+    eventsTotal = total;
+#endif
+
+    // Rank 0 writes the output file of the job from the chunk files of all the ranks
+    if (fRank != 0)
+        return;
+
+    std::vector<G4String> files;
+    for (G4long chunk = 0; chunk < nChunks; ++chunk)
+    {
+        output.SetChunkIndex(static_cast<G4int>(chunk));
+        files.push_back(output.GetOutputPath(fOutputName));
+    }
+    output.SetChunkIndex(-1);
+
+    if (eventsTotal < nEvents)
+    {
+        G4ExceptionDescription msg;
+        msg << "Only " << eventsTotal << " of the " << nEvents << " events were simulated: the " << nChunks
+            << " chunk files are kept, not merged.";
+        G4Exception("PlasmaMLPALLASMPIDriver::Run", "MPI0003", JustWarning, msg);
+        return;
+    }
+
+    if (output.MergeFiles(files, fOutputName))
+    {
+        std::error_code ec;
+        for (const G4String& file : files)
+            std::filesystem::remove(file.c_str(), ec);
+        G4cout << "### Job of " << nEvents << " events on " << fSize << " ranks merged into "
+               << output.GetOutputPath(fOutputName) << G4endl;
+    }
+}
@@ -0,0 +1,104 @@
+#include "PlasmaMLPALLASMPIMessenger.hh"
+#include "PlasmaMLPALLASMPIDriver.hh"
+
+/**
+ * @file PlasmaMLPALLASMPIMessenger.cc
+ * @brief User interface (UI) messenger for the jobs shared by MPI ranks.
+ *
+ * Commands are organized in the /PlasmaMLPALLAS/mpi/ directory and allow users to:
+ *  - Set the number of events of the chunks handed out to the ranks.
+ *  - Set the seed of the job.
+ *  - Run the job on all the ranks.
+ *
+ * @authors Arnaud HUBER
+ * @authors Alexei SYTOV
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Constructor.
+ * @param driver Pointer to the MPI driver.
+ */
+PlasmaMLPALLASMPIMessenger::PlasmaMLPALLASMPIMessenger(PlasmaMLPALLASMPIDriver *driver)
+    : G4UImessenger(), fDriver(driver)
+{
+    fMPIDir = new G4UIdirectory("/PlasmaMLPALLAS/mpi/");
+    fMPIDir->SetGuidance("Jobs shared by the MPI ranks UI commands");
+
+    /**
+     * @brief Command to set the number of events of each chunk.
+     */
+    fSetChunkEventsCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/mpi/setChunkEvents", this);
+    fSetChunkEventsCmd->SetGuidance("Events of each chunk taken by a rank (one run and one closed file per chunk)");
+    fSetChunkEventsCmd->SetGuidance("Smaller chunks balance the ranks better, larger ones cost fewer runs");
+    fSetChunkEventsCmd->SetParameterName("Events", false);
+    fSetChunkEventsCmd->SetRange("Events>=1");
+    fSetChunkEventsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fSetChunkEventsCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the seed of the job.
+     */
+    fSetSeedCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/mpi/setSeed", this);
+    fSetSeedCmd->SetGuidance("Seed of the job, combined with the chunk index to seed each chunk");
+    fSetSeedCmd->SetGuidance("0 (default): drawn from the clock of rank 0");
+    fSetSeedCmd->SetParameterName("Seed", false);
+    fSetSeedCmd->SetRange("Seed>=0");
+    fSetSeedCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fSetSeedCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to run the job on all the ranks.
+     *
+     * Parameter: NEvents (integer, events of the whole job)
+     */
+    fBeamOnCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/mpi/beamOn", this);
+    fBeamOnCmd->SetGuidance("Simulate NEvents on all the ranks, in chunks of setChunkEvents events taken on demand");
+    fBeamOnCmd->SetGuidance("Collective: every rank must execute it; rank 0 merges the chunk files into the output file");
+    fBeamOnCmd->SetParameterName("NEvents", false);
+    fBeamOnCmd->SetRange("NEvents>=1");
+    fBeamOnCmd->AvailableForStates(G4State_Idle);
+    fBeamOnCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Destructor.
+ */
+PlasmaMLPALLASMPIMessenger::~PlasmaMLPALLASMPIMessenger()
+{
+    delete fSetChunkEventsCmd;
+    delete fSetSeedCmd;
+    delete fBeamOnCmd;
+    delete fMPIDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASMPIMessenger::SetNewValue(G4UIcommand *aCommand, G4String aNewValue)
+{
+    if (aCommand == fSetChunkEventsCmd)
+        fDriver->SetChunkEvents(fSetChunkEventsCmd->GetNewIntValue(aNewValue));
+    else if (aCommand == fSetSeedCmd)
+        fDriver->SetSeed(fSetSeedCmd->GetNewIntValue(aNewValue));
+    else if (aCommand == fBeamOnCmd)
+        fDriver->Run(fBeamOnCmd->GetNewIntValue(aNewValue));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PlasmaMLPALLASMPIMessenger::GetCurrentValue(G4UIcommand *aCommand)
+{
+    G4String cv;
+
+    if (aCommand == fSetChunkEventsCmd)
+        cv = fSetChunkEventsCmd->ConvertToString(fDriver->GetChunkEvents());
+    else if (aCommand == fSetSeedCmd)
+        cv = fSetSeedCmd->ConvertToString(static_cast<G4int>(fDriver->GetSeed()));
+
+    return cv;
+}
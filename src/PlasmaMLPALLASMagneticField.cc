@@ -21,8 +21,18 @@
  *  - symmetrizedFunctionS(): Reflects fitFunction about x0 = 3.4495 for S-axis symmetry.
  *
  * Magnetic field computation:
- *  - Uses dipole field or mapped-field mode depending on StatusMapBField.
- *  - Adds quadrupole contributions according to the configured gradients, lengths, and drifts.
+ *  - Uses dipole field, fitted-profile or 3D map mode depending on StatusMapBField.
+ *  - The constant dipole is a hard-edged box; the mapped-field mode evaluates
+ *    the Y and S fits, tabulated once on regular 0.1 mm grids shared by all
+ *    threads, with a linear interpolation (no ROOT function call per step);
+ *    the 3D map mode interpolates a measured map mapped once per process.
+ *  - Quadrupoles come first: the lattice is rebuilt and sorted whenever a
+ *    gradient, length or drift is set, and a bisection on y finds the
+ *    element, if any.
+ *  - Every source has a bounding box, rebuilt with the lattice and the dipole
+ *    model: points outside all boxes get a zero field at once, and the box
+ *    of the last hit (or the field-free slab of the last drift) is tested
+ *    first, so consecutive substeps in the same element skip the search.
  *
  * This implementation is compatible with Geant4 and CLHEP units.
  *
@@ -35,7 +45,65 @@
 
 #include "PlasmaMLPALLASMagneticField.hh"
 #include "TMath.h"
-#include "TF1.h"
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    /// Fit parameters of the dipole profile across the gap (positions in m, field in T)
+    constexpr std::array<G4double, 7> kFitParamsY = {-1.05579 + 1.15, -0.985, -1.03649 + 1.15, 0.0307999, 721.501, -1.58778 + 1.15, 0.141887};
+
+    /// Fit parameters of the dipole profile along the beam (positions in m)
+    constexpr std::array<G4double, 7> kFitParamsS = {0.169992 + 3.4495, -0.806796, 0.193481 + 3.4495, 0.0405178, 1.9817, 0.0119007 + 3.4495, 0.0946281};
+
+    /// Grid spacing of the tabulated profiles (mm)
+    constexpr G4double kProfileStep = 0.1;
+
+    /**
+     * @brief Analytic dipole profile across the gap
+     * @param z Position in mm
+     */
+    G4double AnalyticProfileY(G4double z)
+    {
+        std::array<G4double, 7> par = kFitParamsY;
+        G4double x = z / 1000;
+        return symmetrizedFunctionY(&x, par.data());
+    }
+
+    /**
+     * @brief Analytic dipole profile along the beam
+     * @param y Position in mm
+     */
+    G4double AnalyticProfileS(G4double y)
+    {
+        std::array<G4double, 7> par = kFitParamsS;
+        G4double x = y / 1000;
+        return symmetrizedFunctionS(&x, par.data());
+    }
+
+    /**
+     * @brief Tabulated profile across the gap, built on first use.
+     *
+     * The fit is below 1e-6 T beyond |z| = 500 mm.
+     */
+    const PlasmaMLPALLASFieldProfile &DipoleProfileY()
+    {
+        static const PlasmaMLPALLASFieldProfile profile(-500., 500., kProfileStep, AnalyticProfileY);
+        return profile;
+    }
+
+    /**
+     * @brief Tabulated profile along the beam, built on first use.
+     *
+     * The range is symmetric around the dipole centre (3449.5 mm), where the
+     * fit is below 1e-6.
+     */
+    const PlasmaMLPALLASFieldProfile &DipoleProfileS()
+    {
+        static const PlasmaMLPALLASFieldProfile profile(2899., 4000., kProfileStep, AnalyticProfileS);
+        return profile;
+    }
+}
 
 //--------------------------------------
 // Constructor / Destructor
@@ -43,8 +111,14 @@
 
 /**
  * @brief Default constructor.
+ *
+ * Binds the tabulated dipole profiles. They are built once by the first field
+ * created (in ConstructSDandField) and then shared read-only by all threads.
  */
-PlasmaMLPALLASMagneticField::PlasmaMLPALLASMagneticField() {}
+PlasmaMLPALLASMagneticField::PlasmaMLPALLASMagneticField()
+    : fProfileS(DipoleProfileS()), fProfileY(DipoleProfileY())
+{
+}
 
 /**
  * @brief Destructor.
@@ -140,74 +214,330 @@ G4double symmetrizedFunctionS(G4double *x, G4double *par)
 void PlasmaMLPALLASMagneticField::GetFieldValue(const G4double point[4], G4double *bField) const
 {
     G4double x = point[0];
-    G4double y = point[1];
     G4double z = point[2];
 
     bField[0] = 0.;
     bField[1] = 0.;
     bField[2] = 0.;
 
-    if (!StatusMapBField)
+    // Consecutive substeps usually stay in the same source: no search then
+    const FieldBox *box = fLastBox;
+    if (!box || !box->Contains(point))
+    {
+        box = FindBox(point);
+        if (box)
+            fLastBox = box->exclusive ? box : nullptr;
+        else
+            fLastBox = FindDriftSlab(point[1]);
+    }
+
+    // Field-free outside every source
+    if (!box || !box->field)
     {
-        // Constant dipole approximation
-        static TF1 ConstantS("ConstantS", "x > 3270 && x < 3599 ? 1 : 0", 3100, 3800);
-        static TF1 ConstantY("ConstantY", "x > -150 && x < 150 ? 1 : 0", -1000, 1000);
+        if (fStatistics)
+            ++fStatistics->fieldCalls[PlasmaMLPALLASFieldStatistics::kDrift];
+        return;
+    }
+
+    // Quadrupoles override the dipole model inside their aperture
+    if (const LatticeElement *quad = box->quad)
+    {
+        bField[0] = quad->gradient * (z * CLHEP::mm);
+        bField[2] = -quad->gradient * (x * CLHEP::mm);
+        if (fStatistics)
+            ++fStatistics->fieldCalls[quad->index < NumQuadrupoles ? PlasmaMLPALLASFieldStatistics::kQ1 + quad->index
+                                                                   : PlasmaMLPALLASFieldStatistics::kQExtra];
+        return;
+    }
 
-        bField[0] = -ConstantDipoleBField * ConstantS.Eval(y) * ConstantY.Eval(z);
+    if (StatusMapBField == 0)
+    {
+        // Constant dipole approximation with hard edges (the box itself)
+        bField[0] = -ConstantDipoleBField;
+    }
+    else if (StatusMapBField == 1 || !fFieldMap)
+    {
+        // Field map mode using the tabulated fitted profiles
+        bField[0] = -fProfileY.Value(z) * fProfileS.Value(point[1]) * CLHEP::tesla;
     }
     else
     {
-        // Field map mode using fitted functions
-        static TF1 fitFuncY("fitFuncY", symmetrizedFunctionY, -0.15, 0.15, 7);
-        static TF1 fitFuncS("fitFuncS", symmetrizedFunctionS, 3.0995, 3.7995, 7);
+        // Measured 3D map, all three components
+        fFieldMap->GetValue(point, bField);
+    }
 
-        static bool paramsInitialized = false;
-        if (!paramsInitialized)
-        {
-            fitFuncY.SetParameters(-1.05579 + 1.15, -0.985, -1.03649 + 1.15, 0.0307999, 721.501, -1.58778 + 1.15, 0.141887);
-            fitFuncS.SetParameters(0.169992 + 3.4495, -0.806796, 0.193481 + 3.4495, 0.0405178, 1.9817, 0.0119007 + 3.4495, 0.0946281);
-            paramsInitialized = true;
-        }
+    if (fStatistics)
+    {
+        const G4bool inField = bField[0] != 0. || bField[1] != 0. || bField[2] != 0.;
+        ++fStatistics->fieldCalls[inField ? PlasmaMLPALLASFieldStatistics::kDipole : PlasmaMLPALLASFieldStatistics::kDrift];
+    }
+}
 
-        bField[0] = -fitFuncY.Eval(z / 1000) * fitFuncS.Eval(y / 1000) * CLHEP::tesla;
+/**
+ * @brief Find the source containing a point.
+ *
+ * The quadrupoles come first (aperture test and bisection on y), then the
+ * dipole box. Outside the quadrupole aperture the dipole model applies at
+ * any y, as it did before the lattice was introduced.
+ *
+ * @param point Position [x, y, z] (mm)
+ * @return Box of the source, or nullptr outside every source
+ */
+const FieldBox *PlasmaMLPALLASMagneticField::FindBox(const G4double point[3]) const
+{
+    if (std::abs(point[0]) < QuadrupoleHalfAperture && std::abs(point[2]) < QuadrupoleHalfAperture)
+    {
+        if (const LatticeElement *quad = FindQuadrupole(point[1]))
+            return &fBoxes[quad - fLattice.data()];
     }
 
-    // Quadrupole contributions
-    G4double Q1_begin = qdrift[0];
-    G4double Q1_end = Q1_begin + qlength[0];
-    G4double Q2_begin = Q1_end + qdrift[1];
-    G4double Q2_end = Q2_begin + qlength[1];
-    G4double Q3_begin = Q2_end + qdrift[2];
-    G4double Q3_end = Q3_begin + qlength[2];
-    G4double Q4_begin = Q3_end + qdrift[3];
-    G4double Q4_end = Q4_begin + qlength[3];
-
-    if (x > -20 && x < 20 && z > -20 && z < 20)
+    if (fBoxes.size() > fLattice.size() && fBoxes.back().Contains(point))
+        return &fBoxes.back();
+
+    return nullptr;
+}
+
+/**
+ * @brief Field-free slab along y around a point outside every source.
+ *
+ * The slab runs from the last source ending before y to the first one
+ * starting after it, over all x and z.
+ *
+ * @param y Position along the beam axis (mm)
+ * @return The slab, or nullptr if a source spans y
+ */
+const FieldBox *PlasmaMLPALLASMagneticField::FindDriftSlab(G4double y) const
+{
+    constexpr G4double inf = std::numeric_limits<G4double>::infinity();
+
+    G4double begin = -inf, end = inf;
+    for (const FieldBox &box : fBoxes)
     {
-        if (y > Q1_begin && y < Q1_end)
-        {
-            bField[0] = gradients[0]*(z*CLHEP::mm);
-            bField[2] = -gradients[0]*(x*CLHEP::mm);
-        }
+        if (box.max[1] <= y)
+            begin = std::max(begin, box.max[1]);
+        else if (box.min[1] > y)
+            end = std::min(end, box.min[1]);
+        else
+            return nullptr;
+    }
 
-        if (y > Q2_begin && y < Q2_end)
+    fDriftSlab.min = {-inf, begin, -inf};
+    fDriftSlab.max = {inf, end, inf};
+    fDriftSlab.field = false;
+    return &fDriftSlab;
+}
+
+//--------------------------------------
+// Lattice
+//--------------------------------------
+
+/**
+ * @brief Make room for a quadrupole index in the parameter arrays.
+ * @param index Quadrupole index (0-based)
+ */
+void PlasmaMLPALLASMagneticField::Reserve(size_t index)
+{
+    if (index < gradients.size())
+        return;
+
+    gradients.resize(index + 1, 0.);
+    qlength.resize(index + 1, 0.);
+    qdrift.resize(index + 1, 0.);
+}
+
+/**
+ * @brief Rebuild the lattice from the drifts, lengths and gradients.
+ *
+ * Each quadrupole starts one drift after the exit of the previous one. The
+ * elements are sorted by entrance, so that FindQuadrupole is a bisection;
+ * quadrupoles of zero length never hold a point and are skipped.
+ */
+void PlasmaMLPALLASMagneticField::UpdateLattice()
+{
+    fLattice.clear();
+
+    G4double position = 0.;
+    for (size_t i = 0; i < gradients.size(); ++i)
+    {
+        LatticeElement element;
+        element.begin = position + qdrift[i];
+        element.end = element.begin + qlength[i];
+        element.gradient = gradients[i];
+        element.index = i;
+        position = element.end;
+
+        if (element.end > element.begin)
+            fLattice.push_back(element);
+    }
+
+    std::stable_sort(fLattice.begin(), fLattice.end(),
+                     [](const LatticeElement &a, const LatticeElement &b) { return a.begin < b.begin; });
+
+    UpdateBoxes();
+}
+
+/**
+ * @brief Rebuild the bounding boxes of the field sources.
+ *
+ * One box per quadrupole (aperture in x and z, length in y) in lattice
+ * order, then the box of the dipole model: the hard edges of the constant
+ * dipole, the tabulated range of the fitted profiles (any x), or the grid of
+ * the 3D map. The dipole box is exclusive unless a quadrupole overlaps it.
+ * The last-hit cache points into the old boxes, so it is cleared.
+ */
+void PlasmaMLPALLASMagneticField::UpdateBoxes()
+{
+    constexpr G4double inf = std::numeric_limits<G4double>::infinity();
+
+    fBoxes.clear();
+    fLastBox = nullptr;
+
+    for (const LatticeElement &element : fLattice)
+    {
+        FieldBox box;
+        box.min = {-QuadrupoleHalfAperture, element.begin, -QuadrupoleHalfAperture};
+        box.max = {QuadrupoleHalfAperture, element.end, QuadrupoleHalfAperture};
+        box.quad = &element;
+        fBoxes.push_back(box);
+    }
+
+    FieldBox dipole;
+    if (StatusMapBField == 0)
+    {
+        // Open box 3270 < y < 3599, |z| < 150
+        dipole.min = {-inf, std::nextafter(3270., inf), std::nextafter(-150., inf)};
+        dipole.max = {inf, 3599., 150.};
+    }
+    else
+    {
+        if (StatusMapBField == 1 || !fFieldMap)
         {
-            bField[0] = gradients[1]*(z*CLHEP::mm);
-            bField[2] = -gradients[1]*(x*CLHEP::mm);
+            dipole.min = {-inf, fProfileS.GetMin(), fProfileY.GetMin()};
+            dipole.max = {inf, fProfileS.GetMax(), fProfileY.GetMax()};
         }
-
-        if (y > Q3_begin && y < Q3_end)
+        else
         {
-            bField[0] = gradients[2]*(z*CLHEP::mm);
-            bField[2] = -gradients[2]*(x*CLHEP::mm);
+            dipole.min = fFieldMap->GetLowerCorner();
+            dipole.max = fFieldMap->GetUpperCorner();
         }
 
-        if (y > Q4_begin && y < Q4_end)
+        // Upper edges are excluded by Contains; the last nodes still count
+        for (G4double &edge : dipole.max)
+            edge = std::nextafter(edge, inf);
+    }
+
+    for (size_t i = 0; i < fLattice.size(); ++i)
+    {
+        const FieldBox &quad = fBoxes[i];
+        G4bool overlap = true;
+        for (size_t a = 0; a < 3; ++a)
+            overlap = overlap && quad.min[a] < dipole.max[a] && dipole.min[a] < quad.max[a];
+        dipole.exclusive = dipole.exclusive && !overlap;
+    }
+
+    fBoxes.push_back(dipole);
+}
+
+/**
+ * @brief Find the quadrupole containing a position along y.
+ * @param y Position along the beam axis (mm)
+ * @return Element of the lattice, or nullptr in a drift
+ */
+const LatticeElement *PlasmaMLPALLASMagneticField::FindQuadrupole(G4double y) const
+{
+    // Last element entering before y
+    auto it = std::upper_bound(fLattice.begin(), fLattice.end(), y,
+                               [](G4double value, const LatticeElement &element) { return value <= element.begin; });
+    if (it == fLattice.begin())
+        return nullptr;
+
+    --it;
+    return (y < it->end) ? &*it : nullptr;
+}
+
+/**
+ * @brief Append a quadrupole after the last one of the lattice.
+ * @param drift Distance from the exit of the previous quadrupole (mm)
+ * @param length Length (mm)
+ * @param gradient Gradient (tesla/m)
+ */
+void PlasmaMLPALLASMagneticField::AddQuadrupole(G4double drift, G4double length, G4double gradient)
+{
+    const size_t index = gradients.size();
+    Reserve(index);
+    SetQDrift(index, drift);
+    SetQLength(index, length);
+    SetGradient(index, gradient);
+}
+
+//--------------------------------------
+// Validation of the tabulated profiles
+//--------------------------------------
+
+/**
+ * @brief Compare the tabulated dipole profiles with the analytic fits.
+ *
+ * Positions are taken at the centre of nSamples equal slices of each range,
+ * which never coincide with the grid nodes. The product is tested on a
+ * scrambled pairing of the two sample sets, over the whole (z, y) plane.
+ *
+ * @param nSamples Number of positions tested in each profile
+ */
+void PlasmaMLPALLASMagneticField::ValidateDipoleProfiles(size_t nSamples)
+{
+    nSamples = std::max<size_t>(nSamples, 1);
+
+    const PlasmaMLPALLASFieldProfile &profileY = DipoleProfileY();
+    const PlasmaMLPALLASFieldProfile &profileS = DipoleProfileS();
+
+    auto position = [nSamples](const PlasmaMLPALLASFieldProfile &profile, size_t i) {
+        return profile.GetMin() + (i + 0.5) * (profile.GetMax() - profile.GetMin()) / nSamples;
+    };
+
+    auto report = [](const char *name, G4double maxDiff, G4double where, G4double sumSq, size_t n, G4double peak) {
+        G4cout << "  " << name << " : max |grid - fit| = " << maxDiff << " T"
+               << " at " << where << " mm (" << 100. * maxDiff / peak << " % of the peak), RMS = "
+               << std::sqrt(sumSq / n) << " T" << G4endl;
+    };
+
+    G4cout << "Validation of the tabulated dipole profiles (" << nSamples << " samples, "
+           << profileY.GetSize() << " x " << profileS.GetSize() << " nodes)" << G4endl;
+
+    for (const auto *profile : {&profileY, &profileS})
+    {
+        const bool isY = (profile == &profileY);
+        G4double maxDiff = 0., where = 0., sumSq = 0., peak = 0.;
+        for (size_t i = 0; i < nSamples; ++i)
         {
-            bField[0] = gradients[3]*(z*CLHEP::mm);
-            bField[2] = -gradients[3]*(x*CLHEP::mm);
+            const G4double x = position(*profile, i);
+            const G4double fit = isY ? AnalyticProfileY(x) : AnalyticProfileS(x);
+            const G4double diff = std::abs(profile->Value(x) - fit);
+            sumSq += diff * diff;
+            peak = std::max(peak, std::abs(fit));
+            if (diff > maxDiff)
+            {
+                maxDiff = diff;
+                where = x;
+            }
         }
+        report(isY ? "Y (z)" : "S (y)", maxDiff, where, sumSq, nSamples, peak);
     }
+
+    // Product, as used by GetFieldValue
+    G4double maxDiff = 0., sumSq = 0., peak = 0.;
+    for (size_t i = 0; i < nSamples; ++i)
+    {
+        const G4double z = position(profileY, i);
+        const G4double y = position(profileS, (i * 7919) % nSamples);
+        const G4double fit = AnalyticProfileY(z) * AnalyticProfileS(y);
+        const G4double diff = std::abs(profileY.Value(z) * profileS.Value(y) - fit);
+        sumSq += diff * diff;
+        peak = std::max(peak, std::abs(fit));
+        maxDiff = std::max(maxDiff, diff);
+    }
+    G4cout << "  Y x S : max |grid - fit| = " << maxDiff << " T (" << 100. * maxDiff / std::max(peak, 1e-30)
+           << " % of the peak), RMS = " << std::sqrt(sumSq / nSamples) << " T" << G4endl;
+    G4cout << "  (the maximum sits in the grid cell of a step/Gaussian junction, where the fits themselves jump)" << G4endl;
 }
 
 //--------------------------------------
@@ -225,12 +555,23 @@ void PlasmaMLPALLASMagneticField::SetDipoleField(G4double fieldValue)
 }
 
 /**
- * @brief Enable or disable mapped-field mode.
- * @param status True for mapped-field, false for constant/parameterized
+ * @brief Select the dipole field model.
+ * @param status 0 for the constant dipole, 1 for the fitted profiles, 2 for the 3D field map
  */
-void PlasmaMLPALLASMagneticField::SetMapBFieldStatus(G4bool status)
+void PlasmaMLPALLASMagneticField::SetMapBFieldStatus(G4int status)
 {
     StatusMapBField = status;
+    UpdateBoxes();
+}
+
+/**
+ * @brief Set the measured 3D dipole map used with status 2.
+ * @param map Map shared by the fields of all threads
+ */
+void PlasmaMLPALLASMagneticField::SetFieldMap(std::shared_ptr<const PlasmaMLPALLASFieldMap> map)
+{
+    fFieldMap = std::move(map);
+    UpdateBoxes();
 }
 
 /**
@@ -240,11 +581,36 @@ void PlasmaMLPALLASMagneticField::SetMapBFieldStatus(G4bool status)
  */
 void PlasmaMLPALLASMagneticField::SetGradient(size_t index, G4double gradient)
 {
-    if (index < NumQuadrupoles)
+    Reserve(index);
+    gradients[index] = gradient;
+    UpdateLattice();
+    G4cout << "SET Q" << index + 1 << " Gradient : " << gradient / CLHEP::tesla * CLHEP::m << " tesla/m" << G4endl;
+}
+
+/**
+ * @brief Set the dipole field, the gradients and the drifts of Q1..Q4 at once.
+ * @param parameters Snapshot published by the geometry
+ * @return True if any value changed
+ */
+G4bool PlasmaMLPALLASMagneticField::SetParameters(const PlasmaMLPALLASFieldParameters &parameters)
+{
+    Reserve(parameters.gradients.size() - 1);
+
+    G4bool latticeChanged = false;
+    for (size_t i = 0; i < parameters.gradients.size(); ++i)
     {
-        gradients[index] = gradient;
-        G4cout << "SET Q" << index + 1 << " Gradient : " << gradient / CLHEP::tesla * CLHEP::m << " tesla/m" << G4endl;
+        latticeChanged = latticeChanged || gradients[i] != parameters.gradients[i] || qdrift[i] != parameters.drifts[i];
+        gradients[i] = parameters.gradients[i];
+        qdrift[i] = parameters.drifts[i];
     }
+
+    const G4bool dipoleChanged = ConstantDipoleBField != parameters.constantDipoleBField;
+    ConstantDipoleBField = parameters.constantDipoleBField;
+
+    if (latticeChanged)
+        UpdateLattice();
+
+    return latticeChanged || dipoleChanged;
 }
 
 /**
@@ -254,7 +620,7 @@ void PlasmaMLPALLASMagneticField::SetGradient(size_t index, G4double gradient)
  */
 G4double PlasmaMLPALLASMagneticField::GetGradient(size_t index) const
 {
-    if (index < NumQuadrupoles)
+    if (index < gradients.size())
         return gradients[index];
     else
     {
@@ -270,11 +636,10 @@ G4double PlasmaMLPALLASMagneticField::GetGradient(size_t index) const
  */
 void PlasmaMLPALLASMagneticField::SetQLength(size_t index, G4double length)
 {
-    if (index < NumQuadrupoles)
-    {
-        qlength[index] = length;
-        G4cout << "SET QLength" << index + 1 << " Length : " << length / CLHEP::mm << " mm" << G4endl;
-    }
+    Reserve(index);
+    qlength[index] = length;
+    UpdateLattice();
+    G4cout << "SET QLength" << index + 1 << " Length : " << length / CLHEP::mm << " mm" << G4endl;
 }
 
 /**
@@ -284,7 +649,7 @@ void PlasmaMLPALLASMagneticField::SetQLength(size_t index, G4double length)
  */
 G4double PlasmaMLPALLASMagneticField::GetQLength(size_t index) const
 {
-    if (index < NumQuadrupoles)
+    if (index < gradients.size())
         return qlength[index];
     else
     {
@@ -300,11 +665,10 @@ G4double PlasmaMLPALLASMagneticField::GetQLength(size_t index) const
  */
 void PlasmaMLPALLASMagneticField::SetQDrift(size_t index, G4double drift)
 {
-    if (index < NumQuadrupoles)
-    {
-        qdrift[index] = drift;
-        G4cout << "SET QDrift" << index + 1 << " Length : " << drift / CLHEP::mm << " mm" << G4endl;
-    }
+    Reserve(index);
+    qdrift[index] = drift;
+    UpdateLattice();
+    G4cout << "SET QDrift" << index + 1 << " Length : " << drift / CLHEP::mm << " mm" << G4endl;
 }
 
 /**
@@ -314,7 +678,7 @@ void PlasmaMLPALLASMagneticField::SetQDrift(size_t index, G4double drift)
  */
 G4double PlasmaMLPALLASMagneticField::GetQDrift(size_t index) const
 {
-    if (index < NumQuadrupoles)
+    if (index < gradients.size())
         return qdrift[index];
     else
     {
@@ -0,0 +1,65 @@
+/**
+ * @file PlasmaMLPALLASMappedFile.cc
+ * @brief Implementation of the read-only file mapping helper (POSIX mmap).
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASMappedFile.hh"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Map a file in read-only mode
+ * @param path File to map
+ *
+ * The descriptor is closed right after mapping: the mapping keeps the file
+ * referenced until munmap.
+ */
+PlasmaMLPALLASMappedFile::PlasmaMLPALLASMappedFile(const G4String& path)
+    : fPath(path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        fError = "cannot open file: " + std::string(std::strerror(errno));
+        return;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        fError = "cannot read file size or file is empty";
+        close(fd);
+        return;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        fError = "mmap failed: " + std::string(std::strerror(errno));
+        return;
+    }
+
+    fData = static_cast<const char*>(data);
+    fSize = static_cast<size_t>(info.st_size);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASMappedFile::~PlasmaMLPALLASMappedFile()
+{
+    if (fData)
+        munmap(const_cast<char*>(fData), fSize);
+}
@@ -5,11 +5,19 @@
  * This file implements the PlasmaMLPALLASOnnxInference class, which provides
  * a mechanism to generate plasma beam parameters by performing inference
  * on a pre-trained ONNX model. The class handles:
- *  - Initialization of the ONNX runtime environment
- *  - Loading the specified ONNX model file
+ *  - Access to the process-wide ONNX runtime session
+ *  - Per-thread input/output buffers bound once through Ort::IoBinding, so
+ *    that steady-state inference does not allocate
  *  - Preparing input tensors from physical simulation parameters
  *  - Running inference and converting outputs to physical units
- *  - Sampling transverse beam coordinates (x, z) and momenta (xp, zp)
+ *  - Caching the predicted moments so that the model is only evaluated
+ *    when the laser/plasma inputs change
+ *  - Batched inference of many input rows in a single session run, used
+ *    for parameter sweeps and for dumping the moments of a full grid
+ *
+ * The ONNX runtime session itself is shared by all threads and owned by
+ * PlasmaMLPALLASOnnxSession; each thread only keeps its own instance of this
+ * class as a lightweight run context.
  *
  * The main purpose is to generate physically realistic beam parameters
  * for use in Geant4 simulations of the PALLAS plasma beamline.
@@ -20,11 +28,13 @@
  *  - Plasma density (fCN2)
  *  - Gas pressure (fPressure)
  *
- * Output parameters encapsulated in the BeamParameters structure include:
+ * Output parameters encapsulated in the BeamMoments structure include:
  *  - Kinetic energy (Ekin) and spread (dEkin)
  *  - Beam charge (Q)
  *  - Normalized emittance (epsb)
- *  - Transverse positions (x, z) and angles (xp, zp)
+ *
+ * The transverse phase space of each primary is sampled from these moments
+ * by PlasmaMLPALLASBeamSampler, with the source optics of the run.
  *
  * The class uses CLHEP units for all physical quantities.
  *
@@ -36,95 +46,326 @@
 
 
 #include "PlasmaMLPALLASOnnxInference.hh"
-#include "Randomize.hh"
+#include "PlasmaMLPALLASOnnxSession.hh"
 #include "CLHEP/Units/SystemOfUnits.h"
 #include "CLHEP/Units/PhysicalConstants.h"
+#include "G4ios.hh"
+#include <algorithm>
 #include <cmath>
+#include <fstream>
+#include <iomanip>
+
+namespace
+{
+    /// Input ranges used to train the model (Xoff, A0, CN2, Pressure)
+    constexpr std::array<G4double, 4> kInputMin = {-399.824698, 1.100516, 0.002064, 10.094508};
+    constexpr std::array<G4double, 4> kInputMax = {1798.325132, 1.849792, 0.119983, 99.957409};
+
+    /// Output ranges used to train the model (Ekin [MeV], dEkin, Q [C], epsb [m.rad])
+    constexpr std::array<G4double, 4> kOutputMin = {43.88486, 8.269990e-4, 6.498496e-17, 2.504754e-9};
+    constexpr std::array<G4double, 4> kOutputMax = {368.2576, 5.622887e-1, 8.376833e-10, 7.615750e-5};
+
+    /**
+     * @brief Normalize N input rows between 0 and 1 into a row-major buffer
+     */
+    void RescaleInputs(const std::vector<OnnxInputRow>& inputs, std::vector<double>& rescaled)
+    {
+        rescaled.resize(4 * inputs.size());
+        for (size_t i = 0; i < inputs.size(); ++i)
+            for (size_t j = 0; j < 4; ++j)
+                rescaled[4 * i + j] = (inputs[i][j] - kInputMin[j]) / (kInputMax[j] - kInputMin[j]);
+    }
+
+    /**
+     * @brief Convert one row of model outputs to physical units
+     */
+    template <typename T>
+    BeamMoments ConvertOutputs(const T* row)
+    {
+        BeamMoments moments;
+        moments.Ekin  = (row[0] * (kOutputMax[0] - kOutputMin[0]) + kOutputMin[0]) * CLHEP::MeV;
+        moments.dEkin = row[1] * (kOutputMax[1] - kOutputMin[1]) + kOutputMin[1];
+        moments.Q     = row[2] * (kOutputMax[2] - kOutputMin[2]) + kOutputMin[2];
+        moments.epsb  = row[3] * (kOutputMax[3] - kOutputMin[3]) + kOutputMin[3];
+        return moments;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Value of point i of a grid axis
+ * @param i Point index, between 0 and n - 1
+ */
+G4double OnnxGridAxis::Value(size_t i) const
+{
+    if (n <= 1) return min;
+    return min + (max - min) * G4double(i) / G4double(n - 1);
+}
+
+/**
+ * @brief Parse one grid axis given as a single value or "min:max:n"
+ * @param spec Axis specification
+ * @param axis Parsed axis
+ * @return True if the specification is valid
+ */
+bool OnnxGridAxis::Parse(const std::string& spec, OnnxGridAxis& axis)
+{
+    try
+    {
+        size_t first = spec.find(':');
+        if (first == std::string::npos)
+        {
+            axis.min = axis.max = std::stod(spec);
+            axis.n = 1;
+            return true;
+        }
+
+        size_t second = spec.find(':', first + 1);
+        if (second == std::string::npos)
+            return false;
+
+        axis.min = std::stod(spec.substr(0, first));
+        axis.max = std::stod(spec.substr(first + 1, second - first - 1));
+        axis.n = std::stoul(spec.substr(second + 1));
+        return axis.n > 0;
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+/**
+ * @brief Number of points of the cartesian product of the four input axes
+ */
+size_t OnnxGridAxis::GridSize(const std::array<OnnxGridAxis, 4>& axes)
+{
+    size_t nPoints = 1;
+    for (const auto& axis : axes) nPoints *= std::max<size_t>(axis.n, 1);
+    return nPoints;
+}
+
+/**
+ * @brief Input row of one point of the cartesian product of the four input axes
+ * @param axes Grid axes for Xoff, A0, CN2 and Pressure
+ * @param index Point index, between 0 and GridSize(axes) - 1
+ */
+OnnxInputRow OnnxGridAxis::GridPoint(const std::array<OnnxGridAxis, 4>& axes, size_t index)
+{
+    // Pressure varies fastest, Xoff slowest
+    OnnxInputRow row;
+    for (size_t j = 4; j-- > 0;)
+    {
+        const size_t n = std::max<size_t>(axes[j].n, 1);
+        row[j] = axes[j].Value(index % n);
+        index /= n;
+    }
+    return row;
+}
 
 /**
  * @brief Constructor
- * @param modelPath Path to the ONNX model file
  *
- * Initializes the ONNX runtime environment, sets session options, 
- * and loads the specified ONNX model. Also initializes input and output node names.
+ * Only prepares the per-thread run context. The model is loaded once for the
+ * whole process by PlasmaMLPALLASOnnxSession, on the first inference.
  */
-PlasmaMLPALLASOnnxInference::PlasmaMLPALLASOnnxInference(const std::string& modelPath)
-    : env(ORT_LOGGING_LEVEL_WARNING, "plasma"),
-      sessionOptions(),
-      memoryInfo(Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault))
-{
-    sessionOptions.SetIntraOpNumThreads(1);
-    session = std::make_unique<Ort::Session>(env, modelPath.c_str(), sessionOptions);
+PlasmaMLPALLASOnnxInference::PlasmaMLPALLASOnnxInference()
+    : memoryInfo(Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU))
+{}
+
+/**
+ * @brief Binds the per-thread single-row buffers to a shared model
+ * @param model Model used for the following inferences
+ *
+ * The buffer matching the element type declared by the model is wrapped in a
+ * tensor, so that a double-input/float-output model (as model2.onnx) or a
+ * model using a single precision runs without any conversion tensor.
+ */
+void PlasmaMLPALLASOnnxInference::BindModel(const std::shared_ptr<PlasmaMLPALLASOnnxModel>& model) {
+    static const std::array<int64_t, 2> dims = {1, 4};
+
+    ioBinding.reset();
+
+    if (model->inputType == ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE)
+        inputTensor = Ort::Value::CreateTensor<double>(memoryInfo, inputBufferDouble.data(), 4, dims.data(), dims.size());
+    else
+        inputTensor = Ort::Value::CreateTensor<float>(memoryInfo, inputBufferFloat.data(), 4, dims.data(), dims.size());
 
-    // TODO: fill input/output node names according to the ONNX model
-    inputNodeNames = {"input"}; 
-    outputNodeNames = {"output"};
+    if (model->outputType == ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE)
+        outputTensor = Ort::Value::CreateTensor<double>(memoryInfo, outputBufferDouble.data(), 4, dims.data(), dims.size());
+    else
+        outputTensor = Ort::Value::CreateTensor<float>(memoryInfo, outputBufferFloat.data(), 4, dims.data(), dims.size());
+
+    ioBinding = std::make_unique<Ort::IoBinding>(model->session);
+    ioBinding->BindInput(model->inputName.c_str(), inputTensor);
+    ioBinding->BindOutput(model->outputName.c_str(), outputTensor);
+
+    boundModel = model;
+}
+
+/**
+ * @brief Predicts the beam moments for N input rows with a single session run
+ * @param inputs Laser/plasma input rows
+ * @return One BeamMoments per input row, in the same order
+ */
+std::vector<BeamMoments> PlasmaMLPALLASOnnxInference::PredictMomentsBatch(const std::vector<OnnxInputRow>& inputs) {
+    std::vector<BeamMoments> moments;
+    if (inputs.empty()) return moments;
+
+    std::vector<double> rescaled;
+    RescaleInputs(inputs, rescaled);
+    RunInference(rescaled, inputs.size(), moments);
+
+    return moments;
 }
 
 /**
- * @brief Generates beam parameters using the ONNX model
+ * @brief Predicts the moments of a full input grid and writes them to a CSV file
+ * @param axes Grid axes for Xoff, A0, CN2 and Pressure
+ * @param fileName Output CSV file
+ * @param batchSize Maximum number of rows sent to the model in one run
+ * @return Number of grid points written
+ *
+ * Units of the CSV columns follow the run output: Ekin in MeV, dEkin in %,
+ * Q in pC and epsb in µm.
+ */
+size_t PlasmaMLPALLASOnnxInference::DumpMomentsGrid(const std::array<OnnxGridAxis, 4>& axes, const std::string& fileName, size_t batchSize) {
+    std::ofstream out(fileName);
+    if (!out)
+    {
+        G4cerr << "Error : cannot open " << fileName << " to dump ONNX predictions !" << G4endl;
+        return 0;
+    }
+
+    out << "Xoff,A0,CN2,Pressure,Ekin,dEkin,Q,epsb\n";
+    out << std::setprecision(8);
+
+    const size_t nPoints = OnnxGridAxis::GridSize(axes);
+    batchSize = std::max<size_t>(batchSize, 1);
+
+    std::vector<OnnxInputRow> rows;
+    rows.reserve(std::min(batchSize, nPoints));
+
+    for (size_t first = 0; first < nPoints; first += batchSize)
+    {
+        const size_t last = std::min(first + batchSize, nPoints);
+        rows.clear();
+
+        for (size_t index = first; index < last; ++index)
+            rows.push_back(OnnxGridAxis::GridPoint(axes, index));
+
+        const std::vector<BeamMoments> moments = PredictMomentsBatch(rows);
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            out << rows[i][0] << "," << rows[i][1] << "," << rows[i][2] << "," << rows[i][3] << ","
+                << moments[i].Ekin / CLHEP::MeV << "," << moments[i].dEkin * 100. << ","
+                << moments[i].Q * 1e12 << "," << moments[i].epsb * 1e6 << "\n";
+        }
+    }
+
+    return nPoints;
+}
+
+/**
+ * @brief Predicts the beam moments, reusing the last prediction when possible
  * @param fXof Laser focal position
  * @param fA0 Laser normalized amplitude
  * @param fCN2 Plasma density
  * @param fPressure Gas pressure
- * @return BeamParameters structure with the generated beam values
+ * @return Beam moments in physical units
  *
- * This method rescales inputs, runs inference on the ONNX model,
- * converts outputs to physical units, and samples transverse positions/momenta.
+ * The cache is keyed on the rescaled inputs, which are exactly what the model
+ * sees: identical inputs always give identical outputs, so the session only
+ * needs to be run again when one of the laser/plasma parameters changes, or
+ * when the shared session has been reconfigured (new model file).
+ */
+const BeamMoments& PlasmaMLPALLASOnnxInference::PredictMoments(G4double fXof, G4double fA0, G4double fCN2, G4double fPressure) {
+    const OnnxInputRow inputs = {fXof, fA0, fCN2, fPressure};
+
+    std::array<G4double, 4> rescaledInputs;
+    for (size_t j = 0; j < 4; ++j)
+        rescaledInputs[j] = (inputs[j] - kInputMin[j]) / (kInputMax[j] - kInputMin[j]);
+
+    const size_t version = PlasmaMLPALLASOnnxSession::Instance().GetVersion();
+
+    if (!cacheValid || version != cachedVersion || rescaledInputs != cachedInputs) {
+        cachedMoments = RunSingle(rescaledInputs);
+        cachedInputs = rescaledInputs;
+        cachedVersion = version;
+        cacheValid = true;
+    }
+
+    return cachedMoments;
+}
+
+/**
+ * @brief Runs the ONNX session on one input row through the pre-bound tensors
+ * @param rescaledInputs Model inputs normalised between 0 and 1
+ * @return Beam moments in physical units
  */
-BeamParameters PlasmaMLPALLASOnnxInference::GenerateBeam(G4double fXof, G4double fA0, G4double fCN2, G4double fPressure) {
-    // Lambda to normalize input values between 0 and 1
-    auto rescale = [](G4double val, G4double min, G4double max) {
-        return (val - min) / (max - min);
-    };
-
-    G4double fXof_rescaled = rescale(fXof, -399.824698, 1798.325132);
-    G4double fA0_rescaled  = rescale(fA0, 1.100516, 1.849792);
-    G4double fCN2_rescaled = rescale(fCN2, 0.002064, 0.119983);
-    G4double fPressure_rescaled = rescale(fPressure, 10.094508, 99.957409);
-
-    // Prepare input tensor for ONNX runtime
-    std::vector<double> inputValues = {fXof_rescaled, fA0_rescaled, fCN2_rescaled, fPressure_rescaled};
-    std::vector<int64_t> inputDims = {1, (long long)inputValues.size()};
-    Ort::Value inputTensor = Ort::Value::CreateTensor<double>(
-        memoryInfo, inputValues.data(), inputValues.size(),
-        inputDims.data(), inputDims.size()
-    );
-
-    // Run inference
-    auto outputTensors = session->Run(Ort::RunOptions{nullptr},
-                                      inputNodeNames.data(),
-                                      &inputTensor, 1,
-                                      outputNodeNames.data(),
-                                      outputNodeNames.size());
-
-    G4float* outVals = outputTensors.front().GetTensorMutableData<G4float>();
-
-    BeamParameters params;
+BeamMoments PlasmaMLPALLASOnnxInference::RunSingle(const std::array<G4double, 4>& rescaledInputs) {
+    std::shared_ptr<PlasmaMLPALLASOnnxModel> model = PlasmaMLPALLASOnnxSession::Instance().GetModel();
+    if (model != boundModel)
+        BindModel(model);
+
+    for (size_t j = 0; j < 4; ++j) {
+        inputBufferDouble[j] = rescaledInputs[j];
+        inputBufferFloat[j] = static_cast<float>(rescaledInputs[j]);
+    }
+
+    model->session.Run(runOptions, *ioBinding);
+    ++nInferences;
+
+    if (model->outputType == ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE)
+        return ConvertOutputs(outputBufferDouble.data());
+    return ConvertOutputs(outputBufferFloat.data());
+}
+
+/**
+ * @brief Runs the ONNX session and converts the outputs to physical units
+ * @param rescaledInputs Row-major [nRows x 4] model inputs normalised between 0 and 1
+ * @param nRows Number of input rows
+ * @param moments Output moments, resized to nRows
+ */
+void PlasmaMLPALLASOnnxInference::RunInference(std::vector<double>& rescaledInputs, size_t nRows, std::vector<BeamMoments>& moments) {
+    std::shared_ptr<PlasmaMLPALLASOnnxModel> model = PlasmaMLPALLASOnnxSession::Instance().GetModel();
+
+    // Prepare input tensor for ONNX runtime, in the element type expected by the model
+    const std::array<int64_t, 2> inputDims = {(int64_t)nRows, 4};
+    Ort::Value batchTensor{nullptr};
+    if (model->inputType == ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE)
+    {
+        batchTensor = Ort::Value::CreateTensor<double>(
+            memoryInfo, rescaledInputs.data(), rescaledInputs.size(),
+            inputDims.data(), inputDims.size());
+    }
+    else
+    {
+        batchInputFloat.assign(rescaledInputs.begin(), rescaledInputs.end());
+        batchTensor = Ort::Value::CreateTensor<float>(
+            memoryInfo, batchInputFloat.data(), batchInputFloat.size(),
+            inputDims.data(), inputDims.size());
+    }
+
+    // Run inference on the shared session
+    const char* inputName = model->inputName.c_str();
+    const char* outputName = model->outputName.c_str();
+    auto outputTensors = model->session.Run(runOptions, &inputName, &batchTensor, 1, &outputName, 1);
+    ++nInferences;
 
     // Convert model outputs to physical units
-    params.Ekin  = outVals[0] * (368.2576*CLHEP::MeV - 43.88486*CLHEP::MeV) + 43.88486*CLHEP::MeV;
-    params.dEkin = outVals[1] * (5.622887e-1 - 8.269990e-4) + 8.269990e-4;
-    params.Q     = outVals[2] * (8.376833e-10 - 6.498496e-17) + 6.498496e-17;
-    params.epsb  = outVals[3] * (7.615750e-5 - 2.504754e-9) + 2.504754e-9;
-
-    G4double eps_z = params.epsb;           // Polarization direction
-    G4double eps_x = params.epsb / 2.5;     // Transverse direction
-
-    // Twiss parameters (assume alpha=0, beta=1)
-    G4double alphax = 0, betax = 1, alphay = 0, betay = 1;
-
-    // Sample X transverse position and momentum
-    G4double Ax = std::sqrt(eps_x * betax) * std::sqrt(-2 * std::log(G4UniformRand()));
-    G4double psix = CLHEP::twopi * G4UniformRand();
-    params.x  = Ax * std::cos(psix);
-    params.xp = -params.x * alphax / betax - Ax / std::sqrt(betax) * std::sin(psix);
-
-    // Sample Z transverse position and momentum
-    G4double Ay = std::sqrt(eps_z * betay) * std::sqrt(-2 * std::log(G4UniformRand()));
-    G4double psiy = CLHEP::twopi * G4UniformRand();
-    params.z  = Ay * std::cos(psiy);
-    params.zp = -params.z * alphay / betay - Ay / std::sqrt(betay) * std::sin(psiy);
-
-    return params;
+    moments.resize(nRows);
+    if (model->outputType == ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE)
+    {
+        const double* outVals = outputTensors.front().GetTensorData<double>();
+        for (size_t i = 0; i < nRows; ++i)
+            moments[i] = ConvertOutputs(outVals + 4 * i);
+    }
+    else
+    {
+        const float* outVals = outputTensors.front().GetTensorData<float>();
+        for (size_t i = 0; i < nRows; ++i)
+            moments[i] = ConvertOutputs(outVals + 4 * i);
+    }
 }
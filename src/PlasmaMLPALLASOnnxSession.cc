@@ -0,0 +1,197 @@
+/**
+ * @file PlasmaMLPALLASOnnxSession.cc
+ * @brief Implementation of the process-wide ONNX runtime session.
+ *
+ * A single `Ort::Env` and `Ort::Session` are created for the whole process, so
+ * that the model weights are loaded and the graph optimised only once even when
+ * running with many worker threads. Worker threads obtain the session through
+ * GetModel(), which loads the model on first use with the options set by the
+ * /PlasmaMLPALLAS/onnx/ commands. Changing an option drops the current session;
+ * threads still running inference keep it alive through their shared pointer,
+ * and the next call to GetModel() loads the model again.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASOnnxSession.hh"
+#include "PlasmaMLPALLASOnnxSessionMessenger.hh"
+#include "G4ios.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+    /**
+     * @brief Check that a model tensor is a [N x 4] tensor of floats or doubles
+     */
+    void CheckTensor(const Ort::ConstTensorTypeAndShapeInfo& info, const std::string& name)
+    {
+        const ONNXTensorElementDataType type = info.GetElementType();
+        const std::vector<int64_t> shape = info.GetShape();
+
+        if (type != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT && type != ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE)
+            G4Exception("PlasmaMLPALLASOnnxModel", "ONNX0002", FatalException,
+                        ("Tensor " + name + " must contain float or double values.").c_str());
+
+        if (shape.size() != 2 || (shape[1] > 0 && shape[1] != 4))
+            G4Exception("PlasmaMLPALLASOnnxModel", "ONNX0002", FatalException,
+                        ("Tensor " + name + " must have a [N x 4] shape.").c_str());
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Load the model and read the description of its input and output
+ * @param env ONNX runtime environment
+ * @param path ONNX model file
+ * @param options Session options
+ */
+PlasmaMLPALLASOnnxModel::PlasmaMLPALLASOnnxModel(Ort::Env& env, const G4String& path, const Ort::SessionOptions& options)
+    : session(env, path.c_str(), options)
+{
+    if (session.GetInputCount() != 1 || session.GetOutputCount() != 1)
+        G4Exception("PlasmaMLPALLASOnnxModel", "ONNX0002", FatalException,
+                    "The ONNX model must have exactly one input and one output.");
+
+    Ort::AllocatorWithDefaultOptions allocator;
+    inputName = session.GetInputNameAllocated(0, allocator).get();
+    outputName = session.GetOutputNameAllocated(0, allocator).get();
+
+    Ort::TypeInfo inputInfo = session.GetInputTypeInfo(0);
+    Ort::TypeInfo outputInfo = session.GetOutputTypeInfo(0);
+    CheckTensor(inputInfo.GetTensorTypeAndShapeInfo(), inputName);
+    CheckTensor(outputInfo.GetTensorTypeAndShapeInfo(), outputName);
+
+    inputType = inputInfo.GetTensorTypeAndShapeInfo().GetElementType();
+    outputType = outputInfo.GetTensorTypeAndShapeInfo().GetElementType();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASOnnxSession& PlasmaMLPALLASOnnxSession::Instance()
+{
+    static PlasmaMLPALLASOnnxSession instance;
+    return instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Constructor
+ *
+ * Creates the ONNX runtime environment and the UI commands. The model itself
+ * is only loaded on the first call to GetModel().
+ */
+PlasmaMLPALLASOnnxSession::PlasmaMLPALLASOnnxSession()
+    : fEnv(ORT_LOGGING_LEVEL_WARNING, "plasma")
+{
+    fMessenger = new PlasmaMLPALLASOnnxSessionMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASOnnxSession::~PlasmaMLPALLASOnnxSession()
+{
+    delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Get the shared model, loading it if needed
+ * @return Shared pointer keeping the session alive while it is used
+ */
+std::shared_ptr<PlasmaMLPALLASOnnxModel> PlasmaMLPALLASOnnxSession::GetModel()
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    if (!fModel)
+        Load();
+    return fModel;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Load the ONNX model with the current threading options
+ */
+void PlasmaMLPALLASOnnxSession::Load()
+{
+    Ort::SessionOptions sessionOptions;
+    sessionOptions.SetIntraOpNumThreads(fIntraOpNumThreads);
+    sessionOptions.SetInterOpNumThreads(fInterOpNumThreads);
+    sessionOptions.SetExecutionMode(fInterOpNumThreads == 1 ? ORT_SEQUENTIAL : ORT_PARALLEL);
+    sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+
+    try
+    {
+        fModel = std::make_shared<PlasmaMLPALLASOnnxModel>(fEnv, fModelPath, sessionOptions);
+    }
+    catch (const Ort::Exception& e)
+    {
+        G4String msg = "Cannot load ONNX model " + fModelPath + " : " + e.what();
+        G4Exception("PlasmaMLPALLASOnnxSession::Load", "ONNX0001", FatalException, msg);
+        return;
+    }
+
+    G4cout << "ONNX model " << fModelPath << " loaded (" << fModel->inputName << " -> " << fModel->outputName
+           << ", intra-op threads = " << fIntraOpNumThreads
+           << ", inter-op threads = " << fInterOpNumThreads << ")" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASOnnxSession::Invalidate()
+{
+    fModel.reset();
+    fVersion.fetch_add(1, std::memory_order_acq_rel);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASOnnxSession::SetModelPath(const G4String& path)
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    if (path == fModelPath) return;
+    fModelPath = path;
+    Invalidate();
+}
+
+void PlasmaMLPALLASOnnxSession::SetIntraOpNumThreads(G4int n)
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    if (n == fIntraOpNumThreads) return;
+    fIntraOpNumThreads = n;
+    Invalidate();
+}
+
+void PlasmaMLPALLASOnnxSession::SetInterOpNumThreads(G4int n)
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    if (n == fInterOpNumThreads) return;
+    fInterOpNumThreads = n;
+    Invalidate();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PlasmaMLPALLASOnnxSession::GetModelPath() const
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    return fModelPath;
+}
+
+G4int PlasmaMLPALLASOnnxSession::GetIntraOpNumThreads() const
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    return fIntraOpNumThreads;
+}
+
+G4int PlasmaMLPALLASOnnxSession::GetInterOpNumThreads() const
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    return fInterOpNumThreads;
+}
@@ -0,0 +1,109 @@
+#include "PlasmaMLPALLASOnnxSessionMessenger.hh"
+#include "PlasmaMLPALLASOnnxSession.hh"
+
+/**
+ * @file PlasmaMLPALLASOnnxSessionMessenger.cc
+ * @brief User interface (UI) messenger for the shared ONNX session.
+ *
+ * Commands are organized in the /PlasmaMLPALLAS/onnx/ directory and allow users to:
+ *  - Select the ONNX model file used for beam generation.
+ *  - Set the size of the ONNX runtime intra-op and inter-op thread pools.
+ *
+ * The new settings are applied the next time the model is used: the shared
+ * session is then reloaded once for the whole process.
+ *
+ * @authors Arnaud HUBER
+ * @authors Alexei SYTOV
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Constructor.
+ * @param session Pointer to the shared ONNX session.
+ */
+PlasmaMLPALLASOnnxSessionMessenger::PlasmaMLPALLASOnnxSessionMessenger(PlasmaMLPALLASOnnxSession *session)
+    : G4UImessenger(), fSession(session)
+{
+    fOnnxDir = new G4UIdirectory("/PlasmaMLPALLAS/onnx/");
+    fOnnxDir->SetGuidance("Shared ONNX session UI commands");
+
+    /**
+     * @brief Command to set the ONNX model file.
+     *
+     * Parameter: ModelPath (string)
+     */
+    fModelPathCmd = new G4UIcmdWithAString("/PlasmaMLPALLAS/onnx/setModelPath", this);
+    fModelPathCmd->SetGuidance("Set the ONNX model file used for beam generation");
+    fModelPathCmd->SetParameterName("ModelPath", false);
+    fModelPathCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fModelPathCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the number of ONNX runtime intra-op threads.
+     *
+     * Parameter: IntraOpNumThreads (0 = ONNX runtime default)
+     */
+    fIntraOpThreadsCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/onnx/setIntraOpNumThreads", this);
+    fIntraOpThreadsCmd->SetGuidance("Set the number of ONNX runtime intra-op threads (0 = default)");
+    fIntraOpThreadsCmd->SetParameterName("IntraOpNumThreads", false);
+    fIntraOpThreadsCmd->SetRange("IntraOpNumThreads>=0");
+    fIntraOpThreadsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fIntraOpThreadsCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the number of ONNX runtime inter-op threads.
+     *
+     * Parameter: InterOpNumThreads (0 = ONNX runtime default)
+     */
+    fInterOpThreadsCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/onnx/setInterOpNumThreads", this);
+    fInterOpThreadsCmd->SetGuidance("Set the number of ONNX runtime inter-op threads (0 = default)");
+    fInterOpThreadsCmd->SetGuidance("Values other than 1 enable the parallel execution mode.");
+    fInterOpThreadsCmd->SetParameterName("InterOpNumThreads", false);
+    fInterOpThreadsCmd->SetRange("InterOpNumThreads>=0");
+    fInterOpThreadsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fInterOpThreadsCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Destructor.
+ */
+PlasmaMLPALLASOnnxSessionMessenger::~PlasmaMLPALLASOnnxSessionMessenger()
+{
+    delete fModelPathCmd;
+    delete fIntraOpThreadsCmd;
+    delete fInterOpThreadsCmd;
+    delete fOnnxDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASOnnxSessionMessenger::SetNewValue(G4UIcommand *aCommand, G4String aNewValue)
+{
+    if (aCommand == fModelPathCmd)
+        fSession->SetModelPath(aNewValue);
+    else if (aCommand == fIntraOpThreadsCmd)
+        fSession->SetIntraOpNumThreads(fIntraOpThreadsCmd->GetNewIntValue(aNewValue));
+    else if (aCommand == fInterOpThreadsCmd)
+        fSession->SetInterOpNumThreads(fInterOpThreadsCmd->GetNewIntValue(aNewValue));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PlasmaMLPALLASOnnxSessionMessenger::GetCurrentValue(G4UIcommand *aCommand)
+{
+    G4String cv;
+
+    if (aCommand == fModelPathCmd)
+        cv = fSession->GetModelPath();
+    else if (aCommand == fIntraOpThreadsCmd)
+        cv = fIntraOpThreadsCmd->ConvertToString(fSession->GetIntraOpNumThreads());
+    else if (aCommand == fInterOpThreadsCmd)
+        cv = fInterOpThreadsCmd->ConvertToString(fSession->GetInterOpNumThreads());
+
+    return cv;
+}
@@ -0,0 +1,287 @@
+/**
+ * @file PlasmaMLPALLASOptimiser.cc
+ * @brief Implementation of the Nelder-Mead optimisation of the quadrupole gradients.
+ *
+ * The simplex lives in the space of the active gradients only; the others
+ * keep their current value. Standard coefficients are used (reflection 1,
+ * expansion 2, contraction and shrink 1/2). An evaluation with fewer
+ * primaries on the screen than the minimum is given an infinite value, so
+ * that the simplex moves away from the gradients that lose the beam.
+ *
+ * The statistical error of an rms size estimated from n particles is taken
+ * as value / sqrt(2 n).
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASOptimiser.hh"
+#include "PlasmaMLPALLASOptimiserMessenger.hh"
+#include "PlasmaMLPALLASGeometryConstruction.hh"
+#include "PlasmaMLPALLASRunAction.hh"
+#include "PlasmaMLPALLASSpotAccumulable.hh"
+#include "G4AccumulableManager.hh"
+#include "G4RunManager.hh"
+#include "G4StateManager.hh"
+#include "G4UImanager.hh"
+#include "G4ios.hh"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASOptimiser& PlasmaMLPALLASOptimiser::Instance()
+{
+    static PlasmaMLPALLASOptimiser instance;
+    return instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASOptimiser::PlasmaMLPALLASOptimiser()
+{
+    fMessenger = new PlasmaMLPALLASOptimiserMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASOptimiser::~PlasmaMLPALLASOptimiser()
+{
+    delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const std::vector<G4String>& PlasmaMLPALLASOptimiser::GetObjectiveNames()
+{
+    static const std::vector<G4String> names = {"spot", "x", "z"};
+    return names;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASOptimiser::ApplyGradients(const Gradients& gradients) const
+{
+    G4UImanager* UI = G4UImanager::GetUIpointer();
+    for (size_t i = 0; i < gradients.size(); ++i)
+    {
+        std::ostringstream os;
+        os << "/PlasmaMLPALLAS/field/setQ" << i + 1 << "Gradient " << std::setprecision(12)
+           << gradients[i] / (tesla / m) << " T/m";
+        UI->ApplyCommand(os.str());
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Run one candidate
+ * @param gradients Gradients of Q1..Q4
+ * @return Objective and statistical error (infinite value if too few primaries reach the screen)
+ */
+PlasmaMLPALLASOptimiser::Evaluation PlasmaMLPALLASOptimiser::Evaluate(const Gradients& gradients)
+{
+    ApplyGradients(gradients);
+    G4UImanager::GetUIpointer()->ApplyCommand("/run/beamOn " + std::to_string(fEvents.load()));
+
+    Evaluation evaluation;
+    evaluation.value = std::numeric_limits<G4double>::infinity();
+
+    const auto* spot = dynamic_cast<const PlasmaMLPALLASSpotAccumulable*>(
+        G4AccumulableManager::Instance()->GetAccumulable(PlasmaMLPALLASRunAction::BSYAGSpotName));
+    if (spot && spot->GetEntries() >= fSettings.minEntries)
+    {
+        const G4double sx = spot->GetSigmaX(), sz = spot->GetSigmaZ();
+        if (fSettings.objective == "x")
+            evaluation.value = sx;
+        else if (fSettings.objective == "z")
+            evaluation.value = sz;
+        else
+            evaluation.value = std::hypot(sx, sz);
+        evaluation.error = evaluation.value / std::sqrt(2. * spot->GetEntries());
+    }
+
+    G4cout << "### Optimisation evaluation " << fEvaluationIndex.load() << " (" << fEvents.load() << " events) : G = ("
+           << gradients[0] / (tesla / m) << ", " << gradients[1] / (tesla / m) << ", "
+           << gradients[2] / (tesla / m) << ", " << gradients[3] / (tesla / m) << ") T/m, "
+           << fSettings.objective << " = " << evaluation.value << " +- " << evaluation.error << " mm ("
+           << (spot ? spot->GetEntries() : 0) << " primaries on BS1_YAG)" << G4endl;
+
+    ++fEvaluationIndex;
+    return evaluation;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Optimise the active gradients from the current ones
+ *
+ * The UI state is checked first, so that an optimisation never stops in the
+ * middle with its output file left open.
+ */
+void PlasmaMLPALLASOptimiser::Run()
+{
+    const auto* geometry = dynamic_cast<const PlasmaMLPALLASGeometryConstruction*>(
+        G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+    if (!geometry || G4StateManager::GetStateManager()->GetCurrentState() != G4State_Idle)
+    {
+        G4Exception("PlasmaMLPALLASOptimiser::Run", "OPT0001", JustWarning,
+                    "The kernel must be initialised before an optimisation.");
+        return;
+    }
+
+    std::vector<size_t> axes;
+    for (size_t i = 0; i < fSettings.active.size(); ++i)
+        if (fSettings.active[i])
+            axes.push_back(i);
+
+    if (axes.empty() || fSettings.minEvents > fSettings.maxEvents)
+    {
+        G4Exception("PlasmaMLPALLASOptimiser::Run", "OPT0002", JustWarning,
+                    "No active gradient, or minimum number of events above the maximum: nothing optimised.");
+        return;
+    }
+
+    const Gradients start = {geometry->GetQ1Gradient(), geometry->GetQ2Gradient(),
+                             geometry->GetQ3Gradient(), geometry->GetQ4Gradient()};
+
+    fEvaluationIndex = 0;
+    fEvents = fSettings.minEvents;
+    fRunning = true;
+    fKeepOutputOpen = true;
+
+    // Initial simplex: the start and one step along each active gradient
+    const size_t n = axes.size();
+    std::vector<Gradients> simplex(n + 1, start);
+    for (size_t k = 0; k < n; ++k)
+        simplex[k + 1][axes[k]] += fSettings.initialStep;
+
+    std::vector<Evaluation> values(n + 1);
+    for (size_t i = 0; i <= n; ++i)
+        values[i] = Evaluate(simplex[i]);
+
+    const auto combine = [&](const Gradients& a, const Gradients& b, G4double t) {
+        Gradients g = a;
+        for (size_t axis : axes)
+            g[axis] = a[axis] + t * (b[axis] - a[axis]);
+        return g;
+    };
+
+    while (fEvaluationIndex.load() < fSettings.maxEvaluations)
+    {
+        // Order the vertices, best first
+        std::vector<size_t> order(n + 1);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return values[a].value < values[b].value; });
+        std::vector<Gradients> sortedSimplex;
+        std::vector<Evaluation> sortedValues;
+        for (size_t i : order)
+        {
+            sortedSimplex.push_back(simplex[i]);
+            sortedValues.push_back(values[i]);
+        }
+        simplex.swap(sortedSimplex);
+        values.swap(sortedValues);
+
+        G4double size = 0.;
+        for (size_t i = 1; i <= n; ++i)
+            for (size_t axis : axes)
+                size = std::max(size, std::abs(simplex[i][axis] - simplex[0][axis]));
+
+        // Converged at the current statistics: more events, or stop at the maximum
+        const G4bool withinNoise = std::isfinite(values[n].value) &&
+                                   values[n].value - values[0].value <= 2. * values[0].error;
+        if (size < fSettings.tolerance || withinNoise)
+        {
+            if (fEvents.load() >= fSettings.maxEvents)
+            {
+                if (size < fSettings.tolerance)
+                    break;
+            }
+            else
+            {
+                fEvents = std::min(2 * fEvents.load(), fSettings.maxEvents);
+                G4cout << "### Optimisation: " << fEvents.load() << " events per evaluation" << G4endl;
+                for (size_t i = 0; i <= n; ++i)
+                    values[i] = Evaluate(simplex[i]);
+                continue;
+            }
+        }
+
+        // Centroid of all the vertices but the worst
+        Gradients centroid = start;
+        for (size_t axis : axes)
+        {
+            centroid[axis] = 0.;
+            for (size_t i = 0; i < n; ++i)
+                centroid[axis] += simplex[i][axis] / n;
+        }
+
+        const Gradients reflected = combine(centroid, simplex[n], -1.);
+        const Evaluation fr = Evaluate(reflected);
+
+        if (fr.value < values[0].value)
+        {
+            const Gradients expanded = combine(centroid, simplex[n], -2.);
+            const Evaluation fe = Evaluate(expanded);
+            if (fe.value < fr.value)
+            {
+                simplex[n] = expanded;
+                values[n] = fe;
+            }
+            else
+            {
+                simplex[n] = reflected;
+                values[n] = fr;
+            }
+            continue;
+        }
+
+        if (fr.value < values[n - 1].value)
+        {
+            simplex[n] = reflected;
+            values[n] = fr;
+            continue;
+        }
+
+        // Contraction, outside or inside the simplex
+        const G4bool outside = fr.value < values[n].value;
+        const Gradients contracted = outside ? combine(centroid, reflected, 0.5) : combine(centroid, simplex[n], 0.5);
+        const Evaluation fc = Evaluate(contracted);
+        if (fc.value < std::min(fr.value, values[n].value))
+        {
+            simplex[n] = contracted;
+            values[n] = fc;
+            continue;
+        }
+
+        // Shrink towards the best vertex
+        for (size_t i = 1; i <= n; ++i)
+        {
+            simplex[i] = combine(simplex[0], simplex[i], 0.5);
+            values[i] = Evaluate(simplex[i]);
+        }
+    }
+
+    const size_t best = std::min_element(values.begin(), values.end(),
+                                         [](const Evaluation& a, const Evaluation& b) { return a.value < b.value; }) -
+                        values.begin();
+
+    // Final run at the best gradients, with full statistics, closing the output
+    fEvents = fSettings.maxEvents;
+    fKeepOutputOpen = false;
+    const Evaluation result = Evaluate(simplex[best]);
+
+    fRunning = false;
+
+    G4cout << "### Optimisation finished after " << fEvaluationIndex.load() << " runs : G = ("
+           << simplex[best][0] / (tesla / m) << ", " << simplex[best][1] / (tesla / m) << ", "
+           << simplex[best][2] / (tesla / m) << ", " << simplex[best][3] / (tesla / m) << ") T/m, "
+           << fSettings.objective << " = " << result.value << " +- " << result.error << " mm" << G4endl;
+}
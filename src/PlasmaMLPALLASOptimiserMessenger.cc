@@ -0,0 +1,206 @@
+#include "PlasmaMLPALLASOptimiserMessenger.hh"
+#include "PlasmaMLPALLASOptimiser.hh"
+#include "G4UIparameter.hh"
+#include "G4SystemOfUnits.hh"
+#include <sstream>
+
+/**
+ * @file PlasmaMLPALLASOptimiserMessenger.cc
+ * @brief User interface (UI) messenger for the quadrupole gradient optimisation.
+ *
+ * Commands are organized in the /PlasmaMLPALLAS/optimise/ directory and allow users to:
+ *  - Select the gradients to optimise and the objective on BS1_YAG.
+ *  - Set the initial simplex, the tolerance and the number of events per evaluation.
+ *  - Run the optimisation in the current kernel, from the current gradients.
+ *
+ * @authors Arnaud HUBER
+ * @authors Alexei SYTOV
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Constructor.
+ * @param optimiser Pointer to the optimiser.
+ */
+PlasmaMLPALLASOptimiserMessenger::PlasmaMLPALLASOptimiserMessenger(PlasmaMLPALLASOptimiser *optimiser)
+    : G4UImessenger(), fOptimiser(optimiser)
+{
+    fOptimiseDir = new G4UIdirectory("/PlasmaMLPALLAS/optimise/");
+    fOptimiseDir->SetGuidance("Optimisation of the quadrupole gradients UI commands");
+
+    /**
+     * @brief Command to select the optimised gradients.
+     *
+     * Parameters: Q1, Q2, Q3, Q4 (bool)
+     */
+    fActiveCmd = new G4UIcommand("/PlasmaMLPALLAS/optimise/setActive", this);
+    fActiveCmd->SetGuidance("Select the gradients optimised (the others keep their current value)");
+    for (const char *name : {"Q1", "Q2", "Q3", "Q4"})
+        fActiveCmd->SetParameter(new G4UIparameter(name, 'b', false));
+    fActiveCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fActiveCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the size of the initial simplex.
+     */
+    fInitialStepCmd = new G4UIcmdWithADoubleAndUnit("/PlasmaMLPALLAS/optimise/setInitialStep", this);
+    fInitialStepCmd->SetGuidance("Step of each active gradient from the start in the initial simplex");
+    fInitialStepCmd->SetParameterName("InitialStep", false);
+    fInitialStepCmd->SetUnitCategory("MagneticGradient");
+    fInitialStepCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fInitialStepCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the simplex size at convergence.
+     */
+    fToleranceCmd = new G4UIcmdWithADoubleAndUnit("/PlasmaMLPALLAS/optimise/setTolerance", this);
+    fToleranceCmd->SetGuidance("Largest gradient difference in the simplex at convergence");
+    fToleranceCmd->SetParameterName("Tolerance", false);
+    fToleranceCmd->SetUnitCategory("MagneticGradient");
+    fToleranceCmd->SetRange("Tolerance>0");
+    fToleranceCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fToleranceCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the number of events per evaluation.
+     *
+     * Parameters: MinEvents, MaxEvents (integer)
+     */
+    fEventsCmd = new G4UIcommand("/PlasmaMLPALLAS/optimise/setEvents", this);
+    fEventsCmd->SetGuidance("Events per evaluation at start and near convergence (doubled in between)");
+    auto *minEvents = new G4UIparameter("MinEvents", 'i', false);
+    minEvents->SetParameterRange("MinEvents>=1");
+    fEventsCmd->SetParameter(minEvents);
+    auto *maxEvents = new G4UIparameter("MaxEvents", 'i', false);
+    maxEvents->SetParameterRange("MaxEvents>=1");
+    fEventsCmd->SetParameter(maxEvents);
+    fEventsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fEventsCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the maximum number of runs.
+     */
+    fMaxEvaluationsCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/optimise/setMaxEvaluations", this);
+    fMaxEvaluationsCmd->SetGuidance("Maximum number of runs of the search (the final run excluded)");
+    fMaxEvaluationsCmd->SetParameterName("MaxEvaluations", false);
+    fMaxEvaluationsCmd->SetRange("MaxEvaluations>=1");
+    fMaxEvaluationsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fMaxEvaluationsCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the number of primaries needed on the screen.
+     */
+    fMinEntriesCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/optimise/setMinEntries", this);
+    fMinEntriesCmd->SetGuidance("Primaries on BS1_YAG needed for a valid evaluation (infinite objective below)");
+    fMinEntriesCmd->SetParameterName("MinEntries", false);
+    fMinEntriesCmd->SetRange("MinEntries>=2");
+    fMinEntriesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fMinEntriesCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to select the objective.
+     */
+    G4String objectives;
+    for (const auto &name : PlasmaMLPALLASOptimiser::GetObjectiveNames())
+        objectives += (objectives.empty() ? "" : " ") + name;
+
+    fObjectiveCmd = new G4UIcmdWithAString("/PlasmaMLPALLAS/optimise/setObjective", this);
+    fObjectiveCmd->SetGuidance("Objective minimised on BS1_YAG: rms spot radius (spot), rms along x or z");
+    fObjectiveCmd->SetParameterName("Objective", false);
+    fObjectiveCmd->SetCandidates(objectives);
+    fObjectiveCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fObjectiveCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to run the optimisation.
+     */
+    fRunCmd = new G4UIcmdWithoutParameter("/PlasmaMLPALLAS/optimise/run", this);
+    fRunCmd->SetGuidance("Optimise the active gradients from the current ones, then apply the best");
+    fRunCmd->SetGuidance("All the runs are written to the same output file, keyed by the ScanIndex branch");
+    fRunCmd->AvailableForStates(G4State_Idle);
+    fRunCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Destructor.
+ */
+PlasmaMLPALLASOptimiserMessenger::~PlasmaMLPALLASOptimiserMessenger()
+{
+    delete fActiveCmd;
+    delete fInitialStepCmd;
+    delete fToleranceCmd;
+    delete fEventsCmd;
+    delete fMaxEvaluationsCmd;
+    delete fMinEntriesCmd;
+    delete fObjectiveCmd;
+    delete fRunCmd;
+    delete fOptimiseDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASOptimiserMessenger::SetNewValue(G4UIcommand *aCommand, G4String aNewValue)
+{
+    PlasmaMLPALLASOptimiser::Settings &settings = fOptimiser->GetSettings();
+
+    if (aCommand == fActiveCmd)
+    {
+        std::istringstream is(aNewValue);
+        for (auto &active : settings.active)
+        {
+            G4String value;
+            is >> value;
+            active = G4UIcommand::ConvertToBool(value);
+        }
+    }
+    else if (aCommand == fInitialStepCmd)
+        settings.initialStep = fInitialStepCmd->GetNewDoubleValue(aNewValue);
+    else if (aCommand == fToleranceCmd)
+        settings.tolerance = fToleranceCmd->GetNewDoubleValue(aNewValue);
+    else if (aCommand == fEventsCmd)
+    {
+        std::istringstream is(aNewValue);
+        is >> settings.minEvents >> settings.maxEvents;
+    }
+    else if (aCommand == fMaxEvaluationsCmd)
+        settings.maxEvaluations = fMaxEvaluationsCmd->GetNewIntValue(aNewValue);
+    else if (aCommand == fMinEntriesCmd)
+        settings.minEntries = fMinEntriesCmd->GetNewIntValue(aNewValue);
+    else if (aCommand == fObjectiveCmd)
+        settings.objective = aNewValue;
+    else if (aCommand == fRunCmd)
+        fOptimiser->Run();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PlasmaMLPALLASOptimiserMessenger::GetCurrentValue(G4UIcommand *aCommand)
+{
+    G4String cv;
+    const PlasmaMLPALLASOptimiser::Settings &settings = fOptimiser->GetSettings();
+
+    if (aCommand == fActiveCmd)
+    {
+        for (G4bool active : settings.active)
+            cv += (cv.empty() ? "" : " ") + G4UIcommand::ConvertToString(active);
+    }
+    else if (aCommand == fInitialStepCmd)
+        cv = fInitialStepCmd->ConvertToString(settings.initialStep, "T/m");
+    else if (aCommand == fToleranceCmd)
+        cv = fToleranceCmd->ConvertToString(settings.tolerance, "T/m");
+    else if (aCommand == fEventsCmd)
+        cv = std::to_string(settings.minEvents) + " " + std::to_string(settings.maxEvents);
+    else if (aCommand == fMaxEvaluationsCmd)
+        cv = fMaxEvaluationsCmd->ConvertToString(settings.maxEvaluations);
+    else if (aCommand == fMinEntriesCmd)
+        cv = fMinEntriesCmd->ConvertToString(static_cast<G4int>(settings.minEntries));
+    else if (aCommand == fObjectiveCmd)
+        cv = settings.objective;
+
+    return cv;
+}
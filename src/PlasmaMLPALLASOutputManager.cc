@@ -0,0 +1,364 @@
+/**
+ * @file PlasmaMLPALLASOutputManager.cc
+ * @brief Implementation of the final ROOT file and of the in-process merging.
+ *
+ * TBufferMerger merges the buffer of a worker file into the output in the
+ * thread calling TBufferMergerFile::Write(), one worker at a time; the
+ * output file itself is only written and closed by the destructor of the
+ * merger. The RNTuple parallel writers compress the clusters in the worker
+ * threads and only serialise the write of the pages to the final file;
+ * destroying a writer commits its RNTuple (footer and anchor). The chunks
+ * of a checkpointed job are closed files, merged at the end with
+ * TFileMerger as hadd would do.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASOutputManager.hh"
+#include "PlasmaMLPALLASOutputMessenger.hh"
+#include "G4ios.hh"
+#include "TFile.h"
+#include "Compression.h"
+#include "ROOT/TBufferMerger.hxx"
+#include "TFileMerger.h"
+#include <algorithm>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+    /** ROOT algorithm and default level of a codec, in the order of GetCodecNames() */
+    struct Codec
+    {
+        ROOT::RCompressionSetting::EAlgorithm::EValues algorithm;
+        G4int level;
+    };
+
+    const Codec kCodecs[] = {
+        {ROOT::RCompressionSetting::EAlgorithm::kUseGlobal, 0}, // default
+        {ROOT::RCompressionSetting::EAlgorithm::kZSTD, 5},
+        {ROOT::RCompressionSetting::EAlgorithm::kLZ4, 4},
+        {ROOT::RCompressionSetting::EAlgorithm::kZLIB, 1},
+        {ROOT::RCompressionSetting::EAlgorithm::kLZMA, 7},
+        {ROOT::RCompressionSetting::EAlgorithm::kUseGlobal, 0}, // none
+    };
+
+    /** Shell-style match of a name with * (any sequence) and ? (any character) */
+    G4bool Match(const char* pattern, const char* name)
+    {
+        if (*pattern == '\0')
+            return *name == '\0';
+        if (*pattern == '*')
+            return Match(pattern + 1, name) || (*name != '\0' && Match(pattern, name + 1));
+        return *name != '\0' && (*pattern == '?' || *pattern == *name) && Match(pattern + 1, name + 1);
+    }
+
+    /** Compression argument of TFile and TBufferMerger */
+    G4int FileCompression(G4int settings)
+    {
+        return settings < 0 ? ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault : settings;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASOutputManager& PlasmaMLPALLASOutputManager::Instance()
+{
+    static PlasmaMLPALLASOutputManager instance;
+    return instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASOutputManager::PlasmaMLPALLASOutputManager()
+{
+    // Screens of the routine analysis: 50 um pixels on BS1_YAG, the dispersed beam on BSPEC1_YAG
+    const PlasmaMLPALLASScreenImage::Binning bsyag = {200, -5., 5., 200, -5., 5.};
+    const PlasmaMLPALLASScreenImage::Binning bspecyag = {100, -5., 5., 900, -340., -250.};
+    fImageBinnings = {{"BSYAG_Hits", bsyag},
+                      {"BSYAG_Edep", bsyag},
+                      {"BSPECYAG_Hits", bspecyag},
+                      {"BSPECYAG_Edep", bspecyag},
+                      {"BSPECYAG_Spectrum", {450, -340., -250., 400, 0., 400.}}};
+
+    fMessenger = new PlasmaMLPALLASOutputMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASOutputManager::~PlasmaMLPALLASOutputManager()
+{
+    delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const std::vector<G4String>& PlasmaMLPALLASOutputManager::GetFormatNames()
+{
+    static const std::vector<G4String> names = {"ttree", "rntuple"};
+    return names;
+}
+
+const std::vector<G4String>& PlasmaMLPALLASOutputManager::GetCodecNames()
+{
+    static const std::vector<G4String> names = {"default", "zstd", "lz4", "zlib", "lzma", "none"};
+    return names;
+}
+
+const std::vector<G4String>& PlasmaMLPALLASOutputManager::GetImageFormatNames()
+{
+    static const std::vector<G4String> names = {"th2", "raw"};
+    return names;
+}
+
+const std::vector<G4String>& PlasmaMLPALLASOutputManager::GetImageNames()
+{
+    static const std::vector<G4String> names = {"BSYAG_Hits", "BSYAG_Edep", "BSPECYAG_Hits", "BSPECYAG_Edep", "BSPECYAG_Spectrum"};
+    return names;
+}
+
+G4bool PlasmaMLPALLASOutputManager::SetFormat(Format format)
+{
+#ifndef PLASMAMLPALLAS_WITH_RNTUPLE
+    if (format == Format::RNTuple)
+    {
+        G4Exception("PlasmaMLPALLASOutputManager::SetFormat", "OUT0003", JustWarning,
+                    "RNTuple output not compiled in (ROOT >= 6.34 with ROOTNTuple needed), the tables stay TTrees.");
+        return false;
+    }
+#endif
+    fFormat = format;
+    return true;
+}
+
+G4bool PlasmaMLPALLASOutputManager::SetCompression(const G4String& codec, G4int level)
+{
+    const auto& names = GetCodecNames();
+    if (std::find(names.begin(), names.end(), codec) == names.end())
+        return false;
+    fCodec = codec;
+    fCompressionLevel = std::clamp(level, 0, 9);
+    return true;
+}
+
+G4bool PlasmaMLPALLASOutputManager::SetImageBinning(const G4String& image, const PlasmaMLPALLASScreenImage::Binning& binning)
+{
+    const auto it = fImageBinnings.find(image);
+    if (it == fImageBinnings.end() || binning.nx < 1 || binning.ny < 1 ||
+        !(binning.xmax > binning.xmin) || !(binning.ymax > binning.ymin))
+    {
+        G4ExceptionDescription msg;
+        msg << "Unknown image " << image << " or empty binning: binning unchanged.";
+        G4Exception("PlasmaMLPALLASOutputManager::SetImageBinning", "OUT0004", JustWarning, msg);
+        return false;
+    }
+    it->second = binning;
+    return true;
+}
+
+const PlasmaMLPALLASScreenImage::Binning& PlasmaMLPALLASOutputManager::GetImageBinning(const G4String& image) const
+{
+    return fImageBinnings.at(image);
+}
+
+G4int PlasmaMLPALLASOutputManager::GetCompressionSettings() const
+{
+    if (fCodec == "default")
+        return -1;
+    if (fCodec == "none")
+        return 0;
+    const auto& names = GetCodecNames();
+    const Codec& codec = kCodecs[std::find(names.begin(), names.end(), fCodec) - names.begin()];
+    return ROOT::CompressionSettings(codec.algorithm, fCompressionLevel > 0 ? fCompressionLevel : codec.level);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASAsyncWriter* PlasmaMLPALLASOutputManager::GetAsyncWriter()
+{
+    std::lock_guard<std::mutex> lock(fAsyncWriterMutex);
+
+    // A new thread count applies once no table of the previous run is registered
+    if (fAsyncWriter && fAsyncWriter->GetNumberOfThreads() != fWriterThreads && fAsyncWriter->IsIdle())
+        fAsyncWriter.reset();
+    if (!fAsyncWriter && fWriterThreads > 0)
+        fAsyncWriter = std::make_unique<PlasmaMLPALLASAsyncWriter>(fWriterThreads);
+    return fWriterThreads > 0 ? fAsyncWriter.get() : nullptr;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PlasmaMLPALLASOutputManager::IsTableEnabled(const G4String& table) const
+{
+    G4bool enabled = true;
+    for (const SelectionRule& rule : fTableRules)
+        if (Match(rule.table.c_str(), table.c_str()))
+            enabled = rule.enabled;
+    return enabled;
+}
+
+G4bool PlasmaMLPALLASOutputManager::IsColumnEnabled(const G4String& table, const G4String& column) const
+{
+    if (column == "ScanIndex")
+        return true; // key of the scan points in every table
+
+    G4bool enabled = true;
+    for (const SelectionRule& rule : fColumnRules)
+        if (Match(rule.table.c_str(), table.c_str()) && Match(rule.column.c_str(), column.c_str()))
+            enabled = rule.enabled;
+    return enabled;
+}
+
+G4String PlasmaMLPALLASOutputManager::GetSelection() const
+{
+    G4String selection;
+    for (const SelectionRule& rule : fTableRules)
+        selection += (selection.empty() ? "" : ",") + rule.table + (rule.enabled ? "=on" : "=off");
+    for (const SelectionRule& rule : fColumnRules)
+        selection += (selection.empty() ? "" : ",") + rule.table + "." + rule.column + (rule.enabled ? "=on" : "=off");
+    return selection;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PlasmaMLPALLASOutputManager::GetOutputPath(const G4String& defaultName) const
+{
+    G4String name = fFileName.empty() ? defaultName : fFileName;
+    if (fs::path(name.c_str()).extension() == ".root")
+        name = fs::path(name.c_str()).replace_extension().string();
+    if (fChunkIndex >= 0)
+        name += "_chunk" + std::to_string(fChunkIndex);
+    name += ".root";
+    if (fDirectory.empty())
+        return name;
+
+    std::error_code ec;
+    fs::create_directories(fDirectory.c_str(), ec);
+    if (ec)
+    {
+        G4ExceptionDescription msg;
+        msg << "Cannot create the output directory " << fDirectory << ": " << ec.message();
+        G4Exception("PlasmaMLPALLASOutputManager::GetOutputPath", "OUT0001", JustWarning, msg);
+    }
+    return (fs::path(fDirectory.c_str()) / name.c_str()).string();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PlasmaMLPALLASOutputManager::MergeFiles(const std::vector<G4String>& inputs, const G4String& defaultName)
+{
+    const G4String path = GetOutputPath(defaultName);
+    TFileMerger merger(kFALSE, kFALSE);
+    merger.SetPrintLevel(0);
+    G4bool ok = merger.OutputFile(path.c_str(), "RECREATE", FileCompression(GetCompressionSettings()));
+    for (const G4String& input : inputs)
+        ok = ok && merger.AddFile(input.c_str(), kFALSE);
+    ok = ok && merger.Merge();
+
+    if (!ok)
+    {
+        G4ExceptionDescription msg;
+        msg << "Cannot merge the " << inputs.size() << " chunk files into " << path << ": they are kept.";
+        G4Exception("PlasmaMLPALLASOutputManager::MergeFiles", "OUT0005", JustWarning, msg);
+        return false;
+    }
+    G4cout << "Filename = " << path << " (merged from " << inputs.size() << " chunk files)" << G4endl;
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASOutputManager::OpenMerger(const G4String& defaultName,
+                                             const std::vector<const PlasmaMLPALLASOutputTable*>& tables)
+{
+    if (IsMerging())
+        return;
+    fMergerPath = GetOutputPath(defaultName);
+    const G4int compression = FileCompression(GetCompressionSettings());
+
+    if (fFormat == Format::TTree)
+    {
+        fMerger = std::make_unique<ROOT::TBufferMerger>(fMergerPath.c_str(), "RECREATE", compression);
+        G4cout << "Filename = " << fMergerPath << " (merged in memory from the worker threads)" << G4endl;
+        return;
+    }
+
+#ifdef PLASMAMLPALLAS_WITH_RNTUPLE
+    fMergedFile = std::make_shared<TFile>(fMergerPath.c_str(), "RECREATE", "", compression);
+    for (const PlasmaMLPALLASOutputTable* table : tables)
+        fParallelWriters[table->GetName()] = PlasmaMLPALLASRNTuple::RNTupleParallelWriter::Append(
+            table->CreateModel(), table->GetName(), *fMergedFile, GetWriteOptions());
+    G4cout << "Filename = " << fMergerPath << " (RNTuples filled in parallel by the worker threads)" << G4endl;
+#else
+    (void)tables;
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::shared_ptr<TFile> PlasmaMLPALLASOutputManager::OpenFile(const G4String& defaultName)
+{
+    std::shared_ptr<TFile> file;
+    if (fMergedFile)
+        return file; // the tables fill the contexts of the parallel writers
+    if (fMerger)
+        file = fMerger->GetFile();
+    else
+    {
+        const G4String path = GetOutputPath(defaultName);
+        G4cout << "Filename = " << path << G4endl;
+        file = std::make_shared<TFile>(path.c_str(), "RECREATE", "", FileCompression(GetCompressionSettings()));
+    }
+
+    if (!file || file->IsZombie())
+    {
+        G4ExceptionDescription msg;
+        msg << "Cannot open the output file of " << defaultName;
+        G4Exception("PlasmaMLPALLASOutputManager::OpenFile", "OUT0002", FatalException, msg);
+    }
+    file->cd();
+    return file;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASOutputManager::CloseMerger()
+{
+    fMerger.reset();
+
+#ifdef PLASMAMLPALLAS_WITH_RNTUPLE
+    fParallelWriters.clear();
+#endif
+    if (fMergedFile)
+    {
+        fMergedFile->Write();
+        fMergedFile.reset();
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifdef PLASMAMLPALLAS_WITH_RNTUPLE
+PlasmaMLPALLASRNTuple::RNTupleParallelWriter* PlasmaMLPALLASOutputManager::GetParallelWriter(const G4String& table) const
+{
+    const auto it = fParallelWriters.find(table);
+    return it != fParallelWriters.end() ? it->second.get() : nullptr;
+}
+
+PlasmaMLPALLASRNTuple::RNTupleWriteOptions PlasmaMLPALLASOutputManager::GetWriteOptions() const
+{
+    PlasmaMLPALLASRNTuple::RNTupleWriteOptions options;
+    const G4int compression = GetCompressionSettings();
+    if (compression >= 0)
+        options.SetCompression(compression);
+    if (fClusterSize > 0)
+        options.SetApproxZippedClusterSize(static_cast<std::size_t>(fClusterSize));
+    return options;
+}
+#endif
@@ -0,0 +1,364 @@
+#include "PlasmaMLPALLASOutputMessenger.hh"
+#include "PlasmaMLPALLASOutputManager.hh"
+#include "G4UIparameter.hh"
+#include <algorithm>
+#include <sstream>
+
+/**
+ * @file PlasmaMLPALLASOutputMessenger.cc
+ * @brief User interface (UI) messenger for the final ROOT file.
+ *
+ * Commands are organized in the /PlasmaMLPALLAS/output/ directory and allow users to:
+ *  - Set the directory and the name of the file written by the run (merged
+ *    in memory from the worker threads in multi-threaded runs).
+ *  - Write the tables as TTrees or RNTuples, with a codec and a cluster size.
+ *  - Keep only the per-run tables (beam moments) for scans and optimisations.
+ *  - Select the tables and the columns written, by name or wildcard pattern.
+ *  - Flush the tables every N events or bytes to bound the memory of long runs.
+ *  - Fill the tables in writer threads, with a bounded queue per table.
+ *  - Write the binned images of the YAG screens as TH2D or raw pixels.
+ *
+ * @authors Arnaud HUBER
+ * @authors Alexei SYTOV
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Constructor.
+ * @param output Pointer to the output manager.
+ */
+PlasmaMLPALLASOutputMessenger::PlasmaMLPALLASOutputMessenger(PlasmaMLPALLASOutputManager *output)
+    : G4UImessenger(), fOutput(output)
+{
+    fOutputDir = new G4UIdirectory("/PlasmaMLPALLAS/output/");
+    fOutputDir->SetGuidance("Final ROOT file of the run UI commands");
+
+    /**
+     * @brief Command to set the directory of the final file.
+     *
+     * Parameter: Directory (string), created if needed
+     */
+    fDirectoryCmd = new G4UIcmdWithAString("/PlasmaMLPALLAS/output/setDirectory", this);
+    fDirectoryCmd->SetGuidance("Directory of the ROOT file written by the run (default ../Resultats, created if needed)");
+    fDirectoryCmd->SetParameterName("Directory", false);
+    fDirectoryCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fDirectoryCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the name of the final file.
+     *
+     * Parameter: Name (string), ".root" appended if missing
+     */
+    fFileNameCmd = new G4UIcmdWithAString("/PlasmaMLPALLAS/output/setFileName", this);
+    fFileNameCmd->SetGuidance("Name of the ROOT file written by the run (default: name given on the command line)");
+    fFileNameCmd->SetParameterName("Name", false);
+    fFileNameCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFileNameCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to select the format of the tables.
+     */
+    G4String formats;
+    for (const auto &name : PlasmaMLPALLASOutputManager::GetFormatNames())
+        formats += (formats.empty() ? "" : " ") + name;
+
+    fFormatCmd = new G4UIcmdWithAString("/PlasmaMLPALLAS/output/setFormat", this);
+    fFormatCmd->SetGuidance("Layout of the tables in the file:");
+    fFormatCmd->SetGuidance("  ttree: one TTree per table (default)");
+    fFormatCmd->SetGuidance("  rntuple: one RNTuple per table, with the same fields (ROOT >= 6.34)");
+    fFormatCmd->SetParameterName("Format", false);
+    fFormatCmd->SetCandidates(formats);
+    fFormatCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFormatCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to select the codec.
+     *
+     * Parameters: Codec (string), Level (int, 0 for the default level of the codec)
+     */
+    G4String codecs;
+    for (const auto &name : PlasmaMLPALLASOutputManager::GetCodecNames())
+        codecs += (codecs.empty() ? "" : " ") + name;
+
+    fCompressionCmd = new G4UIcommand("/PlasmaMLPALLAS/output/setCompression", this);
+    fCompressionCmd->SetGuidance("Codec of the file: default (ROOT default of the format), zstd, lz4, zlib, lzma or none");
+    fCompressionCmd->SetGuidance("Level 1-9, 0 for the default level of the codec (zstd 5, lz4 4, zlib 1, lzma 7)");
+    auto *codec = new G4UIparameter("Codec", 's', false);
+    codec->SetParameterCandidates(codecs);
+    fCompressionCmd->SetParameter(codec);
+    auto *level = new G4UIparameter("Level", 'i', true);
+    level->SetDefaultValue(0);
+    level->SetParameterRange("Level>=0 && Level<=9");
+    fCompressionCmd->SetParameter(level);
+    fCompressionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fCompressionCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the cluster size.
+     */
+    fClusterSizeCmd = new G4UIcmdWithADouble("/PlasmaMLPALLAS/output/setClusterSize", this);
+    fClusterSizeCmd->SetGuidance("Zipped size of a cluster in MB (TTree auto-flush or RNTuple cluster), 0 for the ROOT default");
+    fClusterSizeCmd->SetParameterName("SizeMB", false);
+    fClusterSizeCmd->SetRange("SizeMB>=0.");
+    fClusterSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fClusterSizeCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to switch the per-event tables on or off.
+     */
+    fEventOutputCmd = new G4UIcmdWithABool("/PlasmaMLPALLAS/output/setEventOutput", this);
+    fEventOutputCmd->SetGuidance("Write the per-event tables (Input, QuadrupolesTracking, collimators, YAG screens)");
+    fEventOutputCmd->SetGuidance("false: only GlobalInput and the beam moments of BeamSummary, one row per run");
+    fEventOutputCmd->SetParameterName("EventOutput", false);
+    fEventOutputCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fEventOutputCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to enable or disable tables.
+     *
+     * Parameters: Table (name or pattern with * and ?), Enabled (bool)
+     */
+    fTableCmd = new G4UIcommand("/PlasmaMLPALLAS/output/setTable", this);
+    fTableCmd->SetGuidance("Write the matching tables or not: GlobalInput, Input, QuadrupolesTracking,");
+    fTableCmd->SetGuidance("Horizontal_Coll, Vertical_Coll, BSYAG, BSPECYAG, BeamSummary (* and ? wildcards)");
+    fTableCmd->SetGuidance("Rules apply in order, the last matching one wins: setTable * false, then setTable Input true");
+    fTableCmd->SetParameter(new G4UIparameter("Table", 's', false));
+    fTableCmd->SetParameter(new G4UIparameter("Enabled", 'b', false));
+    fTableCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fTableCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to enable or disable columns.
+     *
+     * Parameters: Table and Columns (names or patterns), Enabled (bool)
+     */
+    fColumnsCmd = new G4UIcommand("/PlasmaMLPALLAS/output/setColumns", this);
+    fColumnsCmd->SetGuidance("Write the matching columns of the matching tables or not (* and ? wildcards),");
+    fColumnsCmd->SetGuidance("e.g. QuadrupolesTracking *Mom_* false, QuadrupolesTracking Q2* false; ScanIndex is always written");
+    fColumnsCmd->SetParameter(new G4UIparameter("Table", 's', false));
+    fColumnsCmd->SetParameter(new G4UIparameter("Columns", 's', false));
+    fColumnsCmd->SetParameter(new G4UIparameter("Enabled", 'b', false));
+    fColumnsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fColumnsCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to forget the selection rules.
+     */
+    fClearSelectionCmd = new G4UIcommand("/PlasmaMLPALLAS/output/clearSelection", this);
+    fClearSelectionCmd->SetGuidance("Forget the setTable and setColumns rules: every table and column is written");
+    fClearSelectionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fClearSelectionCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to flush the tables every N events.
+     */
+    fFlushEventsCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/output/setFlushEvents", this);
+    fFlushEventsCmd->SetGuidance("Write the tables of each thread every N of its events (worker files merged and emptied)");
+    fFlushEventsCmd->SetGuidance("0 (default): the tables are written at the end of the run only");
+    fFlushEventsCmd->SetParameterName("Events", false);
+    fFlushEventsCmd->SetRange("Events>=0");
+    fFlushEventsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFlushEventsCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to flush the tables every N filled bytes.
+     */
+    fFlushSizeCmd = new G4UIcmdWithADouble("/PlasmaMLPALLAS/output/setFlushSize", this);
+    fFlushSizeCmd->SetGuidance("Write the tables of each thread every time they were filled with this many MB (uncompressed)");
+    fFlushSizeCmd->SetGuidance("0 (default): no limit; combined with setFlushEvents, the first limit reached flushes");
+    fFlushSizeCmd->SetParameterName("SizeMB", false);
+    fFlushSizeCmd->SetRange("SizeMB>=0.");
+    fFlushSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFlushSizeCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the number of writer threads.
+     */
+    fWriterThreadsCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/output/setWriterThreads", this);
+    fWriterThreadsCmd->SetGuidance("Fill and compress the tables in N writer threads shared by the Geant4 threads");
+    fWriterThreadsCmd->SetGuidance("0 (default): the Geant4 threads fill their tables themselves");
+    fWriterThreadsCmd->SetParameterName("Threads", false);
+    fWriterThreadsCmd->SetRange("Threads>=0");
+    fWriterThreadsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fWriterThreadsCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the queue size of the writer threads.
+     */
+    fQueueSizeCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/output/setQueueSize", this);
+    fQueueSizeCmd->SetGuidance("Entries queued per table for the writer threads (default 1024)");
+    fQueueSizeCmd->SetGuidance("A Geant4 thread waits for its writer when its queue is full");
+    fQueueSizeCmd->SetParameterName("Rows", false);
+    fQueueSizeCmd->SetRange("Rows>=2");
+    fQueueSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fQueueSizeCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to select the form of the screen images.
+     */
+    G4String imageFormats;
+    for (const auto &name : PlasmaMLPALLASOutputManager::GetImageFormatNames())
+        imageFormats += (imageFormats.empty() ? "" : " ") + name;
+
+    fImageFormatCmd = new G4UIcmdWithAString("/PlasmaMLPALLAS/output/setImageFormat", this);
+    fImageFormatCmd->SetGuidance("Form of the images of the YAG screens, written once per run:");
+    fImageFormatCmd->SetGuidance("  th2: one TH2D per image (default)");
+    fImageFormatCmd->SetGuidance("  raw: one row of the ScreenImages table, nx x ny float pixels per image");
+    fImageFormatCmd->SetParameterName("Format", false);
+    fImageFormatCmd->SetCandidates(imageFormats);
+    fImageFormatCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fImageFormatCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the grid of a screen image.
+     *
+     * Parameters: Image (string), Nx, Xmin, Xmax, Ny, Ymin, Ymax
+     */
+    G4String images;
+    for (const auto &name : PlasmaMLPALLASOutputManager::GetImageNames())
+        images += (images.empty() ? "" : " ") + name;
+
+    fImageBinningCmd = new G4UIcommand("/PlasmaMLPALLAS/output/setImageBinning", this);
+    fImageBinningCmd->SetGuidance("Grid of a screen image: x (mm) horizontally, z (mm) vertically;");
+    fImageBinningCmd->SetGuidance("BSPECYAG_Spectrum: z (mm) horizontally, kinetic energy (MeV) vertically");
+    fImageBinningCmd->SetGuidance("_Hits images sum the weights, _Edep images the deposited energy (keV)");
+    auto *image = new G4UIparameter("Image", 's', false);
+    image->SetParameterCandidates(images);
+    fImageBinningCmd->SetParameter(image);
+    fImageBinningCmd->SetParameter(new G4UIparameter("Nx", 'i', false));
+    fImageBinningCmd->SetParameter(new G4UIparameter("Xmin", 'd', false));
+    fImageBinningCmd->SetParameter(new G4UIparameter("Xmax", 'd', false));
+    fImageBinningCmd->SetParameter(new G4UIparameter("Ny", 'i', false));
+    fImageBinningCmd->SetParameter(new G4UIparameter("Ymin", 'd', false));
+    fImageBinningCmd->SetParameter(new G4UIparameter("Ymax", 'd', false));
+    fImageBinningCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fImageBinningCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Destructor.
+ */
+PlasmaMLPALLASOutputMessenger::~PlasmaMLPALLASOutputMessenger()
+{
+    delete fDirectoryCmd;
+    delete fFileNameCmd;
+    delete fFormatCmd;
+    delete fCompressionCmd;
+    delete fClusterSizeCmd;
+    delete fEventOutputCmd;
+    delete fTableCmd;
+    delete fColumnsCmd;
+    delete fClearSelectionCmd;
+    delete fFlushEventsCmd;
+    delete fFlushSizeCmd;
+    delete fWriterThreadsCmd;
+    delete fQueueSizeCmd;
+    delete fImageFormatCmd;
+    delete fImageBinningCmd;
+    delete fOutputDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASOutputMessenger::SetNewValue(G4UIcommand *aCommand, G4String aNewValue)
+{
+    if (aCommand == fDirectoryCmd)
+        fOutput->SetDirectory(aNewValue);
+    else if (aCommand == fFileNameCmd)
+        fOutput->SetFileName(aNewValue);
+    else if (aCommand == fFormatCmd)
+    {
+        const auto &names = PlasmaMLPALLASOutputManager::GetFormatNames();
+        const auto it = std::find(names.begin(), names.end(), aNewValue);
+        fOutput->SetFormat(static_cast<PlasmaMLPALLASOutputManager::Format>(it - names.begin()));
+    }
+    else if (aCommand == fCompressionCmd)
+    {
+        std::istringstream is(aNewValue);
+        G4String codec;
+        G4int level = 0;
+        is >> codec >> level;
+        fOutput->SetCompression(codec, level);
+    }
+    else if (aCommand == fClusterSizeCmd)
+        fOutput->SetClusterSize(static_cast<Long64_t>(fClusterSizeCmd->GetNewDoubleValue(aNewValue) * 1024. * 1024.));
+    else if (aCommand == fEventOutputCmd)
+        fOutput->SetEventOutput(fEventOutputCmd->GetNewBoolValue(aNewValue));
+    else if (aCommand == fTableCmd)
+    {
+        std::istringstream is(aNewValue);
+        G4String table, enabled;
+        is >> table >> enabled;
+        fOutput->SetTableEnabled(table, G4UIcommand::ConvertToBool(enabled));
+    }
+    else if (aCommand == fColumnsCmd)
+    {
+        std::istringstream is(aNewValue);
+        G4String table, columns, enabled;
+        is >> table >> columns >> enabled;
+        fOutput->SetColumnsEnabled(table, columns, G4UIcommand::ConvertToBool(enabled));
+    }
+    else if (aCommand == fClearSelectionCmd)
+        fOutput->ClearSelection();
+    else if (aCommand == fFlushEventsCmd)
+        fOutput->SetFlushEvents(fFlushEventsCmd->GetNewIntValue(aNewValue));
+    else if (aCommand == fFlushSizeCmd)
+        fOutput->SetFlushSize(static_cast<Long64_t>(fFlushSizeCmd->GetNewDoubleValue(aNewValue) * 1024. * 1024.));
+    else if (aCommand == fWriterThreadsCmd)
+        fOutput->SetWriterThreads(fWriterThreadsCmd->GetNewIntValue(aNewValue));
+    else if (aCommand == fQueueSizeCmd)
+        fOutput->SetQueueSize(fQueueSizeCmd->GetNewIntValue(aNewValue));
+    else if (aCommand == fImageFormatCmd)
+    {
+        const auto &names = PlasmaMLPALLASOutputManager::GetImageFormatNames();
+        const auto it = std::find(names.begin(), names.end(), aNewValue);
+        fOutput->SetImageFormat(static_cast<PlasmaMLPALLASOutputManager::ImageFormat>(it - names.begin()));
+    }
+    else if (aCommand == fImageBinningCmd)
+    {
+        std::istringstream is(aNewValue);
+        G4String image;
+        PlasmaMLPALLASScreenImage::Binning binning;
+        is >> image >> binning.nx >> binning.xmin >> binning.xmax >> binning.ny >> binning.ymin >> binning.ymax;
+        fOutput->SetImageBinning(image, binning);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PlasmaMLPALLASOutputMessenger::GetCurrentValue(G4UIcommand *aCommand)
+{
+    G4String cv;
+
+    if (aCommand == fDirectoryCmd)
+        cv = fOutput->GetDirectory();
+    else if (aCommand == fFileNameCmd)
+        cv = fOutput->GetFileName();
+    else if (aCommand == fFormatCmd)
+        cv = PlasmaMLPALLASOutputManager::GetFormatNames()[static_cast<size_t>(fOutput->GetFormat())];
+    else if (aCommand == fCompressionCmd)
+        cv = fOutput->GetCodec() + " " + std::to_string(fOutput->GetCompressionLevel());
+    else if (aCommand == fClusterSizeCmd)
+        cv = fClusterSizeCmd->ConvertToString(fOutput->GetClusterSize() / (1024. * 1024.));
+    else if (aCommand == fEventOutputCmd)
+        cv = fEventOutputCmd->ConvertToString(fOutput->GetEventOutput());
+    else if (aCommand == fTableCmd || aCommand == fColumnsCmd)
+        cv = fOutput->GetSelection();
+    else if (aCommand == fFlushEventsCmd)
+        cv = fFlushEventsCmd->ConvertToString(fOutput->GetFlushEvents());
+    else if (aCommand == fFlushSizeCmd)
+        cv = fFlushSizeCmd->ConvertToString(fOutput->GetFlushSize() / (1024. * 1024.));
+    else if (aCommand == fWriterThreadsCmd)
+        cv = fWriterThreadsCmd->ConvertToString(fOutput->GetWriterThreads());
+    else if (aCommand == fQueueSizeCmd)
+        cv = fQueueSizeCmd->ConvertToString(fOutput->GetQueueSize());
+    else if (aCommand == fImageFormatCmd)
+        cv = PlasmaMLPALLASOutputManager::GetImageFormatNames()[static_cast<size_t>(fOutput->GetImageFormat())];
+
+    return cv;
+}
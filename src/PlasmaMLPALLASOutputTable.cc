@@ -0,0 +1,442 @@
+/**
+ * @file PlasmaMLPALLASOutputTable.cc
+ * @brief Implementation of the output tables, as TTrees or RNTuples.
+ *
+ * The RNTuple entry of a thread is bound to the same variables as the
+ * branches of the TTree, so both formats share the statistics structures of
+ * the run action and no value is copied at Fill(). With writer threads the
+ * branches and fields read a row owned by the table instead, refreshed by
+ * the writer thread from the queued rows.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASOutputTable.hh"
+#include "PlasmaMLPALLASOutputManager.hh"
+#include "TFile.h"
+#include "TTree.h"
+#include <algorithm>
+#include <thread>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASOutputTable::PlasmaMLPALLASOutputTable(const G4String& name, const G4String& title)
+    : fName(name), fTitle(title)
+{
+}
+
+PlasmaMLPALLASOutputTable::~PlasmaMLPALLASOutputTable()
+{
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASOutputTable::AddColumn(const G4String& name, int* address) { AddColumn(name, Type::Int, address); }
+void PlasmaMLPALLASOutputTable::AddColumn(const G4String& name, float* address) { AddColumn(name, Type::Float, address); }
+void PlasmaMLPALLASOutputTable::AddColumn(const G4String& name, Long64_t* address) { AddColumn(name, Type::Long64, address); }
+void PlasmaMLPALLASOutputTable::AddColumn(const G4String& name, std::vector<float>* address) { AddColumn(name, Type::VectorFloat, address); }
+void PlasmaMLPALLASOutputTable::AddColumn(const G4String& name, std::vector<int>* address) { AddColumn(name, Type::VectorInt, address); }
+void PlasmaMLPALLASOutputTable::AddColumn(const G4String& name, std::vector<std::string>* address) { AddColumn(name, Type::VectorString, address); }
+
+void PlasmaMLPALLASOutputTable::AddColumn(const G4String& name, Type type, void* address)
+{
+    fColumns.push_back({name, type, address, fTypeCount[static_cast<size_t>(type)]++});
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::vector<PlasmaMLPALLASOutputTable::Column> PlasmaMLPALLASOutputTable::SelectedColumns() const
+{
+    const PlasmaMLPALLASOutputManager& output = PlasmaMLPALLASOutputManager::Instance();
+    std::vector<Column> columns;
+    for (const Column& column : fColumns)
+        if (output.IsColumnEnabled(fName, column.name))
+            columns.push_back(column);
+    return columns;
+}
+
+void* PlasmaMLPALLASOutputTable::Address(const Column& column) const
+{
+    if (!fBound)
+        return column.address;
+
+    switch (column.type)
+    {
+    case Type::Int:
+        return &fBound->ints[column.slot];
+    case Type::Float:
+        return &fBound->floats[column.slot];
+    case Type::Long64:
+        return &fBound->longs[column.slot];
+    case Type::VectorFloat:
+        return &fBound->floatVectors[column.slot];
+    case Type::VectorInt:
+        return &fBound->intVectors[column.slot];
+    case Type::VectorString:
+        return &fBound->stringVectors[column.slot];
+    }
+    return nullptr;
+}
+
+void PlasmaMLPALLASOutputTable::CreateBranches()
+{
+    for (const Column& column : fOpenColumns)
+    {
+        const char* name = column.name.c_str();
+        void* address = Address(column);
+        switch (column.type)
+        {
+        case Type::Int:
+            fTree->Branch(name, static_cast<int*>(address), (column.name + "/I").c_str());
+            break;
+        case Type::Float:
+            fTree->Branch(name, static_cast<float*>(address), (column.name + "/F").c_str());
+            break;
+        case Type::Long64:
+            fTree->Branch(name, static_cast<Long64_t*>(address), (column.name + "/L").c_str());
+            break;
+        case Type::VectorFloat:
+            fTree->Branch(name, "vector<float>", address);
+            break;
+        case Type::VectorInt:
+            fTree->Branch(name, "vector<int>", address);
+            break;
+        case Type::VectorString:
+            fTree->Branch(name, "vector<string>", address);
+            break;
+        }
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASOutputTable::Open(TFile* file)
+{
+    PlasmaMLPALLASOutputManager& output = PlasmaMLPALLASOutputManager::Instance();
+    fOpenColumns = SelectedColumns();
+    fCountBytes = output.GetFlushSize() > 0;
+    fFilledBytes = 0;
+
+    // Writer threads: the branches read a row of the table, the queues hold the others
+    if (PlasmaMLPALLASAsyncWriter* async = output.GetAsyncWriter())
+    {
+        const size_t nRows = static_cast<size_t>(std::max(output.GetQueueSize(), 2));
+        fBound = MakeRow();
+        fQueued = std::make_unique<PlasmaMLPALLASRingBuffer<Row*>>(nRows);
+        fFree = std::make_unique<PlasmaMLPALLASRingBuffer<Row*>>(nRows);
+        for (size_t i = 0; i < nRows; ++i)
+        {
+            fRows.push_back(MakeRow());
+            fFree->TryPush(fRows.back().get());
+        }
+        fPushed = 0;
+        fWritten.store(0, std::memory_order_relaxed);
+        fAsync = async;
+    }
+
+    if (output.GetFormat() == PlasmaMLPALLASOutputManager::Format::TTree)
+    {
+        file->cd();
+        fTree = new TTree(fName.c_str(), fTitle.c_str());
+        if (output.GetClusterSize() > 0)
+            fTree->SetAutoFlush(-output.GetClusterSize());
+        CreateBranches();
+    }
+#ifdef PLASMAMLPALLAS_WITH_RNTUPLE
+    else
+    {
+        if (PlasmaMLPALLASRNTuple::RNTupleParallelWriter* writer = output.GetParallelWriter(fName))
+        {
+            fContext = writer->CreateFillContext();
+            fEntry = fContext->CreateEntry();
+        }
+        else
+        {
+            fWriter = PlasmaMLPALLASRNTuple::RNTupleWriter::Append(CreateModel(), fName, *file, output.GetWriteOptions());
+            fEntry = fWriter->CreateEntry();
+        }
+        Bind();
+    }
+#endif
+
+    // Registered last: the writer thread sees the table complete
+    if (fAsync)
+        fAsync->Register(this, file);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PlasmaMLPALLASOutputTable::IsOpen() const
+{
+#ifdef PLASMAMLPALLAS_WITH_RNTUPLE
+    if (fEntry)
+        return true;
+#endif
+    return fTree != nullptr;
+}
+
+void PlasmaMLPALLASOutputTable::Fill()
+{
+    if (fCountBytes)
+        fFilledBytes += RowBytes();
+
+    if (!fAsync)
+    {
+        Write();
+        return;
+    }
+
+    // Back-pressure: every row is queued, wait for the writer thread to free one
+    Row* row = nullptr;
+    while (!fFree->TryPop(row))
+        std::this_thread::yield();
+    Encode(*row);
+    fQueued->TryPush(row); // never full: it can hold all the rows
+    ++fPushed;
+}
+
+void PlasmaMLPALLASOutputTable::Write()
+{
+    if (fTree)
+    {
+        fTree->Fill();
+        return;
+    }
+
+#ifdef PLASMAMLPALLAS_WITH_RNTUPLE
+    if (fContext)
+        fContext->Fill(*fEntry);
+    else if (fWriter)
+        fWriter->Fill(*fEntry);
+#endif
+}
+
+G4bool PlasmaMLPALLASOutputTable::Drain()
+{
+    G4bool drained = false;
+    Row* row = nullptr;
+    while (fQueued->TryPop(row))
+    {
+        Decode(*row);
+        Write();
+        fFree->TryPush(row);
+        fWritten.store(fWritten.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        drained = true;
+    }
+    return drained;
+}
+
+void PlasmaMLPALLASOutputTable::WaitWritten() const
+{
+    while (fWritten.load(std::memory_order_acquire) != fPushed)
+        std::this_thread::yield();
+}
+
+void PlasmaMLPALLASOutputTable::Flush()
+{
+    // The writer thread has no row left: nothing else uses the tree or the context until the next Fill()
+    if (fAsync)
+        WaitWritten();
+    fFilledBytes = 0;
+
+    if (fTree)
+    {
+        fTree->FlushBaskets();
+        return;
+    }
+
+#ifdef PLASMAMLPALLAS_WITH_RNTUPLE
+    if (fContext)
+        fContext->FlushCluster();
+    else if (fWriter)
+        fWriter->CommitCluster();
+#endif
+}
+
+void PlasmaMLPALLASOutputTable::Close()
+{
+    if (fAsync)
+    {
+        // The queued rows go to the tree or the fill context before they are flushed
+        WaitWritten();
+        fAsync->Unregister(this);
+        fAsync = nullptr;
+        fQueued.reset();
+        fFree.reset();
+        fRows.clear();
+    }
+
+    fTree = nullptr;
+
+#ifdef PLASMAMLPALLAS_WITH_RNTUPLE
+    // A worker flushes its last cluster, a sequential writer commits the RNTuple into the file
+    fEntry.reset();
+    fContext.reset();
+    fWriter.reset();
+#endif
+    fBound.reset();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+Long64_t PlasmaMLPALLASOutputTable::RowBytes() const
+{
+    Long64_t bytes = 0;
+    for (const Column& column : fOpenColumns)
+    {
+        switch (column.type)
+        {
+        case Type::Int:
+            bytes += sizeof(int);
+            break;
+        case Type::Float:
+            bytes += sizeof(float);
+            break;
+        case Type::Long64:
+            bytes += sizeof(Long64_t);
+            break;
+        case Type::VectorFloat:
+            bytes += static_cast<const std::vector<float>*>(column.address)->size() * sizeof(float);
+            break;
+        case Type::VectorInt:
+            bytes += static_cast<const std::vector<int>*>(column.address)->size() * sizeof(int);
+            break;
+        case Type::VectorString:
+            for (const std::string& value : *static_cast<const std::vector<std::string>*>(column.address))
+                bytes += value.size();
+            break;
+        }
+    }
+    return bytes;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::unique_ptr<PlasmaMLPALLASOutputTable::Row> PlasmaMLPALLASOutputTable::MakeRow() const
+{
+    auto row = std::make_unique<Row>();
+    row->ints.resize(fTypeCount[static_cast<size_t>(Type::Int)]);
+    row->floats.resize(fTypeCount[static_cast<size_t>(Type::Float)]);
+    row->longs.resize(fTypeCount[static_cast<size_t>(Type::Long64)]);
+    row->floatVectors.resize(fTypeCount[static_cast<size_t>(Type::VectorFloat)]);
+    row->intVectors.resize(fTypeCount[static_cast<size_t>(Type::VectorInt)]);
+    row->stringVectors.resize(fTypeCount[static_cast<size_t>(Type::VectorString)]);
+    return row;
+}
+
+void PlasmaMLPALLASOutputTable::Encode(Row& row) const
+{
+    // The vectors keep the capacity of the previous use of the row
+    for (const Column& column : fOpenColumns)
+    {
+        switch (column.type)
+        {
+        case Type::Int:
+            row.ints[column.slot] = *static_cast<const int*>(column.address);
+            break;
+        case Type::Float:
+            row.floats[column.slot] = *static_cast<const float*>(column.address);
+            break;
+        case Type::Long64:
+            row.longs[column.slot] = *static_cast<const Long64_t*>(column.address);
+            break;
+        case Type::VectorFloat:
+            row.floatVectors[column.slot] = *static_cast<const std::vector<float>*>(column.address);
+            break;
+        case Type::VectorInt:
+            row.intVectors[column.slot] = *static_cast<const std::vector<int>*>(column.address);
+            break;
+        case Type::VectorString:
+            row.stringVectors[column.slot] = *static_cast<const std::vector<std::string>*>(column.address);
+            break;
+        }
+    }
+}
+
+void PlasmaMLPALLASOutputTable::Decode(const Row& row)
+{
+    // Element-wise: the bound slots keep the addresses given to the branches and fields
+    std::copy(row.ints.begin(), row.ints.end(), fBound->ints.begin());
+    std::copy(row.floats.begin(), row.floats.end(), fBound->floats.begin());
+    std::copy(row.longs.begin(), row.longs.end(), fBound->longs.begin());
+    std::copy(row.floatVectors.begin(), row.floatVectors.end(), fBound->floatVectors.begin());
+    std::copy(row.intVectors.begin(), row.intVectors.end(), fBound->intVectors.begin());
+    std::copy(row.stringVectors.begin(), row.stringVectors.end(), fBound->stringVectors.begin());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifdef PLASMAMLPALLAS_WITH_RNTUPLE
+namespace
+{
+    /** Add a field to a bare model (no default entry to hold its value) */
+    template <typename T>
+    void AddField(PlasmaMLPALLASRNTuple::RNTupleModel& model, const G4String& name)
+    {
+        model.AddField(std::make_unique<PlasmaMLPALLASRNTuple::RField<T>>(name));
+    }
+}
+
+std::unique_ptr<PlasmaMLPALLASRNTuple::RNTupleModel> PlasmaMLPALLASOutputTable::CreateModel() const
+{
+    auto model = PlasmaMLPALLASRNTuple::RNTupleModel::CreateBare();
+    model->SetDescription(fTitle);
+    for (const Column& column : SelectedColumns())
+    {
+        switch (column.type)
+        {
+        case Type::Int:
+            AddField<int>(*model, column.name);
+            break;
+        case Type::Float:
+            AddField<float>(*model, column.name);
+            break;
+        case Type::Long64:
+            AddField<std::int64_t>(*model, column.name);
+            break;
+        case Type::VectorFloat:
+            AddField<std::vector<float>>(*model, column.name);
+            break;
+        case Type::VectorInt:
+            AddField<std::vector<int>>(*model, column.name);
+            break;
+        case Type::VectorString:
+            AddField<std::vector<std::string>>(*model, column.name);
+            break;
+        }
+    }
+    return model;
+}
+
+void PlasmaMLPALLASOutputTable::Bind()
+{
+    for (const Column& column : fOpenColumns)
+    {
+        void* address = Address(column);
+        switch (column.type)
+        {
+        case Type::Int:
+            fEntry->BindRawPtr(column.name, static_cast<int*>(address));
+            break;
+        case Type::Float:
+            fEntry->BindRawPtr(column.name, static_cast<float*>(address));
+            break;
+        case Type::Long64:
+            fEntry->BindRawPtr(column.name, reinterpret_cast<std::int64_t*>(address));
+            break;
+        case Type::VectorFloat:
+            fEntry->BindRawPtr(column.name, static_cast<std::vector<float>*>(address));
+            break;
+        case Type::VectorInt:
+            fEntry->BindRawPtr(column.name, static_cast<std::vector<int>*>(address));
+            break;
+        case Type::VectorString:
+            fEntry->BindRawPtr(column.name, static_cast<std::vector<std::string>*>(address));
+            break;
+        }
+    }
+}
+#endif
@@ -0,0 +1,150 @@
+/**
+ * @file PlasmaMLPALLASPhaseSpaceFile.cc
+ * @brief Implementation of the memory-mapped phase-space source.
+ *
+ * Mappings are kept in a process-wide registry by path, so that all worker
+ * threads asking for the same file share one mapping; the registry only holds
+ * weak references and the file is unmapped once no generator uses it.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASPhaseSpaceFile.hh"
+#include "G4ios.hh"
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+    constexpr char kMagic[8] = {'P', 'M', 'L', 'P', 'S', 'P', 'C', '1'};
+
+    /**
+     * @brief Header of the binary phase-space file
+     */
+    struct PhaseSpaceHeader {
+        char magic[8];
+        std::uint64_t count;
+    };
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Map the file and check its header against its size
+ * @param path Binary phase-space file
+ */
+PlasmaMLPALLASPhaseSpaceFile::PlasmaMLPALLASPhaseSpaceFile(const G4String& path)
+    : fMapping(path)
+{
+    if (!fMapping.IsOpen())
+    {
+        G4Exception("PlasmaMLPALLASPhaseSpaceFile", "PSF0001", FatalException,
+                    ("Cannot map phase-space file " + path + ": " + fMapping.GetError()).c_str());
+        return;
+    }
+
+    PhaseSpaceHeader header;
+    if (fMapping.GetSize() < sizeof(header))
+    {
+        G4Exception("PlasmaMLPALLASPhaseSpaceFile", "PSF0002", FatalException,
+                    ("Phase-space file " + path + " is too short.").c_str());
+        return;
+    }
+
+    std::memcpy(&header, fMapping.GetData(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.count == 0 ||
+        fMapping.GetSize() != sizeof(header) + header.count * sizeof(PhaseSpaceRecord))
+    {
+        G4Exception("PlasmaMLPALLASPhaseSpaceFile", "PSF0002", FatalException,
+                    ("Phase-space file " + path + " has an invalid header or size.").c_str());
+        return;
+    }
+
+    fRecords = reinterpret_cast<const PhaseSpaceRecord*>(fMapping.GetData() + sizeof(header));
+    fCount = header.count;
+
+    G4cout << "Phase-space file " << path << " mapped: " << fCount << " macro-particles" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Get the mapping of a phase-space file, shared by all threads
+ * @param path Binary phase-space file
+ * @return Existing mapping of the file, or a new one
+ */
+std::shared_ptr<const PlasmaMLPALLASPhaseSpaceFile> PlasmaMLPALLASPhaseSpaceFile::Open(const G4String& path)
+{
+    static std::mutex registryMutex;
+    static std::map<std::string, std::weak_ptr<const PlasmaMLPALLASPhaseSpaceFile>> registry;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    std::shared_ptr<const PlasmaMLPALLASPhaseSpaceFile> file = registry[path].lock();
+    if (!file)
+    {
+        file.reset(new PlasmaMLPALLASPhaseSpaceFile(path));
+        registry[path] = file;
+    }
+
+    return file;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Convert a CSV table into a binary phase-space file
+ * @param csvFile Input table (x,y,z,ux,uy,uz,Ekin,weight per line, in mm and MeV)
+ * @param binaryFile Output binary file
+ * @return Number of records written
+ *
+ * Commas, semicolons and tabs are accepted as separators, and lines that do
+ * not hold eight numbers (headers, comments) are skipped.
+ */
+size_t PlasmaMLPALLASPhaseSpaceFile::ConvertCSV(const G4String& csvFile, const G4String& binaryFile)
+{
+    std::ifstream in(csvFile);
+    std::ofstream out(binaryFile, std::ios::binary);
+    if (!in || !out)
+    {
+        G4Exception("PlasmaMLPALLASPhaseSpaceFile", "PSF0003", FatalException,
+                    ("Cannot convert " + csvFile + " into " + binaryFile).c_str());
+        return 0;
+    }
+
+    // The count is only known at the end: write the header last
+    PhaseSpaceHeader header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.count = 0;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        for (char& c : line)
+            if (c == ',' || c == ';' || c == '\t')
+                c = ' ';
+
+        std::istringstream is(line);
+        PhaseSpaceRecord record;
+        if (!(is >> record.x >> record.y >> record.z >> record.ux >> record.uy >> record.uz
+                 >> record.Ekin >> record.weight))
+            continue;
+
+        out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        ++header.count;
+    }
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    return header.count;
+}
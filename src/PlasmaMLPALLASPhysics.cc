@@ -15,10 +15,17 @@
  *  - Gamma-nuclear interactions
  *  - Electromagnetic physics with high-precision settings
  *  - Decay and radioactive decay processes
+ *  - Fast simulation for e-, e+ and protons (linear-optics transport)
  *
  * The class also configures the nuclide table to store unstable isotopes with
- * half-lives above a threshold and sets default production cuts for secondary
- * particles.
+ * half-lives above a threshold and sets the production cuts for secondary
+ * particles: the default cut for the beamline, and their own cuts for the
+ * "YAGScreens" and "Collimators" regions created by the geometry.
+ *
+ * The hadronic and radioactive decay modules depend on the preset:
+ *  - full: the list above (default);
+ *  - dose: hadronics without the HP neutron data, no radioactive decay;
+ *  - optics: no hadronics nor radioactive decay, for beam transport studies.
  *
  * Usage:
  *  - Instantiate `PlasmaMLPALLASPhysics` and set it as the physics list in
@@ -34,6 +41,15 @@
 
 
 #include "PlasmaMLPALLASPhysics.hh"
+#include "PlasmaMLPALLASPhysicsMessenger.hh"
+#include "PlasmaMLPALLASStartupCache.hh"
+#include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4StateManager.hh"
+#include "G4Threading.hh"
+#include <sstream>
 
 // ============================================================
 // Constructor
@@ -44,9 +60,10 @@
  * The constructor:
  *  - Sets the verbosity level for physics processes.
  *  - Configures the nuclide table for radioactive decay handling.
- *  - Registers high-precision hadronic physics for neutrons and ions.
- *  - Adds electromagnetic physics with high-accuracy settings.
- *  - Includes decay and radioactive decay processes.
+ *  - Registers the modules of the default (full) preset: high-precision
+ *    hadronic physics for neutrons and ions, electromagnetic physics with
+ *    high-accuracy settings, decay and radioactive decay processes.
+ *  - Creates the UI commands of the preset and of the region cuts.
  */
 PlasmaMLPALLASPhysics::PlasmaMLPALLASPhysics()
 {
@@ -63,42 +80,190 @@ PlasmaMLPALLASPhysics::PlasmaMLPALLASPhysics()
     // =============================
     // Physics Modules Registration
     // =============================
+    RegisterPresetPhysics();
 
-    // --- Hadron Elastic Scattering ---
-    RegisterPhysics(new G4HadronElasticPhysicsHP(verb)); ///< High-precision elastic scattering for low-energy neutrons
+    fMessenger = new PlasmaMLPALLASPhysicsMessenger(this);
+}
 
-    // --- Hadron Inelastic Physics ---
-    RegisterPhysics(new G4HadronPhysicsQGSP_BIC_HP(verb)); ///< Binary Cascade model + HP neutron model
+// ============================================================
+// Destructor
+// ============================================================
+/**
+ * @brief Destructor (no manual cleanup required, Geant4 handles physics constructors).
+ */
+PlasmaMLPALLASPhysics::~PlasmaMLPALLASPhysics()
+{
+    delete fMessenger;
+}
 
-    // --- Ion Elastic Scattering ---
-    RegisterPhysics(new G4IonElasticPhysics(verb));
+// ============================================================
+// Presets
+// ============================================================
+const std::vector<G4String> &PlasmaMLPALLASPhysics::GetPresetNames()
+{
+    static const std::vector<G4String> names = {"optics", "dose", "full"};
+    return names;
+}
 
-    // --- Ion Inelastic Physics ---
-    RegisterPhysics(new G4IonPhysicsXS(verb)); ///< Uses cross-section data for ion interactions
+const std::vector<G4String> &PlasmaMLPALLASPhysics::GetCutRegionNames()
+{
+    static const std::vector<G4String> names = {"beamline", "yag", "collimators"};
+    return names;
+}
 
-    // --- Stopping Physics ---
-    RegisterPhysics(new G4StoppingPhysics(verb)); ///< Handles particles coming to rest
+/**
+ * @brief Registers the modules of the current preset, in the order of the full list.
+ *
+ * The HP neutron data and the radioactive decay are only needed for the
+ * dose studies of the full preset; skipping them saves most of the
+ * initialisation time of an optics run.
+ */
+void PlasmaMLPALLASPhysics::RegisterPresetPhysics()
+{
+    const G4int verb = verboseLevel;
+
+    if (fPreset == Preset::Full)
+    {
+        // --- Hadron Elastic Scattering ---
+        fModules.push_back(new G4HadronElasticPhysicsHP(verb)); ///< High-precision elastic scattering for low-energy neutrons
+
+        // --- Hadron Inelastic Physics ---
+        fModules.push_back(new G4HadronPhysicsQGSP_BIC_HP(verb)); ///< Binary Cascade model + HP neutron model
+    }
+    else if (fPreset == Preset::Dose)
+    {
+        fModules.push_back(new G4HadronElasticPhysics(verb));
+        fModules.push_back(new G4HadronPhysicsQGSP_BIC(verb));
+    }
 
-    // --- Gamma-Nuclear Physics ---
-    RegisterPhysics(new G4EmExtraPhysics()); ///< Includes gamma-nuclear interactions
+    if (fPreset != Preset::Optics)
+    {
+        // --- Ion Elastic Scattering ---
+        fModules.push_back(new G4IonElasticPhysics(verb));
+
+        // --- Ion Inelastic Physics ---
+        fModules.push_back(new G4IonPhysicsXS(verb)); ///< Uses cross-section data for ion interactions
+
+        // --- Stopping Physics ---
+        fModules.push_back(new G4StoppingPhysics(verb)); ///< Handles particles coming to rest
+
+        // --- Gamma-Nuclear Physics ---
+        fModules.push_back(new G4EmExtraPhysics()); ///< Includes gamma-nuclear interactions
+    }
 
     // --- Electromagnetic Physics ---
-    RegisterPhysics(new G4EmStandardPhysics_option3()); ///< High-precision EM physics
+    fModules.push_back(new G4EmStandardPhysics_option3()); ///< High-precision EM physics
 
     // --- Decay Processes ---
-    RegisterPhysics(new G4DecayPhysics());
+    fModules.push_back(new G4DecayPhysics());
 
     // --- Radioactive Decay ---
-    RegisterPhysics(new G4RadioactiveDecayPhysics());
+    if (fPreset == Preset::Full)
+        fModules.push_back(new G4RadioactiveDecayPhysics());
+
+    // --- Fast Simulation ---
+    // Linear-optics transport of the charged beam particles (model in the "LinearOptics" region)
+    auto fastSimulationPhysics = new G4FastSimulationPhysics();
+    fastSimulationPhysics->ActivateFastSimulation("e-");
+    fastSimulationPhysics->ActivateFastSimulation("e+");
+    fastSimulationPhysics->ActivateFastSimulation("proton");
+    fModules.push_back(fastSimulationPhysics);
+
+    for (G4VPhysicsConstructor *physics : fModules)
+        RegisterPhysics(physics);
+}
+
+/**
+ * @brief Replaces the modules of the current preset.
+ *
+ * All the modules are registered again so that the order of the full list is
+ * kept. The particles are already built at this point; the modules of every
+ * preset only use the standard ones, built by the decay physics.
+ */
+void PlasmaMLPALLASPhysics::SetPreset(Preset preset)
+{
+    if (preset == fPreset)
+        return;
+
+    if (G4StateManager::GetStateManager()->GetCurrentState() != G4State_PreInit)
+    {
+        G4Exception("PlasmaMLPALLASPhysics::SetPreset", "PHY0001", JustWarning,
+                    "The physics preset can only be changed before /run/initialize, command ignored.");
+        return;
+    }
+
+    for (G4VPhysicsConstructor *physics : fModules)
+    {
+        RemovePhysics(physics);
+        delete physics;
+    }
+    fModules.clear();
+
+    fPreset = preset;
+    RegisterPresetPhysics();
 }
 
 // ============================================================
-// Destructor
+// Region cuts
 // ============================================================
+void PlasmaMLPALLASPhysics::SetRegionCut(CutRegion region, G4double cut)
+{
+    // Cached tables of the configuration set up at /run/initialize no longer apply
+    if (G4StateManager::GetStateManager()->GetCurrentState() == G4State_Idle)
+        PlasmaMLPALLASStartupCache::Instance().DiscardPhysicsTables(this);
+
+    switch (region)
+    {
+    case CutRegion::Beamline:
+        SetDefaultCutValue(cut);
+        break;
+    case CutRegion::YAG:
+        fYAGCut = cut;
+        SetRegionProductionCuts("YAGScreens", cut);
+        break;
+    case CutRegion::Collimators:
+        fCollimatorCut = cut;
+        SetRegionProductionCuts("Collimators", cut);
+        break;
+    }
+}
+
+G4double PlasmaMLPALLASPhysics::GetRegionCut(CutRegion region) const
+{
+    switch (region)
+    {
+    case CutRegion::YAG:
+        return EffectiveCut(fYAGCut);
+    case CutRegion::Collimators:
+        return EffectiveCut(fCollimatorCut);
+    default:
+        return GetDefaultCutValue();
+    }
+}
+
 /**
- * @brief Destructor (no manual cleanup required, Geant4 handles physics constructors).
+ * @brief Give a region its own production cuts, or the default ones.
+ *
+ * An unset cut (negative) makes the region share the cuts of the default
+ * region, so that /run/setCut and the beamline cut keep applying to it.
  */
-PlasmaMLPALLASPhysics::~PlasmaMLPALLASPhysics() {}
+void PlasmaMLPALLASPhysics::SetRegionProductionCuts(const G4String &regionName, G4double cut)
+{
+    G4Region *region = G4RegionStore::GetInstance()->GetRegion(regionName, false);
+    if (!region)
+        return;
+
+    G4ProductionCuts *defaultCuts = G4ProductionCutsTable::GetProductionCutsTable()->GetDefaultProductionCuts();
+    if (cut < 0.)
+    {
+        region->SetProductionCuts(defaultCuts);
+        return;
+    }
+
+    if (!region->GetProductionCuts() || region->GetProductionCuts() == defaultCuts)
+        region->SetProductionCuts(new G4ProductionCuts());
+    region->GetProductionCuts()->SetProductionCut(cut);
+}
 
 // ============================================================
 // SetCuts
@@ -106,8 +271,11 @@ PlasmaMLPALLASPhysics::~PlasmaMLPALLASPhysics() {}
 /**
  * @brief Sets the default production thresholds ("cuts") for secondary particles.
  *
- * This method is called automatically by Geant4 during initialization.
- * The default cut values are chosen to balance accuracy and performance.
+ * This method is called automatically by Geant4 during initialization,
+ * after the geometry has created its regions. The default cut applies to the
+ * rest of the beamline (bulk steel), the YAG screens and the collimator jaws
+ * get their own value once set (they follow the default cut until then). With a startup cache, the physics tables of the same
+ * configuration are then retrieved instead of built.
  */
 void PlasmaMLPALLASPhysics::SetCuts()
 {
@@ -115,4 +283,17 @@ void PlasmaMLPALLASPhysics::SetCuts()
         G4cout << "PlasmaMLPALLASPhysics::SetCuts" << G4endl;
     }
     SetCutsWithDefault();
+
+    // The regions and their cuts are shared: the master sets them
+    if (!G4Threading::IsMasterThread())
+        return;
+
+    SetRegionProductionCuts("YAGScreens", fYAGCut);
+    SetRegionProductionCuts("Collimators", fCollimatorCut);
+
+    // Physics tables of this configuration from the startup cache, if any
+    std::ostringstream configuration;
+    configuration << GetPresetNames()[static_cast<size_t>(fPreset)] << ' ' << defaultCutValue << ' '
+                  << EffectiveCut(fYAGCut) << ' ' << EffectiveCut(fCollimatorCut);
+    PlasmaMLPALLASStartupCache::Instance().PreparePhysicsTables(this, configuration.str());
 }
@@ -0,0 +1,135 @@
+#include "PlasmaMLPALLASPhysicsMessenger.hh"
+#include "PlasmaMLPALLASPhysics.hh"
+#include "G4UIparameter.hh"
+#include "G4UnitsTable.hh"
+#include <algorithm>
+#include <sstream>
+
+/**
+ * @file PlasmaMLPALLASPhysicsMessenger.cc
+ * @brief User interface (UI) messenger for the physics preset and the region cuts.
+ *
+ * Commands are organized in the /PlasmaMLPALLAS/physics/ directory and allow users to:
+ *  - Select the hadronic and decay modules (optics, dose or full), before
+ *    /run/initialize.
+ *  - Set the production cut of the YAG screens, of the collimator jaws and
+ *    of the rest of the beamline.
+ *
+ * @authors Arnaud HUBER
+ * @authors Alexei SYTOV
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Constructor.
+ * @param physics Pointer to the physics list.
+ */
+PlasmaMLPALLASPhysicsMessenger::PlasmaMLPALLASPhysicsMessenger(PlasmaMLPALLASPhysics *physics)
+    : G4UImessenger(), fPhysics(physics)
+{
+    fPhysicsDir = new G4UIdirectory("/PlasmaMLPALLAS/physics/");
+    fPhysicsDir->SetGuidance("Physics preset and production cuts UI commands");
+
+    /**
+     * @brief Command to select the preset.
+     */
+    G4String presets;
+    for (const auto &name : PlasmaMLPALLASPhysics::GetPresetNames())
+        presets += (presets.empty() ? "" : " ") + name;
+
+    fPresetCmd = new G4UIcmdWithAString("/PlasmaMLPALLAS/physics/setPreset", this);
+    fPresetCmd->SetGuidance("Hadronic and decay modules of the physics list:");
+    fPresetCmd->SetGuidance("  optics: EM, decay and fast simulation only");
+    fPresetCmd->SetGuidance("  dose: adds hadronics without the HP neutron data");
+    fPresetCmd->SetGuidance("  full: HP hadronics and radioactive decay (default)");
+    fPresetCmd->SetParameterName("Preset", false);
+    fPresetCmd->SetCandidates(presets);
+    fPresetCmd->AvailableForStates(G4State_PreInit);
+    fPresetCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the production cut of a region.
+     *
+     * Parameters: Region (string), Cut (double), Unit (string)
+     */
+    G4String regions;
+    for (const auto &name : PlasmaMLPALLASPhysics::GetCutRegionNames())
+        regions += (regions.empty() ? "" : " ") + name;
+
+    fRegionCutCmd = new G4UIcommand("/PlasmaMLPALLAS/physics/setRegionCut", this);
+    fRegionCutCmd->SetGuidance("Production cut of a region (all particles)");
+    fRegionCutCmd->SetGuidance("  beamline: rest of the beamline (default region of the world)");
+    fRegionCutCmd->SetGuidance("  yag: YAG screens");
+    fRegionCutCmd->SetGuidance("  collimators: collimator jaws");
+    auto *region = new G4UIparameter("Region", 's', false);
+    region->SetParameterCandidates(regions);
+    fRegionCutCmd->SetParameter(region);
+    auto *cut = new G4UIparameter("Cut", 'd', false);
+    cut->SetParameterRange("Cut>0.");
+    fRegionCutCmd->SetParameter(cut);
+    auto *unit = new G4UIparameter("Unit", 's', true);
+    unit->SetDefaultUnit("mm");
+    fRegionCutCmd->SetParameter(unit);
+    fRegionCutCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fRegionCutCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Destructor.
+ */
+PlasmaMLPALLASPhysicsMessenger::~PlasmaMLPALLASPhysicsMessenger()
+{
+    delete fPresetCmd;
+    delete fRegionCutCmd;
+    delete fPhysicsDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASPhysicsMessenger::SetNewValue(G4UIcommand *aCommand, G4String aNewValue)
+{
+    if (aCommand == fPresetCmd)
+    {
+        const auto &names = PlasmaMLPALLASPhysics::GetPresetNames();
+        const auto it = std::find(names.begin(), names.end(), aNewValue);
+        fPhysics->SetPreset(static_cast<PlasmaMLPALLASPhysics::Preset>(it - names.begin()));
+    }
+    else if (aCommand == fRegionCutCmd)
+    {
+        std::istringstream is(aNewValue);
+        G4String regionName, unit;
+        G4double value = 0.;
+        is >> regionName >> value >> unit;
+
+        const auto &names = PlasmaMLPALLASPhysics::GetCutRegionNames();
+        const auto it = std::find(names.begin(), names.end(), regionName);
+        fPhysics->SetRegionCut(static_cast<PlasmaMLPALLASPhysics::CutRegion>(it - names.begin()),
+                               value * G4UIcommand::ValueOf(unit));
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PlasmaMLPALLASPhysicsMessenger::GetCurrentValue(G4UIcommand *aCommand)
+{
+    G4String cv;
+
+    if (aCommand == fPresetCmd)
+        cv = PlasmaMLPALLASPhysics::GetPresetNames()[static_cast<size_t>(fPhysics->GetPreset())];
+    else if (aCommand == fRegionCutCmd)
+    {
+        std::ostringstream os;
+        const auto &names = PlasmaMLPALLASPhysics::GetCutRegionNames();
+        for (size_t i = 0; i < names.size(); ++i)
+            os << (i ? ", " : "") << names[i] << " "
+               << G4BestUnit(fPhysics->GetRegionCut(static_cast<PlasmaMLPALLASPhysics::CutRegion>(i)), "Length");
+        cv = os.str();
+    }
+
+    return cv;
+}
@@ -5,22 +5,29 @@
  * This file implements the `PlasmaMLPALLASPrimaryGeneratorAction` class, which handles
  * the generation of primary particles for Geant4 events in the PALLAS project.
  * 
- * Two generation modes are supported:
+ * Three generation modes are supported:
  *  1. **ONNX model inference**: Beam parameters (energy, charge, emittance, transverse 
  *     positions, and momenta) are predicted by a neural network model and used to 
  *     configure the particle gun.
  *  2. **Geant4 GeneralParticleSource (GPS)**: Standard Geant4 particle generation.
+ *  3. **Phase-space file**: Macro-particles of a PIC-simulated bunch, read in
+ *     place from a memory-mapped binary file shared by all threads.
  *
  * Features:
- *  - Thread-safe generation using atomic counters and per-thread UI handling.
- *  - Progress display with estimated remaining simulation time.
+ *  - Thread-safe generation with per-thread UI handling.
+ *  - Per-event reads only touch the immutable run configuration snapshot
+ *    installed at BeginOfRunAction (resolved particle, ONNX inputs, optics).
  *  - Energy smearing with Gaussian fluctuations.
+ *  - Bunch mode: each event holds K primaries drawn from the same moments,
+ *    each weighted by the number of real particles it represents (Q/(e*K)).
+ *  - Transverse phase space drawn by blocks from a per-thread sampler, with
+ *    source Twiss parameters configurable per plane.
  *
  * Usage:
  *  - Instantiate the class and assign it to the Geant4 run manager via `SetUserAction`.
  *  - Configure the ONNX model or GPS via the associated messenger.
  *
- * @note Multithreading is supported; thread 0 handles progress display.
+ * @note Multithreading is supported; progress is reported by PlasmaMLPALLASProgressMonitor.
  *
  * @authors Arnaud HUBER <huber@lp2ib.in2p3.fr>
  * @authors Alexei SYTOV <sytov@infn.it>
@@ -30,9 +37,7 @@
 
 
 #include "PlasmaMLPALLASPrimaryGeneratorAction.hh"
-
-/// Global counter of generated particles (atomic to support multithreading).
-std::atomic<size_t> currentParticleNumber{0};
+#include "G4PhysicalConstants.hh"
 
 /// Global pointer to the Geant4 UI manager.
 G4UImanager *UI = G4UImanager::GetUIpointer();
@@ -58,7 +63,8 @@ PlasmaMLPALLASPrimaryGeneratorAction::PlasmaMLPALLASPrimaryGeneratorAction(size_
   fPrimaryGeneratorMessenger = new PlasmaMLPALLASPrimaryGeneratorMessenger(this);
   particleGun = new G4ParticleGun(1);
   particleSource = new G4GeneralParticleSource();
-  onnxInference = std::make_unique<PlasmaMLPALLASOnnxInference>("model2.onnx");
+  onnxInference = std::make_unique<PlasmaMLPALLASOnnxInference>();
+  fRunConfig = std::make_shared<const PlasmaMLPALLASRunConfig>();
 }
 
 /**
@@ -72,56 +78,53 @@ PlasmaMLPALLASPrimaryGeneratorAction::~PlasmaMLPALLASPrimaryGeneratorAction()
   delete particleSource;
 }
 
-void PlasmaMLPALLASPrimaryGeneratorAction::UpdateParticleDefinition()
+/**
+ * @brief Install the configuration snapshot of the run.
+ *
+ * Everything that only depends on the configuration is applied here, once
+ * per run: the particle definition of the gun and the source optics.
+ *
+ * @param config Immutable configuration published at BeginOfRunAction.
+ */
+void PlasmaMLPALLASPrimaryGeneratorAction::SetRunConfig(std::shared_ptr<const PlasmaMLPALLASRunConfig> config)
 {
-  particleDefinition = G4ParticleTable::GetParticleTable()->FindParticle(OnnxParameters::Instance().GetParticleName());
+  fRunConfig = std::move(config);
 
-  if (!particleDefinition)
+  if (fRunConfig->statusONNX >= 1 && !fRunConfig->particle)
   {
-    G4cerr << "Particle doesn't exist : RUN ABORT" << G4endl;
+    G4cerr << "Particle " << fRunConfig->particleName << " doesn't exist : RUN ABORT" << G4endl;
     G4RunManager::GetRunManager()->AbortRun();
     return;
   }
+
+  if (fRunConfig->particle)
+    particleGun->SetParticleDefinition(fRunConfig->particle);
+
+  // The mapping is shared by all threads and only reopened when the file changes
+  if (fRunConfig->statusONNX == 2 &&
+      (!phaseSpaceFile || phaseSpaceFile->GetPath() != fRunConfig->phaseSpaceFile))
+    phaseSpaceFile = PlasmaMLPALLASPhaseSpaceFile::Open(fRunConfig->phaseSpaceFile);
+  phaseSpaceWrapped = false;
+
+  beamSampler.SetTwiss(fRunConfig->twissX, fRunConfig->twissZ);
 }
 
 /**
- * @brief Display the progress of event generation.
+ * @brief Assign a statistical weight to the vertices generated in this event.
  *
- * Prints a progress bar along with an estimate of the remaining simulation time.
+ * The vertex list is walked once from its first new element, which keeps the
+ * cost linear in the bunch size.
  *
- * @param progress Fraction of events completed (between 0 and 1).
- * @param startTime Start time of the simulation.
+ * @param anEvent Event holding the vertices.
+ * @param firstVertex Index of the first vertex to weight.
+ * @param weight Weight given to every primary of these vertices.
  */
-void PlasmaMLPALLASPrimaryGeneratorAction::ShowProgress(
-    double progress,
-    std::chrono::high_resolution_clock::time_point startTime)
+void PlasmaMLPALLASPrimaryGeneratorAction::SetVertexWeights(G4Event *anEvent, G4int firstVertex, G4double weight)
 {
-    int barWidth = 70;
-    std::ostringstream oss;
-
-    oss << "\r[";  // retour chariot pour écraser la ligne
-    int pos = static_cast<int>(barWidth * progress);
-    for (int i = 0; i < barWidth; ++i) {
-        if (i < pos) oss << "=";
-        else if (i == pos) oss << ">";
-        else oss << " ";
-    }
-    oss << "] " << int(progress * 100.0) << " %";
-
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    auto elapsedTime = std::chrono::duration_cast<std::chrono::seconds>(currentTime - startTime).count();
-
-    double averageTimePerProgress = (progress > 0.0) ? (elapsedTime / progress) : 0.0;
-    double estimatedRemainingTime = (1.0 - progress) * averageTimePerProgress;
-
-    oss << " | ETA = " << std::fixed << std::setprecision(1)
-        << estimatedRemainingTime / 60.0 << " min";
-
-    if (progress >0.01) std::cerr << oss.str() << std::flush;
+  for (G4PrimaryVertex *vertex = anEvent->GetPrimaryVertex(firstVertex); vertex; vertex = vertex->GetNext())
+    vertex->SetWeight(weight);
 }
 
-
-
 /**
  * @brief Generate primary particles for a simulation event.
  *
@@ -129,31 +132,24 @@ void PlasmaMLPALLASPrimaryGeneratorAction::ShowProgress(
  *  - Uses the ONNX model inference to generate beam parameters and configure
  *    the particle gun.
  *  - Uses the Geant4 GeneralParticleSource (GPS) to generate the particle.
+ *  - Reads the primaries of the event from the mapped phase-space file.
+ *
+ * In all cases the event receives /PlasmaMLPALLAS/gun/setBunchSize primaries,
+ * one per vertex, so that their track IDs run from 1 to the bunch size.
  *
  * @param anEvent Pointer to the Geant4 event where primary particles are generated.
  */
 void PlasmaMLPALLASPrimaryGeneratorAction::GeneratePrimaries(G4Event *anEvent)
 {
-  if (!isStartTimeInitialized)
-  {
-    startTime = std::chrono::high_resolution_clock::now();
-    isStartTimeInitialized = true;
-  }
-
-  // Récupération thread-safe des paramètres définis par le messenger
-  OnnxParameters &params = OnnxParameters::Instance();
+  // Configuration frozen for the whole run at BeginOfRunAction
+  const PlasmaMLPALLASRunConfig &config = *fRunConfig;
+  const G4int bunchSize = config.bunchSize;
 
-  UpdateParticleDefinition();
-
-  // Copie des autres paramètres atomiques
-  int status = params.GetStatusONNX();
-  double xoff = params.GetXoff();
-  double a0 = params.GetA0();
-  double cn2 = params.GetCN2();
-  double pressure = params.GetPressure();
+  // Primaries of this call are appended after any vertex already in the event
+  const G4int firstVertex = anEvent->GetNumberOfPrimaryVertex();
 
   // ####################### CASE 1 : GENERATION FROM ONNX MODEL ##########################
-  if (status == 1)
+  if (config.statusONNX == 1)
   {
     if (!onnxInference)
     {
@@ -161,36 +157,71 @@ void PlasmaMLPALLASPrimaryGeneratorAction::GeneratePrimaries(G4Event *anEvent)
       return;
     }
 
-    BeamParameters params = onnxInference->GenerateBeam(xoff, a0, cn2, pressure);
+    // Moments are only re-predicted when the laser/plasma inputs change
+    const BeamMoments &moments = onnxInference->PredictMoments(config.xoff, config.a0, config.cn2, config.pressure);
+
+    Ekin = moments.Ekin;
+    dEkin = moments.dEkin;
+    Q = moments.Q;
+    epsb = moments.epsb;
 
-    Ekin = params.Ekin;
-    dEkin = params.dEkin;
-    Q = params.Q;
-    epsb = params.epsb;
+    // Every event is one bunch replica: its K macro-particles share the predicted charge
+    const G4double weight = std::abs(Q) / CLHEP::e_SI / bunchSize;
 
-    // Add Gaussian fluctuation to kinetic energy
-    params.Ekin = G4RandGauss::shoot(params.Ekin, params.dEkin * params.Ekin);
+    for (G4int i = 0; i < bunchSize; ++i)
+    {
+      // Draw the transverse phase space and the smeared kinetic energy from the pre-sampled block
+      const PhaseSpaceSample sample = beamSampler.Next(moments);
 
-    // Set particle parameters
-    particleGun->SetParticleDefinition(particleDefinition);
-    particleGun->SetParticleEnergy(params.Ekin);
-    particleGun->SetParticlePosition(G4ThreeVector(params.x, 0, params.z));
+      particleGun->SetParticleEnergy(sample.Ekin);
+      particleGun->SetParticlePosition(G4ThreeVector(sample.x, 0, sample.z));
 
-    G4double MomentumDirectionY = 1. / (1. + std::pow(std::tan(params.xp), 2) + std::pow(std::tan(params.zp), 2));
-    particleGun->SetParticleMomentumDirection(
-        G4ThreeVector(MomentumDirectionY * std::tan(params.xp),
-                      MomentumDirectionY,
-                      MomentumDirectionY * std::tan(params.zp)));
+      G4double MomentumDirectionY = 1. / (1. + std::pow(std::tan(sample.xp), 2) + std::pow(std::tan(sample.zp), 2));
+      particleGun->SetParticleMomentumDirection(
+          G4ThreeVector(MomentumDirectionY * std::tan(sample.xp),
+                        MomentumDirectionY,
+                        MomentumDirectionY * std::tan(sample.zp)));
+
+      particleGun->GeneratePrimaryVertex(anEvent);
+    }
 
-    particleGun->GeneratePrimaryVertex(anEvent);
-    currentParticleNumber++;
+    SetVertexWeights(anEvent, firstVertex, weight);
   }
 
   // ############################ CASE 2 : GENERATION FROM GPS ############################
-  else if (status == 0)
+  else if (config.statusONNX == 0)
   {
-    particleSource->GeneratePrimaryVertex(anEvent);
-    currentParticleNumber++;
+    for (G4int i = 0; i < bunchSize; ++i)
+      particleSource->GeneratePrimaryVertex(anEvent);
+  }
+
+  // ###################### CASE 3 : GENERATION FROM A PHASE-SPACE FILE ######################
+  else if (config.statusONNX == 2)
+  {
+    // Event i reads the records [i*K, (i+1)*K): workers get disjoint slices of
+    // the shared mapping through their event IDs, whatever the thread count;
+    // the chunks of a checkpointed job carry on after the events of the previous ones
+    const size_t firstRecord = static_cast<size_t>(config.firstEvent + anEvent->GetEventID()) * bunchSize;
+    if (!phaseSpaceWrapped && firstRecord + bunchSize > phaseSpaceFile->GetNumberOfRecords())
+    {
+      G4Exception("PrimaryGeneratorAction", "PGA0002", JustWarning,
+                  "More primaries requested than stored in the phase-space file: records are reused.");
+      phaseSpaceWrapped = true;
+    }
+
+    G4PrimaryVertex *vertex = nullptr;
+    for (G4int i = 0; i < bunchSize; ++i)
+    {
+      const PhaseSpaceRecord &record = phaseSpaceFile->GetRecord(firstRecord + i);
+
+      particleGun->SetParticleEnergy(record.Ekin * MeV);
+      particleGun->SetParticlePosition(G4ThreeVector(record.x, record.y, record.z) * mm);
+      particleGun->SetParticleMomentumDirection(G4ThreeVector(record.ux, record.uy, record.uz));
+      particleGun->GeneratePrimaryVertex(anEvent);
+
+      vertex = vertex ? vertex->GetNext() : anEvent->GetPrimaryVertex(firstVertex);
+      vertex->SetWeight(record.weight);
+    }
   }
 
   else
@@ -198,11 +229,4 @@ void PlasmaMLPALLASPrimaryGeneratorAction::GeneratePrimaries(G4Event *anEvent)
     G4Exception("PrimaryGeneratorAction", "PGA0001", FatalException,
                 "Incorrect ONNX Status.");
   }
-
-  
-  if (threadID == 0)
-    {
-      ShowProgress(double(currentParticleNumber) / double(NEventsGenerated), startTime);
-    }
-    
 }
@@ -1,4 +1,6 @@
 #include "PlasmaMLPALLASPrimaryGeneratorMessenger.hh"
+#include "CLHEP/Units/SystemOfUnits.h"
+#include <sstream>
 
 /**
  * @file PlasmaMLPALLASPrimaryGeneratorMessenger.cc
@@ -8,8 +10,12 @@
  * generator and machine-learning-based laser parameters in the PALLAS simulation.
  * 
  * It allows users to:
- *  - Enable or disable ONNX-based particle generation.
+ *  - Select the primary source: GPS, ONNX-based generation or a memory-mapped
+ *    phase-space file.
  *  - Set the particle type for the simulation.
+ *  - Set the number of weighted primaries generated in each event (bunch mode).
+ *  - Set the Twiss parameters (alpha, beta, emittance ratio) of the source
+ *    in each transverse plane.
  *  - Configure laser parameters such as focus offset, normalized vector potential,
  *    dopant fraction in the target chamber, and gas pressure.
  *
@@ -17,8 +23,9 @@
  *  - /PlasmaMLPALLAS/gun/ for particle gun-related commands
  *  - /PlasmaMLPALLAS/laser/ for laser-related parameters
  *
- * The messenger interacts with the `PlasmaMLPALLASPrimaryGeneratorAction` and
- * `OnnxParameters` singleton to apply changes in real time.
+ * The messenger stores the values in the per-thread `OnnxParameters` staging
+ * area; they take effect at the next run, when `PlasmaMLPALLASRunAction`
+ * publishes the `PlasmaMLPALLASRunConfig` snapshot of the generator.
  *
  * Usage:
  *  - Instantiate the messenger with a pointer to the primary generator action.
@@ -59,16 +66,17 @@ PlasmaMLPALLASPrimaryGeneratorMessenger::PlasmaMLPALLASPrimaryGeneratorMessenger
     //=====================================
 
     /**
-     * @brief Command to enable or disable ONNX feature for the gun.
+     * @brief Command to select the primary source of the gun.
      *
-     * Parameter: StatusONNX (0 or 1)
-     * - 0: Disable ONNX
-     * - 1: Enable ONNX
+     * Parameter: StatusONNX (0, 1 or 2)
+     * - 0: GPS
+     * - 1: ONNX model
+     * - 2: Memory-mapped phase-space file
      */
     fGunStatusONNXCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/gun/setStatusONNX", this);
-    fGunStatusONNXCmd->SetGuidance("Enable or disable the feature (0/1)");
+    fGunStatusONNXCmd->SetGuidance("Select the primary source (0 GPS / 1 ONNX / 2 phase-space file)");
     fGunStatusONNXCmd->SetParameterName("StatusONNX", false);
-    fGunStatusONNXCmd->SetRange("StatusONNX==0 || StatusONNX==1");
+    fGunStatusONNXCmd->SetRange("StatusONNX>=0 && StatusONNX<=2");
     fGunStatusONNXCmd->AvailableForStates(G4State_PreInit, G4State_Idle, G4State_GeomClosed);
     fGunStatusONNXCmd->SetToBeBroadcasted(true);
 
@@ -83,6 +91,39 @@ PlasmaMLPALLASPrimaryGeneratorMessenger::PlasmaMLPALLASPrimaryGeneratorMessenger
     fGunParticleNameCmd->AvailableForStates(G4State_PreInit, G4State_Idle, G4State_GeomClosed);
     fGunParticleNameCmd->SetToBeBroadcasted(true);
 
+    /**
+     * @brief Command to set the phase-space file read by the status-2 source.
+     *
+     * Parameter: PhaseSpaceFile (string)
+     */
+    fGunPhaseSpaceFileCmd = new G4UIcmdWithAString("/PlasmaMLPALLAS/gun/setPhaseSpaceFile", this);
+    fGunPhaseSpaceFileCmd->SetGuidance("Set the binary phase-space file used with setStatusONNX 2");
+    fGunPhaseSpaceFileCmd->SetGuidance("Produced from a CSV table with ./PlasmaMLPALLAS --phasespace in.csv out.bin");
+    fGunPhaseSpaceFileCmd->SetParameterName("PhaseSpaceFile", false);
+    fGunPhaseSpaceFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fGunPhaseSpaceFileCmd->SetToBeBroadcasted(true);
+
+    /**
+     * @brief Command to set the number of primaries generated in each event.
+     *
+     * Parameter: BunchSize (integer >= 1)
+     */
+    fGunBunchSizeCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/gun/setBunchSize", this);
+    fGunBunchSizeCmd->SetGuidance("Set the number of primaries drawn from the same moments in each event");
+    fGunBunchSizeCmd->SetGuidance("Each primary carries the weight Q/(e*BunchSize) in ONNX mode");
+    fGunBunchSizeCmd->SetParameterName("BunchSize", false);
+    fGunBunchSizeCmd->SetRange("BunchSize>=1");
+    fGunBunchSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fGunBunchSizeCmd->SetToBeBroadcasted(true);
+
+    /**
+     * @brief Commands to set the source Twiss parameters of each transverse plane.
+     *
+     * Parameters: alpha, beta (mm), emittance ratio eps/epsb
+     */
+    fGunTwissXCmd = CreateTwissCommand("/PlasmaMLPALLAS/gun/setTwissX", "x");
+    fGunTwissZCmd = CreateTwissCommand("/PlasmaMLPALLAS/gun/setTwissZ", "z");
+
     //=====================================
     // Laser Commands
     //=====================================
@@ -134,6 +175,38 @@ PlasmaMLPALLASPrimaryGeneratorMessenger::PlasmaMLPALLASPrimaryGeneratorMessenger
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+/**
+ * @brief Create a command taking the Twiss alpha, beta and emittance ratio of one plane.
+ * @param path Command path.
+ * @param plane Plane name used in the guidance.
+ * @return New command.
+ */
+G4UIcommand *PlasmaMLPALLASPrimaryGeneratorMessenger::CreateTwissCommand(const G4String &path, const G4String &plane)
+{
+    auto *cmd = new G4UIcommand(path, this);
+    cmd->SetGuidance(("Set the source Twiss parameters of the " + plane + " plane").c_str());
+    cmd->SetGuidance(("alpha, beta in mm and emittance ratio eps_" + plane + "/epsb").c_str());
+    cmd->SetGuidance("Defaults (0, 1 mm, 0.4 for x and 1 for z) reproduce the historical sampling");
+
+    auto *alpha = new G4UIparameter("alpha", 'd', false);
+    cmd->SetParameter(alpha);
+
+    auto *beta = new G4UIparameter("beta", 'd', false);
+    beta->SetParameterRange("beta>0.");
+    cmd->SetParameter(beta);
+
+    auto *ratio = new G4UIparameter("ratio", 'd', false);
+    ratio->SetParameterRange("ratio>0.");
+    cmd->SetParameter(ratio);
+
+    cmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    cmd->SetToBeBroadcasted(true);
+
+    return cmd;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 /**
  * @brief Destructor.
  *
@@ -143,6 +216,10 @@ PlasmaMLPALLASPrimaryGeneratorMessenger::~PlasmaMLPALLASPrimaryGeneratorMessenge
 {
     delete fGunStatusONNXCmd;
     delete fGunParticleNameCmd;
+    delete fGunBunchSizeCmd;
+    delete fGunPhaseSpaceFileCmd;
+    delete fGunTwissXCmd;
+    delete fGunTwissZCmd;
     delete fLaserOffsetCmd;
     delete fLaserNormVecPotentialCmd;
     delete fLaserFracDopTargetChamberCmd;
@@ -166,6 +243,21 @@ void PlasmaMLPALLASPrimaryGeneratorMessenger::SetNewValue(G4UIcommand *aCommand,
         OnnxParameters::Instance().SetStatusONNX(fGunStatusONNXCmd->GetNewIntValue(aNewValue));
     else if (aCommand == fGunParticleNameCmd)
         OnnxParameters::Instance().SetParticleName(aNewValue);
+    else if (aCommand == fGunPhaseSpaceFileCmd)
+        OnnxParameters::Instance().SetPhaseSpaceFile(aNewValue);
+    else if (aCommand == fGunBunchSizeCmd)
+        OnnxParameters::Instance().SetBunchSize(fGunBunchSizeCmd->GetNewIntValue(aNewValue));
+    else if (aCommand == fGunTwissXCmd || aCommand == fGunTwissZCmd)
+    {
+        G4double alpha = 0., beta = 1., ratio = 1.;
+        std::istringstream is(aNewValue);
+        is >> alpha >> beta >> ratio;
+
+        if (aCommand == fGunTwissXCmd)
+            OnnxParameters::Instance().SetTwissX(alpha, beta * CLHEP::mm, ratio);
+        else
+            OnnxParameters::Instance().SetTwissZ(alpha, beta * CLHEP::mm, ratio);
+    }
     else if (aCommand == fLaserOffsetCmd)
         OnnxParameters::Instance().SetXoff(fLaserOffsetCmd->GetNewDoubleValue(aNewValue));
     else if (aCommand == fLaserNormVecPotentialCmd)
@@ -195,6 +287,24 @@ G4String PlasmaMLPALLASPrimaryGeneratorMessenger::GetCurrentValue(G4UIcommand *a
         cv = fGunStatusONNXCmd->ConvertToString(OnnxParameters::Instance().GetStatusONNX());
     else if (aCommand == fGunParticleNameCmd)
         cv = OnnxParameters::Instance().GetParticleName();
+    else if (aCommand == fGunPhaseSpaceFileCmd)
+        cv = OnnxParameters::Instance().GetPhaseSpaceFile();
+    else if (aCommand == fGunBunchSizeCmd)
+        cv = fGunBunchSizeCmd->ConvertToString(OnnxParameters::Instance().GetBunchSize());
+    else if (aCommand == fGunTwissXCmd)
+    {
+        std::ostringstream os;
+        os << OnnxParameters::Instance().GetAlphaX() << " " << OnnxParameters::Instance().GetBetaX() / CLHEP::mm
+           << " " << OnnxParameters::Instance().GetEmittanceRatioX();
+        cv = os.str();
+    }
+    else if (aCommand == fGunTwissZCmd)
+    {
+        std::ostringstream os;
+        os << OnnxParameters::Instance().GetAlphaZ() << " " << OnnxParameters::Instance().GetBetaZ() / CLHEP::mm
+           << " " << OnnxParameters::Instance().GetEmittanceRatioZ();
+        cv = os.str();
+    }
     else if (aCommand == fLaserOffsetCmd)
         cv = fLaserOffsetCmd->ConvertToString(OnnxParameters::Instance().GetXoff());
     else if (aCommand == fLaserNormVecPotentialCmd)
@@ -0,0 +1,110 @@
+#include "PlasmaMLPALLASProgressMessenger.hh"
+#include "PlasmaMLPALLASProgressMonitor.hh"
+#include "CLHEP/Units/SystemOfUnits.h"
+
+/**
+ * @file PlasmaMLPALLASProgressMessenger.cc
+ * @brief User interface (UI) messenger for the progress report.
+ *
+ * Commands are organized in the /PlasmaMLPALLAS/progress/ directory and allow users to:
+ *  - Select the report format: progress bar, machine-readable lines or none.
+ *  - Set the period of the report.
+ *
+ * The new settings are applied at the next run.
+ *
+ * @authors Arnaud HUBER
+ * @authors Alexei SYTOV
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Constructor.
+ * @param monitor Pointer to the progress monitor.
+ */
+PlasmaMLPALLASProgressMessenger::PlasmaMLPALLASProgressMessenger(PlasmaMLPALLASProgressMonitor *monitor)
+    : G4UImessenger(), fMonitor(monitor)
+{
+    fProgressDir = new G4UIdirectory("/PlasmaMLPALLAS/progress/");
+    fProgressDir->SetGuidance("Progress report UI commands");
+
+    /**
+     * @brief Command to set the format of the report.
+     *
+     * Parameter: Mode (bar, machine or off)
+     */
+    fModeCmd = new G4UIcmdWithAString("/PlasmaMLPALLAS/progress/setMode", this);
+    fModeCmd->SetGuidance("Set the progress report format");
+    fModeCmd->SetGuidance("  bar     : progress bar with rates and ETA on the standard error");
+    fModeCmd->SetGuidance("  machine : one key=value line per report on the standard output");
+    fModeCmd->SetGuidance("  off     : no report");
+    fModeCmd->SetParameterName("Mode", false);
+    fModeCmd->SetCandidates("bar machine off");
+    fModeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fModeCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to set the period of the report.
+     *
+     * Parameter: Interval (time, default unit s)
+     */
+    fIntervalCmd = new G4UIcmdWithADoubleAndUnit("/PlasmaMLPALLAS/progress/setInterval", this);
+    fIntervalCmd->SetGuidance("Set the period of the progress report");
+    fIntervalCmd->SetParameterName("Interval", false);
+    fIntervalCmd->SetRange("Interval>0.");
+    fIntervalCmd->SetDefaultUnit("s");
+    fIntervalCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fIntervalCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Destructor.
+ */
+PlasmaMLPALLASProgressMessenger::~PlasmaMLPALLASProgressMessenger()
+{
+    delete fModeCmd;
+    delete fIntervalCmd;
+    delete fProgressDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASProgressMessenger::SetNewValue(G4UIcommand *aCommand, G4String aNewValue)
+{
+    if (aCommand == fModeCmd)
+    {
+        if (aNewValue == "machine")
+            fMonitor->SetMode(PlasmaMLPALLASProgressMonitor::Mode::Machine);
+        else if (aNewValue == "off")
+            fMonitor->SetMode(PlasmaMLPALLASProgressMonitor::Mode::Off);
+        else
+            fMonitor->SetMode(PlasmaMLPALLASProgressMonitor::Mode::Bar);
+    }
+    else if (aCommand == fIntervalCmd)
+        fMonitor->SetInterval(fIntervalCmd->GetNewDoubleValue(aNewValue) / CLHEP::s);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PlasmaMLPALLASProgressMessenger::GetCurrentValue(G4UIcommand *aCommand)
+{
+    G4String cv;
+
+    if (aCommand == fModeCmd)
+    {
+        switch (fMonitor->GetMode())
+        {
+        case PlasmaMLPALLASProgressMonitor::Mode::Machine: cv = "machine"; break;
+        case PlasmaMLPALLASProgressMonitor::Mode::Off: cv = "off"; break;
+        default: cv = "bar"; break;
+        }
+    }
+    else if (aCommand == fIntervalCmd)
+        cv = fIntervalCmd->ConvertToString(fMonitor->GetInterval() * CLHEP::s, "s");
+
+    return cv;
+}
@@ -0,0 +1,243 @@
+/**
+ * @file PlasmaMLPALLASProgressMonitor.cc
+ * @brief Implementation of the throttled progress and throughput report.
+ *
+ * The event loop only touches the per-thread counters. Everything else (clock
+ * reads, rate and ETA computation, formatting and printing) happens in the
+ * reporter thread, once per report period:
+ *  - `bar` mode rewrites a progress bar on the standard error, with the
+ *    overall rate, the slowest and fastest thread rates and the ETA;
+ *  - `machine` mode prints one `key=value` line per report on the standard
+ *    output, including every thread rate, for batch scheduler logs.
+ *
+ * Rates are computed over the last report period; the ETA uses the average
+ * rate since the start of the run.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASProgressMonitor.hh"
+#include "PlasmaMLPALLASProgressMessenger.hh"
+#include "G4Threading.hh"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASProgressMonitor& PlasmaMLPALLASProgressMonitor::Instance()
+{
+    static PlasmaMLPALLASProgressMonitor instance;
+    return instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASProgressMonitor::PlasmaMLPALLASProgressMonitor()
+{
+    fMessenger = new PlasmaMLPALLASProgressMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASProgressMonitor::~PlasmaMLPALLASProgressMonitor()
+{
+    if (fReporter.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(fStopMutex);
+            fStopRequested = true;
+        }
+        fStopCondition.notify_all();
+        fReporter.join();
+    }
+    delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Get a counter for the calling thread
+ * @return Counter owned by the calling thread
+ *
+ * Counters are allocated separately, so their address never changes when
+ * other threads register.
+ */
+PlasmaMLPALLASProgressMonitor::Counter& PlasmaMLPALLASProgressMonitor::RegisterThread()
+{
+    std::lock_guard<std::mutex> lock(fCountersMutex);
+    fCounters.push_back(std::make_unique<Counter>());
+    fCounters.back()->threadID = std::max(0, G4Threading::G4GetThreadId());
+    return *fCounters.back();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Start reporting a run
+ * @param nEvents Number of events to process in the run
+ *
+ * The current counter values become the baseline of the run, so counters
+ * never need to be reset while worker threads may be writing them.
+ */
+void PlasmaMLPALLASProgressMonitor::Start(G4int nEvents)
+{
+    if (fReporter.joinable())
+        Stop();
+
+    {
+        std::lock_guard<std::mutex> lock(fCountersMutex);
+        fBaseline.clear();
+        for (const auto& counter : fCounters)
+            fBaseline.push_back(counter->events.load(std::memory_order_relaxed));
+        fLast = fBaseline;
+    }
+
+    fEventsToProcess = nEvents;
+    fStartTime = fLastTime = Clock::now();
+
+    if (fMode == Mode::Off)
+        return;
+
+    fStopRequested = false;
+    fReporter = std::thread(&PlasmaMLPALLASProgressMonitor::Loop, this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Stop the reporter thread and print the summary of the run
+ */
+void PlasmaMLPALLASProgressMonitor::Stop()
+{
+    if (!fReporter.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(fStopMutex);
+        fStopRequested = true;
+    }
+    fStopCondition.notify_all();
+    fReporter.join();
+
+    Report(true);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASProgressMonitor::Loop()
+{
+    const auto period = std::chrono::duration<double>(fInterval);
+
+    std::unique_lock<std::mutex> lock(fStopMutex);
+    while (!fStopCondition.wait_for(lock, period, [this] { return fStopRequested; }))
+    {
+        lock.unlock();
+        Report(false);
+        lock.lock();
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Aggregate the thread counters and print one report
+ * @param final Whether this is the summary printed at the end of the run
+ */
+void PlasmaMLPALLASProgressMonitor::Report(bool final)
+{
+    const Clock::time_point now = Clock::now();
+    const double elapsed = std::chrono::duration<double>(now - fStartTime).count();
+    const double period = std::chrono::duration<double>(now - fLastTime).count();
+    fLastTime = now;
+
+    // Events done in the run and rate over the last period, per thread
+    std::vector<std::uint64_t> done;
+    std::vector<double> rates;
+    std::vector<G4int> ids;
+    {
+        std::lock_guard<std::mutex> lock(fCountersMutex);
+        for (size_t i = 0; i < fCounters.size(); ++i)
+        {
+            const std::uint64_t current = fCounters[i]->events.load(std::memory_order_relaxed);
+            if (i >= fBaseline.size())
+            {
+                fBaseline.push_back(0);
+                fLast.push_back(0);
+            }
+
+            done.push_back(current - fBaseline[i]);
+            rates.push_back(period > 0. ? (current - fLast[i]) / period : 0.);
+            ids.push_back(fCounters[i]->threadID);
+            fLast[i] = current;
+        }
+    }
+
+    std::uint64_t total = 0;
+    double rate = 0.;
+    for (size_t i = 0; i < done.size(); ++i)
+    {
+        total += done[i];
+        rate += rates[i];
+    }
+
+    const double averageRate = elapsed > 0. ? total / elapsed : 0.;
+    const double fraction = fEventsToProcess > 0 ? std::min(1., double(total) / fEventsToProcess) : 0.;
+    const double eta = averageRate > 0. ? std::max(0., (fEventsToProcess - double(total)) / averageRate) : -1.;
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+
+    if (fMode == Mode::Machine)
+    {
+        oss << (final ? "PROGRESS_END" : "PROGRESS")
+            << " elapsed=" << elapsed
+            << " events=" << total
+            << " total=" << fEventsToProcess
+            << " fraction=" << std::setprecision(4) << fraction << std::setprecision(1)
+            << " rate=" << (final ? averageRate : rate)
+            << " avg_rate=" << averageRate
+            << " eta=" << (final ? 0. : eta)
+            << " threads=" << done.size()
+            << (final ? " thread_events=" : " thread_rates=");
+        for (size_t i = 0; i < done.size(); ++i)
+        {
+            if (i) oss << ",";
+            oss << ids[i] << ":";
+            if (final) oss << done[i];
+            else oss << rates[i];
+        }
+        oss << "\n";
+        std::cout << oss.str() << std::flush;
+        return;
+    }
+
+    const int barWidth = 50;
+    const int pos = static_cast<int>(barWidth * fraction);
+    oss << "\r[";
+    for (int i = 0; i < barWidth; ++i)
+        oss << (i < pos ? '=' : (i == pos ? '>' : ' '));
+    oss << "] " << int(fraction * 100.) << " %";
+
+    if (final)
+    {
+        oss << " | " << total << " events in " << elapsed << " s | " << averageRate << " evt/s\n";
+    }
+    else
+    {
+        oss << " | " << rate << " evt/s";
+        if (!rates.empty())
+            oss << " (thread min " << *std::min_element(rates.begin(), rates.end())
+                << " / max " << *std::max_element(rates.begin(), rates.end()) << ")";
+        oss << " | ETA = ";
+        if (eta < 0.) oss << "-";
+        else oss << eta / 60. << " min";
+        oss << "   ";
+    }
+
+    std::cerr << oss.str() << std::flush;
+}
@@ -7,29 +7,49 @@
  *
  * This file contains the method definitions for the `PlasmaMLPALLASRunAction` class
  * declared in `PlasmaMLPALLASRunAction.hh`. It manages:
- *  - Initialization of run-wide ROOT files and trees
+ *  - Initialization of run-wide ROOT files and output tables (TTrees or RNTuples)
  *  - Thread-safe data collection in multi-threaded runs
- *  - Branch creation for all recorded statistics
+ *  - Column definition for all recorded statistics (once, in the constructor)
  *  - Interaction with primary generator and geometry to populate run metadata
  *  - Begin/end-of-run hooks to prepare and finalize data storage
  *
  * The run action workflow:
  *  - **BeginOfRunAction**:
- *      - Locks file access (multi-thread safety)
- *      - Builds the ROOT output file name based on threading context
- *      - Creates TTree objects for each statistics category
- *      - Defines ROOT branches for run-wide parameters and measurements
- *      - Initializes the random seed
+ *      - Pushes the latest gradients and dipole field into the field of the thread
+ *      - Publishes the immutable generator configuration of the run
+ *      - Sets the grids of the screen images from the output manager
+ *      - Resets the accumulables, the field cost counters and the kill-zone counters of the thread
+ *      - Reads the index of the working point when a scan or an optimisation is running
+ *      - Opens the ROOT output under the file lock, unless a scan kept it
+ *        open from the previous point: the merger of the final file on the
+ *        master of a multi-threaded run, otherwise the file of the thread
+ *        (see PlasmaMLPALLASOutputManager), and opens one table per
+ *        statistics category in the selected format (per-run tables only
+ *        without event output)
+ *      - Initializes the random seed, unless the chunk of a checkpointed or MPI job was seeded
+ *      - Starts the progress report (master thread)
  *  - **During the run**:
- *      - Updates statistics via `UpdateStatistics()` and specialized variants
+ *      - Updates statistics via `UpdateStatistics()` and specialized variants,
+ *        without any lock: each thread fills its own tables and beam moments
+ *      - Flushes the tables and the file of the thread every setFlushEvents
+ *        events or setFlushSize filled bytes (`EndOfEvent()`)
  *  - **EndOfRunAction**:
- *      - Finalizes statistics
- *      - Writes all TTrees to the ROOT file
- *      - Closes the file and releases resources
+ *      - Stops the progress report (master thread)
+ *      - Merges the accumulables into the master ones
+ *      - Prints the field cost counters and the kill zones of the thread, when enabled
+ *      - Finalizes statistics; the master writes the BeamSummary row of the
+ *        merged beam moments and the merged screen images
+ *      - Closes the tables and writes the ROOT file (merged into the final
+ *        file for a worker) and closes it under the file lock, the master closing the
+ *        merger last, unless more points of a scan or an optimisation follow
  *
  * Thread safety is ensured via:
  *  - `std::atomic<int> activeThreads` for counting active threads
- *  - `G4Mutex fileMutex` for synchronized file access
+ *  - `G4Mutex fileMutex` around the creation and the closing of the files
+ *    (ROOT global lists), the only steps shared by the threads
+ *  - ROOT::EnableThreadSafety() in main, which makes gDirectory thread-local:
+ *    the trees of a thread are attached to its own file and TTree::Fill,
+ *    basket compression and writing included, runs concurrently
  *
  * @note This class uses Geant4's ROOT integration to structure physics
  *       output in an analysis-friendly format.
@@ -37,6 +57,17 @@
 
 // Include class header
 #include "PlasmaMLPALLASRunAction.hh"
+#include "PlasmaMLPALLASScanDriver.hh"
+#include "PlasmaMLPALLASOptimiser.hh"
+#include "PlasmaMLPALLASKillZones.hh"
+#include "PlasmaMLPALLASCheckpoint.hh"
+#include "PlasmaMLPALLASMPIDriver.hh"
+#include "PlasmaMLPALLASOutputManager.hh"
+#include "G4AccumulableManager.hh"
+#include "TH2D.h"
+#include <algorithm>
+#include <utility>
+#include "G4Threading.hh"
 
 // --- Static member initialization ---
 std::atomic<int> PlasmaMLPALLASRunAction::activeThreads(0);       ///< Counter for active threads
@@ -46,6 +77,29 @@ G4Mutex PlasmaMLPALLASRunAction::fileMutex = G4MUTEX_INITIALIZER; ///< Mutex for
 PlasmaMLPALLASRunAction::PlasmaMLPALLASRunAction(const char *suff, size_t N, G4bool pMT)
     : suffixe(suff), NEventsGenerated(N), flag_MT(pMT)
 {
+  G4AccumulableManager::Instance()->RegisterAccumulable(&fBSYAGSpot);
+
+  // Beam moments of the planes of the routine analysis (no direction on the screens)
+  fMoments.emplace_back(new PlasmaMLPALLASBeamMoments("Input", true));
+  for (const char *quad : {"Q1", "Q2", "Q3", "Q4"})
+    for (const char *part : {"Begin", "End"})
+      fMoments.emplace_back(new PlasmaMLPALLASBeamMoments(G4String(quad) + part, true));
+  fMoments.emplace_back(new PlasmaMLPALLASBeamMoments("BSYAG", false));
+  fMoments.emplace_back(new PlasmaMLPALLASBeamMoments("BSPECYAG", false));
+  for (const auto &moments : fMoments)
+    G4AccumulableManager::Instance()->RegisterAccumulable(moments.get());
+  fMomentsSummary.resize(fMoments.size());
+
+  // Images of the YAG screens, binned by every thread instead of the offline analysis
+  const PlasmaMLPALLASOutputManager &output = PlasmaMLPALLASOutputManager::Instance();
+  for (const G4String &name : PlasmaMLPALLASOutputManager::GetImageNames())
+    fImages.emplace_back(new PlasmaMLPALLASScreenImage(name, output.GetImageBinning(name)));
+  for (const auto &image : fImages)
+    G4AccumulableManager::Instance()->RegisterAccumulable(image.get());
+  fImagesRaw.resize(fImages.size());
+  fImageEnabled.assign(fImages.size(), true);
+
+  DefineTables();
 }
 
 // --- Destructor ---
@@ -64,84 +118,231 @@ void PlasmaMLPALLASRunAction::SetGeometry(PlasmaMLPALLASGeometryConstruction *ge
 }
 
 /**
- * @brief Utility template to create simple branches in a TTree.
+ * @brief Utility template to declare simple columns of a table.
  * @tparam T Data type (int, float, etc.)
- * @param tree Pointer to the TTree to populate
- * @param branches List of name-pointer pairs
+ * @param table Table to populate
+ * @param columns List of name-pointer pairs
  */
 template <typename T>
-static void CreateBranches(TTree *tree, const std::vector<std::pair<const char *, T *>> &branches)
+static void CreateBranches(PlasmaMLPALLASOutputTable &table, const std::vector<std::pair<const char *, T *>> &columns)
 {
-  for (const auto &b : branches)
-  {
-    tree->Branch(
-        b.first,
-        b.second,
-        (std::string(b.first) + "/" +
-         (std::is_same<T, int>::value ? "I" : std::is_same<T, float>::value ? "F"
-                                                                            : ""))
-            .c_str());
-  }
+  for (const auto &c : columns)
+    table.AddColumn(c.first, c.second);
 }
 
 /**
- * @brief Creates ROOT branches specific to YAG detector statistics.
- * @param tree ROOT tree to populate
+ * @brief Declares the columns specific to YAG detector statistics.
+ * @param table Table to populate
  * @param stats YAG statistics structure
  */
-static void CreateYAGBranches(TTree *tree, RunTallyYAG &stats)
+static void CreateYAGBranches(PlasmaMLPALLASOutputTable &table, RunTallyYAG &stats)
 {
-  tree->Branch("x_exit", "vector<float>", &stats.x_exit);
-  tree->Branch("y_exit", "vector<float>", &stats.y_exit);
-  tree->Branch("z_exit", "vector<float>", &stats.z_exit);
-  tree->Branch("parentID", "vector<int>", &stats.parentID);
-  tree->Branch("particleID", "vector<int>", &stats.particleID);
-  tree->Branch("energy", "vector<float>", &stats.energy);
-  tree->Branch("deposited_energy", "vector<float>", &stats.total_deposited_energy);
+  table.AddColumn("x_exit", &stats.x_exit);
+  table.AddColumn("y_exit", &stats.y_exit);
+  table.AddColumn("z_exit", &stats.z_exit);
+  table.AddColumn("parentID", &stats.parentID);
+  table.AddColumn("particleID", &stats.particleID);
+  table.AddColumn("energy", &stats.energy);
+  table.AddColumn("weight", &stats.weight);
+  table.AddColumn("deposited_energy", &stats.total_deposited_energy);
 }
 
 /**
- * @brief Creates ROOT branches specific to Collimators statistics.
- * @param tree ROOT tree to populate
+ * @brief Declares the columns specific to Collimators statistics.
+ * @param table Table to populate
  * @param stats Collimators statistics structure
  */
-static void CreateCollimatorsBranches(TTree *tree, RunTallyCollimators &stats)
+static void CreateCollimatorsBranches(PlasmaMLPALLASOutputTable &table, RunTallyCollimators &stats)
 {
-  tree->Branch("x_interaction", &stats.x, "x_interaction/F");
-  tree->Branch("y_interaction", &stats.y, "y_interaction/F");
-  tree->Branch("z_interaction", &stats.z, "z_interaction/F");
-  tree->Branch("energy", &stats.energy, "energy/F");
+  table.AddColumn("x_interaction", &stats.x);
+  table.AddColumn("y_interaction", &stats.y);
+  table.AddColumn("z_interaction", &stats.z);
+  table.AddColumn("energy", &stats.energy);
+  table.AddColumn("weight", &stats.weight);
 }
 
 //---------------------------------------------------------
 //  Generic statistics update function
 //---------------------------------------------------------
 /**
- * @brief Thread-safe update of statistics and ROOT tree filling.
+ * @brief Whether a primary crossed at least one quadrupole boundary (rows are zeroed at each event).
+ * @param r Quadrupole statistics of the primary
+ */
+static bool CrossedQuadrupole(const RunTallyQuadrupoles &r)
+{
+  for (const QuadrupoleState *q : {&r.Q1, &r.Q2, &r.Q3, &r.Q4})
+    if (q->beginMomentum.y != 0 || q->endMomentum.y != 0)
+      return true;
+  return false;
+}
+
+/**
+ * @brief Declares the columns of the moments of one plane in the summary table.
+ * @param table Table to populate
+ * @param plane Name of the plane, prefix of the columns
+ * @param summary Summary values of the plane
+ */
+static void CreateMomentsBranches(PlasmaMLPALLASOutputTable &table, const G4String &plane, PlasmaMLPALLASBeamMoments::Summary &summary)
+{
+  const std::vector<std::pair<const char *, float *>> columns = {
+      {"weight", &summary.weight},
+      {"mean_x", &summary.mean_x}, {"rms_x", &summary.rms_x},
+      {"mean_xp", &summary.mean_xp}, {"rms_xp", &summary.rms_xp},
+      {"emit_x", &summary.emit_x}, {"alpha_x", &summary.alpha_x},
+      {"beta_x", &summary.beta_x}, {"gamma_x", &summary.gamma_x},
+      {"mean_z", &summary.mean_z}, {"rms_z", &summary.rms_z},
+      {"mean_zp", &summary.mean_zp}, {"rms_zp", &summary.rms_zp},
+      {"emit_z", &summary.emit_z}, {"alpha_z", &summary.alpha_z},
+      {"beta_z", &summary.beta_z}, {"gamma_z", &summary.gamma_z},
+      {"mean_E", &summary.mean_E}, {"rms_E", &summary.rms_E}};
+
+  table.AddColumn(plane + "_entries", &summary.entries);
+  for (const auto &c : columns)
+    table.AddColumn(plane + "_" + c.first, c.second);
+}
+
+/**
+ * @brief Declares the columns of one image in the raw screen images table.
+ * @param table Table to populate
+ * @param image Name of the image, prefix of the columns
+ * @param raw Pixels and grid of the image
+ */
+static void CreateImageBranches(PlasmaMLPALLASOutputTable &table, const G4String &image, PlasmaMLPALLASScreenImage::Raw &raw)
+{
+  table.AddColumn(image, &raw.pixels);
+  table.AddColumn(image + "_nx", &raw.nx);
+  table.AddColumn(image + "_ny", &raw.ny);
+  table.AddColumn(image + "_xmin", &raw.xmin);
+  table.AddColumn(image + "_xmax", &raw.xmax);
+  table.AddColumn(image + "_ymin", &raw.ymin);
+  table.AddColumn(image + "_ymax", &raw.ymax);
+}
+
+/**
+ * @brief Update of statistics and table filling.
+ *
+ * The table belongs to the calling thread: no lock. Tables left out of the
+ * output (setEventOutput, setTable) are not open and only keep the values.
+ * The two structures are swapped rather than copied: the vectors of the
+ * bound one keep their addresses and take the new values with no
+ * allocation, the source gets back the buffers of the previous row.
+ *
  * @tparam T Type of the statistics structure
- * @param stats Destination statistics object (persistent in the run)
- * @param newStats Source statistics (new values)
- * @param tree ROOT tree to fill
+ * @param stats Destination statistics object (persistent in the run, bound to the table)
+ * @param newStats Source statistics (new values), holds the previous row on return
+ * @param table Table to fill
  */
 template <typename T>
-void PlasmaMLPALLASRunAction::UpdateStatistics(T &stats, const T &newStats, TTree *tree)
+void PlasmaMLPALLASRunAction::UpdateStatistics(T &stats, T &newStats, PlasmaMLPALLASOutputTable &table)
 {
-  std::lock_guard<std::mutex> lock(fileMutex);
-  stats = newStats;
-  if (tree)
-    tree->Fill();
-  else
-    G4cerr << "Error: Tree is nullptr" << G4endl;
+  if (&stats != &newStats)
+    std::swap(stats, newStats);
+  if (table.IsOpen())
+    table.Fill();
+}
+
+/**
+ * @brief Filling of one row per selected primary of an event (table of the calling thread, no lock).
+ *
+ * @tparam T Type of the statistics structure
+ * @tparam Selector Predicate telling whether a primary row is written
+ * @param stats Destination statistics object bound to the table columns
+ * @param rows Per-primary statistics of the event
+ * @param table Table to fill
+ * @param select Row selection predicate
+ */
+template <typename T, typename Selector>
+void PlasmaMLPALLASRunAction::UpdateStatistics(T &stats, const std::vector<T> &rows, PlasmaMLPALLASOutputTable &table, Selector select)
+{
+  if (!table.IsOpen())
+    return; // table not selected for the output
+
+  for (const T &row : rows)
+  {
+    if (!select(row))
+      continue;
+    stats = row;
+    table.Fill();
+  }
 }
 
 // --- Specific statistics update wrappers ---
-void PlasmaMLPALLASRunAction::UpdateStatisticsGlobalInput(RunTallyGlobalInput a) { UpdateStatistics(StatsGlobalInput, a, Tree_GlobalInput); }
-void PlasmaMLPALLASRunAction::UpdateStatisticsInput(RunTallyInput a) { UpdateStatistics(StatsInput, a, Tree_Input); }
-void PlasmaMLPALLASRunAction::UpdateStatisticsQuadrupoles(RunTallyQuadrupoles a) { UpdateStatistics(StatsQuadrupoles, a, Tree_Quadrupoles); }
-void PlasmaMLPALLASRunAction::UpdateStatisticsHorizontalColl(RunTallyCollimators a) { UpdateStatistics(StatsHorizontalColl, a, Tree_HorizontalColl); }
-void PlasmaMLPALLASRunAction::UpdateStatisticsVerticalColl(RunTallyCollimators a) { UpdateStatistics(StatsVerticalColl, a, Tree_VerticalColl); }
-void PlasmaMLPALLASRunAction::UpdateStatisticsBSYAG(RunTallyYAG a) { UpdateStatistics(StatsBSYAG, a, Tree_BSYAG); }
-void PlasmaMLPALLASRunAction::UpdateStatisticsBSPECYAG(RunTallyYAG a) { UpdateStatistics(StatsBSPECYAG, a, Tree_BSPECYAG); }
+void PlasmaMLPALLASRunAction::UpdateStatisticsGlobalInput(RunTallyGlobalInput &a) { UpdateStatistics(StatsGlobalInput, a, Table_GlobalInput); }
+void PlasmaMLPALLASRunAction::UpdateStatisticsInput(const std::vector<RunTallyInput> &a)
+{
+  // Thread-local moments; the weights are kept for the quadrupole planes of the same primaries
+  fPrimaryWeights.assign(a.size(), 0.f);
+  for (size_t i = 0; i < a.size(); ++i)
+  {
+    const RunTallyInput &r = a[i];
+    if (r.energy <= 0 || r.yp == 0)
+      continue;
+    fPrimaryWeights[i] = r.weight;
+    fMoments[kInputPlane]->Fill(r.x, 1000. * r.xp / r.yp, r.z, 1000. * r.zp / r.yp, r.energy, r.weight);
+  }
+
+  UpdateStatistics(StatsInput, a, Table_Input, [](const RunTallyInput &r) { return r.energy > 0; });
+}
+void PlasmaMLPALLASRunAction::UpdateStatisticsQuadrupoles(const std::vector<RunTallyQuadrupoles> &a)
+{
+  // A plane was crossed when its direction was recorded (rows are zeroed at each event)
+  for (size_t i = 0; i < a.size() && i < fPrimaryWeights.size(); ++i)
+  {
+    const RunTallyQuadrupoles &r = a[i];
+    const QuadrupoleState *quads[] = {&r.Q1, &r.Q2, &r.Q3, &r.Q4};
+    for (size_t q = 0; q < 4; ++q)
+    {
+      const Vector3 *pos[] = {&quads[q]->begin, &quads[q]->end};
+      const Vector3 *mom[] = {&quads[q]->beginMomentum, &quads[q]->endMomentum};
+      for (size_t p = 0; p < 2; ++p)
+        if (mom[p]->y != 0)
+          fMoments[kQuadrupolePlanes + 2 * q + p]->Fill(pos[p]->x, 1000. * mom[p]->x / mom[p]->y,
+                                                       pos[p]->z, 1000. * mom[p]->z / mom[p]->y,
+                                                       r.energy, fPrimaryWeights[i]);
+    }
+  }
+
+  UpdateStatistics(StatsQuadrupoles, a, Table_Quadrupoles, CrossedQuadrupole);
+}
+void PlasmaMLPALLASRunAction::UpdateStatisticsHorizontalColl(const std::vector<RunTallyCollimators> &a)
+{
+  UpdateStatistics(StatsHorizontalColl, a, Table_HorizontalColl, [](const RunTallyCollimators &r) { return r.flag; });
+}
+void PlasmaMLPALLASRunAction::UpdateStatisticsVerticalColl(const std::vector<RunTallyCollimators> &a)
+{
+  UpdateStatistics(StatsVerticalColl, a, Table_VerticalColl, [](const RunTallyCollimators &r) { return r.flag; });
+}
+void PlasmaMLPALLASRunAction::UpdateStatisticsBSYAG(RunTallyYAG &a)
+{
+  // Thread-local sums: spot of the primaries, moments and images of every particle on the screen
+  for (size_t i = 0; i < a.parentID.size(); ++i)
+  {
+    if (a.parentID[i] == 0)
+      fBSYAGSpot.Fill(a.x_exit[i], a.z_exit[i], a.weight[i]);
+    fMoments[kBSYAGPlane]->Fill(a.x_exit[i], 0., a.z_exit[i], 0., a.energy[i], a.weight[i]);
+    if (fImageEnabled[kBSYAGHits])
+      fImages[kBSYAGHits]->Fill(a.x_exit[i], a.z_exit[i], a.weight[i]);
+    if (fImageEnabled[kBSYAGEdep])
+      fImages[kBSYAGEdep]->Fill(a.x_exit[i], a.z_exit[i], a.weight[i] * a.deposit[i]);
+  }
+
+  UpdateStatistics(StatsBSYAG, a, Table_BSYAG);
+}
+void PlasmaMLPALLASRunAction::UpdateStatisticsBSPECYAG(RunTallyYAG &a)
+{
+  for (size_t i = 0; i < a.parentID.size(); ++i)
+  {
+    fMoments[kBSPECYAGPlane]->Fill(a.x_exit[i], 0., a.z_exit[i], 0., a.energy[i], a.weight[i]);
+    if (fImageEnabled[kBSPECYAGHits])
+      fImages[kBSPECYAGHits]->Fill(a.x_exit[i], a.z_exit[i], a.weight[i]);
+    if (fImageEnabled[kBSPECYAGEdep])
+      fImages[kBSPECYAGEdep]->Fill(a.x_exit[i], a.z_exit[i], a.weight[i] * a.deposit[i]);
+    if (fImageEnabled[kBSPECYAGSpectrum])
+      fImages[kBSPECYAGSpectrum]->Fill(a.z_exit[i], a.energy[i], a.weight[i]);
+  }
+
+  UpdateStatistics(StatsBSPECYAG, a, Table_BSPECYAG);
+}
 
 /**
  * @brief Populates global input statistics from generator and geometry state.
@@ -164,6 +365,7 @@ void RunTallyGlobalInput::FillFrom(const PlasmaMLPALLASPrimaryGeneratorAction *g
     dEkin = gen->GetdEkin();
     Q = gen->GetQ();
     epsb = gen->GetEPSB();
+    BunchSize = gen->GetBunchSize();
   }
 
   // Extract geometry configuration
@@ -188,40 +390,42 @@ void RunTallyGlobalInput::FillFrom(const PlasmaMLPALLASPrimaryGeneratorAction *g
     Q3Q4Distance = geo->GetQ3Q4Distance();
     B_Dipole_Map = geo->GetStatusMapBField();
     B_Dipole = geo->GetConstantDipoleBField();
+
+    if (geo->GetStatusFieldStatistics() == 1)
+    {
+      const PlasmaMLPALLASFieldStatistics &field = PlasmaMLPALLASFieldStatistics::Local();
+      std::copy(field.fieldCalls.begin(), field.fieldCalls.end(), FieldCalls.begin());
+      std::copy(field.chordSteps.begin(), field.chordSteps.end(), ChordSteps.begin());
+      std::copy(field.tracks.begin(), field.tracks.end(), FieldTracks.begin());
+      std::copy(field.driverTime.begin(), field.driverTime.end(), FieldTime.begin());
+      RunTime = field.runTime;
+    }
+  }
+
+  // Kills of the thread (empty on the master, which tracks nothing)
+  const PlasmaMLPALLASKillZones &killZones = PlasmaMLPALLASKillZones::Local();
+  KillZoneNames.clear();
+  KillZoneCounts.clear();
+  if (killZones.IsActive())
+  {
+    for (const G4String &name : killZones.GetCounterNames())
+      KillZoneNames.push_back(name);
+    for (G4long count : killZones.GetCounts())
+      KillZoneCounts.push_back(static_cast<int>(count));
   }
 }
 
 //-----------------------------------------------------
-//  BeginOfRunAction
+//  DefineTables
 //-----------------------------------------------------
 /**
- * @brief Called at the start of each run to set up ROOT output structures and initialize state.
- * @param aRun Pointer to the current G4Run
+ * @brief Declares the columns of the tables, bound to the statistics structures.
+ *
+ * Called once by the constructor; the same columns make the branches of the
+ * TTrees or the fields of the RNTuples.
  */
-void PlasmaMLPALLASRunAction::BeginOfRunAction(const G4Run *aRun)
+void PlasmaMLPALLASRunAction::DefineTables()
 {
-  // Populate branches for each TTree...
-  G4AutoLock lock(&fileMutex); // Automatic mutex lock
-
-  start = time(NULL); // start the timer clock to calculate run times
-
-  int a = activeThreads;
-
-  std::string s = flag_MT ? "_" + std::to_string(activeThreads) : "";
-  fileName = suffixe + s + ".root";
-
-  G4cout << "Filename = " << fileName << G4endl;
-
-  f = new TFile(fileName.c_str(), "RECREATE");
-
-  // Creating trees for different types of run information
-  Tree_GlobalInput = new TTree("GlobalInput", "Global Input Information");                 // Tree to access Input information
-  Tree_Input = new TTree("Input", "Input Information");                                    // Tree to access Input information
-  Tree_Quadrupoles = new TTree("QuadrupolesTracking", "Quadrupoles Tracking Information"); // Tree to access Quadrupoles tracking information
-  Tree_HorizontalColl = new TTree("Horizontal_Coll", "Horizontal Collimator Information"); // Tree to access Horizontal Collimator information
-  Tree_VerticalColl = new TTree("Vertical_Coll", "Vertical Collimator Information");       // Tree to access Vertical Collimator information
-  Tree_BSYAG = new TTree("BSYAG", "BS YAG Information");                                   // Tree to access Back Collimator infos
-  Tree_BSPECYAG = new TTree("BSPECYAG", "BSPEC YAG Information");                          // Tree to access Back Collimator infos
 
   //*****************************INFORMATIONS FROM THE GLOBAL INPUT*******************************************
   std::vector<std::pair<const char *, int *>> globalIntBranches = {
@@ -229,7 +433,8 @@ void PlasmaMLPALLASRunAction::BeginOfRunAction(const G4Run *aRun)
       {"Display_FullPALLASGeometry", &StatsGlobalInput.Display_Geometry},
       {"Display_Collimators", &StatsGlobalInput.Display_Collimators},
       {"Display_Quadrupoles", &StatsGlobalInput.Display_Quadrupoles},
-      {"B_Dipole_Map", &StatsGlobalInput.B_Dipole_Map}};
+      {"B_Dipole_Map", &StatsGlobalInput.B_Dipole_Map},
+      {"BunchSize", &StatsGlobalInput.BunchSize}};
 
   std::vector<std::pair<const char *, float *>> globalFloatBranches = {
       {"Q1_Length", &StatsGlobalInput.Q1_Length},
@@ -254,13 +459,36 @@ void PlasmaMLPALLASRunAction::BeginOfRunAction(const G4Run *aRun)
       {"Q", &StatsGlobalInput.Q},
       {"epsb", &StatsGlobalInput.epsb}};
 
-  CreateBranches(Tree_GlobalInput, globalIntBranches);
-  CreateBranches(Tree_GlobalInput, globalFloatBranches);
+  CreateBranches(Table_GlobalInput, globalIntBranches);
+  CreateBranches(Table_GlobalInput, globalFloatBranches);
+
+  // Field cost counters: FieldCalls_<region>, ChordSteps_/FieldTracks_/FieldTime_<field manager>
+  const auto &regions = PlasmaMLPALLASFieldStatistics::GetRegionNames();
+  const auto &drivers = PlasmaMLPALLASFieldStatistics::GetDriverNames();
+  for (size_t i = 0; i < regions.size(); ++i)
+  {
+    TString name = TString::Format("FieldCalls_%s", regions[i]);
+    Table_GlobalInput.AddColumn(name.Data(), &StatsGlobalInput.FieldCalls[i]);
+  }
+  for (size_t i = 0; i < drivers.size(); ++i)
+  {
+    TString steps = TString::Format("ChordSteps_%s", drivers[i]);
+    TString tracks = TString::Format("FieldTracks_%s", drivers[i]);
+    TString time = TString::Format("FieldTime_%s", drivers[i]);
+    Table_GlobalInput.AddColumn(steps.Data(), &StatsGlobalInput.ChordSteps[i]);
+    Table_GlobalInput.AddColumn(tracks.Data(), &StatsGlobalInput.FieldTracks[i]);
+    Table_GlobalInput.AddColumn(time.Data(), &StatsGlobalInput.FieldTime[i]);
+  }
+  Table_GlobalInput.AddColumn("RunTime", &StatsGlobalInput.RunTime);
+
+  // Kill-zone counters: names and kills, one entry per aperture then Backward and MinEnergy
+  Table_GlobalInput.AddColumn("KillZoneNames", &StatsGlobalInput.KillZoneNames);
+  Table_GlobalInput.AddColumn("KillZoneCounts", &StatsGlobalInput.KillZoneCounts);
 
   //*****************************INFORMATIONS FROM THE INPUT*******************************************
   std::vector<std::pair<const char *, float *>> inputBranches = {
-      {"x", &StatsInput.x}, {"xp", &StatsInput.xp}, {"y", &StatsInput.y}, {"yp", &StatsInput.yp}, {"z", &StatsInput.z}, {"zp", &StatsInput.zp}, {"energy", &StatsInput.energy}};
-  CreateBranches(Tree_Input, inputBranches);
+      {"x", &StatsInput.x}, {"xp", &StatsInput.xp}, {"y", &StatsInput.y}, {"yp", &StatsInput.yp}, {"z", &StatsInput.z}, {"zp", &StatsInput.zp}, {"energy", &StatsInput.energy}, {"weight", &StatsInput.weight}};
+  CreateBranches(Table_Input, inputBranches);
 
   //*****************************INFORMATIONS FROM THE QUADRUPOLES TRACKING*******************************************
   const char *quads[] = {"Q1", "Q2", "Q3", "Q4"};
@@ -293,34 +521,286 @@ void PlasmaMLPALLASRunAction::BeginOfRunAction(const G4Run *aRun)
             ptr = &vec->z;
 
           TString branchName = TString::Format("%s%s%s_%s", quads[q], parts[p], types[t], coords[c]);
-          Tree_Quadrupoles->Branch(branchName, ptr, TString::Format("%s/F", branchName.Data()));
+          Table_Quadrupoles.AddColumn(branchName.Data(), ptr);
         }
       }
     }
   }
 
   // Branch pour l'énergie
-  Tree_Quadrupoles->Branch("energy", &StatsQuadrupoles.energy, "energy/F");
+  Table_Quadrupoles.AddColumn("energy", &StatsQuadrupoles.energy);
 
   //************************************INFORMATIONS FROM THE HORIZONTAL COLLIMATOR*****************************************
-  CreateCollimatorsBranches(Tree_HorizontalColl, StatsHorizontalColl);
+  CreateCollimatorsBranches(Table_HorizontalColl, StatsHorizontalColl);
 
   //************************************INFORMATIONS FROM THE VERTICAL COLLIMATOR*****************************************
-  CreateCollimatorsBranches(Tree_VerticalColl, StatsVerticalColl);
+  CreateCollimatorsBranches(Table_VerticalColl, StatsVerticalColl);
 
   //************************************INFORMATIONS FROM THE YAGs*****************************************
   //************************************INFORMATIONS FROM THE BS YAG*****************************************
-  CreateYAGBranches(Tree_BSYAG, StatsBSYAG);
+  CreateYAGBranches(Table_BSYAG, StatsBSYAG);
 
   //************************************INFORMATIONS FROM THE BSPEC YAG*****************************************
-  CreateYAGBranches(Tree_BSPECYAG, StatsBSPECYAG);
+  CreateYAGBranches(Table_BSPECYAG, StatsBSPECYAG);
+
+  //************************************INDEX OF THE SCAN POINT*****************************************
+  // Beam moments: one row per run, <plane>_<quantity> columns
+  for (size_t i = 0; i < fMoments.size(); ++i)
+    CreateMomentsBranches(Table_BeamSummary, fMoments[i]->GetName(), fMomentsSummary[i]);
 
-  // set the random seed to the CPU clock
+  // Screen images in the raw format: one row per run, <image>_<quantity> columns
+  for (size_t i = 0; i < fImages.size(); ++i)
+    CreateImageBranches(Table_ScreenImages, fImages[i]->GetName(), fImagesRaw[i]);
+
+  for (PlasmaMLPALLASOutputTable *table : {&Table_GlobalInput, &Table_Input, &Table_Quadrupoles, &Table_HorizontalColl,
+                                           &Table_VerticalColl, &Table_BSYAG, &Table_BSPECYAG, &Table_BeamSummary,
+                                           &Table_ScreenImages})
+    table->AddColumn("ScanIndex", &fScanIndex);
+}
+
+/**
+ * @brief Tables of the final file, in writing order.
+ *
+ * The per-event tables are left out when /PlasmaMLPALLAS/output/setEventOutput is false,
+ * and any table disabled by /PlasmaMLPALLAS/output/setTable; the ScreenImages
+ * table only exists with /PlasmaMLPALLAS/output/setImageFormat raw.
+ */
+std::vector<PlasmaMLPALLASOutputTable *> PlasmaMLPALLASRunAction::GetTables()
+{
+  std::vector<PlasmaMLPALLASOutputTable *> tables = {&Table_GlobalInput};
+  if (fEventOutput)
+    tables.insert(tables.end(), {&Table_Input, &Table_Quadrupoles, &Table_HorizontalColl,
+                                 &Table_VerticalColl, &Table_BSYAG, &Table_BSPECYAG});
+  tables.push_back(&Table_BeamSummary);
+  if (fRawImages)
+    tables.push_back(&Table_ScreenImages);
+
+  const PlasmaMLPALLASOutputManager &output = PlasmaMLPALLASOutputManager::Instance();
+  tables.erase(std::remove_if(tables.begin(), tables.end(), [&output](const PlasmaMLPALLASOutputTable *table)
+                              { return !output.IsTableEnabled(table->GetName()); }),
+               tables.end());
+  return tables;
+}
+
+/**
+ * @brief Tables filled by this thread.
+ *
+ * The beam summary and the raw images are written from the merged accumulables,
+ * by the master only: alone on the master of a multi-threaded run, with the
+ * others in a sequential run.
+ */
+std::vector<PlasmaMLPALLASOutputTable *> PlasmaMLPALLASRunAction::GetThreadTables()
+{
+  if (!flag_MT)
+    return GetTables();
+  std::vector<PlasmaMLPALLASOutputTable *> tables = GetTables();
+  const G4bool master = G4Threading::IsMasterThread();
+  tables.erase(std::remove_if(tables.begin(), tables.end(), [this, master](const PlasmaMLPALLASOutputTable *table)
+                              { return master != (table == &Table_BeamSummary || table == &Table_ScreenImages); }),
+               tables.end());
+  return tables;
+}
+
+/**
+ * @brief Fills the BeamSummary row of the run from the merged moments (master thread).
+ */
+void PlasmaMLPALLASRunAction::WriteBeamSummary()
+{
+  for (size_t i = 0; i < fMoments.size(); ++i)
+    fMomentsSummary[i] = fMoments[i]->GetSummary();
+  if (Table_BeamSummary.IsOpen())
+    Table_BeamSummary.Fill();
+}
+
+/**
+ * @brief Writes the merged screen images of the run (master thread).
+ *
+ * As TH2D objects in the final file (through the file of the master in a
+ * merged run), named after the image and, within a scan or an optimisation,
+ * suffixed by the index of the point; or as the ScreenImages row of the run.
+ */
+void PlasmaMLPALLASRunAction::WriteImages()
+{
+  if (fRawImages)
+  {
+    for (size_t i = 0; i < fImages.size(); ++i)
+      fImagesRaw[i] = fImageEnabled[i] ? fImages[i]->GetRaw() : PlasmaMLPALLASScreenImage::Raw();
+    if (Table_ScreenImages.IsOpen())
+      Table_ScreenImages.Fill();
+    return;
+  }
+
+  TDirectory *directory = f ? f.get() : PlasmaMLPALLASOutputManager::Instance().GetMergedFile();
+  if (!directory)
+    return;
+
+  // Titles in the order of the images, with the axis titles
+  static const char *titles[kNImages] = {
+      "BS1_YAG passages (weighted);x [mm];z [mm]",
+      "BS1_YAG deposited energy [keV];x [mm];z [mm]",
+      "BSPEC1_YAG passages (weighted);x [mm];z [mm]",
+      "BSPEC1_YAG deposited energy [keV];x [mm];z [mm]",
+      "BSPEC1_YAG energy vs position;z [mm];E [MeV]"};
+
+  const G4bool scanning = PlasmaMLPALLASScanDriver::Instance().IsRunning() || PlasmaMLPALLASOptimiser::Instance().IsRunning();
+  for (size_t i = 0; i < fImages.size(); ++i)
+  {
+    if (!fImageEnabled[i])
+      continue;
+    const PlasmaMLPALLASScreenImage &image = *fImages[i];
+    const PlasmaMLPALLASScreenImage::Binning &binning = image.GetBinning();
+    const G4String name = scanning ? image.GetName() + "_" + std::to_string(fScanIndex) : image.GetName();
+
+    TH2D histogram(name.c_str(), titles[i], binning.nx, binning.xmin, binning.xmax, binning.ny, binning.ymin, binning.ymax);
+    histogram.SetDirectory(nullptr);
+    for (G4int bin = 0; bin < image.GetNumberOfBins(); ++bin)
+      histogram.SetBinContent(bin, image.GetBinContent(bin));
+    histogram.SetEntries(static_cast<Double_t>(image.GetEntries()));
+    directory->WriteObject(&histogram, name.c_str());
+  }
+}
+
+//-----------------------------------------------------
+//  EndOfEvent
+//-----------------------------------------------------
+/**
+ * @brief Counts the event of the thread and flushes its output when a limit is reached.
+ *
+ * Called by the event action once the tables are filled. Only the tables of
+ * the thread are concerned, without lock: a worker file of the merger is
+ * handed over to the merger queue, a sequential file writes its baskets.
+ */
+void PlasmaMLPALLASRunAction::EndOfEvent()
+{
+  if (!fOutputOpen || (fFlushEvents <= 0 && fFlushSize <= 0))
+    return;
+
+  ++fEventsSinceFlush;
+  G4bool flush = fFlushEvents > 0 && fEventsSinceFlush >= fFlushEvents;
+  if (!flush && fFlushSize > 0)
+  {
+    Long64_t filled = 0;
+    for (PlasmaMLPALLASOutputTable *table : GetThreadTables())
+      filled += table->GetFilledBytes();
+    flush = filled >= fFlushSize;
+  }
+  if (flush)
+    FlushOutput();
+}
+
+/**
+ * @brief Writes the entries filled so far by the thread.
+ *
+ * The trees are written with kOverwrite, so that the file keeps one cycle of
+ * each tree header.
+ */
+void PlasmaMLPALLASRunAction::FlushOutput()
+{
+  for (PlasmaMLPALLASOutputTable *table : GetThreadTables())
+    if (table->IsOpen())
+      table->Flush();
+  if (f)
+  {
+    f->cd();
+    f->Write(nullptr, TObject::kOverwrite);
+  }
+  fEventsSinceFlush = 0;
+}
+
+//-----------------------------------------------------
+//  OpenOutput
+//-----------------------------------------------------
+/**
+ * @brief Creates the ROOT output file of the thread and its tables.
+ *
+ * Called with fileMutex held. The file is the final one in sequential runs
+ * and a file of the merger in multi-threaded runs (the master writing the
+ * per-run tables only); the threads of RNTuple parallel writers have no file
+ * of their own.
+ */
+void PlasmaMLPALLASRunAction::OpenOutput()
+{
+  f = PlasmaMLPALLASOutputManager::Instance().OpenFile(suffixe);
+  fileName = f ? f->GetName() : "";
+
+  for (PlasmaMLPALLASOutputTable *table : GetThreadTables())
+    table->Open(f.get());
+  fOutputOpen = true;
+  fEventsSinceFlush = 0;
+}
+
+//-----------------------------------------------------
+//  BeginOfRunAction
+//-----------------------------------------------------
+/**
+ * @brief Called at the start of each run to set up ROOT output structures and initialize state.
+ * @param aRun Pointer to the current G4Run
+ */
+void PlasmaMLPALLASRunAction::BeginOfRunAction(const G4Run *aRun)
+{
+  // Gradients and dipole field set since the previous run (no geometry rebuild)
+  if (fGeometry)
+    fGeometry->UpdateMagneticField();
+
+  // Freeze the generator configuration for the whole run (worker threads only own a generator)
+  if (fPrimaryGenerator)
+    fPrimaryGenerator->SetRunConfig(PlasmaMLPALLASRunConfig::Publish());
+
+  // Grids and selection of the screen images, the same on every thread for the merge
+  PlasmaMLPALLASOutputManager &output = PlasmaMLPALLASOutputManager::Instance();
+  for (size_t i = 0; i < fImages.size(); ++i)
+  {
+    fImages[i]->SetBinning(output.GetImageBinning(fImages[i]->GetName()));
+    fImageEnabled[i] = output.IsTableEnabled(fImages[i]->GetName());
+  }
+
+  // Flush limits of the run, the events left since the last flush of a scan point carry on
+  fFlushEvents = output.GetFlushEvents();
+  fFlushSize = output.GetFlushSize();
+
+  G4AccumulableManager::Instance()->Reset();
+  PlasmaMLPALLASFieldStatistics::Local().Reset();
+  PlasmaMLPALLASKillZones::Local().Reset();
+
+  start = time(NULL); // start the timer clock to calculate run times
+
+  // Index of the working point in a scan or an optimisation (0 for a plain run)
+  const PlasmaMLPALLASOptimiser &optimiser = PlasmaMLPALLASOptimiser::Instance();
+  fScanIndex = optimiser.IsRunning() ? optimiser.GetEvaluationIndex() : PlasmaMLPALLASScanDriver::Instance().GetScanIndex();
+
+  // A scan or an optimisation keeps the same file and tables open for all its points.
+  // The master of a multi-threaded run opens the merger of the worker files and writes the per-run tables only.
+  const G4bool merger = flag_MT && G4Threading::IsMasterThread();
+  int a = 0;
+  {
+    G4AutoLock lock(&fileMutex); // file creation only: the events fill without lock
+    a = activeThreads;
+    if (!fOutputOpen)
+    {
+      fEventOutput = output.GetEventOutput();
+      fRawImages = output.GetImageFormat() == PlasmaMLPALLASOutputManager::ImageFormat::Raw;
+      if (merger)
+      {
+        // The RNTuple parallel writers take the models of the tables of all the threads
+        const std::vector<PlasmaMLPALLASOutputTable *> tables = GetTables();
+        output.OpenMerger(suffixe, std::vector<const PlasmaMLPALLASOutputTable *>(tables.begin(), tables.end()));
+      }
+      OpenOutput();
+      activeThreads++;
+    }
+  }
+
+  // set the random seed to the CPU clock, unless the chunk of a checkpointed or MPI job was seeded by its driver
   // G4Random::setTheEngine(new CLHEP::HepJamesRandom);
-  G4long seed = time(NULL) + a;
-  G4Random::setTheSeed(seed);
-  // G4Random::setTheSeed(1712670533);
-  G4cout << "seed = " << seed << G4endl;
+  // the points of a scan start within the same second: offset by the run ID
+  const G4bool chunk = PlasmaMLPALLASCheckpoint::Instance().IsRunning() || PlasmaMLPALLASMPIDriver::Instance().IsRunning();
+  if (!chunk)
+  {
+    G4long seed = time(NULL) + a + 1000 * aRun->GetRunID();
+    G4Random::setTheSeed(seed);
+    // G4Random::setTheSeed(1712670533);
+    G4cout << "seed = " << seed << G4endl;
+  }
 
   G4cout << "### Run " << aRun->GetRunID() << " start." << G4endl;
 
@@ -330,7 +810,9 @@ void PlasmaMLPALLASRunAction::BeginOfRunAction(const G4Run *aRun)
     UI->ApplyCommand("/vis/scene/notifyHandlers");
   }
 
-  activeThreads++;
+  // The master aggregates the per-thread event counters for the whole run
+  if (G4Threading::IsMasterThread())
+    PlasmaMLPALLASProgressMonitor::Instance().Start(aRun->GetNumberOfEventToBeProcessed());
 }
 
 //-----------------------------------------------------
@@ -342,23 +824,67 @@ void PlasmaMLPALLASRunAction::BeginOfRunAction(const G4Run *aRun)
  */
 void PlasmaMLPALLASRunAction::EndOfRunAction(const G4Run *aRun)
 {
-  StatsGlobalInput.FillFrom(fPrimaryGenerator, fGeometry, NEventsGenerated);
-  UpdateStatisticsGlobalInput(StatsGlobalInput);
+  if (G4Threading::IsMasterThread())
+    PlasmaMLPALLASProgressMonitor::Instance().Stop();
+
+  // Worker sums into the master ones (the master thread merges last)
+  G4AccumulableManager::Instance()->Merge();
+
+  PlasmaMLPALLASFieldStatistics::Local().Stop();
+  if (fGeometry && fGeometry->GetStatusFieldStatistics() == 1)
+    PlasmaMLPALLASFieldStatistics::Local().Print();
+  if (PlasmaMLPALLASKillZones::Local().IsActive())
+    PlasmaMLPALLASKillZones::Local().Print();
+
+  const PlasmaMLPALLASScanDriver &scan = PlasmaMLPALLASScanDriver::Instance();
+  const PlasmaMLPALLASOptimiser &optimiser = PlasmaMLPALLASOptimiser::Instance();
+  size_t nEvents = NEventsGenerated;
+  if (PlasmaMLPALLASCheckpoint::Instance().IsRunning() || PlasmaMLPALLASMPIDriver::Instance().IsRunning())
+    nEvents = aRun->GetNumberOfEventToBeProcessed();
+  else if (optimiser.IsRunning())
+    nEvents = optimiser.GetEventsPerEvaluation();
+  else if (scan.IsRunning())
+    nEvents = scan.GetEventsPerPoint();
+  const G4bool merger = flag_MT && G4Threading::IsMasterThread();
+  if (!merger)
+  {
+    StatsGlobalInput.FillFrom(fPrimaryGenerator, fGeometry, nEvents);
+    UpdateStatisticsGlobalInput(StatsGlobalInput);
+  }
+
+  // Moments and screen images of the whole run, once per run or scan point
+  if (G4Threading::IsMasterThread())
+  {
+    WriteBeamSummary();
+    WriteImages();
+  }
+
+  // The next point of the scan or the next evaluation keeps filling the same tables
+  if (scan.KeepOutputOpen() || optimiser.KeepOutputOpen())
+  {
+    G4cout << "Leaving Run Action (scan point " << fScanIndex << ")" << G4endl;
+    return;
+  }
 
   G4AutoLock lock(&fileMutex);
 
-  // Write all trees to ROOT file
-  f->cd();
-  Tree_GlobalInput->Write();
-  Tree_Input->Write();
-  Tree_Quadrupoles->Write();
-  Tree_HorizontalColl->Write();
-  Tree_VerticalColl->Write();
-  Tree_BSYAG->Write();
-  Tree_BSPECYAG->Write();
-  f->Close();
-  delete f;
-  f = nullptr;
+  // Flush the tables, write the file (a worker file is merged into the final one), then close it
+  if (fOutputOpen)
+  {
+    for (PlasmaMLPALLASOutputTable *table : GetTables())
+      table->Close();
+    if (f)
+    {
+      f->cd();
+      f->Write(nullptr, TObject::kOverwrite);
+      f.reset();
+    }
+    fOutputOpen = false;
+  }
+
+  // The workers and the beam summary are done: write the merged file
+  if (merger)
+    PlasmaMLPALLASOutputManager::Instance().CloseMerger();
 
   if (G4VVisManager::GetConcreteInstance())
     G4UImanager::GetUIpointer()->ApplyCommand("/vis/viewer/update");
@@ -0,0 +1,58 @@
+/**
+ * @file PlasmaMLPALLASRunConfig.cc
+ * @brief Publication of the per-run generator configuration snapshot.
+ *
+ * The configuration is copied from the thread-local OnnxParameters staging
+ * area once per run, and the primary particle name is resolved there so that
+ * the event loop never touches the particle table.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASRunConfig.hh"
+#include "PlasmaMLPALLASOnnxParameters.hh"
+#include "PlasmaMLPALLASCheckpoint.hh"
+#include "PlasmaMLPALLASMPIDriver.hh"
+#include "G4ParticleTable.hh"
+#include <atomic>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Freeze the parameters staged by the calling thread into a new snapshot.
+ * @return New immutable configuration
+ *
+ * Version numbers are unique over the process, so that a consumer can tell
+ * two publications apart even when they come from different threads.
+ */
+std::shared_ptr<const PlasmaMLPALLASRunConfig> PlasmaMLPALLASRunConfig::Publish()
+{
+    static std::atomic<std::uint64_t> lastVersion{0};
+
+    const OnnxParameters &params = OnnxParameters::Instance();
+    auto config = std::make_shared<PlasmaMLPALLASRunConfig>();
+
+    config->version = ++lastVersion;
+
+    config->particleName = params.GetParticleName();
+    config->particle = G4ParticleTable::GetParticleTable()->FindParticle(config->particleName);
+
+    config->statusONNX = params.GetStatusONNX();
+    config->xoff = params.GetXoff();
+    config->a0 = params.GetA0();
+    config->cn2 = params.GetCN2();
+    config->pressure = params.GetPressure();
+
+    config->twissX = {params.GetAlphaX(), params.GetBetaX(), params.GetEmittanceRatioX()};
+    config->twissZ = {params.GetAlphaZ(), params.GetBetaZ(), params.GetEmittanceRatioZ()};
+
+    config->bunchSize = params.GetBunchSize();
+    config->firstEvent = PlasmaMLPALLASCheckpoint::Instance().GetEventOffset() + PlasmaMLPALLASMPIDriver::Instance().GetEventOffset();
+
+    config->phaseSpaceFile = params.GetPhaseSpaceFile();
+
+    return config;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file PlasmaMLPALLASScanDriver.cc
+ * @brief Implementation of the in-process scan of ONNX working points.
+ *
+ * Each point of the scan is one Geant4 run of the already initialised kernel:
+ *  - the four /PlasmaMLPALLAS/laser/ commands of the point are applied on the
+ *    master, which broadcasts them to the workers at the next run;
+ *  - the scan index is published for the run actions, together with whether
+ *    more points follow (the output file then stays open);
+ *  - /run/beamOn is called with the number of events per point.
+ *
+ * The generator configuration is frozen again at each BeginOfRunAction, so
+ * every point gets its own snapshot and its own ONNX prediction.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASScanDriver.hh"
+#include "PlasmaMLPALLASScanMessenger.hh"
+#include "PlasmaMLPALLASOnnxInference.hh"
+#include "G4UImanager.hh"
+#include "G4UIcommandTree.hh"
+#include "G4ios.hh"
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+    /// Commands setting the ONNX inputs, in the order of a scan point
+    const std::array<const char*, 4> kLaserCommands = {
+        "/PlasmaMLPALLAS/laser/setOffsetLaserFocus",
+        "/PlasmaMLPALLAS/laser/setNormVecPotential",
+        "/PlasmaMLPALLAS/laser/setFracDopTargetChamber",
+        "/PlasmaMLPALLAS/laser/setPressure"};
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASScanDriver& PlasmaMLPALLASScanDriver::Instance()
+{
+    static PlasmaMLPALLASScanDriver instance;
+    return instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASScanDriver::PlasmaMLPALLASScanDriver()
+{
+    fMessenger = new PlasmaMLPALLASScanMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASScanDriver::~PlasmaMLPALLASScanDriver()
+{
+    delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASScanDriver::AddPoint(const Point& point)
+{
+    fPoints.push_back(point);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Append the cartesian product of four input axes to the scan
+ * @param axes Grid axes for Xoff, A0, CN2 and Pressure
+ * @return Number of points appended
+ *
+ * Points are appended in the order of the --predict CSV dump: Pressure
+ * varies fastest and Xoff slowest.
+ */
+size_t PlasmaMLPALLASScanDriver::AddGrid(const std::array<OnnxGridAxis, 4>& axes)
+{
+    const size_t nPoints = OnnxGridAxis::GridSize(axes);
+    fPoints.reserve(fPoints.size() + nPoints);
+    for (size_t index = 0; index < nPoints; ++index)
+        fPoints.push_back(OnnxGridAxis::GridPoint(axes, index));
+    return nPoints;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Run every point of the scan
+ * @param nEventsPerPoint Number of events simulated for each point
+ *
+ * The laser commands are checked before the first run, so that a scan never
+ * stops in the middle with its output file left open.
+ */
+void PlasmaMLPALLASScanDriver::Run(G4int nEventsPerPoint)
+{
+    if (fPoints.empty())
+    {
+        G4Exception("PlasmaMLPALLASScanDriver::Run", "SCAN0001", JustWarning,
+                    "No working point in the scan: use /PlasmaMLPALLAS/scan/addPoint or setGrid first.");
+        return;
+    }
+
+    G4UImanager* UI = G4UImanager::GetUIpointer();
+    for (const char* command : kLaserCommands)
+    {
+        if (!UI->GetTree()->FindPath(command))
+        {
+            G4Exception("PlasmaMLPALLASScanDriver::Run", "SCAN0002", JustWarning,
+                        ("Command " + G4String(command) + " not found: the kernel must be initialised before a scan.").c_str());
+            return;
+        }
+    }
+
+    const size_t nPoints = fPoints.size();
+    fEventsPerPoint = nEventsPerPoint;
+    fRunning = true;
+
+    for (size_t i = 0; i < nPoints; ++i)
+    {
+        const Point& point = fPoints[i];
+        for (size_t j = 0; j < kLaserCommands.size(); ++j)
+        {
+            std::ostringstream os;
+            os << kLaserCommands[j] << " " << std::setprecision(12) << point[j];
+            UI->ApplyCommand(os.str());
+        }
+
+        fScanIndex = static_cast<G4int>(i);
+        fKeepOutputOpen = (i + 1 < nPoints);
+
+        G4cout << "### Scan point " << i + 1 << "/" << nPoints
+               << " : Xoff = " << point[0] << " A0 = " << point[1]
+               << " CN2 = " << point[2] << " Pressure = " << point[3] << G4endl;
+
+        UI->ApplyCommand("/run/beamOn " + std::to_string(nEventsPerPoint));
+    }
+
+    fKeepOutputOpen = false;
+    fRunning = false;
+    fScanIndex = 0;
+    fHasRun = true;
+}
@@ -0,0 +1,158 @@
+#include "PlasmaMLPALLASScanMessenger.hh"
+#include "PlasmaMLPALLASScanDriver.hh"
+#include "PlasmaMLPALLASOnnxInference.hh"
+#include "G4UIparameter.hh"
+#include <sstream>
+
+/**
+ * @file PlasmaMLPALLASScanMessenger.cc
+ * @brief User interface (UI) messenger for the scan of ONNX working points.
+ *
+ * Commands are organized in the /PlasmaMLPALLAS/scan/ directory and allow users to:
+ *  - Append one (Xoff, A0, CN2, Pressure) working point.
+ *  - Append a grid of working points, each input given as a value or min:max:n.
+ *  - Clear and print the list of points.
+ *  - Run every point in the current kernel, with the same number of events.
+ *
+ * @authors Arnaud HUBER
+ * @authors Alexei SYTOV
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Constructor.
+ * @param driver Pointer to the scan driver.
+ */
+PlasmaMLPALLASScanMessenger::PlasmaMLPALLASScanMessenger(PlasmaMLPALLASScanDriver *driver)
+    : G4UImessenger(), fDriver(driver)
+{
+    fScanDir = new G4UIdirectory("/PlasmaMLPALLAS/scan/");
+    fScanDir->SetGuidance("Scan of ONNX working points UI commands");
+
+    const char *names[4] = {"Xoff", "A0", "CN2", "Pressure"};
+
+    /**
+     * @brief Command to append one working point.
+     *
+     * Parameters: Xoff, A0, CN2, Pressure (double)
+     */
+    fAddPointCmd = new G4UIcommand("/PlasmaMLPALLAS/scan/addPoint", this);
+    fAddPointCmd->SetGuidance("Append one working point (Xoff A0 CN2 Pressure) to the scan");
+    for (const char *name : names)
+        fAddPointCmd->SetParameter(new G4UIparameter(name, 'd', false));
+    fAddPointCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fAddPointCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to append a grid of working points.
+     *
+     * Parameters: Xoff, A0, CN2, Pressure (value or min:max:n)
+     */
+    fSetGridCmd = new G4UIcommand("/PlasmaMLPALLAS/scan/setGrid", this);
+    fSetGridCmd->SetGuidance("Append the cartesian product of four input axes to the scan");
+    fSetGridCmd->SetGuidance("Each input is a single value or min:max:n, Pressure varying fastest");
+    for (const char *name : names)
+        fSetGridCmd->SetParameter(new G4UIparameter(name, 's', false));
+    fSetGridCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fSetGridCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to remove all the points of the scan.
+     */
+    fClearCmd = new G4UIcmdWithoutParameter("/PlasmaMLPALLAS/scan/clear", this);
+    fClearCmd->SetGuidance("Remove all the working points of the scan");
+    fClearCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fClearCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to print the points of the scan.
+     */
+    fListCmd = new G4UIcmdWithoutParameter("/PlasmaMLPALLAS/scan/list", this);
+    fListCmd->SetGuidance("Print the working points of the scan with their scan index");
+    fListCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fListCmd->SetToBeBroadcasted(false);
+
+    /**
+     * @brief Command to run every point of the scan.
+     *
+     * Parameter: NEvents (integer, events per point)
+     */
+    fRunCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/scan/run", this);
+    fRunCmd->SetGuidance("Run /run/beamOn for each working point in the current kernel");
+    fRunCmd->SetGuidance("All the points are written to the same output file, keyed by the ScanIndex branch");
+    fRunCmd->SetParameterName("NEvents", false);
+    fRunCmd->SetRange("NEvents>=1");
+    fRunCmd->AvailableForStates(G4State_Idle);
+    fRunCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Destructor.
+ */
+PlasmaMLPALLASScanMessenger::~PlasmaMLPALLASScanMessenger()
+{
+    delete fAddPointCmd;
+    delete fSetGridCmd;
+    delete fClearCmd;
+    delete fListCmd;
+    delete fRunCmd;
+    delete fScanDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASScanMessenger::SetNewValue(G4UIcommand *aCommand, G4String aNewValue)
+{
+    if (aCommand == fAddPointCmd)
+    {
+        PlasmaMLPALLASScanDriver::Point point{};
+        std::istringstream is(aNewValue);
+        is >> point[0] >> point[1] >> point[2] >> point[3];
+        fDriver->AddPoint(point);
+    }
+    else if (aCommand == fSetGridCmd)
+    {
+        std::array<OnnxGridAxis, 4> axes;
+        std::istringstream is(aNewValue);
+        for (auto &axis : axes)
+        {
+            std::string spec;
+            is >> spec;
+            if (!OnnxGridAxis::Parse(spec, axis))
+            {
+                G4Exception("PlasmaMLPALLASScanMessenger::SetNewValue", "SCAN0003", JustWarning,
+                            ("Invalid grid axis \"" + spec + "\": expected a value or min:max:n. No point added.").c_str());
+                return;
+            }
+        }
+        G4cout << fDriver->AddGrid(axes) << " working points added to the scan" << G4endl;
+    }
+    else if (aCommand == fClearCmd)
+        fDriver->Clear();
+    else if (aCommand == fListCmd)
+    {
+        const auto &points = fDriver->GetPoints();
+        for (size_t i = 0; i < points.size(); ++i)
+            G4cout << "ScanIndex " << i << " : Xoff = " << points[i][0] << " A0 = " << points[i][1]
+                   << " CN2 = " << points[i][2] << " Pressure = " << points[i][3] << G4endl;
+    }
+    else if (aCommand == fRunCmd)
+        fDriver->Run(fRunCmd->GetNewIntValue(aNewValue));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PlasmaMLPALLASScanMessenger::GetCurrentValue(G4UIcommand *aCommand)
+{
+    G4String cv;
+
+    if (aCommand == fRunCmd)
+        cv = fRunCmd->ConvertToString(fDriver->GetEventsPerPoint());
+
+    return cv;
+}
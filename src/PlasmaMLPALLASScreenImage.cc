@@ -0,0 +1,98 @@
+/**
+ * @file PlasmaMLPALLASScreenImage.cc
+ * @brief Implementation of the binned image of a YAG screen.
+ *
+ * The bins are summed in double precision by every thread; the master image
+ * holds the sum of the worker ones after the merge, the grid being the same
+ * on every thread (set from PlasmaMLPALLASOutputManager before the run).
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASScreenImage.hh"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASScreenImage::PlasmaMLPALLASScreenImage(const G4String& name, const Binning& binning)
+    : G4VAccumulable(name)
+{
+    SetBinning(binning);
+}
+
+void PlasmaMLPALLASScreenImage::SetBinning(const Binning& binning)
+{
+    fBinning = binning;
+    fBinning.nx = std::max(fBinning.nx, 1);
+    fBinning.ny = std::max(fBinning.ny, 1);
+    fBins.assign(static_cast<size_t>(fBinning.nx + 2) * static_cast<size_t>(fBinning.ny + 2), 0.);
+    fEntries = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int PlasmaMLPALLASScreenImage::AxisBin(G4double value, G4int n, G4double min, G4double max)
+{
+    if (value < min)
+        return 0;
+    if (value >= max)
+        return n + 1;
+    return 1 + std::min(static_cast<G4int>((value - min) * n / (max - min)), n - 1);
+}
+
+void PlasmaMLPALLASScreenImage::Fill(G4double u, G4double v, G4double weight)
+{
+    if (weight == 0. || std::isnan(u) || std::isnan(v) || std::isnan(weight))
+        return;
+
+    const G4int i = AxisBin(u, fBinning.nx, fBinning.xmin, fBinning.xmax);
+    const G4int j = AxisBin(v, fBinning.ny, fBinning.ymin, fBinning.ymax);
+    fBins[static_cast<size_t>(i + (fBinning.nx + 2) * j)] += weight;
+    ++fEntries;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASScreenImage::Merge(const G4VAccumulable& other)
+{
+    const auto& image = static_cast<const PlasmaMLPALLASScreenImage&>(other);
+    if (image.fBins.size() != fBins.size())
+    {
+        G4ExceptionDescription msg;
+        msg << "Image " << GetName() << " of a worker has another binning: not merged.";
+        G4Exception("PlasmaMLPALLASScreenImage::Merge", "IMG0001", JustWarning, msg);
+        return;
+    }
+
+    std::transform(fBins.begin(), fBins.end(), image.fBins.begin(), fBins.begin(), std::plus<G4double>());
+    fEntries += image.fEntries;
+}
+
+void PlasmaMLPALLASScreenImage::Reset()
+{
+    std::fill(fBins.begin(), fBins.end(), 0.);
+    fEntries = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASScreenImage::Raw PlasmaMLPALLASScreenImage::GetRaw() const
+{
+    Raw raw;
+    raw.nx = fBinning.nx;
+    raw.ny = fBinning.ny;
+    raw.xmin = fBinning.xmin;
+    raw.xmax = fBinning.xmax;
+    raw.ymin = fBinning.ymin;
+    raw.ymax = fBinning.ymax;
+    raw.pixels.reserve(static_cast<size_t>(raw.nx) * static_cast<size_t>(raw.ny));
+    for (G4int j = 1; j <= raw.ny; ++j)
+        for (G4int i = 1; i <= raw.nx; ++i)
+            raw.pixels.push_back(static_cast<float>(fBins[static_cast<size_t>(i + (raw.nx + 2) * j)]));
+    return raw;
+}
@@ -0,0 +1,220 @@
+/**
+ * @file PlasmaMLPALLASSensitiveDetectors.cc
+ * @brief Implementation of the sensitive detectors of the beamline.
+ *
+ * Positions are stored in mm and energies in MeV (deposited energies in keV),
+ * with the step points used by the former stepping action, so that the
+ * tallies hold the same values.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASSensitiveDetectors.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4SystemOfUnits.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASQuadrupoleSD::PlasmaMLPALLASQuadrupoleSD(const G4String &name,
+                                                       const PlasmaMLPALLASVolumeRoles &volumeRoles)
+    : G4VSensitiveDetector(name), fVolumeRoles(volumeRoles)
+{
+    collectionName.insert("Hits");
+}
+
+void PlasmaMLPALLASQuadrupoleSD::Initialize(G4HCofThisEvent *hce)
+{
+    fHits = new PlasmaMLPALLASQuadrupoleHitsCollection(SensitiveDetectorName, collectionName[0]);
+    hce->AddHitsCollection(GetCollectionID(0), fHits);
+}
+
+/**
+ * @brief Record the entry and the exit of a primary.
+ *
+ * Secondaries are skipped: the tallies hold one row per primary, while the
+ * former stepping action let a secondary crossing a boundary overwrite the
+ * record of the event (intended change).
+ * The step entering the volume from the holder ends where the first step
+ * inside starts, so the entry is read on the pre-step point of the latter.
+ * A linear-optics fast step fills the tallies itself.
+ */
+G4bool PlasmaMLPALLASQuadrupoleSD::ProcessHits(G4Step *step, G4TouchableHistory *)
+{
+    const G4Track *track = step->GetTrack();
+    const G4StepPoint *pre = step->GetPreStepPoint();
+    const G4StepPoint *post = step->GetPostStepPoint();
+    if (track->GetParentID() != 0 || post->GetStepStatus() == fExclusivelyForcedProc)
+        return false;
+
+    const VolumeRole role = fVolumeRoles.Get(pre->GetPhysicalVolume());
+    if (!IsQuadrupole(role))
+        return false;
+
+    const QuadID quad = ToQuadID(role);
+    const G4double energy = pre->GetKineticEnergy() / MeV;
+    G4bool stored = false;
+
+    if (pre->GetStepStatus() == fGeomBoundary)
+    {
+        AddHit(track, pre, quad, PositionType::Begin, energy);
+        stored = true;
+    }
+
+    if (post->GetStepStatus() == fGeomBoundary && fVolumeRoles.Get(post->GetPhysicalVolume()) == VolumeRole::Holder)
+    {
+        AddHit(track, post, quad, PositionType::End, energy);
+        stored = true;
+    }
+
+    return stored;
+}
+
+void PlasmaMLPALLASQuadrupoleSD::AddHit(const G4Track *track, const G4StepPoint *point, QuadID quad,
+                                        PositionType posType, G4double energy)
+{
+    auto hit = new PlasmaMLPALLASQuadrupoleHit();
+    hit->trackID = track->GetTrackID();
+    hit->quad = quad;
+    hit->posType = posType;
+    hit->energy = energy;
+    hit->position = point->GetPosition() / mm;
+    hit->direction = point->GetMomentumDirection();
+    fHits->insert(hit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASCollimatorSD::PlasmaMLPALLASCollimatorSD(const G4String &name,
+                                                       const PlasmaMLPALLASVolumeRoles &volumeRoles)
+    : G4VSensitiveDetector(name), fVolumeRoles(volumeRoles)
+{
+    collectionName.insert("Horizontal");
+    collectionName.insert("Vertical");
+}
+
+void PlasmaMLPALLASCollimatorSD::Initialize(G4HCofThisEvent *hce)
+{
+    fHorizontal = new PlasmaMLPALLASCollimatorHitsCollection(SensitiveDetectorName, collectionName[0]);
+    fVertical = new PlasmaMLPALLASCollimatorHitsCollection(SensitiveDetectorName, collectionName[1]);
+    hce->AddHitsCollection(GetCollectionID(0), fHorizontal);
+    hce->AddHitsCollection(GetCollectionID(1), fVertical);
+
+    // Capacity kept across events
+    fHorizontalFlags.assign(fHorizontalFlags.size(), 0);
+    fVerticalFlags.assign(fVerticalFlags.size(), 0);
+}
+
+char &PlasmaMLPALLASCollimatorSD::Flag(std::vector<char> &flags, G4int trackID)
+{
+    const size_t i = static_cast<size_t>(trackID - 1);
+    if (i >= flags.size())
+        flags.resize(i + 1, 0);
+    return flags[i];
+}
+
+/**
+ * @brief Record the first interaction of a primary.
+ *
+ * Horizontal collimator: entry point, read on the pre-step point of the first
+ * step inside. Vertical collimator: end of the first step inside, only if the
+ * primary did not reach the horizontal collimator before.
+ */
+G4bool PlasmaMLPALLASCollimatorSD::ProcessHits(G4Step *step, G4TouchableHistory *)
+{
+    const G4Track *track = step->GetTrack();
+    if (track->GetParentID() != 0)
+        return false;
+
+    const G4StepPoint *pre = step->GetPreStepPoint();
+    const VolumeRole role = fVolumeRoles.Get(pre->GetPhysicalVolume());
+    const G4int trackID = track->GetTrackID();
+    char &horizontal = Flag(fHorizontalFlags, trackID);
+
+    PlasmaMLPALLASCollimatorHitsCollection *hits = nullptr;
+    const G4StepPoint *point = nullptr;
+    if (role == VolumeRole::HorizontalCollimator && !horizontal)
+    {
+        horizontal = 1;
+        hits = fHorizontal;
+        point = pre;
+    }
+    else if (role == VolumeRole::VerticalCollimator && !horizontal)
+    {
+        char &vertical = Flag(fVerticalFlags, trackID);
+        if (vertical)
+            return false;
+        vertical = 1;
+        hits = fVertical;
+        point = step->GetPostStepPoint();
+    }
+    else
+        return false;
+
+    auto hit = new PlasmaMLPALLASCollimatorHit();
+    hit->trackID = trackID;
+    hit->position = point->GetPosition() / mm;
+    hit->energy = pre->GetKineticEnergy() / MeV;
+    hit->weight = track->GetWeight();
+    hits->insert(hit);
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASYAGSD::PlasmaMLPALLASYAGSD(const G4String &name, const PlasmaMLPALLASVolumeRoles &volumeRoles)
+    : G4VSensitiveDetector(name), fVolumeRoles(volumeRoles)
+{
+    collectionName.insert("Hits");
+}
+
+void PlasmaMLPALLASYAGSD::Initialize(G4HCofThisEvent *hce)
+{
+    fHits = new PlasmaMLPALLASYAGHitsCollection(SensitiveDetectorName, collectionName[0]);
+    hce->AddHitsCollection(GetCollectionID(0), fHits);
+    fOpenHit = nullptr;
+}
+
+/**
+ * @brief Record the steps of a particle in the screen.
+ *
+ * The first step opens a hit (end of the step, kinetic energy at its start),
+ * every step adds its deposit, and the hit is closed when the particle leaves
+ * into the holder or loses all its energy.
+ */
+G4bool PlasmaMLPALLASYAGSD::ProcessHits(G4Step *step, G4TouchableHistory *)
+{
+    const G4Track *track = step->GetTrack();
+    const G4StepPoint *post = step->GetPostStepPoint();
+    const G4float energy = step->GetPreStepPoint()->GetKineticEnergy() / MeV;
+    const G4float energyDeposited = step->GetTotalEnergyDeposit() / keV;
+
+    if (!fOpenHit)
+    {
+        const G4ThreeVector position = post->GetPosition() / mm;
+        fOpenHit = new PlasmaMLPALLASYAGHit();
+        fOpenHit->x = position.x();
+        fOpenHit->y = position.y();
+        fOpenHit->z = position.z();
+        fOpenHit->parentID = track->GetParentID();
+        fOpenHit->particleID = track->GetDefinition()->GetPDGEncoding();
+        fOpenHit->energy = energy;
+        fOpenHit->weight = track->GetWeight();
+        fHits->insert(fOpenHit);
+    }
+
+    fOpenHit->depositedEnergy += energyDeposited;
+
+    if (fVolumeRoles.Get(post->GetPhysicalVolume()) == VolumeRole::Holder || (energy - energyDeposited) == 0)
+    {
+        fOpenHit->closed = true;
+        fOpenHit = nullptr;
+    }
+
+    return true;
+}
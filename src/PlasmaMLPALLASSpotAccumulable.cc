@@ -0,0 +1,32 @@
+/**
+ * @file PlasmaMLPALLASSpotAccumulable.cc
+ * @brief Implementation of the merge and reset of the screen spot moments.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASSpotAccumulable.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASSpotAccumulable::Merge(const G4VAccumulable& other)
+{
+    const auto& spot = static_cast<const PlasmaMLPALLASSpotAccumulable&>(other);
+    fEntries += spot.fEntries;
+    fSumW += spot.fSumW;
+    fSumWX += spot.fSumWX;
+    fSumWX2 += spot.fSumWX2;
+    fSumWZ += spot.fSumWZ;
+    fSumWZ2 += spot.fSumWZ2;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASSpotAccumulable::Reset()
+{
+    fEntries = 0;
+    fSumW = fSumWX = fSumWX2 = fSumWZ = fSumWZ2 = 0.;
+}
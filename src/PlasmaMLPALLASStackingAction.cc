@@ -0,0 +1,106 @@
+/**
+ * @file PlasmaMLPALLASStackingAction.cc
+ * @brief Implementation of the kill and defer policies of the secondaries.
+ *
+ * In the deferYAG policy the secondaries go to the waiting stack, which
+ * Geant4 only opens once the urgent stack (the primaries) is empty. At that
+ * point NewStage() reads the YAG detectors: without hit, the waiting stack is
+ * cleared; otherwise it is tracked, and the particles it produces are tracked
+ * at once instead of opening a stage per generation.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASStackingAction.hh"
+#include "PlasmaMLPALLASStackingMessenger.hh"
+#include "PlasmaMLPALLASSensitiveDetectors.hh"
+#include "G4SDManager.hh"
+#include "G4StackManager.hh"
+#include "G4Track.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASStackingAction::PlasmaMLPALLASStackingAction()
+{
+    fMessenger = new PlasmaMLPALLASStackingMessenger(this);
+}
+
+PlasmaMLPALLASStackingAction::~PlasmaMLPALLASStackingAction()
+{
+    delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const std::vector<G4String> &PlasmaMLPALLASStackingAction::GetPolicyNames()
+{
+    static const std::vector<G4String> names = {"all", "primaries", "deferYAG"};
+    return names;
+}
+
+void PlasmaMLPALLASStackingAction::SetKillThreshold(const G4ParticleDefinition *particle, G4double threshold)
+{
+    if (!particle)
+        return;
+    if (threshold > 0.)
+        fKillThresholds[particle] = threshold;
+    else
+        fKillThresholds.erase(particle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ClassificationOfNewTrack PlasmaMLPALLASStackingAction::ClassifyNewTrack(const G4Track *track)
+{
+    if (track->GetParentID() == 0)
+        return fUrgent;
+
+    if (fPolicy == Policy::Primaries)
+        return fKill;
+
+    if (!fKillThresholds.empty())
+    {
+        const auto it = fKillThresholds.find(track->GetDefinition());
+        if (it != fKillThresholds.end() && track->GetKineticEnergy() < it->second)
+            return fKill;
+    }
+
+    if (fPolicy == Policy::DeferYAG && !fDeferredStage)
+        return fWaiting;
+
+    return fUrgent;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASStackingAction::NewStage()
+{
+    if (fPolicy != Policy::DeferYAG || fDeferredStage)
+        return;
+
+    fDeferredStage = true;
+    if (!YAGHit())
+        stackManager->clear();
+}
+
+void PlasmaMLPALLASStackingAction::PrepareNewEvent()
+{
+    fDeferredStage = false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PlasmaMLPALLASStackingAction::YAGHit()
+{
+    G4SDManager *sdManager = G4SDManager::GetSDMpointer();
+    for (const char *name : {"BS1YAG", "BSPEC1YAG"})
+    {
+        const auto *yag = static_cast<const PlasmaMLPALLASYAGSD *>(sdManager->FindSensitiveDetector(name, false));
+        if (yag && yag->GetNumberOfHits() > 0)
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,138 @@
+#include "PlasmaMLPALLASStackingMessenger.hh"
+#include "PlasmaMLPALLASStackingAction.hh"
+#include "G4UIparameter.hh"
+#include "G4ParticleTable.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4UnitsTable.hh"
+#include <algorithm>
+#include <sstream>
+
+/**
+ * @file PlasmaMLPALLASStackingMessenger.cc
+ * @brief User interface (UI) messenger for the kill and defer policies of the secondaries.
+ *
+ * Commands are organized in the /PlasmaMLPALLAS/stack/ directory and allow users to:
+ *  - Track all particles, the primaries only, or defer the secondaries to a
+ *    stage tracked only if a primary reached a YAG screen.
+ *  - Kill the secondaries of a species below a kinetic energy.
+ *
+ * @authors Arnaud HUBER
+ * @authors Alexei SYTOV
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Constructor.
+ * @param stacking Pointer to the stacking action.
+ */
+PlasmaMLPALLASStackingMessenger::PlasmaMLPALLASStackingMessenger(PlasmaMLPALLASStackingAction *stacking)
+    : G4UImessenger(), fStacking(stacking)
+{
+    fStackDir = new G4UIdirectory("/PlasmaMLPALLAS/stack/");
+    fStackDir->SetGuidance("Kill and defer policies of the secondary particles UI commands");
+
+    /**
+     * @brief Command to select the policy.
+     */
+    G4String policies;
+    for (const auto &name : PlasmaMLPALLASStackingAction::GetPolicyNames())
+        policies += (policies.empty() ? "" : " ") + name;
+
+    fPolicyCmd = new G4UIcmdWithAString("/PlasmaMLPALLAS/stack/setPolicy", this);
+    fPolicyCmd->SetGuidance("Handling of the secondaries:");
+    fPolicyCmd->SetGuidance("  all: every particle is tracked (default)");
+    fPolicyCmd->SetGuidance("  primaries: the secondaries are killed at birth");
+    fPolicyCmd->SetGuidance("  deferYAG: the secondaries are tracked after the primaries, only if one of them hit a YAG screen");
+    fPolicyCmd->SetParameterName("Policy", false);
+    fPolicyCmd->SetCandidates(policies);
+    fPolicyCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    /**
+     * @brief Command to kill the secondaries of a species below a kinetic energy.
+     *
+     * Parameters: Particle (string), Threshold (double), Unit (string)
+     */
+    fKillThresholdCmd = new G4UIcommand("/PlasmaMLPALLAS/stack/setKillThreshold", this);
+    fKillThresholdCmd->SetGuidance("Kill the secondaries of a species below a kinetic energy (0 removes the threshold)");
+    fKillThresholdCmd->SetParameter(new G4UIparameter("Particle", 's', false));
+    auto *threshold = new G4UIparameter("Threshold", 'd', false);
+    threshold->SetParameterRange("Threshold>=0.");
+    fKillThresholdCmd->SetParameter(threshold);
+    auto *unit = new G4UIparameter("Unit", 's', true);
+    unit->SetDefaultUnit("MeV");
+    fKillThresholdCmd->SetParameter(unit);
+    fKillThresholdCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    /**
+     * @brief Command to remove all the thresholds.
+     */
+    fClearKillThresholdsCmd = new G4UIcmdWithoutParameter("/PlasmaMLPALLAS/stack/clearKillThresholds", this);
+    fClearKillThresholdsCmd->SetGuidance("Remove the kinetic energy thresholds of all species");
+    fClearKillThresholdsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Destructor.
+ */
+PlasmaMLPALLASStackingMessenger::~PlasmaMLPALLASStackingMessenger()
+{
+    delete fPolicyCmd;
+    delete fKillThresholdCmd;
+    delete fClearKillThresholdsCmd;
+    delete fStackDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASStackingMessenger::SetNewValue(G4UIcommand *aCommand, G4String aNewValue)
+{
+    if (aCommand == fPolicyCmd)
+    {
+        const auto &names = PlasmaMLPALLASStackingAction::GetPolicyNames();
+        const auto it = std::find(names.begin(), names.end(), aNewValue);
+        fStacking->SetPolicy(static_cast<PlasmaMLPALLASStackingAction::Policy>(it - names.begin()));
+    }
+    else if (aCommand == fKillThresholdCmd)
+    {
+        std::istringstream is(aNewValue);
+        G4String particleName, unit;
+        G4double value = 0.;
+        is >> particleName >> value >> unit;
+
+        const G4ParticleDefinition *particle = G4ParticleTable::GetParticleTable()->FindParticle(particleName);
+        if (!particle)
+        {
+            G4ExceptionDescription msg;
+            msg << "Unknown particle " << particleName << ", threshold ignored.";
+            G4Exception("PlasmaMLPALLASStackingMessenger::SetNewValue", "STK0001", JustWarning, msg);
+            return;
+        }
+        fStacking->SetKillThreshold(particle, value * G4UIcommand::ValueOf(unit));
+    }
+    else if (aCommand == fClearKillThresholdsCmd)
+        fStacking->ClearKillThresholds();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PlasmaMLPALLASStackingMessenger::GetCurrentValue(G4UIcommand *aCommand)
+{
+    G4String cv;
+
+    if (aCommand == fPolicyCmd)
+        cv = PlasmaMLPALLASStackingAction::GetPolicyNames()[static_cast<size_t>(fStacking->GetPolicy())];
+    else if (aCommand == fKillThresholdCmd)
+    {
+        std::ostringstream os;
+        for (const auto &[particle, threshold] : fStacking->GetKillThresholds())
+            os << (os.tellp() > 0 ? ", " : "") << particle->GetParticleName() << " " << G4BestUnit(threshold, "Energy");
+        cv = os.str();
+    }
+
+    return cv;
+}
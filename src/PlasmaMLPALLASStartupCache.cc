@@ -0,0 +1,300 @@
+/**
+ * @file PlasmaMLPALLASStartupCache.cc
+ * @brief Implementation of the on-disk cache of the GDML solids and physics tables.
+ *
+ * A cached model is a 40-byte header (the magic "PMLBTES1", the size and the
+ * time stamp of the GDML file, the number of facets and the length of the
+ * solid name), the solid name, then three vertices per facet as doubles in
+ * mm, in the order of the facets of the parsed solid.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASStartupCache.hh"
+#include "PlasmaMLPALLASStartupCacheMessenger.hh"
+#include "PlasmaMLPALLASGDMLLoader.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4Material.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4UIcommandStatus.hh"
+#include "G4UImanager.hh"
+#include "G4VUserPhysicsList.hh"
+#include "G4Version.hh"
+#include "G4ios.hh"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+    constexpr char kMagic[8] = {'P', 'M', 'L', 'B', 'T', 'E', 'S', '1'};
+
+    /**
+     * @brief Header of a cached GDML model
+     */
+    struct TessellatedHeader {
+        char magic[8];
+        std::uint64_t gdmlSize;
+        std::int64_t gdmlTime;
+        std::uint64_t nFacets;
+        std::uint64_t nameLength;
+    };
+
+    static_assert(sizeof(TessellatedHeader) == 40, "TessellatedHeader must be packed");
+
+    /**
+     * @brief Size and time stamp of a GDML file
+     * @return False if the file cannot be read
+     */
+    bool Stamp(const G4String& gdmlFile, std::uint64_t& size, std::int64_t& time)
+    {
+        std::error_code ec;
+        size = fs::file_size(gdmlFile.c_str(), ec);
+        if (ec)
+            return false;
+        time = fs::last_write_time(gdmlFile.c_str(), ec).time_since_epoch().count();
+        return !ec;
+    }
+
+    /**
+     * @brief 64-bit FNV-1a hash, stable across compilers and runs
+     */
+    std::uint64_t Hash(const std::string& text)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : text)
+        {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Name of an entry being written by this process
+     */
+    std::string TemporaryName(const std::string& entry)
+    {
+        return entry + ".tmp." + std::to_string(::getpid());
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASStartupCache& PlasmaMLPALLASStartupCache::Instance()
+{
+    static PlasmaMLPALLASStartupCache instance;
+    return instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASStartupCache::PlasmaMLPALLASStartupCache()
+{
+    fMessenger = new PlasmaMLPALLASStartupCacheMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASStartupCache::~PlasmaMLPALLASStartupCache()
+{
+    delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Cache entry of a GDML model
+ *
+ * The absolute path of the model is flattened into the file name, so that
+ * models with the same name in different sections do not collide.
+ */
+G4String PlasmaMLPALLASStartupCache::GeometryEntry(const G4String &gdmlFile) const
+{
+    std::error_code ec;
+    std::string name = fs::weakly_canonical(gdmlFile.c_str(), ec).string();
+    if (ec)
+        name = gdmlFile;
+    for (char &c : name)
+        if (c == '/' || c == '\\')
+            c = '_';
+
+    return (fs::path(fDirectory.c_str()) / "geometry" / (name + ".bin")).string();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Triangles of a GDML model from the cache.
+ *
+ * Only reads files: safe to call from the threads of PlasmaMLPALLASGDMLLoader.
+ */
+G4bool PlasmaMLPALLASStartupCache::LoadMesh(const G4String &gdmlFile, PlasmaMLPALLASTessellatedMesh &mesh) const
+{
+    if (!IsEnabled())
+        return false;
+
+    std::uint64_t size = 0;
+    std::int64_t time = 0;
+    if (!Stamp(gdmlFile, size, time))
+        return false;
+
+    std::ifstream in(GeometryEntry(gdmlFile), std::ios::binary);
+    TessellatedHeader header;
+    if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.gdmlSize != size || header.gdmlTime != time)
+        return false;
+
+    std::string name(header.nameLength, '\0');
+    std::vector<double> vertices(9 * header.nFacets);
+    in.read(name.data(), static_cast<std::streamsize>(name.size()));
+    in.read(reinterpret_cast<char *>(vertices.data()), static_cast<std::streamsize>(vertices.size() * sizeof(double)));
+    if (!in)
+        return false;
+
+    mesh.solidName = name;
+    mesh.vertices = std::move(vertices);
+    mesh.fromCache = true;
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASStartupCache::StoreMesh(const G4String &gdmlFile, const PlasmaMLPALLASTessellatedMesh &mesh) const
+{
+    if (!IsEnabled() || mesh.fromCache)
+        return;
+
+    TessellatedHeader header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    if (!Stamp(gdmlFile, header.gdmlSize, header.gdmlTime))
+        return;
+
+    const std::string name = mesh.solidName;
+    header.nFacets = mesh.vertices.size() / 9;
+    header.nameLength = name.size();
+
+    const std::string entry = GeometryEntry(gdmlFile);
+    const std::string temporary = TemporaryName(entry);
+    std::error_code ec;
+    fs::create_directories(fs::path(entry).parent_path(), ec);
+    {
+        std::ofstream out(temporary, std::ios::binary);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(name.data(), static_cast<std::streamsize>(name.size()));
+        out.write(reinterpret_cast<const char *>(mesh.vertices.data()),
+                  static_cast<std::streamsize>(9 * header.nFacets * sizeof(double)));
+        if (!out)
+        {
+            out.close();
+            fs::remove(temporary, ec);
+            G4ExceptionDescription msg;
+            msg << "Cannot write the cache entry " << entry << " of " << gdmlFile << ".";
+            G4Exception("PlasmaMLPALLASStartupCache::StoreMesh", "CACHE0001", JustWarning, msg);
+            return;
+        }
+    }
+    fs::rename(temporary, entry, ec);
+    if (ec)
+        fs::remove(temporary, ec);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Retrieve the tables of this configuration if they are cached.
+ *
+ * Called once the geometry is built: the key covers every logical volume with
+ * its material and the root volumes of every region, which is what the
+ * material-cuts couples of the stored tables depend on.
+ */
+void PlasmaMLPALLASStartupCache::PreparePhysicsTables(G4VUserPhysicsList *physicsList, const G4String &configuration)
+{
+    fPhysicsEntry.clear();
+    fPhysicsRetrieved = false;
+    if (!IsEnabled())
+        return;
+
+    std::ostringstream key;
+    key << G4VERSION_NUMBER << '|' << configuration;
+    for (const G4LogicalVolume *volume : *G4LogicalVolumeStore::GetInstance())
+        key << '|' << volume->GetName() << ':' << (volume->GetMaterial() ? volume->GetMaterial()->GetName() : "");
+    for (G4Region *region : *G4RegionStore::GetInstance())
+    {
+        key << '|' << region->GetName();
+        auto root = region->GetRootLogicalVolumeIterator();
+        for (size_t i = 0; i < region->GetNumberOfRootVolumes(); ++i, ++root)
+            key << ':' << (*root)->GetName();
+    }
+
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << Hash(key.str());
+    fPhysicsEntry = (fs::path(fDirectory.c_str()) / "physics" / name.str()).string();
+
+    std::error_code ec;
+    if (fs::is_directory(fPhysicsEntry.c_str(), ec))
+    {
+        physicsList->SetPhysicsTableRetrieved(fPhysicsEntry);
+        fPhysicsRetrieved = true;
+        G4cout << "Physics tables retrieved from " << fPhysicsEntry << G4endl;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASStartupCache::DiscardPhysicsTables(G4VUserPhysicsList *physicsList)
+{
+    if (fPhysicsRetrieved)
+        physicsList->ResetPhysicsTableRetrieved();
+    fPhysicsEntry.clear();
+    fPhysicsRetrieved = false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Store the tables built by the last run.
+ *
+ * The tables are written in a temporary directory renamed at the end; if
+ * another job stored the same configuration in the meantime, its entry is kept.
+ */
+void PlasmaMLPALLASStartupCache::StorePhysicsTables()
+{
+    if (fPhysicsEntry.empty() || fPhysicsRetrieved)
+        return;
+
+    const std::string temporary = TemporaryName(fPhysicsEntry);
+    std::error_code ec;
+    fs::create_directories(temporary, ec);
+    if (ec || G4UImanager::GetUIpointer()->ApplyCommand("/run/particle/storePhysicsTable " + temporary) != fCommandSucceeded)
+    {
+        fs::remove_all(temporary, ec);
+        G4ExceptionDescription msg;
+        msg << "Cannot store the physics tables in " << fPhysicsEntry << ".";
+        G4Exception("PlasmaMLPALLASStartupCache::StorePhysicsTables", "CACHE0002", JustWarning, msg);
+        fPhysicsEntry.clear();
+        return;
+    }
+
+    fs::rename(temporary, fPhysicsEntry.c_str(), ec);
+    if (ec)
+        fs::remove_all(temporary, ec);
+    else
+        G4cout << "Physics tables stored in " << fPhysicsEntry << G4endl;
+
+    fPhysicsRetrieved = true;
+}
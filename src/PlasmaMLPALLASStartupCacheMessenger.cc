@@ -0,0 +1,72 @@
+#include "PlasmaMLPALLASStartupCacheMessenger.hh"
+#include "PlasmaMLPALLASStartupCache.hh"
+
+/**
+ * @file PlasmaMLPALLASStartupCacheMessenger.cc
+ * @brief User interface (UI) messenger for the startup cache.
+ *
+ * Commands are organized in the /PlasmaMLPALLAS/cache/ directory and allow users to:
+ *  - Set the directory where the parsed GDML models and the physics tables
+ *    are kept between jobs.
+ *
+ * @authors Arnaud HUBER
+ * @authors Alexei SYTOV
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Constructor.
+ * @param cache Pointer to the startup cache.
+ */
+PlasmaMLPALLASStartupCacheMessenger::PlasmaMLPALLASStartupCacheMessenger(PlasmaMLPALLASStartupCache *cache)
+    : G4UImessenger(), fCache(cache)
+{
+    fCacheDir = new G4UIdirectory("/PlasmaMLPALLAS/cache/");
+    fCacheDir->SetGuidance("Startup cache (GDML models and physics tables) UI commands");
+
+    /**
+     * @brief Command to set the cache directory.
+     *
+     * Parameter: Directory (string), created if needed
+     */
+    fDirectoryCmd = new G4UIcmdWithAString("/PlasmaMLPALLAS/cache/setDirectory", this);
+    fDirectoryCmd->SetGuidance("Directory of the parsed GDML models and of the physics tables, shared between jobs");
+    fDirectoryCmd->SetGuidance("Must be set before /run/initialize");
+    fDirectoryCmd->SetParameterName("Directory", false);
+    fDirectoryCmd->AvailableForStates(G4State_PreInit);
+    fDirectoryCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Destructor.
+ */
+PlasmaMLPALLASStartupCacheMessenger::~PlasmaMLPALLASStartupCacheMessenger()
+{
+    delete fDirectoryCmd;
+    delete fCacheDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASStartupCacheMessenger::SetNewValue(G4UIcommand *aCommand, G4String aNewValue)
+{
+    if (aCommand == fDirectoryCmd)
+        fCache->SetDirectory(aNewValue);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PlasmaMLPALLASStartupCacheMessenger::GetCurrentValue(G4UIcommand *aCommand)
+{
+    G4String cv;
+
+    if (aCommand == fDirectoryCmd)
+        cv = fCache->GetDirectory();
+
+    return cv;
+}
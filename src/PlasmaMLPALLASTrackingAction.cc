@@ -0,0 +1,58 @@
+/**
+ * @file PlasmaMLPALLASTrackingAction.cc
+ * @brief Implementation of the selection and decimation of the trajectories.
+ *
+ * G4TrackingManager creates the trajectory of a track after the
+ * PreUserTrackingAction, and only if storeTrajectory is set and no
+ * trajectory was given: switching the flag off skips the track, setting a
+ * PlasmaMLPALLASTrajectory caps its points.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASTrackingAction.hh"
+#include "PlasmaMLPALLASTrackingMessenger.hh"
+#include "PlasmaMLPALLASTrajectory.hh"
+#include "G4TrackingManager.hh"
+#include "G4Track.hh"
+#include "G4VVisManager.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASTrackingAction::PlasmaMLPALLASTrackingAction()
+{
+    fMessenger = new PlasmaMLPALLASTrackingMessenger(this);
+}
+
+PlasmaMLPALLASTrackingAction::~PlasmaMLPALLASTrackingAction()
+{
+    delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASTrackingAction::PreUserTrackingAction(const G4Track *track)
+{
+    fStoreTrajectory = fpTrackingManager->GetStoreTrajectory();
+    if (fStoreTrajectory == 0)
+        return;
+
+    // No driver (batch jobs, or vis disabled): nobody will draw the trajectories
+    const G4bool selected = G4VVisManager::GetConcreteInstance() &&
+                            (!fPrimariesOnly || track->GetParentID() == 0) &&
+                            (track->GetTrackID() - 1) % fEveryNth == 0;
+    if (!selected)
+        fpTrackingManager->SetStoreTrajectory(0);
+    else if (fMaxPoints > 0)
+        fpTrackingManager->SetTrajectory(new PlasmaMLPALLASTrajectory(track, fMaxPoints));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASTrackingAction::PostUserTrackingAction(const G4Track *)
+{
+    fpTrackingManager->SetStoreTrajectory(fStoreTrajectory);
+}
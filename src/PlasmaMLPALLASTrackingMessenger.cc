@@ -0,0 +1,102 @@
+#include "PlasmaMLPALLASTrackingMessenger.hh"
+#include "PlasmaMLPALLASTrackingAction.hh"
+
+/**
+ * @file PlasmaMLPALLASTrackingMessenger.cc
+ * @brief User interface (UI) messenger for the selection and decimation of the trajectories.
+ *
+ * Commands are organized in the /PlasmaMLPALLAS/trajectory/ directory and allow users to:
+ *  - Store the trajectories of the primaries only, or of one track out of N.
+ *  - Cap the number of points of a trajectory.
+ *
+ * The trajectories are only stored with /tracking/storeTrajectory on and an
+ * active visualization driver.
+ *
+ * @authors Arnaud HUBER
+ * @authors Alexei SYTOV
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Constructor.
+ * @param tracking Pointer to the tracking action.
+ */
+PlasmaMLPALLASTrackingMessenger::PlasmaMLPALLASTrackingMessenger(PlasmaMLPALLASTrackingAction *tracking)
+    : G4UImessenger(), fTracking(tracking)
+{
+    fTrajectoryDir = new G4UIdirectory("/PlasmaMLPALLAS/trajectory/");
+    fTrajectoryDir->SetGuidance("Selection and decimation of the trajectories stored for the visualization UI commands");
+
+    /**
+     * @brief Command to store the trajectories of the primaries only.
+     */
+    fPrimariesOnlyCmd = new G4UIcmdWithABool("/PlasmaMLPALLAS/trajectory/setPrimariesOnly", this);
+    fPrimariesOnlyCmd->SetGuidance("Store the trajectories of the primaries only (default: every track)");
+    fPrimariesOnlyCmd->SetParameterName("PrimariesOnly", false);
+    fPrimariesOnlyCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    /**
+     * @brief Command to store one trajectory out of N.
+     */
+    fEveryNthCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/trajectory/setEveryNth", this);
+    fEveryNthCmd->SetGuidance("Store the trajectories of one track out of N (track ID 1, N+1, 2N+1...; 1: every track)");
+    fEveryNthCmd->SetGuidance("Combined with setPrimariesOnly, one primary out of N.");
+    fEveryNthCmd->SetParameterName("N", false);
+    fEveryNthCmd->SetRange("N>=1");
+    fEveryNthCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    /**
+     * @brief Command to cap the number of points of a trajectory.
+     */
+    fMaxPointsCmd = new G4UIcmdWithAnInteger("/PlasmaMLPALLAS/trajectory/setMaxPoints", this);
+    fMaxPointsCmd->SetGuidance("Maximum number of points of a trajectory (0: one point per step, default)");
+    fMaxPointsCmd->SetGuidance("The kept points are spread along the track, whose start and end are always drawn;");
+    fMaxPointsCmd->SetGuidance("a capped trajectory has no auxiliary (smooth) points.");
+    fMaxPointsCmd->SetParameterName("MaxPoints", false);
+    fMaxPointsCmd->SetRange("MaxPoints==0 || MaxPoints>=2");
+    fMaxPointsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/**
+ * @brief Destructor.
+ */
+PlasmaMLPALLASTrackingMessenger::~PlasmaMLPALLASTrackingMessenger()
+{
+    delete fPrimariesOnlyCmd;
+    delete fEveryNthCmd;
+    delete fMaxPointsCmd;
+    delete fTrajectoryDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASTrackingMessenger::SetNewValue(G4UIcommand *aCommand, G4String aNewValue)
+{
+    if (aCommand == fPrimariesOnlyCmd)
+        fTracking->SetPrimariesOnly(fPrimariesOnlyCmd->GetNewBoolValue(aNewValue));
+    else if (aCommand == fEveryNthCmd)
+        fTracking->SetEveryNth(fEveryNthCmd->GetNewIntValue(aNewValue));
+    else if (aCommand == fMaxPointsCmd)
+        fTracking->SetMaxPoints(fMaxPointsCmd->GetNewIntValue(aNewValue));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PlasmaMLPALLASTrackingMessenger::GetCurrentValue(G4UIcommand *aCommand)
+{
+    G4String cv;
+
+    if (aCommand == fPrimariesOnlyCmd)
+        cv = fPrimariesOnlyCmd->ConvertToString(fTracking->GetPrimariesOnly());
+    else if (aCommand == fEveryNthCmd)
+        cv = fEveryNthCmd->ConvertToString(fTracking->GetEveryNth());
+    else if (aCommand == fMaxPointsCmd)
+        cv = fMaxPointsCmd->ConvertToString(fTracking->GetMaxPoints());
+
+    return cv;
+}
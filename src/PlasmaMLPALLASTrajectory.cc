@@ -0,0 +1,122 @@
+/**
+ * @file PlasmaMLPALLASTrajectory.cc
+ * @brief Implementation of the trajectory with a capped number of points.
+ *
+ * The kept points are the start (step 0) and the ends of the steps that are
+ * multiples of the stride. Dropping the odd indexes therefore leaves the
+ * multiples of twice the stride, and the memory of a trajectory never
+ * exceeds the cap whatever the length of the track.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASTrajectory.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4TrajectoryPoint.hh"
+#include <algorithm>
+
+G4ThreadLocal G4Allocator<PlasmaMLPALLASTrajectory>* PlasmaMLPALLASTrajectoryAllocator = nullptr;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PlasmaMLPALLASTrajectory::PlasmaMLPALLASTrajectory(const G4Track *track, G4int maxPoints)
+    : fParticle(track->GetDefinition()),
+      fInitialMomentum(track->GetMomentum()),
+      fTrackID(track->GetTrackID()),
+      fParentID(track->GetParentID()),
+      fMaxPoints(std::max(maxPoints, 2))
+{
+    fPoints.reserve(static_cast<size_t>(fMaxPoints));
+    fPoints.push_back(new G4TrajectoryPoint(track->GetPosition()));
+}
+
+PlasmaMLPALLASTrajectory::~PlasmaMLPALLASTrajectory()
+{
+    for (G4TrajectoryPoint *point : fPoints)
+        delete point;
+    delete fEnd;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PlasmaMLPALLASTrajectory::GetParticleName() const
+{
+    return fParticle->GetParticleName();
+}
+
+G4double PlasmaMLPALLASTrajectory::GetCharge() const
+{
+    return fParticle->GetPDGCharge();
+}
+
+G4int PlasmaMLPALLASTrajectory::GetPDGEncoding() const
+{
+    return fParticle->GetPDGEncoding();
+}
+
+G4int PlasmaMLPALLASTrajectory::GetPointEntries() const
+{
+    return static_cast<G4int>(fPoints.size()) + (fEnd ? 1 : 0);
+}
+
+G4VTrajectoryPoint *PlasmaMLPALLASTrajectory::GetPoint(G4int i) const
+{
+    if (i < static_cast<G4int>(fPoints.size()))
+        return fPoints[static_cast<size_t>(i)];
+    return fEnd;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASTrajectory::AppendStep(const G4Step *step)
+{
+    AddPosition(step->GetPostStepPoint()->GetPosition());
+}
+
+void PlasmaMLPALLASTrajectory::MergeTrajectory(G4VTrajectory *secondTrajectory)
+{
+    if (!secondTrajectory)
+        return;
+    for (G4int i = 1; i < secondTrajectory->GetPointEntries(); ++i)
+        AddPosition(secondTrajectory->GetPoint(i)->GetPosition());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASTrajectory::AddPosition(const G4ThreeVector &position)
+{
+    delete fEnd;
+    fEnd = nullptr;
+
+    if (++fSteps % fStride != 0)
+    {
+        fEnd = new G4TrajectoryPoint(position);
+        return;
+    }
+
+    fPoints.push_back(new G4TrajectoryPoint(position));
+    if (static_cast<G4int>(fPoints.size()) >= fMaxPoints)
+        Compact();
+}
+
+void PlasmaMLPALLASTrajectory::Compact()
+{
+    const size_t n = fPoints.size();
+    size_t kept = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (i % 2 == 0)
+            fPoints[kept++] = fPoints[i];
+        else if (i == n - 1)
+            fEnd = fPoints[i]; // the latest step end stays drawn
+        else
+            delete fPoints[i];
+    }
+    fPoints.resize(kept);
+    fStride *= 2;
+}
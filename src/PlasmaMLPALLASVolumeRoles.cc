@@ -0,0 +1,50 @@
+/**
+ * @file PlasmaMLPALLASVolumeRoles.cc
+ * @brief Implementation of the physical volume role table.
+ *
+ * @author Arnaud HUBER <huber@lp2ib.in2p3.fr>
+ * @author Alexei SYTOV <sytov@infn.it>
+ * @date 2025
+ * @copyright PALLAS Project - GEANT4 Collaboration
+ */
+
+#include "PlasmaMLPALLASVolumeRoles.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include <map>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PlasmaMLPALLASVolumeRoles::Build()
+{
+    // Names given to the placements in PlasmaMLPALLASGeometryConstruction
+    static const std::map<G4String, VolumeRole> roles = {
+        {"World", VolumeRole::World},
+        {"Holder", VolumeRole::Holder},
+        {"Q1Volume", VolumeRole::Q1},
+        {"Q2Volume", VolumeRole::Q2},
+        {"Q3Volume", VolumeRole::Q3},
+        {"Q4Volume", VolumeRole::Q4},
+        // Vacuum around the quadrupole volumes: leaving a quadrupole into it is an exit
+        {"Q1FieldVolume", VolumeRole::Holder},
+        {"Q2FieldVolume", VolumeRole::Holder},
+        {"Q3FieldVolume", VolumeRole::Holder},
+        {"Q4FieldVolume", VolumeRole::Holder},
+        {"HorizontalCollimator", VolumeRole::HorizontalCollimator},
+        {"VerticalCollimator", VolumeRole::VerticalCollimator},
+        {"BS1_YAG", VolumeRole::BSYAG},
+        {"BSPEC1_YAG", VolumeRole::BSPECYAG},
+    };
+
+    fRoles.clear();
+    for (const G4VPhysicalVolume* volume : *G4PhysicalVolumeStore::GetInstance())
+    {
+        const auto it = roles.find(volume->GetName());
+        if (it == roles.end())
+            continue;
+
+        const size_t id = volume->GetInstanceID();
+        if (id >= fRoles.size())
+            fRoles.resize(id + 1, VolumeRole::None);
+        fRoles[id] = it->second;
+    }
+}